@@ -0,0 +1,400 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "subjective_logic_lib/batch/evidence_batch.hpp"
+#include "subjective_logic_lib/batch/opinion_batch.hpp"
+#include "subjective_logic_lib/batch/thread_pool.hpp"
+#include "subjective_logic_lib/multi_source/conflict_operators.hpp"
+
+namespace subjective_logic
+{
+
+/**
+ * @brief executes operators on whole OpinionBatch instances using multiple threads.
+ *        a batch is split into tiles of consecutive entries that fit into the (per core) cache,
+ *        each tile is one task of the underlying work-stealing ThreadPool.
+ *        the tile boundaries only depend on the size of the batch and the tile size, not on the number of threads.
+ *        since each entry is processed independently and tiles write to disjoint parts of the output,
+ *        the results are bitwise identical for every number of threads.
+ *        the operands of the binary operators have to be of the size of the batch, otherwise std::invalid_argument
+ *        is thrown before any tile is scheduled.
+ *
+ *        this class is not available with CUDA.
+ */
+class BatchExecutor
+{
+public:
+  /**
+   * @brief default amount of memory a single tile should touch (about the size of a L2 cache)
+   */
+  static constexpr std::size_t DEFAULT_TILE_BYTES{ 256 * 1024 };
+
+  /**
+   * @brief creates an executor
+   * @param num_threads - number of threads used (including the calling thread), 0 selects the number of hardware
+   * threads
+   * @param tile_bytes - amount of memory each tile should touch, used to derive the number of entries per tile
+   */
+  explicit BatchExecutor(std::size_t num_threads = 0, std::size_t tile_bytes = DEFAULT_TILE_BYTES);
+
+  /**
+   * @brief number of threads used to process a batch
+   */
+  [[nodiscard]] std::size_t num_threads() const;
+
+  /**
+   * @brief amount of memory each tile should touch
+   */
+  [[nodiscard]] std::size_t tile_bytes() const;
+
+  /**
+   * @brief number of entries of a tile for an operator touching num_lanes lanes of the given batch type
+   *        the result is a multiple of the lane padding, thus, tiles start at aligned addresses
+   * @tparam BatchT - an OpinionBatch or EvidenceBatch
+   * @param num_lanes - number of lanes accessed per entry (inputs and outputs)
+   */
+  template <typename BatchT>
+  [[nodiscard]] std::size_t tile_size(std::size_t num_lanes) const;
+
+  /**
+   * @brief calls func(first, last) for each tile [first, last) of [0, size) in parallel
+   * @param size - number of entries
+   * @param tile_size - number of entries per tile
+   * @param func - callable processing one tile, must only write to entries within the tile
+   */
+  template <typename Func>
+  void for_each_tile(std::size_t size, std::size_t tile_size, Func&& func);
+
+  /**
+   * @brief applies cumulative belief fusion elementwise to batch (inplace)
+   */
+  template <std::size_t N, typename FloatT>
+  OpinionBatch<N, FloatT>& cum_fuse_(OpinionBatch<N, FloatT>& batch, const OpinionBatch<N, FloatT>& other);
+
+  /**
+   * @brief applies cumulative belief fusion elementwise to an evidence batch (inplace), i.e., adds the evidence
+   */
+  template <std::size_t N, typename FloatT>
+  EvidenceBatch<N, FloatT>& cum_fuse_(EvidenceBatch<N, FloatT>& batch, const EvidenceBatch<N, FloatT>& other);
+
+  /**
+   * @brief applies averaging belief fusion elementwise to batch (inplace)
+   */
+  template <std::size_t N, typename FloatT>
+  OpinionBatch<N, FloatT>& average_fuse_(OpinionBatch<N, FloatT>& batch, const OpinionBatch<N, FloatT>& other);
+
+  /**
+   * @brief applies weighted belief fusion elementwise to batch (inplace)
+   */
+  template <std::size_t N, typename FloatT>
+  OpinionBatch<N, FloatT>& wb_fuse_(OpinionBatch<N, FloatT>& batch, const OpinionBatch<N, FloatT>& other);
+
+  /**
+   * @brief applies belief constrained fusion elementwise to batch (inplace)
+   */
+  template <std::size_t N, typename FloatT>
+  OpinionBatch<N, FloatT>& bc_fuse_(OpinionBatch<N, FloatT>& batch, const OpinionBatch<N, FloatT>& other);
+
+  /**
+   * @brief multi-source fusion of the respective entries of all sources, see OpinionBatch::fuse_opinions
+   */
+  template <std::size_t N, typename FloatT>
+  OpinionBatch<N, FloatT> fuse_opinions(typename OpinionBatch<N, FloatT>::FusionType fusion_type,
+                                        const std::vector<OpinionBatch<N, FloatT>>& sources);
+
+  /**
+   * @brief pairwise conflict (or harmony) of all opinions, see multisource::Conflict::pairwise_matrix.
+   *        each block of PAIRWISE_BLOCK_SIZE rows of the upper triangle is a task, the rows close to the top contain
+   *        more pairs, which is balanced by the work stealing of the pool
+   */
+  template <multisource::Conflict::RelationType RelationT, typename OpinionT>
+  void pairwise_matrix(std::span<const OpinionT> opinions,
+                       std::span<typename OpinionT::FLOAT_t> matrix,
+                       multisource::Workspace<OpinionT>& workspace);
+
+  /**
+   * @brief same as above for a workspace prepared by multisource::Conflict::prepare_pairwise_matrix,
+   *        e.g., from opinions which are not stored as OpinionT
+   */
+  template <multisource::Conflict::RelationType RelationT, typename OpinionT>
+  void pairwise_matrix(const multisource::Workspace<OpinionT>& workspace, std::span<typename OpinionT::FLOAT_t> matrix);
+
+  /**
+   * @brief applies trust discounting with the same probability to each entry of batch (inplace)
+   */
+  template <std::size_t N, typename FloatT>
+  OpinionBatch<N, FloatT>& trust_discount_(OpinionBatch<N, FloatT>& batch, FloatT prop);
+
+  /**
+   * @brief applies trust discounting with the respective trust opinion to each entry of batch (inplace)
+   */
+  template <std::size_t N, typename FloatT>
+  OpinionBatch<N, FloatT>&
+  trust_discount_(OpinionBatch<N, FloatT>& batch, const OpinionBatch<2, FloatT>& trusts, FloatT base_rate = 0.5);
+
+  /**
+   * @brief applies binomial deduction with shared conditionals to each entry of batch (inplace)
+   */
+  template <typename FloatT>
+  OpinionBatch<2, FloatT>& deduction_(OpinionBatch<2, FloatT>& batch,
+                                      FloatT base_x,
+                                      OpinionNoBase<2, FloatT> cond_1,
+                                      OpinionNoBase<2, FloatT> cond_2);
+
+  /**
+   * @brief calculates the projected probability of each entry of a binomial batch
+   */
+  template <typename FloatT>
+  AlignedVector<FloatT> getBinomialProjection(const OpinionBatch<2, FloatT>& batch, FloatT base_rate = 0.5);
+
+  /**
+   * @brief calculates the projected probability of each entry of a binomial evidence batch
+   */
+  template <typename FloatT>
+  AlignedVector<FloatT> getBinomialProjection(const EvidenceBatch<2, FloatT>& batch, FloatT base_rate = 0.5);
+
+  /**
+   * @brief classifies each entry of the batch, e.g., by thresholding its uncertainty and projected probability
+   * @param batch
+   * @param classifier - callable mapping an OpinionNoBase to a class label
+   * @return one label per entry
+   */
+  template <std::size_t N, typename FloatT, typename Classifier>
+  auto classify(const OpinionBatch<N, FloatT>& batch, Classifier&& classifier)
+      -> std::vector<std::invoke_result_t<Classifier, OpinionNoBase<N, FloatT>>>;
+
+protected:
+  /**
+   * @brief throws std::invalid_argument if the operand of a binary operator is not of the size of the batch, checked
+   *        once before scheduling as the ranged operators of the tiles only assert their ranges
+   */
+  static void check_operand_size(std::size_t size, std::size_t operand_size);
+
+  std::unique_ptr<ThreadPool> pool_;
+  std::size_t tile_bytes_;
+};
+
+inline BatchExecutor::BatchExecutor(std::size_t num_threads, std::size_t tile_bytes)
+  : pool_{ std::make_unique<ThreadPool>(num_threads) }, tile_bytes_{ tile_bytes }
+{
+}
+
+inline std::size_t BatchExecutor::num_threads() const
+{
+  return pool_->num_threads();
+}
+
+inline std::size_t BatchExecutor::tile_bytes() const
+{
+  return tile_bytes_;
+}
+
+inline void BatchExecutor::check_operand_size(std::size_t size, std::size_t operand_size)
+{
+  if (operand_size != size)
+  {
+    throw std::invalid_argument{ "the operand of size " + std::to_string(operand_size) +
+                                 " does not match the batch of size " + std::to_string(size) };
+  }
+}
+
+template <typename BatchT>
+std::size_t BatchExecutor::tile_size(std::size_t num_lanes) const
+{
+  using FloatT = typename BatchT::FLOAT_t;
+  constexpr std::size_t padding = BatchT::LANE_PADDING;
+  std::size_t entries = tile_bytes_ / (std::max<std::size_t>(num_lanes, 1) * sizeof(FloatT));
+  return std::max(padding, (entries / padding) * padding);
+}
+
+template <typename Func>
+void BatchExecutor::for_each_tile(std::size_t size, std::size_t tile_size, Func&& func)
+{
+  tile_size = std::max<std::size_t>(tile_size, 1);
+  std::size_t num_tiles = (size + tile_size - 1) / tile_size;
+  pool_->parallel_for(num_tiles, [&func, size, tile_size](std::size_t tile_idx) {
+    std::size_t first = tile_idx * tile_size;
+    func(first, std::min(first + tile_size, size));
+  });
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& BatchExecutor::cum_fuse_(OpinionBatch<N, FloatT>& batch, const OpinionBatch<N, FloatT>& other)
+{
+  check_operand_size(batch.size(), other.size());
+  for_each_tile(batch.size(), tile_size<OpinionBatch<N, FloatT>>(2 * N), [&](std::size_t first, std::size_t last) {
+    batch.cum_fuse_(other, first, last);
+  });
+  return batch;
+}
+
+template <std::size_t N, typename FloatT>
+EvidenceBatch<N, FloatT>& BatchExecutor::cum_fuse_(EvidenceBatch<N, FloatT>& batch,
+                                                   const EvidenceBatch<N, FloatT>& other)
+{
+  check_operand_size(batch.size(), other.size());
+  for_each_tile(batch.size(), tile_size<EvidenceBatch<N, FloatT>>(2 * N), [&](std::size_t first, std::size_t last) {
+    batch.cum_fuse_(other, first, last);
+  });
+  return batch;
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& BatchExecutor::average_fuse_(OpinionBatch<N, FloatT>& batch,
+                                                      const OpinionBatch<N, FloatT>& other)
+{
+  check_operand_size(batch.size(), other.size());
+  for_each_tile(batch.size(), tile_size<OpinionBatch<N, FloatT>>(2 * N), [&](std::size_t first, std::size_t last) {
+    batch.average_fuse_(other, first, last);
+  });
+  return batch;
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& BatchExecutor::wb_fuse_(OpinionBatch<N, FloatT>& batch, const OpinionBatch<N, FloatT>& other)
+{
+  check_operand_size(batch.size(), other.size());
+  for_each_tile(batch.size(), tile_size<OpinionBatch<N, FloatT>>(2 * N), [&](std::size_t first, std::size_t last) {
+    batch.wb_fuse_(other, first, last);
+  });
+  return batch;
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& BatchExecutor::bc_fuse_(OpinionBatch<N, FloatT>& batch, const OpinionBatch<N, FloatT>& other)
+{
+  check_operand_size(batch.size(), other.size());
+  for_each_tile(batch.size(), tile_size<OpinionBatch<N, FloatT>>(2 * N), [&](std::size_t first, std::size_t last) {
+    batch.bc_fuse_(other, first, last);
+  });
+  return batch;
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT> BatchExecutor::fuse_opinions(typename OpinionBatch<N, FloatT>::FusionType fusion_type,
+                                                     const std::vector<OpinionBatch<N, FloatT>>& sources)
+{
+  using Batch = OpinionBatch<N, FloatT>;
+  if (sources.empty())
+  {
+    throw std::invalid_argument{ "multi-source fusion requires at least one source" };
+  }
+  std::vector<typename Batch::ConstLaneType> source_lanes;
+  source_lanes.reserve(sources.size());
+  for (const auto& source : sources)
+  {
+    if (source.size() != sources.front().size())
+    {
+      throw std::invalid_argument{ "all sources of a multi-source fusion must have the same size" };
+    }
+    source_lanes.push_back(source.lanes());
+  }
+
+  // the lanes of all sources and the output are touched for each entry
+  Batch result{ sources.front().size() };
+  for_each_tile(
+      result.size(), tile_size<Batch>((sources.size() + 1) * N), [&](std::size_t first, std::size_t last) {
+        result.fuse_opinions_(fusion_type, source_lanes, first, last);
+      });
+  return result;
+}
+
+template <multisource::Conflict::RelationType RelationT, typename OpinionT>
+void BatchExecutor::pairwise_matrix(std::span<const OpinionT> opinions,
+                                    std::span<typename OpinionT::FLOAT_t> matrix,
+                                    multisource::Workspace<OpinionT>& workspace)
+{
+  multisource::Conflict::prepare_pairwise_matrix(opinions, workspace);
+  pairwise_matrix<RelationT>(std::as_const(workspace), matrix);
+}
+
+template <multisource::Conflict::RelationType RelationT, typename OpinionT>
+void BatchExecutor::pairwise_matrix(const multisource::Workspace<OpinionT>& workspace,
+                                    std::span<typename OpinionT::FLOAT_t> matrix)
+{
+  using multisource::Conflict;
+  for_each_tile(workspace.projections.size(), Conflict::PAIRWISE_BLOCK_SIZE, [&](std::size_t first, std::size_t last) {
+    Conflict::pairwise_matrix_rows<RelationT>(workspace, matrix, first, last);
+  });
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& BatchExecutor::trust_discount_(OpinionBatch<N, FloatT>& batch, FloatT prop)
+{
+  for_each_tile(batch.size(), tile_size<OpinionBatch<N, FloatT>>(N), [&](std::size_t first, std::size_t last) {
+    batch.trust_discount_(prop, first, last);
+  });
+  return batch;
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& BatchExecutor::trust_discount_(OpinionBatch<N, FloatT>& batch,
+                                                        const OpinionBatch<2, FloatT>& trusts,
+                                                        FloatT base_rate)
+{
+  check_operand_size(batch.size(), trusts.size());
+  for_each_tile(batch.size(), tile_size<OpinionBatch<N, FloatT>>(N + 2), [&](std::size_t first, std::size_t last) {
+    batch.trust_discount_(trusts, base_rate, first, last);
+  });
+  return batch;
+}
+
+template <typename FloatT>
+OpinionBatch<2, FloatT>& BatchExecutor::deduction_(OpinionBatch<2, FloatT>& batch,
+                                                   FloatT base_x,
+                                                   OpinionNoBase<2, FloatT> cond_1,
+                                                   OpinionNoBase<2, FloatT> cond_2)
+{
+  for_each_tile(batch.size(), tile_size<OpinionBatch<2, FloatT>>(2), [&](std::size_t first, std::size_t last) {
+    batch.deduction_(base_x, cond_1, cond_2, first, last);
+  });
+  return batch;
+}
+
+template <typename FloatT>
+AlignedVector<FloatT> BatchExecutor::getBinomialProjection(const OpinionBatch<2, FloatT>& batch, FloatT base_rate)
+{
+  AlignedVector<FloatT> projections(batch.size());
+  for_each_tile(batch.size(), tile_size<OpinionBatch<2, FloatT>>(3), [&](std::size_t first, std::size_t last) {
+    batch.getBinomialProjection(projections.data(), base_rate, first, last);
+  });
+  return projections;
+}
+
+template <typename FloatT>
+AlignedVector<FloatT> BatchExecutor::getBinomialProjection(const EvidenceBatch<2, FloatT>& batch, FloatT base_rate)
+{
+  AlignedVector<FloatT> projections(batch.size());
+  for_each_tile(batch.size(), tile_size<EvidenceBatch<2, FloatT>>(3), [&](std::size_t first, std::size_t last) {
+    batch.getBinomialProjection(projections.data(), base_rate, first, last);
+  });
+  return projections;
+}
+
+template <std::size_t N, typename FloatT, typename Classifier>
+auto BatchExecutor::classify(const OpinionBatch<N, FloatT>& batch, Classifier&& classifier)
+    -> std::vector<std::invoke_result_t<Classifier, OpinionNoBase<N, FloatT>>>
+{
+  using LabelT = std::invoke_result_t<Classifier, OpinionNoBase<N, FloatT>>;
+  static_assert(not std::is_same_v<LabelT, bool>, "std::vector<bool> cannot be written concurrently");
+
+  std::vector<LabelT> labels(batch.size());
+  for_each_tile(batch.size(), tile_size<OpinionBatch<N, FloatT>>(N + 1), [&](std::size_t first, std::size_t last) {
+    for (std::size_t idx{ first }; idx < last; ++idx)
+    {
+      labels[idx] = classifier(batch.get(idx));
+    }
+  });
+  return labels;
+}
+
+}  // namespace subjective_logic
@@ -0,0 +1,316 @@
+#pragma once
+
+// the reader is invited to refer to the following book as reference for the implementations within this file:
+// [1] Subjective Logic - A Formalism for Reasoning Under Uncertainty,
+// Audun Jøsang, 2016, https://doi.org/10.1007/978-3-319-42337-1
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "subjective_logic_lib/util.hpp"
+#include "subjective_logic_lib/types/aligned_allocator.hpp"
+#include "subjective_logic_lib/opinions/opinion.hpp"
+#include "subjective_logic_lib/opinions/opinion_no_base.hpp"
+#include "subjective_logic_lib/batch/evidence_batch.hpp"
+
+namespace subjective_logic
+{
+
+/**
+ * @brief accumulates the evidence of opinions of multiple concurrent producers (e.g. sensor threads) per cell without
+ * any lock. within the evidence space of a Dirichlet distribution, cumulative belief fusion of [1] is the sum of the
+ * evidence (see EvidenceBatch), hence, the order in which the producers fuse their opinions does not matter.
+ *
+ * the accumulator holds one shard per producer. each shard is written by a single thread only, thus, updates are
+ * plain loads and stores without read-modify-write operations or contention between producers.
+ * each cell of a shard is protected by a sequence counter (seqlock) so that readers never observe partially written
+ * evidence. a read sums the consistent evidence of all shards, i.e., it contains each update of a producer either
+ * completely or not at all.
+ *
+ * this class is not available with CUDA.
+ *
+ * @tparam N dimension of the Dirichlet distributions
+ * @tparam FloatT float type of the stored evidence
+ */
+template <std::size_t N = 2, typename FloatT = float>
+class ConcurrentEvidenceAccumulator
+{
+public:
+  using OpinionT = OpinionNoBase<N, FloatT>;
+  using OpinionWithBaseT = Opinion<N, FloatT>;
+  using EvidenceType = Array<N, FloatT>;
+
+  // helper to have accessible types/values when used from outside;
+  using FLOAT_t = FloatT;
+  static constexpr std::size_t SIZE = N;
+  // weight of the non-informative prior, see types/convert.hpp
+  static constexpr FloatT PRIOR_WEIGHT = static_cast<FloatT>(N);
+
+  static_assert(std::atomic<FloatT>::is_always_lock_free, "the evidence type must support lock free atomics");
+
+  /**
+   * @brief creates an accumulator without any evidence
+   * @param num_cells - number of cells
+   * @param num_shards - number of producers which may write concurrently
+   */
+  ConcurrentEvidenceAccumulator(std::size_t num_cells, std::size_t num_shards);
+
+  /**
+   * @brief number of cells
+   */
+  [[nodiscard]] std::size_t size() const;
+
+  /**
+   * @brief number of shards, i.e., maximum number of concurrent producers
+   */
+  [[nodiscard]] std::size_t num_shards() const;
+
+  /**
+   * @brief adds evidence to a cell. must only be called by the single producer owning the shard.
+   * @param shard_idx - shard of the calling producer
+   * @param cell_idx
+   * @param evidence
+   */
+  void add_evidence(std::size_t shard_idx, std::size_t cell_idx, const EvidenceType& evidence);
+
+  /**
+   * @brief fuses an opinion into a cell (cumulative fusion). must only be called by the single producer owning the
+   * shard. dogmatic opinions are limited to an uncertainty of EPS_v<FloatT>, see EvidenceBatch.
+   * @param shard_idx - shard of the calling producer
+   * @param cell_idx
+   * @param opinion
+   */
+  void cum_fuse_(std::size_t shard_idx, std::size_t cell_idx, const OpinionT& opinion);
+
+  /**
+   * @brief fuses a batch of opinions into the cells [0, opinions.size()) of the given shard
+   * @param shard_idx - shard of the calling producer
+   * @param opinions
+   */
+  void cum_fuse_(std::size_t shard_idx, const OpinionBatch<N, FloatT>& opinions);
+
+  /**
+   * @brief consistent snapshot of the accumulated evidence of a cell, may be called concurrently to the producers
+   * @param cell_idx
+   */
+  [[nodiscard]] EvidenceType evidence(std::size_t cell_idx) const;
+
+  /**
+   * @brief consistent snapshot of a cell converted to an opinion, may be called concurrently to the producers
+   * @param cell_idx
+   */
+  [[nodiscard]] OpinionT get(std::size_t cell_idx) const;
+
+  /**
+   * @brief consistent snapshot of a cell converted to an opinion using the given prior
+   * @param cell_idx
+   * @param prior_belief_masses
+   */
+  [[nodiscard]] OpinionWithBaseT get(std::size_t cell_idx, const EvidenceType& prior_belief_masses) const;
+
+  /**
+   * @brief reads the cells [first, last) into an evidence batch, may be called concurrently to the producers
+   *        each cell is consistent on its own, different cells may reflect different points in time
+   * @param out - evidence batch with at least last entries
+   * @param first
+   * @param last
+   */
+  void snapshot(EvidenceBatch<N, FloatT>& out, std::size_t first, std::size_t last) const;
+  /**
+   * @brief reads all cells into an evidence batch, may be called concurrently to the producers
+   */
+  [[nodiscard]] EvidenceBatch<N, FloatT> snapshot() const;
+
+  /**
+   * @brief removes all evidence, must not be called concurrently to producers or readers
+   */
+  void reset();
+
+protected:
+  /**
+   * @brief evidence of one producer, each cell consists of a sequence counter and N evidence values.
+   *        the storage of each shard starts at a cache line, which keeps false sharing between producers low.
+   */
+  struct Shard
+  {
+    explicit Shard(std::size_t num_cells);
+
+    AlignedVector<std::atomic<std::uint32_t>> sequences;
+    AlignedVector<std::atomic<FloatT>> evidence;
+  };
+
+  /**
+   * @brief reads the evidence of a cell of one shard retrying until no concurrent write was observed
+   */
+  EvidenceType read_shard(const Shard& shard, std::size_t cell_idx) const;
+
+  std::size_t num_cells_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+template <std::size_t N, typename FloatT>
+ConcurrentEvidenceAccumulator<N, FloatT>::Shard::Shard(std::size_t num_cells)
+  : sequences(num_cells), evidence(num_cells * N)
+{
+  // value initialization of the atomics sets all counters and evidence to zero
+}
+
+template <std::size_t N, typename FloatT>
+ConcurrentEvidenceAccumulator<N, FloatT>::ConcurrentEvidenceAccumulator(std::size_t num_cells, std::size_t num_shards)
+  : num_cells_{ num_cells }
+{
+  for (std::size_t shard_idx{ 0 }; shard_idx < std::max<std::size_t>(num_shards, 1); ++shard_idx)
+  {
+    shards_.push_back(std::make_unique<Shard>(num_cells));
+  }
+}
+
+template <std::size_t N, typename FloatT>
+std::size_t ConcurrentEvidenceAccumulator<N, FloatT>::size() const
+{
+  return num_cells_;
+}
+
+template <std::size_t N, typename FloatT>
+std::size_t ConcurrentEvidenceAccumulator<N, FloatT>::num_shards() const
+{
+  return shards_.size();
+}
+
+template <std::size_t N, typename FloatT>
+void ConcurrentEvidenceAccumulator<N, FloatT>::add_evidence(std::size_t shard_idx,
+                                                            std::size_t cell_idx,
+                                                            const EvidenceType& evidence)
+{
+  assert(shard_idx < shards_.size() and cell_idx < num_cells_);
+  Shard& shard = *shards_[shard_idx];
+  std::atomic<std::uint32_t>& sequence = shard.sequences[cell_idx];
+  std::atomic<FloatT>* cell = shard.evidence.data() + cell_idx * N;
+
+  // the producer is the only writer of the shard, thus, its own loads are always up to date
+  std::uint32_t seq = sequence.load(std::memory_order_relaxed);
+  sequence.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  constexpr_for<0, N, 1>([&](std::size_t evidence_idx) {
+    FloatT current = cell[evidence_idx].load(std::memory_order_relaxed);
+    cell[evidence_idx].store(current + evidence[evidence_idx], std::memory_order_relaxed);
+  });
+
+  sequence.store(seq + 2, std::memory_order_release);
+}
+
+template <std::size_t N, typename FloatT>
+void ConcurrentEvidenceAccumulator<N, FloatT>::cum_fuse_(std::size_t shard_idx,
+                                                         std::size_t cell_idx,
+                                                         const OpinionT& opinion)
+{
+  FloatT uncertainty = std::max(opinion.uncertainty(), EPS_v<FloatT>);
+  add_evidence(shard_idx, cell_idx, PRIOR_WEIGHT * opinion.belief_masses() / uncertainty);
+}
+
+template <std::size_t N, typename FloatT>
+void ConcurrentEvidenceAccumulator<N, FloatT>::cum_fuse_(std::size_t shard_idx,
+                                                         const OpinionBatch<N, FloatT>& opinions)
+{
+  assert(opinions.size() <= num_cells_);
+  for (std::size_t cell_idx{ 0 }; cell_idx < opinions.size(); ++cell_idx)
+  {
+    cum_fuse_(shard_idx, cell_idx, opinions.get(cell_idx));
+  }
+}
+
+template <std::size_t N, typename FloatT>
+typename ConcurrentEvidenceAccumulator<N, FloatT>::EvidenceType
+ConcurrentEvidenceAccumulator<N, FloatT>::read_shard(const Shard& shard, std::size_t cell_idx) const
+{
+  const std::atomic<std::uint32_t>& sequence = shard.sequences[cell_idx];
+  const std::atomic<FloatT>* cell = shard.evidence.data() + cell_idx * N;
+
+  EvidenceType evidence;
+  while (true)
+  {
+    std::uint32_t seq_before = sequence.load(std::memory_order_acquire);
+    if (seq_before % 2 == 1)
+    {
+      // a write is in progress
+      continue;
+    }
+    constexpr_for<0, N, 1>([&](std::size_t evidence_idx) {
+      evidence[evidence_idx] = cell[evidence_idx].load(std::memory_order_relaxed);
+    });
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence.load(std::memory_order_relaxed) == seq_before)
+    {
+      return evidence;
+    }
+  }
+}
+
+template <std::size_t N, typename FloatT>
+typename ConcurrentEvidenceAccumulator<N, FloatT>::EvidenceType
+ConcurrentEvidenceAccumulator<N, FloatT>::evidence(std::size_t cell_idx) const
+{
+  assert(cell_idx < num_cells_);
+  EvidenceType evidence{ 0. };
+  for (const auto& shard : shards_)
+  {
+    evidence += read_shard(*shard, cell_idx);
+  }
+  return evidence;
+}
+
+template <std::size_t N, typename FloatT>
+typename ConcurrentEvidenceAccumulator<N, FloatT>::OpinionT
+ConcurrentEvidenceAccumulator<N, FloatT>::get(std::size_t cell_idx) const
+{
+  EvidenceType evidence = this->evidence(cell_idx);
+  return OpinionT{ evidence / (evidence.sum() + PRIOR_WEIGHT) };
+}
+
+template <std::size_t N, typename FloatT>
+typename ConcurrentEvidenceAccumulator<N, FloatT>::OpinionWithBaseT
+ConcurrentEvidenceAccumulator<N, FloatT>::get(std::size_t cell_idx, const EvidenceType& prior_belief_masses) const
+{
+  EvidenceType evidence = this->evidence(cell_idx);
+  return OpinionWithBaseT{ evidence / (evidence.sum() + PRIOR_WEIGHT), prior_belief_masses };
+}
+
+template <std::size_t N, typename FloatT>
+void ConcurrentEvidenceAccumulator<N, FloatT>::snapshot(EvidenceBatch<N, FloatT>& out,
+                                                        std::size_t first,
+                                                        std::size_t last) const
+{
+  assert(last <= num_cells_ and last <= out.size());
+  for (std::size_t cell_idx{ first }; cell_idx < last; ++cell_idx)
+  {
+    out.set_evidence(cell_idx, evidence(cell_idx));
+  }
+}
+
+template <std::size_t N, typename FloatT>
+EvidenceBatch<N, FloatT> ConcurrentEvidenceAccumulator<N, FloatT>::snapshot() const
+{
+  EvidenceBatch<N, FloatT> out{ num_cells_ };
+  snapshot(out, 0, num_cells_);
+  return out;
+}
+
+template <std::size_t N, typename FloatT>
+void ConcurrentEvidenceAccumulator<N, FloatT>::reset()
+{
+  for (auto& shard : shards_)
+  {
+    for (std::size_t idx{ 0 }; idx < num_cells_ * N; ++idx)
+    {
+      shard->evidence[idx].store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+}  // namespace subjective_logic
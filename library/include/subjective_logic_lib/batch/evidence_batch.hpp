@@ -0,0 +1,530 @@
+#pragma once
+
+// the reader is invited to refer to the following book as reference for the implementations within this file:
+// [1] Subjective Logic - A Formalism for Reasoning Under Uncertainty,
+// Audun Jøsang, 2016, https://doi.org/10.1007/978-3-319-42337-1
+
+#include <array>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "subjective_logic_lib/util.hpp"
+#include "subjective_logic_lib/types/aligned_allocator.hpp"
+#include "subjective_logic_lib/types/dirichlet_distribution.hpp"
+#include "subjective_logic_lib/opinions/opinion_no_base.hpp"
+#include "subjective_logic_lib/batch/opinion_batch.hpp"
+
+namespace subjective_logic
+{
+
+/**
+ * @brief structure of arrays container storing the evidence of a Dirichlet distribution per entry, e.g., per cell of an
+ * evidential grid map. The evidence is related to the belief masses of an OpinionNoBase as in types/convert.hpp
+ * (non-informative prior weight W = N):
+ *     evidence = N * belief_masses / uncertainty,   belief_masses = evidence / (sum(evidence) + N)
+ * within this representation, cumulative belief fusion of [1] is the sum of the evidence of both opinions.
+ * thus, fusing two batches is a single streaming add over memory without any division or branch.
+ * opinions and projections are only calculated when they are read.
+ *
+ * dogmatic opinions correspond to infinite evidence and cannot be represented,
+ * their uncertainty is limited to EPS_v<FloatT> when they are converted to evidence.
+ *
+ * this container is not available with CUDA.
+ *
+ * @tparam N dimension of the Dirichlet distributions
+ * @tparam FloatT float type of the stored evidence
+ */
+template <std::size_t N = 2, typename FloatT = float>
+class EvidenceBatch
+{
+public:
+  using OpinionT = OpinionNoBase<N, FloatT>;
+  using DistributionT = DirichletDistribution<N, FloatT>;
+  using EvidenceType = Array<N, FloatT>;
+  using StorageType = AlignedVector<FloatT>;
+  using LaneType = std::array<FloatT*, N>;
+  using ConstLaneType = std::array<const FloatT*, N>;
+
+  // helper to have accessible types/values when used from outside;
+  using FLOAT_t = FloatT;
+  static constexpr std::size_t SIZE = N;
+  // lanes are padded to a multiple of this number of elements, so that each lane starts at an aligned address
+  static constexpr std::size_t LANE_PADDING = BATCH_ALIGNMENT / sizeof(FloatT);
+  // weight of the non-informative prior, see types/convert.hpp
+  static constexpr FloatT PRIOR_WEIGHT = static_cast<FloatT>(N);
+
+  /**
+   * @brief creates an empty batch
+   */
+  EvidenceBatch() = default;
+
+  /**
+   * @brief creates a batch of the given size without any evidence (all entries are vacuous)
+   * @param size
+   */
+  explicit EvidenceBatch(std::size_t size);
+
+  /**
+   * @brief creates a batch containing the evidence of the given opinions
+   * @param opinions
+   */
+  explicit EvidenceBatch(const OpinionBatch<N, FloatT>& opinions);
+
+  /**
+   * @brief number of entries stored in the batch
+   */
+  [[nodiscard]] std::size_t size() const;
+
+  /**
+   * @brief checks if the batch contains any entry
+   */
+  [[nodiscard]] bool empty() const;
+
+  /**
+   * @brief distance between the first elements of two consecutive lanes (number of FloatT values)
+   */
+  [[nodiscard]] std::size_t lane_stride() const;
+
+  /**
+   * @brief changes the number of stored entries, existing entries are kept, new ones are vacuous
+   * @param size
+   */
+  void resize(std::size_t size);
+
+  /**
+   * @brief removes all evidence, i.e., all entries become vacuous
+   */
+  void reset();
+
+  /**
+   * @brief direct access to the contiguous lane of one evidence component
+   * @param evidence_idx - must be smaller than N
+   */
+  FloatT* lane(std::size_t evidence_idx);
+  /**
+   * @brief direct const access to the contiguous lane of one evidence component
+   * @param evidence_idx - must be smaller than N
+   */
+  [[nodiscard]] const FloatT* lane(std::size_t evidence_idx) const;
+
+  /**
+   * @brief pointers to all N lanes
+   */
+  LaneType lanes();
+  /**
+   * @brief const pointers to all N lanes
+   */
+  [[nodiscard]] ConstLaneType lanes() const;
+
+  /**
+   * @brief gathers the evidence of the given entry
+   */
+  [[nodiscard]] EvidenceType evidence(std::size_t idx) const;
+
+  /**
+   * @brief overwrites the evidence of the given entry
+   */
+  void set_evidence(std::size_t idx, const EvidenceType& evidence);
+
+  /**
+   * @brief overwrites the given entry with the evidence of the given opinion
+   */
+  void set(std::size_t idx, const OpinionT& opinion);
+
+  /**
+   * @brief converts the given entry to a Dirichlet distribution with non-informative prior
+   */
+  [[nodiscard]] DistributionT distribution(std::size_t idx) const;
+
+  /**
+   * @brief converts the given entry to an opinion
+   */
+  [[nodiscard]] OpinionT get(std::size_t idx) const;
+  /**
+   * @brief converts the given entry to an opinion
+   */
+  OpinionT operator[](std::size_t idx) const;
+
+  /**
+   * @brief uncertainty of the opinion corresponding to the given entry
+   */
+  [[nodiscard]] FloatT uncertainty(std::size_t idx) const;
+
+  /**
+   * @brief converts all entries to opinions
+   */
+  [[nodiscard]] OpinionBatch<N, FloatT> as_opinion_batch() const;
+  /**
+   * @brief converts the entries [first, last) to opinions, output is written to out[first, last)
+   */
+  void as_opinion_batch(OpinionBatch<N, FloatT>& out, std::size_t first, std::size_t last) const;
+
+  /**
+   * @brief applies the concept of cumulative belief fusion of [1] elementwise inplace, i.e., adds the evidence
+   * @param other - batch of the same size
+   * @return reference to this
+   */
+  EvidenceBatch& cum_fuse_(const EvidenceBatch& other);
+  /**
+   * @brief applies the concept of cumulative belief fusion of [1] elementwise inplace to the entries [first, last)
+   */
+  EvidenceBatch& cum_fuse_(const EvidenceBatch& other, std::size_t first, std::size_t last);
+  /**
+   * @brief applies the concept of cumulative belief fusion of [1] elementwise using a copy
+   */
+  [[nodiscard]] EvidenceBatch cum_fuse(const EvidenceBatch& other) const;
+
+  /**
+   * @brief fuses opinions into the batch, the opinions are converted to evidence on the fly
+   * @param other - batch of opinions of the same size
+   * @return reference to this
+   */
+  EvidenceBatch& cum_fuse_(const OpinionBatch<N, FloatT>& other);
+  /**
+   * @brief fuses the opinions [first, last) into the batch
+   */
+  EvidenceBatch& cum_fuse_(const OpinionBatch<N, FloatT>& other, std::size_t first, std::size_t last);
+
+  /**
+   * @brief removes the evidence of other, i.e., the inverse of cum_fuse_ (cumulative unfusion of [1])
+   *        the resulting evidence is limited to be non-negative
+   * @param other - batch of the same size
+   * @return reference to this
+   */
+  EvidenceBatch& cum_unfuse_(const EvidenceBatch& other);
+  /**
+   * @brief removes the evidence of other for the entries [first, last)
+   */
+  EvidenceBatch& cum_unfuse_(const EvidenceBatch& other, std::size_t first, std::size_t last);
+  /**
+   * @brief removes the evidence of other using a copy
+   */
+  [[nodiscard]] EvidenceBatch cum_unfuse(const EvidenceBatch& other) const;
+
+  /**
+   * @brief scales the evidence of all entries, e.g., to let old evidence decay
+   * @param factor
+   * @return reference to this
+   */
+  EvidenceBatch& scale_(FloatT factor);
+  /**
+   * @brief scales the evidence of the entries [first, last)
+   */
+  EvidenceBatch& scale_(FloatT factor, std::size_t first, std::size_t last);
+
+  /**
+   * @brief calculates the projected probability of all entries for binomial distributions
+   * @param base_rate
+   * @return aligned vector containing one projected probability per entry
+   */
+  [[nodiscard]] StorageType getBinomialProjection(FloatT base_rate = 0.5) const
+    requires is_binomial<N>;
+  /**
+   * @brief calculates the projected probability of the entries [first, last), output is written to out[first, last)
+   */
+  void getBinomialProjection(FloatT* out, FloatT base_rate, std::size_t first, std::size_t last) const
+    requires is_binomial<N>;
+
+protected:
+  StorageType storage_;
+  std::size_t size_{ 0 };
+  std::size_t stride_{ 0 };
+};
+
+template <std::size_t N, typename FloatT>
+EvidenceBatch<N, FloatT>::EvidenceBatch(std::size_t size)
+{
+  resize(size);
+}
+
+template <std::size_t N, typename FloatT>
+EvidenceBatch<N, FloatT>::EvidenceBatch(const OpinionBatch<N, FloatT>& opinions)
+{
+  resize(opinions.size());
+  cum_fuse_(opinions);
+}
+
+template <std::size_t N, typename FloatT>
+std::size_t EvidenceBatch<N, FloatT>::size() const
+{
+  return size_;
+}
+
+template <std::size_t N, typename FloatT>
+bool EvidenceBatch<N, FloatT>::empty() const
+{
+  return size_ == 0;
+}
+
+template <std::size_t N, typename FloatT>
+std::size_t EvidenceBatch<N, FloatT>::lane_stride() const
+{
+  return stride_;
+}
+
+template <std::size_t N, typename FloatT>
+void EvidenceBatch<N, FloatT>::resize(std::size_t size)
+{
+  std::size_t stride = ((size + LANE_PADDING - 1) / LANE_PADDING) * LANE_PADDING;
+  StorageType storage(N * stride, static_cast<FloatT>(0.));
+
+  std::size_t num_kept = std::min(size, size_);
+  for (std::size_t evidence_idx{ 0 }; evidence_idx < N; ++evidence_idx)
+  {
+    std::copy_n(lane(evidence_idx), num_kept, storage.data() + evidence_idx * stride);
+  }
+
+  storage_ = std::move(storage);
+  size_ = size;
+  stride_ = stride;
+}
+
+template <std::size_t N, typename FloatT>
+void EvidenceBatch<N, FloatT>::reset()
+{
+  std::fill(storage_.begin(), storage_.end(), static_cast<FloatT>(0.));
+}
+
+template <std::size_t N, typename FloatT>
+FloatT* EvidenceBatch<N, FloatT>::lane(std::size_t evidence_idx)
+{
+  assert(evidence_idx < N);
+  return storage_.data() + evidence_idx * stride_;
+}
+
+template <std::size_t N, typename FloatT>
+const FloatT* EvidenceBatch<N, FloatT>::lane(std::size_t evidence_idx) const
+{
+  assert(evidence_idx < N);
+  return storage_.data() + evidence_idx * stride_;
+}
+
+template <std::size_t N, typename FloatT>
+typename EvidenceBatch<N, FloatT>::LaneType EvidenceBatch<N, FloatT>::lanes()
+{
+  LaneType lanes;
+  constexpr_for<0, N, 1>([this, &lanes](std::size_t evidence_idx) { lanes[evidence_idx] = lane(evidence_idx); });
+  return lanes;
+}
+
+template <std::size_t N, typename FloatT>
+typename EvidenceBatch<N, FloatT>::ConstLaneType EvidenceBatch<N, FloatT>::lanes() const
+{
+  ConstLaneType lanes;
+  constexpr_for<0, N, 1>([this, &lanes](std::size_t evidence_idx) { lanes[evidence_idx] = lane(evidence_idx); });
+  return lanes;
+}
+
+template <std::size_t N, typename FloatT>
+typename EvidenceBatch<N, FloatT>::EvidenceType EvidenceBatch<N, FloatT>::evidence(std::size_t idx) const
+{
+  assert(idx < size_);
+  EvidenceType evidence;
+  constexpr_for<0, N, 1>([this, idx, &evidence](std::size_t evidence_idx) {
+    evidence[evidence_idx] = storage_[evidence_idx * stride_ + idx];
+  });
+  return evidence;
+}
+
+template <std::size_t N, typename FloatT>
+void EvidenceBatch<N, FloatT>::set_evidence(std::size_t idx, const EvidenceType& evidence)
+{
+  assert(idx < size_);
+  constexpr_for<0, N, 1>([this, idx, &evidence](std::size_t evidence_idx) {
+    storage_[evidence_idx * stride_ + idx] = evidence[evidence_idx];
+  });
+}
+
+template <std::size_t N, typename FloatT>
+void EvidenceBatch<N, FloatT>::set(std::size_t idx, const OpinionT& opinion)
+{
+  FloatT uncertainty = std::max(opinion.uncertainty(), EPS_v<FloatT>);
+  set_evidence(idx, PRIOR_WEIGHT * opinion.belief_masses() / uncertainty);
+}
+
+template <std::size_t N, typename FloatT>
+typename EvidenceBatch<N, FloatT>::DistributionT EvidenceBatch<N, FloatT>::distribution(std::size_t idx) const
+{
+  return DistributionT{ evidence(idx), OpinionT::NeutralBeliefDistr() };
+}
+
+template <std::size_t N, typename FloatT>
+typename EvidenceBatch<N, FloatT>::OpinionT EvidenceBatch<N, FloatT>::get(std::size_t idx) const
+{
+  EvidenceType evidence = this->evidence(idx);
+  return OpinionT{ evidence / (evidence.sum() + PRIOR_WEIGHT) };
+}
+
+template <std::size_t N, typename FloatT>
+typename EvidenceBatch<N, FloatT>::OpinionT EvidenceBatch<N, FloatT>::operator[](std::size_t idx) const
+{
+  return get(idx);
+}
+
+template <std::size_t N, typename FloatT>
+FloatT EvidenceBatch<N, FloatT>::uncertainty(std::size_t idx) const
+{
+  return PRIOR_WEIGHT / (evidence(idx).sum() + PRIOR_WEIGHT);
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT> EvidenceBatch<N, FloatT>::as_opinion_batch() const
+{
+  OpinionBatch<N, FloatT> out{ size_ };
+  as_opinion_batch(out, 0, size_);
+  return out;
+}
+
+template <std::size_t N, typename FloatT>
+void EvidenceBatch<N, FloatT>::as_opinion_batch(OpinionBatch<N, FloatT>& out,
+                                                std::size_t first,
+                                                std::size_t last) const
+{
+  assert(last <= size_ and last <= out.size());
+  const ConstLaneType src = lanes();
+  const auto dst = out.lanes();
+  for (std::size_t idx{ first }; idx < last; ++idx)
+  {
+    FloatT evidence_sum{ PRIOR_WEIGHT };
+    constexpr_for<0, N, 1>([&](std::size_t evidence_idx) { evidence_sum += src[evidence_idx][idx]; });
+    FloatT inv_denom = static_cast<FloatT>(1.) / evidence_sum;
+    constexpr_for<0, N, 1>(
+        [&](std::size_t evidence_idx) { dst[evidence_idx][idx] = src[evidence_idx][idx] * inv_denom; });
+  }
+}
+
+template <std::size_t N, typename FloatT>
+EvidenceBatch<N, FloatT>& EvidenceBatch<N, FloatT>::cum_fuse_(const EvidenceBatch& other)
+{
+  return cum_fuse_(other, 0, size_);
+}
+
+template <std::size_t N, typename FloatT>
+EvidenceBatch<N, FloatT>& EvidenceBatch<N, FloatT>::cum_fuse_(const EvidenceBatch& other,
+                                                              std::size_t first,
+                                                              std::size_t last)
+{
+  assert(last <= size_ and last <= other.size_);
+  for (std::size_t evidence_idx{ 0 }; evidence_idx < N; ++evidence_idx)
+  {
+    FloatT* dst = lane(evidence_idx);
+    const FloatT* src = other.lane(evidence_idx);
+    for (std::size_t idx{ first }; idx < last; ++idx)
+    {
+      dst[idx] += src[idx];
+    }
+  }
+  return *this;
+}
+
+template <std::size_t N, typename FloatT>
+EvidenceBatch<N, FloatT> EvidenceBatch<N, FloatT>::cum_fuse(const EvidenceBatch& other) const
+{
+  return EvidenceBatch(*this).cum_fuse_(other);
+}
+
+template <std::size_t N, typename FloatT>
+EvidenceBatch<N, FloatT>& EvidenceBatch<N, FloatT>::cum_fuse_(const OpinionBatch<N, FloatT>& other)
+{
+  return cum_fuse_(other, 0, size_);
+}
+
+template <std::size_t N, typename FloatT>
+EvidenceBatch<N, FloatT>& EvidenceBatch<N, FloatT>::cum_fuse_(const OpinionBatch<N, FloatT>& other,
+                                                              std::size_t first,
+                                                              std::size_t last)
+{
+  assert(last <= size_ and last <= other.size());
+  const LaneType dst = lanes();
+  const auto src = other.lanes();
+  for (std::size_t idx{ first }; idx < last; ++idx)
+  {
+    FloatT belief_sum{ 0. };
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) { belief_sum += src[mass_idx][idx]; });
+    FloatT scale = PRIOR_WEIGHT / std::max(static_cast<FloatT>(1.) - belief_sum, EPS_v<FloatT>);
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) { dst[mass_idx][idx] += src[mass_idx][idx] * scale; });
+  }
+  return *this;
+}
+
+template <std::size_t N, typename FloatT>
+EvidenceBatch<N, FloatT>& EvidenceBatch<N, FloatT>::cum_unfuse_(const EvidenceBatch& other)
+{
+  return cum_unfuse_(other, 0, size_);
+}
+
+template <std::size_t N, typename FloatT>
+EvidenceBatch<N, FloatT>& EvidenceBatch<N, FloatT>::cum_unfuse_(const EvidenceBatch& other,
+                                                                std::size_t first,
+                                                                std::size_t last)
+{
+  assert(last <= size_ and last <= other.size_);
+  for (std::size_t evidence_idx{ 0 }; evidence_idx < N; ++evidence_idx)
+  {
+    FloatT* dst = lane(evidence_idx);
+    const FloatT* src = other.lane(evidence_idx);
+    for (std::size_t idx{ first }; idx < last; ++idx)
+    {
+      dst[idx] = std::max(dst[idx] - src[idx], static_cast<FloatT>(0.));
+    }
+  }
+  return *this;
+}
+
+template <std::size_t N, typename FloatT>
+EvidenceBatch<N, FloatT> EvidenceBatch<N, FloatT>::cum_unfuse(const EvidenceBatch& other) const
+{
+  return EvidenceBatch(*this).cum_unfuse_(other);
+}
+
+template <std::size_t N, typename FloatT>
+EvidenceBatch<N, FloatT>& EvidenceBatch<N, FloatT>::scale_(FloatT factor)
+{
+  return scale_(factor, 0, size_);
+}
+
+template <std::size_t N, typename FloatT>
+EvidenceBatch<N, FloatT>& EvidenceBatch<N, FloatT>::scale_(FloatT factor, std::size_t first, std::size_t last)
+{
+  assert(last <= size_);
+  for (std::size_t evidence_idx{ 0 }; evidence_idx < N; ++evidence_idx)
+  {
+    FloatT* dst = lane(evidence_idx);
+    for (std::size_t idx{ first }; idx < last; ++idx)
+    {
+      dst[idx] *= factor;
+    }
+  }
+  return *this;
+}
+
+template <std::size_t N, typename FloatT>
+typename EvidenceBatch<N, FloatT>::StorageType EvidenceBatch<N, FloatT>::getBinomialProjection(FloatT base_rate) const
+  requires is_binomial<N>
+{
+  StorageType out(size_);
+  getBinomialProjection(out.data(), base_rate, 0, size_);
+  return out;
+}
+
+template <std::size_t N, typename FloatT>
+void EvidenceBatch<N, FloatT>::getBinomialProjection(FloatT* out,
+                                                     FloatT base_rate,
+                                                     std::size_t first,
+                                                     std::size_t last) const
+  requires is_binomial<N>
+{
+  assert(last <= size_);
+  const FloatT* positive = lane(0);
+  const FloatT* negative = lane(1);
+  for (std::size_t idx{ first }; idx < last; ++idx)
+  {
+    // P = b + u * a = (r + W * a) / (r + s + W)
+    out[idx] = (positive[idx] + PRIOR_WEIGHT * base_rate) / (positive[idx] + negative[idx] + PRIOR_WEIGHT);
+  }
+}
+
+}  // namespace subjective_logic
@@ -0,0 +1,844 @@
+#pragma once
+
+// the reader is invited to refer to the following book as reference for the implementations within this file:
+// [1] Subjective Logic - A Formalism for Reasoning Under Uncertainty,
+// Audun Jøsang, 2016, https://doi.org/10.1007/978-3-319-42337-1
+// [2] Multi-source fusion in subjective logic
+// A. J⊘sang, D. Wang and J. Zhang,
+// 2017 20th International Conference on Information Fusion (Fusion), Xi'an, China, 2017, pp. 1-8,
+// doi: 10.23919/ICIF.2017.8009820.
+
+#include <array>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "subjective_logic_lib/util.hpp"
+#include "subjective_logic_lib/types/aligned_allocator.hpp"
+#include "subjective_logic_lib/batch/simd_kernels.hpp"
+#include "subjective_logic_lib/opinions/opinion_no_base.hpp"
+#include "subjective_logic_lib/multi_source/fusion_operators.hpp"
+
+namespace subjective_logic
+{
+
+/**
+ * @brief structure of arrays (SoA) container for a large number of OpinionNoBase instances, e.g., the cells of an
+ * evidential grid map. instead of storing N belief masses per opinion next to each other, each belief mass component
+ * is stored in its own contiguous and aligned lane. thus, the operators below process whole lanes and can be
+ * vectorized by the compiler.
+ * the per cell formulas are exactly the ones of OpinionNoBase, however, the special treatment of dogmatic (or otherwise
+ * degenerated) opinions is written as a select instead of an early return, which keeps the loops free of branches.
+ * all fusion operators use the explicitly vectorized kernels of simd_kernels.hpp.
+ * every operator is available for the full batch and for a range [first, last) of cells,
+ * the latter allows to split the work into tiles that can be processed independently.
+ *
+ * this container is not available with CUDA.
+ *
+ * @tparam N dimension of the subjective logic opinions (2 = Binomial, >2 = multinomial)
+ * @tparam FloatT float type of the stored belief masses
+ */
+template <std::size_t N = 2, typename FloatT = float>
+class OpinionBatch
+{
+public:
+  using OpinionT = OpinionNoBase<N, FloatT>;
+  using BeliefType = typename OpinionT::BeliefType;
+  using StorageType = AlignedVector<FloatT>;
+  using LaneType = std::array<FloatT*, N>;
+  using ConstLaneType = std::array<const FloatT*, N>;
+  using FusionType = multisource::Fusion::FusionType;
+
+  // helper to have accessible types/values when used from outside;
+  using FLOAT_t = FloatT;
+  static constexpr std::size_t SIZE = N;
+  // lanes are padded to a multiple of this number of elements, so that each lane starts at an aligned address
+  static constexpr std::size_t LANE_PADDING = BATCH_ALIGNMENT / sizeof(FloatT);
+
+  /**
+   * @brief creates an empty batch
+   */
+  OpinionBatch() = default;
+
+  /**
+   * @brief creates a batch of the given size, each entry is initialized with the given opinion
+   * @param size - number of opinions
+   * @param default_opinion - opinion copied to each entry, vacuous if not given
+   */
+  explicit OpinionBatch(std::size_t size, OpinionT default_opinion = OpinionT{});
+
+  /**
+   * @brief creates a batch from opinions stored as array of structs
+   * @param opinions
+   */
+  explicit OpinionBatch(const std::vector<OpinionT>& opinions);
+
+  OpinionBatch(const OpinionBatch& other) = default;
+  OpinionBatch(OpinionBatch&& other) noexcept = default;
+  OpinionBatch& operator=(const OpinionBatch& other) = default;
+  OpinionBatch& operator=(OpinionBatch&& other) noexcept = default;
+  ~OpinionBatch() = default;
+
+  /**
+   * @brief number of opinions stored in the batch
+   */
+  [[nodiscard]] std::size_t size() const;
+
+  /**
+   * @brief checks if the batch contains any opinion
+   */
+  [[nodiscard]] bool empty() const;
+
+  /**
+   * @brief distance between the first elements of two consecutive lanes (number of FloatT values)
+   */
+  [[nodiscard]] std::size_t lane_stride() const;
+
+  /**
+   * @brief changes the number of stored opinions, existing opinions are kept, new ones are set to default_opinion
+   * @param size
+   * @param default_opinion
+   */
+  void resize(std::size_t size, OpinionT default_opinion = OpinionT{});
+
+  /**
+   * @brief direct access to the contiguous lane of one belief mass component
+   * @param mass_idx - index of the belief mass, must be smaller than N
+   * @return pointer to the first entry of the lane
+   */
+  FloatT* lane(std::size_t mass_idx);
+  /**
+   * @brief direct const access to the contiguous lane of one belief mass component
+   * @param mass_idx - index of the belief mass, must be smaller than N
+   * @return pointer to the first entry of the lane
+   */
+  [[nodiscard]] const FloatT* lane(std::size_t mass_idx) const;
+
+  /**
+   * @brief pointers to all N lanes
+   */
+  LaneType lanes();
+  /**
+   * @brief const pointers to all N lanes
+   */
+  [[nodiscard]] ConstLaneType lanes() const;
+
+  /**
+   * @brief gathers the opinion at the given index
+   * @param idx
+   * @return copy of the opinion
+   */
+  [[nodiscard]] OpinionT get(std::size_t idx) const;
+  /**
+   * @brief gathers the opinion at the given index
+   * @param idx
+   * @return copy of the opinion
+   */
+  OpinionT operator[](std::size_t idx) const;
+
+  /**
+   * @brief scatters the given opinion to the given index
+   * @param idx
+   * @param opinion
+   */
+  void set(std::size_t idx, OpinionT opinion);
+
+  /**
+   * @brief assigns the given opinion to all entries
+   * @param opinion
+   */
+  void fill(OpinionT opinion);
+
+  /**
+   * @brief converts the batch back to an array of structs representation
+   */
+  [[nodiscard]] std::vector<OpinionT> as_vector() const;
+
+  /**
+   * @brief calculates the uncertainty of a single entry
+   * @param idx
+   * @return
+   */
+  [[nodiscard]] FloatT uncertainty(std::size_t idx) const;
+  /**
+   * @brief calculates the uncertainties of all entries
+   * @return aligned vector containing one uncertainty per entry
+   */
+  [[nodiscard]] StorageType uncertainties() const;
+  /**
+   * @brief calculates the uncertainties of the entries within [first, last), output is written to out[first, last)
+   */
+  void uncertainties(FloatT* out, std::size_t first, std::size_t last) const;
+
+  /**
+   * @brief applies the concept of cumulative belief fusion of [1] elementwise inplace
+   * @param other - batch of the same size, otherwise std::invalid_argument is thrown
+   * @return reference to this
+   */
+  OpinionBatch& cum_fuse_(const OpinionBatch& other);
+  /**
+   * @brief applies the concept of cumulative belief fusion of [1] elementwise inplace to the entries [first, last)
+   */
+  OpinionBatch& cum_fuse_(const OpinionBatch& other, std::size_t first, std::size_t last);
+  /**
+   * @brief applies the concept of cumulative belief fusion of [1] elementwise using a copy
+   */
+  [[nodiscard]] OpinionBatch cum_fuse(const OpinionBatch& other) const;
+
+  /**
+   * @brief applies the concept of averaging belief fusion of [1] elementwise inplace
+   * @param other - batch of the same size, otherwise std::invalid_argument is thrown
+   * @return reference to this
+   */
+  OpinionBatch& average_fuse_(const OpinionBatch& other);
+  /**
+   * @brief applies the concept of averaging belief fusion of [1] elementwise inplace to the entries [first, last)
+   */
+  OpinionBatch& average_fuse_(const OpinionBatch& other, std::size_t first, std::size_t last);
+  /**
+   * @brief applies the concept of averaging belief fusion of [1] elementwise using a copy
+   */
+  [[nodiscard]] OpinionBatch average_fuse(const OpinionBatch& other) const;
+
+  /**
+   * @brief applies the concept of weighted belief fusion of [1] elementwise inplace
+   * @param other - batch of the same size, otherwise std::invalid_argument is thrown
+   * @return reference to this
+   */
+  OpinionBatch& wb_fuse_(const OpinionBatch& other);
+  /**
+   * @brief applies the concept of weighted belief fusion of [1] elementwise inplace to the entries [first, last)
+   */
+  OpinionBatch& wb_fuse_(const OpinionBatch& other, std::size_t first, std::size_t last);
+  /**
+   * @brief applies the concept of weighted belief fusion of [1] elementwise using a copy
+   */
+  [[nodiscard]] OpinionBatch wb_fuse(const OpinionBatch& other) const;
+
+  /**
+   * @brief applies the concept of belief constrained fusion of [1] elementwise inplace
+   * @param other - batch of the same size, otherwise std::invalid_argument is thrown
+   * @return reference to this
+   */
+  OpinionBatch& bc_fuse_(const OpinionBatch& other);
+  /**
+   * @brief applies the concept of belief constrained fusion of [1] elementwise inplace to the entries [first, last)
+   */
+  OpinionBatch& bc_fuse_(const OpinionBatch& other, std::size_t first, std::size_t last);
+  /**
+   * @brief applies the concept of belief constrained fusion of [1] elementwise using a copy
+   */
+  [[nodiscard]] OpinionBatch bc_fuse(const OpinionBatch& other) const;
+
+  /**
+   * @brief multi-source fusion [2] of the respective entries of all sources, see multisource::Fusion::fuse_opinions.
+   *        each entry (e.g., a grid cell or a track) is fused over all sources independently of the other entries,
+   *        the entries are processed by the vectorized kernels instead of calling the fusion for each of them
+   * @param fusion_type
+   * @param sources - batches of the same size, at least one
+   * @return batch of the same size as the sources
+   */
+  static OpinionBatch fuse_opinions(FusionType fusion_type, const std::vector<OpinionBatch>& sources);
+  /**
+   * @brief stores the multi-source fusion of the entries [first, last) of all sources in the entries [first, last)
+   *        of this, the sources are given by their lanes (e.g., the lanes of other batches), this may be one of them
+   * @param fusion_type
+   * @param sources - lanes of each source, at least one
+   * @param first
+   * @param last
+   * @return reference to this
+   */
+  OpinionBatch& fuse_opinions_(FusionType fusion_type,
+                               std::span<const ConstLaneType> sources,
+                               std::size_t first,
+                               std::size_t last);
+
+  /**
+   * @brief applies the concept of trust discounting of [1] inplace, every entry is discounted with the same
+   * probability
+   * @param prop - projected probability of the trust opinion
+   * @return reference to this
+   */
+  OpinionBatch& trust_discount_(FloatT prop);
+  /**
+   * @brief applies the concept of trust discounting of [1] inplace to the entries [first, last)
+   */
+  OpinionBatch& trust_discount_(FloatT prop, std::size_t first, std::size_t last);
+  /**
+   * @brief applies the concept of trust discounting of [1] inplace, each entry is discounted by the respective
+   * trust opinion of the given batch
+   * @param trusts - batch of binomial trust opinions of the same size, otherwise std::invalid_argument is thrown
+   * @param base_rate - base rate used to project the trust opinions
+   * @return reference to this
+   */
+  OpinionBatch& trust_discount_(const OpinionBatch<2, FloatT>& trusts, FloatT base_rate = 0.5);
+  /**
+   * @brief applies the concept of trust discounting of [1] inplace to the entries [first, last)
+   */
+  OpinionBatch&
+  trust_discount_(const OpinionBatch<2, FloatT>& trusts, FloatT base_rate, std::size_t first, std::size_t last);
+  /**
+   * @brief applies the concept of trust discounting of [1] using a copy
+   */
+  [[nodiscard]] OpinionBatch trust_discount(FloatT prop) const;
+  /**
+   * @brief applies the concept of trust discounting of [1] using a copy
+   */
+  [[nodiscard]] OpinionBatch trust_discount(const OpinionBatch<2, FloatT>& trusts, FloatT base_rate = 0.5) const;
+
+  /**
+   * @brief applies the concept of deduction of [1] inplace, see OpinionNoBase::deduction_
+   *        all entries are deduced using the same base rate and conditional opinions
+   * @param base_x
+   * @param cond_1
+   * @param cond_2
+   * @return reference to this
+   */
+  OpinionBatch& deduction_(FloatT base_x, OpinionT cond_1, OpinionT cond_2)
+    requires is_binomial<N>;
+  /**
+   * @brief applies the concept of deduction of [1] inplace to the entries [first, last)
+   */
+  OpinionBatch& deduction_(FloatT base_x, OpinionT cond_1, OpinionT cond_2, std::size_t first, std::size_t last)
+    requires is_binomial<N>;
+  /**
+   * @brief applies the concept of deduction of [1] using a copy
+   */
+  [[nodiscard]] OpinionBatch deduction(FloatT base_x, OpinionT cond_1, OpinionT cond_2) const
+    requires is_binomial<N>;
+
+  /**
+   * @brief calculates the projected probability of all entries for binomial opinions
+   * @param base_rate
+   * @return aligned vector containing one projected probability per entry
+   */
+  [[nodiscard]] StorageType getBinomialProjection(FloatT base_rate = 0.5) const
+    requires is_binomial<N>;
+  /**
+   * @brief calculates the projected probability of the entries [first, last), output is written to out[first, last)
+   */
+  void getBinomialProjection(FloatT* out, FloatT base_rate, std::size_t first, std::size_t last) const
+    requires is_binomial<N>;
+
+protected:
+  /**
+   * @brief throws std::invalid_argument if the size of an operand differs from the size of this batch, used by the
+   *        whole-batch operators as their ranged overloads only assert the range
+   */
+  void check_operand_size(std::size_t operand_size) const;
+
+  /**
+   * @brief calculates the uncertainty of an entry directly from lane pointers, used within the kernels
+   */
+  static inline FloatT lane_uncertainty(const ConstLaneType& lanes, std::size_t idx);
+
+  StorageType storage_;
+  std::size_t size_{ 0 };
+  std::size_t stride_{ 0 };
+};
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>::OpinionBatch(std::size_t size, OpinionT default_opinion)
+{
+  resize(size, default_opinion);
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>::OpinionBatch(const std::vector<OpinionT>& opinions)
+{
+  resize(opinions.size());
+  for (std::size_t idx{ 0 }; idx < size_; ++idx)
+  {
+    set(idx, opinions[idx]);
+  }
+}
+
+template <std::size_t N, typename FloatT>
+std::size_t OpinionBatch<N, FloatT>::size() const
+{
+  return size_;
+}
+
+template <std::size_t N, typename FloatT>
+bool OpinionBatch<N, FloatT>::empty() const
+{
+  return size_ == 0;
+}
+
+template <std::size_t N, typename FloatT>
+std::size_t OpinionBatch<N, FloatT>::lane_stride() const
+{
+  return stride_;
+}
+
+template <std::size_t N, typename FloatT>
+void OpinionBatch<N, FloatT>::resize(std::size_t size, OpinionT default_opinion)
+{
+  std::size_t stride = ((size + LANE_PADDING - 1) / LANE_PADDING) * LANE_PADDING;
+  StorageType storage(N * stride);
+
+  std::size_t num_kept = std::min(size, size_);
+  for (std::size_t mass_idx{ 0 }; mass_idx < N; ++mass_idx)
+  {
+    FloatT* new_lane = storage.data() + mass_idx * stride;
+    std::copy_n(lane(mass_idx), num_kept, new_lane);
+    std::fill(new_lane + num_kept, new_lane + size, default_opinion.belief_mass(mass_idx));
+  }
+
+  storage_ = std::move(storage);
+  size_ = size;
+  stride_ = stride;
+}
+
+template <std::size_t N, typename FloatT>
+FloatT* OpinionBatch<N, FloatT>::lane(std::size_t mass_idx)
+{
+  assert(mass_idx < N);
+  return storage_.data() + mass_idx * stride_;
+}
+
+template <std::size_t N, typename FloatT>
+const FloatT* OpinionBatch<N, FloatT>::lane(std::size_t mass_idx) const
+{
+  assert(mass_idx < N);
+  return storage_.data() + mass_idx * stride_;
+}
+
+template <std::size_t N, typename FloatT>
+typename OpinionBatch<N, FloatT>::LaneType OpinionBatch<N, FloatT>::lanes()
+{
+  LaneType lanes;
+  constexpr_for<0, N, 1>([this, &lanes](std::size_t mass_idx) { lanes[mass_idx] = lane(mass_idx); });
+  return lanes;
+}
+
+template <std::size_t N, typename FloatT>
+typename OpinionBatch<N, FloatT>::ConstLaneType OpinionBatch<N, FloatT>::lanes() const
+{
+  ConstLaneType lanes;
+  constexpr_for<0, N, 1>([this, &lanes](std::size_t mass_idx) { lanes[mass_idx] = lane(mass_idx); });
+  return lanes;
+}
+
+template <std::size_t N, typename FloatT>
+typename OpinionBatch<N, FloatT>::OpinionT OpinionBatch<N, FloatT>::get(std::size_t idx) const
+{
+  assert(idx < size_);
+  OpinionT opinion;
+  constexpr_for<0, N, 1>([this, idx, &opinion](std::size_t mass_idx) {
+    opinion.belief_mass(mass_idx) = storage_[mass_idx * stride_ + idx];
+  });
+  return opinion;
+}
+
+template <std::size_t N, typename FloatT>
+typename OpinionBatch<N, FloatT>::OpinionT OpinionBatch<N, FloatT>::operator[](std::size_t idx) const
+{
+  return get(idx);
+}
+
+template <std::size_t N, typename FloatT>
+void OpinionBatch<N, FloatT>::set(std::size_t idx, OpinionT opinion)
+{
+  assert(idx < size_);
+  constexpr_for<0, N, 1>([this, idx, &opinion](std::size_t mass_idx) {
+    storage_[mass_idx * stride_ + idx] = opinion.belief_mass(mass_idx);
+  });
+}
+
+template <std::size_t N, typename FloatT>
+void OpinionBatch<N, FloatT>::fill(OpinionT opinion)
+{
+  for (std::size_t mass_idx{ 0 }; mass_idx < N; ++mass_idx)
+  {
+    std::fill_n(lane(mass_idx), size_, opinion.belief_mass(mass_idx));
+  }
+}
+
+template <std::size_t N, typename FloatT>
+std::vector<typename OpinionBatch<N, FloatT>::OpinionT> OpinionBatch<N, FloatT>::as_vector() const
+{
+  std::vector<OpinionT> opinions;
+  opinions.reserve(size_);
+  for (std::size_t idx{ 0 }; idx < size_; ++idx)
+  {
+    opinions.push_back(get(idx));
+  }
+  return opinions;
+}
+
+template <std::size_t N, typename FloatT>
+void OpinionBatch<N, FloatT>::check_operand_size(std::size_t operand_size) const
+{
+  if (operand_size != size_)
+  {
+    throw std::invalid_argument{ "the operand of size " + std::to_string(operand_size) +
+                                 " does not match the batch of size " + std::to_string(size_) };
+  }
+}
+
+template <std::size_t N, typename FloatT>
+inline FloatT OpinionBatch<N, FloatT>::lane_uncertainty(const ConstLaneType& lanes, std::size_t idx)
+{
+  FloatT belief_sum{ 0 };
+  constexpr_for<0, N, 1>([&lanes, idx, &belief_sum](std::size_t mass_idx) { belief_sum += lanes[mass_idx][idx]; });
+  return static_cast<FloatT>(1.0) - belief_sum;
+}
+
+template <std::size_t N, typename FloatT>
+FloatT OpinionBatch<N, FloatT>::uncertainty(std::size_t idx) const
+{
+  assert(idx < size_);
+  return lane_uncertainty(lanes(), idx);
+}
+
+template <std::size_t N, typename FloatT>
+typename OpinionBatch<N, FloatT>::StorageType OpinionBatch<N, FloatT>::uncertainties() const
+{
+  StorageType out(size_);
+  uncertainties(out.data(), 0, size_);
+  return out;
+}
+
+template <std::size_t N, typename FloatT>
+void OpinionBatch<N, FloatT>::uncertainties(FloatT* out, std::size_t first, std::size_t last) const
+{
+  assert(last <= size_);
+  const ConstLaneType src = lanes();
+  for (std::size_t idx{ first }; idx < last; ++idx)
+  {
+    out[idx] = lane_uncertainty(src, idx);
+  }
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& OpinionBatch<N, FloatT>::cum_fuse_(const OpinionBatch& other)
+{
+  check_operand_size(other.size_);
+  return cum_fuse_(other, 0, size_);
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& OpinionBatch<N, FloatT>::cum_fuse_(const OpinionBatch& other,
+                                                            std::size_t first,
+                                                            std::size_t last)
+{
+  assert(last <= size_ and last <= other.size_);
+  batch_kernels::apply_binary<batch_kernels::CumulativeFusion, N, FloatT>(
+      lanes(), std::as_const(*this).lanes(), other.lanes(), first, last);
+  return *this;
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT> OpinionBatch<N, FloatT>::cum_fuse(const OpinionBatch& other) const
+{
+  return OpinionBatch(*this).cum_fuse_(other);
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& OpinionBatch<N, FloatT>::average_fuse_(const OpinionBatch& other)
+{
+  check_operand_size(other.size_);
+  return average_fuse_(other, 0, size_);
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& OpinionBatch<N, FloatT>::average_fuse_(const OpinionBatch& other,
+                                                                std::size_t first,
+                                                                std::size_t last)
+{
+  assert(last <= size_ and last <= other.size_);
+  batch_kernels::apply_binary<batch_kernels::AverageFusion, N, FloatT>(
+      lanes(), std::as_const(*this).lanes(), other.lanes(), first, last);
+  return *this;
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT> OpinionBatch<N, FloatT>::average_fuse(const OpinionBatch& other) const
+{
+  return OpinionBatch(*this).average_fuse_(other);
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& OpinionBatch<N, FloatT>::wb_fuse_(const OpinionBatch& other)
+{
+  check_operand_size(other.size_);
+  return wb_fuse_(other, 0, size_);
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& OpinionBatch<N, FloatT>::wb_fuse_(const OpinionBatch& other,
+                                                           std::size_t first,
+                                                           std::size_t last)
+{
+  assert(last <= size_ and last <= other.size_);
+  batch_kernels::apply_binary<batch_kernels::WeightedFusion, N, FloatT>(
+      lanes(), std::as_const(*this).lanes(), other.lanes(), first, last);
+  return *this;
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT> OpinionBatch<N, FloatT>::wb_fuse(const OpinionBatch& other) const
+{
+  return OpinionBatch(*this).wb_fuse_(other);
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& OpinionBatch<N, FloatT>::bc_fuse_(const OpinionBatch& other)
+{
+  check_operand_size(other.size_);
+  return bc_fuse_(other, 0, size_);
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& OpinionBatch<N, FloatT>::bc_fuse_(const OpinionBatch& other,
+                                                           std::size_t first,
+                                                           std::size_t last)
+{
+  assert(last <= size_ and last <= other.size_);
+  batch_kernels::apply_binary<batch_kernels::BeliefConstraintFusion, N, FloatT>(
+      lanes(), std::as_const(*this).lanes(), other.lanes(), first, last);
+  return *this;
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT> OpinionBatch<N, FloatT>::bc_fuse(const OpinionBatch& other) const
+{
+  return OpinionBatch(*this).bc_fuse_(other);
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT> OpinionBatch<N, FloatT>::fuse_opinions(FusionType fusion_type,
+                                                               const std::vector<OpinionBatch>& sources)
+{
+  if (sources.empty())
+  {
+    throw std::invalid_argument{ "multi-source fusion requires at least one source" };
+  }
+  std::vector<ConstLaneType> source_lanes;
+  source_lanes.reserve(sources.size());
+  for (const auto& source : sources)
+  {
+    if (source.size() != sources.front().size())
+    {
+      throw std::invalid_argument{ "all sources of a multi-source fusion must have the same size" };
+    }
+    source_lanes.push_back(source.lanes());
+  }
+
+  OpinionBatch result{ sources.front().size() };
+  return result.fuse_opinions_(fusion_type, source_lanes, 0, result.size());
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& OpinionBatch<N, FloatT>::fuse_opinions_(FusionType fusion_type,
+                                                                 std::span<const ConstLaneType> sources,
+                                                                 std::size_t first,
+                                                                 std::size_t last)
+{
+  assert(not sources.empty() and last <= size_);
+  const LaneType dst = lanes();
+  if (sources.size() == 1)
+  {
+    // see multisource::Fusion::preprocess_opinions, a single opinion is the result of all operators
+    for (std::size_t mass_idx{ 0 }; mass_idx < N; ++mass_idx)
+    {
+      std::copy(sources.front()[mass_idx] + first, sources.front()[mass_idx] + last, dst[mass_idx] + first);
+    }
+    return *this;
+  }
+
+  using batch_kernels::EvidenceFusionType;
+  switch (fusion_type)
+  {
+    case FusionType::CUMULATIVE:
+    {
+      batch_kernels::apply_multi_source<batch_kernels::MultiSourceEvidenceFusion<EvidenceFusionType::CUMULATIVE>>(
+          dst, sources, first, last);
+      break;
+    }
+    case FusionType::BELIEF_CONSTRAINT:
+    {
+      batch_kernels::apply_multi_source<batch_kernels::MultiSourceBeliefConstraintFusion>(dst, sources, first, last);
+      break;
+    }
+    case FusionType::AVERAGE:
+    {
+      batch_kernels::apply_multi_source<batch_kernels::MultiSourceEvidenceFusion<EvidenceFusionType::AVERAGE>>(
+          dst, sources, first, last);
+      break;
+    }
+    case FusionType::WEIGHTED:
+    {
+      batch_kernels::apply_multi_source<batch_kernels::MultiSourceEvidenceFusion<EvidenceFusionType::WEIGHTED>>(
+          dst, sources, first, last);
+      break;
+    }
+    case FusionType::CONSENSUS_COMPROMISE:
+    {
+      batch_kernels::apply_multi_source<batch_kernels::MultiSourceConsensusCompromiseFusion>(
+          dst, sources, first, last);
+      break;
+    }
+    default:
+    {
+      throw std::logic_error{ "MultiSource fusion is not yet implemented for: " +
+                              std::to_string(static_cast<int>(fusion_type)) };
+    }
+  }
+  return *this;
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& OpinionBatch<N, FloatT>::trust_discount_(FloatT prop)
+{
+  return trust_discount_(prop, 0, size_);
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& OpinionBatch<N, FloatT>::trust_discount_(FloatT prop, std::size_t first, std::size_t last)
+{
+  assert(last <= size_);
+  for (std::size_t mass_idx{ 0 }; mass_idx < N; ++mass_idx)
+  {
+    FloatT* dst = lane(mass_idx);
+    for (std::size_t idx{ first }; idx < last; ++idx)
+    {
+      dst[idx] *= prop;
+    }
+  }
+  return *this;
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& OpinionBatch<N, FloatT>::trust_discount_(const OpinionBatch<2, FloatT>& trusts,
+                                                                  FloatT base_rate)
+{
+  check_operand_size(trusts.size());
+  return trust_discount_(trusts, base_rate, 0, size_);
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& OpinionBatch<N, FloatT>::trust_discount_(const OpinionBatch<2, FloatT>& trusts,
+                                                                  FloatT base_rate,
+                                                                  std::size_t first,
+                                                                  std::size_t last)
+{
+  assert(last <= size_ and last <= trusts.size());
+  const LaneType dst = lanes();
+  const FloatT* trust_belief = trusts.lane(0);
+  const FloatT* trust_disbelief = trusts.lane(1);
+
+  for (std::size_t idx{ first }; idx < last; ++idx)
+  {
+    // projected probability of the binomial trust opinion
+    FloatT prop = trust_belief[idx] + (1 - trust_belief[idx] - trust_disbelief[idx]) * base_rate;
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) { dst[mass_idx][idx] *= prop; });
+  }
+  return *this;
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT> OpinionBatch<N, FloatT>::trust_discount(FloatT prop) const
+{
+  return OpinionBatch(*this).trust_discount_(prop);
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT> OpinionBatch<N, FloatT>::trust_discount(const OpinionBatch<2, FloatT>& trusts,
+                                                                FloatT base_rate) const
+{
+  return OpinionBatch(*this).trust_discount_(trusts, base_rate);
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& OpinionBatch<N, FloatT>::deduction_(FloatT base_x, OpinionT cond_1, OpinionT cond_2)
+  requires is_binomial<N>
+{
+  return deduction_(base_x, cond_1, cond_2, 0, size_);
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT>& OpinionBatch<N, FloatT>::deduction_(FloatT base_x,
+                                                             OpinionT cond_1,
+                                                             OpinionT cond_2,
+                                                             std::size_t first,
+                                                             std::size_t last)
+  requires is_binomial<N>
+{
+  assert(last <= size_);
+  // everything depending on the conditionals only is shared by all entries,
+  // the calculation is the same as in OpinionNoBase::deduction_
+  FloatT a_y_nom = base_x * cond_1.belief() + (1 - base_x) * cond_2.belief();
+  FloatT a_y_denom = 1 - (base_x * cond_1.uncertainty() + (1 - base_x) * cond_2.uncertainty());
+  FloatT a_y = base_x;
+  if (std::abs(a_y_denom) > EPS_v<FloatT>)
+  {
+    a_y = a_y_nom / a_y_denom;
+  }
+
+  FloatT P_cond_1 = cond_1.getBinomialProjection(a_y);
+  FloatT P_cond_2 = cond_2.getBinomialProjection(a_y);
+  FloatT P_apex_bel = base_x * P_cond_1 + (1 - base_x) * P_cond_2;
+  FloatT uncert_apex = std::min((P_apex_bel - std::min(cond_1.belief(), cond_2.belief())) / a_y,
+                                ((1 - P_apex_bel) - std::min(cond_1.disbelief(), cond_2.disbelief())) / (1 - a_y));
+  FloatT weight_belief = uncert_apex - cond_1.uncertainty();
+  FloatT weight_disbelief = uncert_apex - cond_2.uncertainty();
+
+  // the remaining part is linear in the belief masses of each entry
+  FloatT* belief = lane(0);
+  FloatT* disbelief = lane(1);
+  for (std::size_t idx{ first }; idx < last; ++idx)
+  {
+    FloatT bel_x = belief[idx];
+    FloatT dis_x = disbelief[idx];
+    FloatT P_x = bel_x + (1 - bel_x - dis_x) * base_x;
+
+    FloatT uncert_y_x = uncert_apex - (weight_belief * bel_x + weight_disbelief * dis_x);
+    FloatT P_y_x = P_cond_1 * P_x + P_cond_2 * (1 - P_x);
+    FloatT bel = P_y_x - a_y * uncert_y_x;
+
+    belief[idx] = bel;
+    disbelief[idx] = 1 - bel - uncert_y_x;
+  }
+  return *this;
+}
+
+template <std::size_t N, typename FloatT>
+OpinionBatch<N, FloatT> OpinionBatch<N, FloatT>::deduction(FloatT base_x, OpinionT cond_1, OpinionT cond_2) const
+  requires is_binomial<N>
+{
+  return OpinionBatch(*this).deduction_(base_x, cond_1, cond_2);
+}
+
+template <std::size_t N, typename FloatT>
+typename OpinionBatch<N, FloatT>::StorageType OpinionBatch<N, FloatT>::getBinomialProjection(FloatT base_rate) const
+  requires is_binomial<N>
+{
+  StorageType out(size_);
+  getBinomialProjection(out.data(), base_rate, 0, size_);
+  return out;
+}
+
+template <std::size_t N, typename FloatT>
+void OpinionBatch<N, FloatT>::getBinomialProjection(FloatT* out,
+                                                    FloatT base_rate,
+                                                    std::size_t first,
+                                                    std::size_t last) const
+  requires is_binomial<N>
+{
+  assert(last <= size_);
+  const FloatT* belief = lane(0);
+  const FloatT* disbelief = lane(1);
+  for (std::size_t idx{ first }; idx < last; ++idx)
+  {
+    out[idx] = belief[idx] + (1 - belief[idx] - disbelief[idx]) * base_rate;
+  }
+}
+
+}  // namespace subjective_logic
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace subjective_logic
+{
+
+/**
+ * @brief codecs mapping a single belief mass within [0, 1] to a compact storage type, used by QuantizedOpinionBatch.
+ *        only the belief masses are stored, the uncertainty is implied (u = 1 - sum of the belief masses).
+ *
+ *        all codecs round towards zero (up to a small guard for the fixed point codecs), thus, the sum of the encoded
+ *        belief masses never exceeds 1 and the implied uncertainty stays valid. as a consequence, quantization never
+ *        results in more certain opinions than the original ones.
+ *        decoding and encoding again returns the same code, i.e., repeatedly decoding, operating and encoding does not
+ *        drift on its own.
+ *
+ *        each codec provides:
+ *        - StorageType: type of a stored belief mass
+ *        - MAX_SIZE: maximum dimension of the opinions for which the sum of the encoded masses is guaranteed to be <= 1
+ *        - decode<FloatT>(code) and encode<FloatT>(mass)
+ *        - error_bound<FloatT>(mass): maximum absolute deviation between a mass and its decoded code
+ */
+
+/**
+ * @brief fixed point representation with the full range of an unsigned integer mapped to [0, 1]
+ *        the error bound is 1 / max(StorageT), i.e., about 3.9e-3 for uint8 and 1.5e-5 for uint16
+ * @tparam StorageT - unsigned integer type
+ */
+template <typename StorageT>
+struct FixedPointCodec
+{
+  static_assert(std::is_unsigned_v<StorageT>, "fixed point codes must be unsigned");
+
+  using StorageType = StorageT;
+
+  // the guard (in units of the last place) absorbs the rounding of the float multiplication,
+  // the sum of the guards of all masses of an opinion must stay below one unit
+  static constexpr double GUARD{ 1. / 128. };
+  static constexpr std::size_t MAX_SIZE{ 127 };
+  static constexpr double SCALE{ static_cast<double>(std::numeric_limits<StorageT>::max()) };
+
+  template <typename FloatT>
+  static inline FloatT decode(StorageT code)
+  {
+    return static_cast<FloatT>(code) * static_cast<FloatT>(1. / SCALE);
+  }
+
+  template <typename FloatT>
+  static inline StorageT encode(FloatT mass)
+  {
+    // the cast truncates, which equals the floor for non negative values
+    return static_cast<StorageT>(std::clamp(mass, FloatT{ 0 }, FloatT{ 1 }) * static_cast<FloatT>(SCALE) +
+                                 static_cast<FloatT>(GUARD));
+  }
+
+  template <typename FloatT>
+  static constexpr FloatT error_bound(FloatT /*mass*/)
+  {
+    return static_cast<FloatT>(1. / SCALE);
+  }
+};
+
+/**
+ * @brief IEEE 754 half precision (1 sign bit, 5 exponent bits, 10 mantissa bits)
+ *        the relative error is below 2^-10, masses below 2^-14 (subnormal) have an absolute error below 2^-24
+ */
+struct Float16Codec
+{
+  using StorageType = std::uint16_t;
+  static constexpr std::size_t MAX_SIZE{ std::numeric_limits<std::size_t>::max() };
+
+  template <typename FloatT>
+  static inline FloatT decode(std::uint16_t code)
+  {
+    std::uint32_t exponent = (code >> 10) & 0x1f;
+    std::uint32_t mantissa = code & 0x3ff;
+    if (exponent == 0)
+    {
+      // subnormal, mantissa * 2^-24
+      return static_cast<FloatT>(mantissa) * static_cast<FloatT>(5.9604644775390625e-08);
+    }
+    return static_cast<FloatT>(std::bit_cast<float>(((exponent + 112) << 23) | (mantissa << 13)));
+  }
+
+  template <typename FloatT>
+  static inline std::uint16_t encode(FloatT mass)
+  {
+    std::uint32_t bits = std::bit_cast<std::uint32_t>(truncate_to_float(mass));
+    std::uint32_t exponent = bits >> 23;
+    std::uint32_t mantissa = bits & 0x7fffff;
+    if (exponent >= 113)
+    {
+      // normal half, the exponent bias changes from 127 to 15
+      return static_cast<std::uint16_t>(((exponent - 112) << 10) | (mantissa >> 13));
+    }
+    // subnormal half, the implicit leading one becomes explicit
+    std::uint32_t shift = 126 - exponent;
+    return shift < 32 ? static_cast<std::uint16_t>((mantissa | 0x800000) >> shift) : std::uint16_t{ 0 };
+  }
+
+  template <typename FloatT>
+  static constexpr FloatT error_bound(FloatT mass)
+  {
+    return std::max(mass * static_cast<FloatT>(9.765625e-04), static_cast<FloatT>(5.9604644775390625e-08));
+  }
+
+  /**
+   * @brief converts a mass within [0, 1] to float without rounding up
+   */
+  template <typename FloatT>
+  static inline float truncate_to_float(FloatT mass)
+  {
+    auto clamped = std::clamp(mass, FloatT{ 0 }, FloatT{ 1 });
+    auto truncated = static_cast<float>(clamped);
+    if constexpr (not std::is_same_v<FloatT, float>)
+    {
+      if (static_cast<FloatT>(truncated) > clamped)
+      {
+        truncated = std::nextafter(truncated, 0.f);
+      }
+    }
+    return truncated;
+  }
+};
+
+/**
+ * @brief brain floating point (the upper half of a float: 1 sign bit, 8 exponent bits, 7 mantissa bits)
+ *        the relative error is below 2^-7, encoding and decoding are plain shifts
+ */
+struct BFloat16Codec
+{
+  using StorageType = std::uint16_t;
+  static constexpr std::size_t MAX_SIZE{ std::numeric_limits<std::size_t>::max() };
+
+  template <typename FloatT>
+  static inline FloatT decode(std::uint16_t code)
+  {
+    return static_cast<FloatT>(std::bit_cast<float>(static_cast<std::uint32_t>(code) << 16));
+  }
+
+  template <typename FloatT>
+  static inline std::uint16_t encode(FloatT mass)
+  {
+    return static_cast<std::uint16_t>(std::bit_cast<std::uint32_t>(Float16Codec::truncate_to_float(mass)) >> 16);
+  }
+
+  template <typename FloatT>
+  static constexpr FloatT error_bound(FloatT mass)
+  {
+    // masses below the smallest normal float lose their relative precision
+    return std::max(mass * static_cast<FloatT>(7.8125e-03), static_cast<FloatT>(std::numeric_limits<float>::min()));
+  }
+};
+
+using UInt8Codec = FixedPointCodec<std::uint8_t>;
+using UInt16Codec = FixedPointCodec<std::uint16_t>;
+
+}  // namespace subjective_logic
@@ -0,0 +1,657 @@
+#pragma once
+
+// the reader is invited to refer to the following book as reference for the implementations within this file:
+// [1] Subjective Logic - A Formalism for Reasoning Under Uncertainty,
+// Audun Jøsang, 2016, https://doi.org/10.1007/978-3-319-42337-1
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+#include "subjective_logic_lib/util.hpp"
+#include "subjective_logic_lib/types/aligned_allocator.hpp"
+#include "subjective_logic_lib/opinions/opinion_no_base.hpp"
+#include "subjective_logic_lib/batch/opinion_batch.hpp"
+#include "subjective_logic_lib/batch/quantization_codecs.hpp"
+#include "subjective_logic_lib/batch/simd_kernels.hpp"
+
+namespace subjective_logic
+{
+
+/**
+ * @brief structure of arrays container storing the belief masses of OpinionNoBase instances in a compact format
+ * (see quantization_codecs.hpp), the uncertainty is implied. e.g., a binomial opinion takes 2 bytes using UInt8Codec
+ * and 4 bytes using UInt16Codec, Float16Codec or BFloat16Codec instead of the 8 bytes of OpinionNoBase<2, float>.
+ *
+ * the operators decode a chunk of CHUNK_SIZE entries into FloatT buffers, apply the kernels of simd_kernels.hpp and
+ * encode the result again, i.e., the compact data is read and written once per operator (decode-operate-encode).
+ * the result of an operator is the encoded result of the same operator applied to the decoded inputs, thus,
+ * each resulting belief mass deviates by at most Codec::error_bound from the result using the decoded inputs.
+ * w.r.t. the full precision inputs, the input errors propagate through the respective operator additionally.
+ * the other operand of a fusion may be a full precision OpinionBatch, e.g., new measurements fused into a map.
+ *
+ * this container is not available with CUDA.
+ *
+ * @tparam N dimension of the opinions
+ * @tparam Codec compact format of a belief mass, one of quantization_codecs.hpp
+ * @tparam FloatT float type used to decode and process the belief masses
+ */
+template <std::size_t N = 2, typename Codec = UInt16Codec, typename FloatT = float>
+class QuantizedOpinionBatch
+{
+public:
+  using OpinionT = OpinionNoBase<N, FloatT>;
+  using CodeType = typename Codec::StorageType;
+  using StorageType = AlignedVector<CodeType>;
+  using LaneType = std::array<CodeType*, N>;
+  using ConstLaneType = std::array<const CodeType*, N>;
+  using OpinionBatchT = OpinionBatch<N, FloatT>;
+
+  // helper to have accessible types/values when used from outside;
+  using FLOAT_t = FloatT;
+  using CODEC_t = Codec;
+  static constexpr std::size_t SIZE = N;
+  // lanes are padded to a multiple of this number of elements, so that each lane starts at an aligned address
+  static constexpr std::size_t LANE_PADDING = BATCH_ALIGNMENT / sizeof(CodeType);
+  // number of entries decoded at once, the decoded chunks of both operands stay within the L1 cache
+  static constexpr std::size_t CHUNK_SIZE{ 128 };
+  // bytes required per opinion (without padding)
+  static constexpr std::size_t BYTES_PER_OPINION = N * sizeof(CodeType);
+
+  static_assert(N <= Codec::MAX_SIZE, "the codec cannot guarantee valid opinions of this dimension");
+
+  /**
+   * @brief creates an empty batch
+   */
+  QuantizedOpinionBatch() = default;
+
+  /**
+   * @brief creates a batch of the given size, all entries are vacuous
+   * @param size
+   */
+  explicit QuantizedOpinionBatch(std::size_t size);
+
+  /**
+   * @brief creates a batch containing the encoded opinions of the given batch
+   * @param opinions
+   */
+  explicit QuantizedOpinionBatch(const OpinionBatchT& opinions);
+
+  /**
+   * @brief number of entries stored in the batch
+   */
+  [[nodiscard]] std::size_t size() const;
+
+  /**
+   * @brief checks if the batch contains any entry
+   */
+  [[nodiscard]] bool empty() const;
+
+  /**
+   * @brief distance between the first elements of two consecutive lanes (number of codes)
+   */
+  [[nodiscard]] std::size_t lane_stride() const;
+
+  /**
+   * @brief direct access to the contiguous lane of encoded belief masses of one hypothesis
+   * @param mass_idx - must be smaller than N
+   */
+  CodeType* lane(std::size_t mass_idx);
+  /**
+   * @brief direct const access to the contiguous lane of encoded belief masses of one hypothesis
+   * @param mass_idx - must be smaller than N
+   */
+  [[nodiscard]] const CodeType* lane(std::size_t mass_idx) const;
+
+  /**
+   * @brief pointers to all N lanes
+   */
+  LaneType lanes();
+  /**
+   * @brief const pointers to all N lanes
+   */
+  [[nodiscard]] ConstLaneType lanes() const;
+
+  /**
+   * @brief decodes the given entry
+   */
+  [[nodiscard]] OpinionT get(std::size_t idx) const;
+  [[nodiscard]] OpinionT operator[](std::size_t idx) const;
+
+  /**
+   * @brief encodes the given opinion into the given entry
+   */
+  void set(std::size_t idx, const OpinionT& opinion);
+
+  /**
+   * @brief encodes the entries [first, last) of the given batch into the same entries of this batch
+   */
+  void encode(const OpinionBatchT& opinions, std::size_t first, std::size_t last);
+
+  /**
+   * @brief decodes the entries [first, last) into the same entries of out
+   * @param out - batch with at least last entries
+   */
+  void decode(OpinionBatchT& out, std::size_t first, std::size_t last) const;
+  /**
+   * @brief decodes all entries
+   */
+  [[nodiscard]] OpinionBatchT decode() const;
+
+  /**
+   * @brief applies cumulative belief fusion elementwise (inplace)
+   */
+  QuantizedOpinionBatch& cum_fuse_(const QuantizedOpinionBatch& other);
+  QuantizedOpinionBatch& cum_fuse_(const QuantizedOpinionBatch& other, std::size_t first, std::size_t last);
+  QuantizedOpinionBatch& cum_fuse_(const OpinionBatchT& other);
+  QuantizedOpinionBatch& cum_fuse_(const OpinionBatchT& other, std::size_t first, std::size_t last);
+  [[nodiscard]] QuantizedOpinionBatch cum_fuse(const QuantizedOpinionBatch& other) const;
+
+  /**
+   * @brief applies averaging belief fusion elementwise (inplace)
+   */
+  QuantizedOpinionBatch& average_fuse_(const QuantizedOpinionBatch& other);
+  QuantizedOpinionBatch& average_fuse_(const QuantizedOpinionBatch& other, std::size_t first, std::size_t last);
+  QuantizedOpinionBatch& average_fuse_(const OpinionBatchT& other);
+  QuantizedOpinionBatch& average_fuse_(const OpinionBatchT& other, std::size_t first, std::size_t last);
+  [[nodiscard]] QuantizedOpinionBatch average_fuse(const QuantizedOpinionBatch& other) const;
+
+  /**
+   * @brief applies weighted belief fusion elementwise (inplace)
+   */
+  QuantizedOpinionBatch& wb_fuse_(const QuantizedOpinionBatch& other);
+  QuantizedOpinionBatch& wb_fuse_(const QuantizedOpinionBatch& other, std::size_t first, std::size_t last);
+  QuantizedOpinionBatch& wb_fuse_(const OpinionBatchT& other);
+  QuantizedOpinionBatch& wb_fuse_(const OpinionBatchT& other, std::size_t first, std::size_t last);
+  [[nodiscard]] QuantizedOpinionBatch wb_fuse(const QuantizedOpinionBatch& other) const;
+
+  /**
+   * @brief applies belief constraint fusion elementwise (inplace)
+   */
+  QuantizedOpinionBatch& bc_fuse_(const QuantizedOpinionBatch& other);
+  QuantizedOpinionBatch& bc_fuse_(const QuantizedOpinionBatch& other, std::size_t first, std::size_t last);
+  QuantizedOpinionBatch& bc_fuse_(const OpinionBatchT& other);
+  QuantizedOpinionBatch& bc_fuse_(const OpinionBatchT& other, std::size_t first, std::size_t last);
+  [[nodiscard]] QuantizedOpinionBatch bc_fuse(const QuantizedOpinionBatch& other) const;
+
+  /**
+   * @brief applies trust discounting with the same probability to each entry (inplace)
+   */
+  QuantizedOpinionBatch& trust_discount_(FloatT prop);
+  QuantizedOpinionBatch& trust_discount_(FloatT prop, std::size_t first, std::size_t last);
+  [[nodiscard]] QuantizedOpinionBatch trust_discount(FloatT prop) const;
+
+  /**
+   * @brief projected probabilities of all entries
+   */
+  [[nodiscard]] AlignedVector<FloatT> getBinomialProjection(FloatT base_rate = 0.5) const
+    requires is_binomial<N>;
+  /**
+   * @brief writes the projected probabilities of the entries [first, last) to out[first, last)
+   */
+  void getBinomialProjection(FloatT* out, FloatT base_rate, std::size_t first, std::size_t last) const
+    requires is_binomial<N>;
+
+protected:
+  using ChunkType = std::array<std::array<FloatT, CHUNK_SIZE>, N>;
+
+  /**
+   * @brief decodes count entries starting at first into the chunk buffer
+   */
+  void decode_chunk(ChunkType& chunk, std::size_t first, std::size_t count) const;
+  /**
+   * @brief encodes count entries of the chunk buffer into the entries starting at first
+   */
+  void encode_chunk(const ChunkType& chunk, std::size_t first, std::size_t count);
+
+  static std::array<FloatT*, N> chunk_lanes(ChunkType& chunk);
+  static std::array<const FloatT*, N> chunk_lanes(const ChunkType& chunk);
+
+  /**
+   * @brief decode-operate-encode loop over the entries [first, last)
+   * @param other_lanes - callable (chunk_first, count) returning the decoded lanes of the other operand,
+   *                      the lanes are indexed relative to chunk_first
+   */
+  template <typename Kernel, typename OtherLanes>
+  QuantizedOpinionBatch& fuse_chunks_(OtherLanes&& other_lanes, std::size_t first, std::size_t last);
+
+  template <typename Kernel>
+  QuantizedOpinionBatch& fuse_(const QuantizedOpinionBatch& other, std::size_t first, std::size_t last);
+  template <typename Kernel>
+  QuantizedOpinionBatch& fuse_(const OpinionBatchT& other, std::size_t first, std::size_t last);
+
+  StorageType storage_;
+  std::size_t size_{ 0 };
+  std::size_t stride_{ 0 };
+};
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>::QuantizedOpinionBatch(std::size_t size)
+  : size_{ size }, stride_{ (size + LANE_PADDING - 1) / LANE_PADDING * LANE_PADDING }
+{
+  // all codecs encode zero belief masses as zero
+  storage_.assign(N * stride_, CodeType{ 0 });
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>::QuantizedOpinionBatch(const OpinionBatchT& opinions)
+  : QuantizedOpinionBatch(opinions.size())
+{
+  encode(opinions, 0, size_);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+std::size_t QuantizedOpinionBatch<N, Codec, FloatT>::size() const
+{
+  return size_;
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+bool QuantizedOpinionBatch<N, Codec, FloatT>::empty() const
+{
+  return size_ == 0;
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+std::size_t QuantizedOpinionBatch<N, Codec, FloatT>::lane_stride() const
+{
+  return stride_;
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+typename QuantizedOpinionBatch<N, Codec, FloatT>::CodeType*
+QuantizedOpinionBatch<N, Codec, FloatT>::lane(std::size_t mass_idx)
+{
+  assert(mass_idx < N);
+  return storage_.data() + mass_idx * stride_;
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+const typename QuantizedOpinionBatch<N, Codec, FloatT>::CodeType*
+QuantizedOpinionBatch<N, Codec, FloatT>::lane(std::size_t mass_idx) const
+{
+  assert(mass_idx < N);
+  return storage_.data() + mass_idx * stride_;
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+typename QuantizedOpinionBatch<N, Codec, FloatT>::LaneType QuantizedOpinionBatch<N, Codec, FloatT>::lanes()
+{
+  LaneType out;
+  constexpr_for<0, N, 1>([&](std::size_t mass_idx) { out[mass_idx] = lane(mass_idx); });
+  return out;
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+typename QuantizedOpinionBatch<N, Codec, FloatT>::ConstLaneType QuantizedOpinionBatch<N, Codec, FloatT>::lanes() const
+{
+  ConstLaneType out;
+  constexpr_for<0, N, 1>([&](std::size_t mass_idx) { out[mass_idx] = lane(mass_idx); });
+  return out;
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+typename QuantizedOpinionBatch<N, Codec, FloatT>::OpinionT
+QuantizedOpinionBatch<N, Codec, FloatT>::get(std::size_t idx) const
+{
+  assert(idx < size_);
+  OpinionT out;
+  constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+    out.belief_masses()[mass_idx] = Codec::template decode<FloatT>(lane(mass_idx)[idx]);
+  });
+  return out;
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+typename QuantizedOpinionBatch<N, Codec, FloatT>::OpinionT
+QuantizedOpinionBatch<N, Codec, FloatT>::operator[](std::size_t idx) const
+{
+  return get(idx);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+void QuantizedOpinionBatch<N, Codec, FloatT>::set(std::size_t idx, const OpinionT& opinion)
+{
+  assert(idx < size_);
+  constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+    lane(mass_idx)[idx] = Codec::template encode<FloatT>(opinion.belief_masses()[mass_idx]);
+  });
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+void QuantizedOpinionBatch<N, Codec, FloatT>::encode(const OpinionBatchT& opinions,
+                                                     std::size_t first,
+                                                     std::size_t last)
+{
+  assert(last <= size_ and last <= opinions.size());
+  for (std::size_t mass_idx{ 0 }; mass_idx < N; ++mass_idx)
+  {
+    CodeType* dst = lane(mass_idx);
+    const FloatT* src = opinions.lane(mass_idx);
+    for (std::size_t idx{ first }; idx < last; ++idx)
+    {
+      dst[idx] = Codec::template encode<FloatT>(src[idx]);
+    }
+  }
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+void QuantizedOpinionBatch<N, Codec, FloatT>::decode(OpinionBatchT& out, std::size_t first, std::size_t last) const
+{
+  assert(last <= size_ and last <= out.size());
+  for (std::size_t mass_idx{ 0 }; mass_idx < N; ++mass_idx)
+  {
+    FloatT* dst = out.lane(mass_idx);
+    const CodeType* src = lane(mass_idx);
+    for (std::size_t idx{ first }; idx < last; ++idx)
+    {
+      dst[idx] = Codec::template decode<FloatT>(src[idx]);
+    }
+  }
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+typename QuantizedOpinionBatch<N, Codec, FloatT>::OpinionBatchT QuantizedOpinionBatch<N, Codec, FloatT>::decode() const
+{
+  OpinionBatchT out{ size_ };
+  decode(out, 0, size_);
+  return out;
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+void QuantizedOpinionBatch<N, Codec, FloatT>::decode_chunk(ChunkType& chunk, std::size_t first, std::size_t count) const
+{
+  for (std::size_t mass_idx{ 0 }; mass_idx < N; ++mass_idx)
+  {
+    const CodeType* src = lane(mass_idx) + first;
+    for (std::size_t idx{ 0 }; idx < count; ++idx)
+    {
+      chunk[mass_idx][idx] = Codec::template decode<FloatT>(src[idx]);
+    }
+  }
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+void QuantizedOpinionBatch<N, Codec, FloatT>::encode_chunk(const ChunkType& chunk, std::size_t first, std::size_t count)
+{
+  for (std::size_t mass_idx{ 0 }; mass_idx < N; ++mass_idx)
+  {
+    CodeType* dst = lane(mass_idx) + first;
+    for (std::size_t idx{ 0 }; idx < count; ++idx)
+    {
+      dst[idx] = Codec::template encode<FloatT>(chunk[mass_idx][idx]);
+    }
+  }
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+std::array<FloatT*, N> QuantizedOpinionBatch<N, Codec, FloatT>::chunk_lanes(ChunkType& chunk)
+{
+  std::array<FloatT*, N> out;
+  constexpr_for<0, N, 1>([&](std::size_t mass_idx) { out[mass_idx] = chunk[mass_idx].data(); });
+  return out;
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+std::array<const FloatT*, N> QuantizedOpinionBatch<N, Codec, FloatT>::chunk_lanes(const ChunkType& chunk)
+{
+  std::array<const FloatT*, N> out;
+  constexpr_for<0, N, 1>([&](std::size_t mass_idx) { out[mass_idx] = chunk[mass_idx].data(); });
+  return out;
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+template <typename Kernel, typename OtherLanes>
+QuantizedOpinionBatch<N, Codec, FloatT>&
+QuantizedOpinionBatch<N, Codec, FloatT>::fuse_chunks_(OtherLanes&& other_lanes, std::size_t first, std::size_t last)
+{
+  assert(last <= size_);
+  alignas(BATCH_ALIGNMENT) ChunkType chunk;
+  for (std::size_t chunk_first{ first }; chunk_first < last; chunk_first += CHUNK_SIZE)
+  {
+    std::size_t count = std::min(CHUNK_SIZE, last - chunk_first);
+    decode_chunk(chunk, chunk_first, count);
+    batch_kernels::apply_binary<Kernel, N, FloatT>(
+        chunk_lanes(chunk), chunk_lanes(std::as_const(chunk)), other_lanes(chunk_first, count), 0, count);
+    encode_chunk(chunk, chunk_first, count);
+  }
+  return *this;
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+template <typename Kernel>
+QuantizedOpinionBatch<N, Codec, FloatT>& QuantizedOpinionBatch<N, Codec, FloatT>::fuse_(
+    const QuantizedOpinionBatch& other, std::size_t first, std::size_t last)
+{
+  assert(last <= other.size_);
+  alignas(BATCH_ALIGNMENT) ChunkType other_chunk;
+  return fuse_chunks_<Kernel>(
+      [&](std::size_t chunk_first, std::size_t count) {
+        other.decode_chunk(other_chunk, chunk_first, count);
+        return chunk_lanes(std::as_const(other_chunk));
+      },
+      first,
+      last);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+template <typename Kernel>
+QuantizedOpinionBatch<N, Codec, FloatT>& QuantizedOpinionBatch<N, Codec, FloatT>::fuse_(const OpinionBatchT& other,
+                                                                                         std::size_t first,
+                                                                                         std::size_t last)
+{
+  assert(last <= other.size());
+  // full precision operands are used in place
+  return fuse_chunks_<Kernel>(
+      [&](std::size_t chunk_first, std::size_t /*count*/) {
+        std::array<const FloatT*, N> out;
+        constexpr_for<0, N, 1>([&](std::size_t mass_idx) { out[mass_idx] = other.lane(mass_idx) + chunk_first; });
+        return out;
+      },
+      first,
+      last);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>&
+QuantizedOpinionBatch<N, Codec, FloatT>::cum_fuse_(const QuantizedOpinionBatch& other)
+{
+  return fuse_<batch_kernels::CumulativeFusion>(other, 0, size_);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>&
+QuantizedOpinionBatch<N, Codec, FloatT>::cum_fuse_(const QuantizedOpinionBatch& other,
+                                                   std::size_t first,
+                                                   std::size_t last)
+{
+  return fuse_<batch_kernels::CumulativeFusion>(other, first, last);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>& QuantizedOpinionBatch<N, Codec, FloatT>::cum_fuse_(const OpinionBatchT& other)
+{
+  return fuse_<batch_kernels::CumulativeFusion>(other, 0, size_);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>&
+QuantizedOpinionBatch<N, Codec, FloatT>::cum_fuse_(const OpinionBatchT& other, std::size_t first, std::size_t last)
+{
+  return fuse_<batch_kernels::CumulativeFusion>(other, first, last);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>::cum_fuse(const QuantizedOpinionBatch& other) const
+{
+  return QuantizedOpinionBatch(*this).cum_fuse_(other);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>&
+QuantizedOpinionBatch<N, Codec, FloatT>::average_fuse_(const QuantizedOpinionBatch& other)
+{
+  return fuse_<batch_kernels::AverageFusion>(other, 0, size_);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>&
+QuantizedOpinionBatch<N, Codec, FloatT>::average_fuse_(const QuantizedOpinionBatch& other,
+                                                       std::size_t first,
+                                                       std::size_t last)
+{
+  return fuse_<batch_kernels::AverageFusion>(other, first, last);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>&
+QuantizedOpinionBatch<N, Codec, FloatT>::average_fuse_(const OpinionBatchT& other)
+{
+  return fuse_<batch_kernels::AverageFusion>(other, 0, size_);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>&
+QuantizedOpinionBatch<N, Codec, FloatT>::average_fuse_(const OpinionBatchT& other, std::size_t first, std::size_t last)
+{
+  return fuse_<batch_kernels::AverageFusion>(other, first, last);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>::average_fuse(const QuantizedOpinionBatch& other) const
+{
+  return QuantizedOpinionBatch(*this).average_fuse_(other);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>&
+QuantizedOpinionBatch<N, Codec, FloatT>::wb_fuse_(const QuantizedOpinionBatch& other)
+{
+  return fuse_<batch_kernels::WeightedFusion>(other, 0, size_);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>&
+QuantizedOpinionBatch<N, Codec, FloatT>::wb_fuse_(const QuantizedOpinionBatch& other,
+                                                  std::size_t first,
+                                                  std::size_t last)
+{
+  return fuse_<batch_kernels::WeightedFusion>(other, first, last);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>& QuantizedOpinionBatch<N, Codec, FloatT>::wb_fuse_(const OpinionBatchT& other)
+{
+  return fuse_<batch_kernels::WeightedFusion>(other, 0, size_);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>&
+QuantizedOpinionBatch<N, Codec, FloatT>::wb_fuse_(const OpinionBatchT& other, std::size_t first, std::size_t last)
+{
+  return fuse_<batch_kernels::WeightedFusion>(other, first, last);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>::wb_fuse(const QuantizedOpinionBatch& other) const
+{
+  return QuantizedOpinionBatch(*this).wb_fuse_(other);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>&
+QuantizedOpinionBatch<N, Codec, FloatT>::bc_fuse_(const QuantizedOpinionBatch& other)
+{
+  return fuse_<batch_kernels::BeliefConstraintFusion>(other, 0, size_);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>&
+QuantizedOpinionBatch<N, Codec, FloatT>::bc_fuse_(const QuantizedOpinionBatch& other,
+                                                  std::size_t first,
+                                                  std::size_t last)
+{
+  return fuse_<batch_kernels::BeliefConstraintFusion>(other, first, last);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>& QuantizedOpinionBatch<N, Codec, FloatT>::bc_fuse_(const OpinionBatchT& other)
+{
+  return fuse_<batch_kernels::BeliefConstraintFusion>(other, 0, size_);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>&
+QuantizedOpinionBatch<N, Codec, FloatT>::bc_fuse_(const OpinionBatchT& other, std::size_t first, std::size_t last)
+{
+  return fuse_<batch_kernels::BeliefConstraintFusion>(other, first, last);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>::bc_fuse(const QuantizedOpinionBatch& other) const
+{
+  return QuantizedOpinionBatch(*this).bc_fuse_(other);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>& QuantizedOpinionBatch<N, Codec, FloatT>::trust_discount_(FloatT prop)
+{
+  return trust_discount_(prop, 0, size_);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT>&
+QuantizedOpinionBatch<N, Codec, FloatT>::trust_discount_(FloatT prop, std::size_t first, std::size_t last)
+{
+  assert(last <= size_);
+  for (std::size_t mass_idx{ 0 }; mass_idx < N; ++mass_idx)
+  {
+    CodeType* dst = lane(mass_idx);
+    for (std::size_t idx{ first }; idx < last; ++idx)
+    {
+      dst[idx] = Codec::template encode<FloatT>(Codec::template decode<FloatT>(dst[idx]) * prop);
+    }
+  }
+  return *this;
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+QuantizedOpinionBatch<N, Codec, FloatT> QuantizedOpinionBatch<N, Codec, FloatT>::trust_discount(FloatT prop) const
+{
+  return QuantizedOpinionBatch(*this).trust_discount_(prop);
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+AlignedVector<FloatT> QuantizedOpinionBatch<N, Codec, FloatT>::getBinomialProjection(FloatT base_rate) const
+  requires is_binomial<N>
+{
+  AlignedVector<FloatT> out(size_);
+  getBinomialProjection(out.data(), base_rate, 0, size_);
+  return out;
+}
+
+template <std::size_t N, typename Codec, typename FloatT>
+void QuantizedOpinionBatch<N, Codec, FloatT>::getBinomialProjection(FloatT* out,
+                                                                    FloatT base_rate,
+                                                                    std::size_t first,
+                                                                    std::size_t last) const
+  requires is_binomial<N>
+{
+  assert(last <= size_);
+  const CodeType* belief = lane(0);
+  const CodeType* disbelief = lane(1);
+  for (std::size_t idx{ first }; idx < last; ++idx)
+  {
+    FloatT bel = Codec::template decode<FloatT>(belief[idx]);
+    FloatT dis = Codec::template decode<FloatT>(disbelief[idx]);
+    out[idx] = bel + (1 - bel - dis) * base_rate;
+  }
+}
+
+}  // namespace subjective_logic
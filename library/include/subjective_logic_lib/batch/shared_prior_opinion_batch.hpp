@@ -0,0 +1,551 @@
+#pragma once
+
+// the reader is invited to refer to the following book as reference for the implementations within this file:
+// [1] Subjective Logic - A Formalism for Reasoning Under Uncertainty,
+// Audun Jøsang, 2016, https://doi.org/10.1007/978-3-319-42337-1
+// [2] Multi-source fusion in subjective logic
+// A. J⊘sang, D. Wang and J. Zhang,
+// 2017 20th International Conference on Information Fusion (Fusion), Xi'an, China, 2017, pp. 1-8,
+// doi: 10.23919/ICIF.2017.8009820.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "subjective_logic_lib/util.hpp"
+#include "subjective_logic_lib/types/aligned_allocator.hpp"
+#include "subjective_logic_lib/opinions/opinion.hpp"
+#include "subjective_logic_lib/batch/opinion_batch.hpp"
+#include "subjective_logic_lib/multi_source/fusion_operators.hpp"
+
+namespace subjective_logic
+{
+
+/**
+ * @brief container for a large number of opinions sharing a small set of priors (base rates), e.g., the cells of a
+ * classification layer of a grid map. a batch of Opinion instances stores a prior next to the belief masses of each
+ * entry, which doubles the memory although the prior is usually identical for all entries.
+ * instead, this container stores the belief masses in an OpinionBatch and the priors in a table. each entry refers to
+ * one prior of the table by its index, as long as the table contains a single prior no index is stored at all.
+ *
+ * priors are compared with the tolerance of Opinion::operator==, i.e., adding a prior that is (almost) equal to one
+ * already present in the table reuses the existing one. results which do not share their priors, e.g., the weighted
+ * fusion of sources with different priors, store one prior per entry in the table.
+ *
+ * this container is not available with CUDA.
+ *
+ * @tparam N dimension of the subjective logic opinions (2 = Binomial, >2 = multinomial)
+ * @tparam FloatT float type of the stored belief masses and priors
+ */
+template <std::size_t N = 2, typename FloatT = float>
+class SharedPriorOpinionBatch
+{
+public:
+  using OpinionT = Opinion<N, FloatT>;
+  using OpinionNoBaseT = OpinionNoBase<N, FloatT>;
+  using BeliefType = typename OpinionT::BeliefType;
+  using OpinionBatchT = OpinionBatch<N, FloatT>;
+  using PriorIndex = std::uint32_t;
+  using FusionType = multisource::Fusion::FusionType;
+
+  // helper to have accessible types/values when used from outside;
+  using FLOAT_t = FloatT;
+  static constexpr std::size_t SIZE = N;
+  static constexpr std::size_t MAX_PRIORS = std::numeric_limits<PriorIndex>::max() + std::size_t{ 1 };
+
+  /**
+   * @brief creates an empty batch with a neutral prior
+   */
+  SharedPriorOpinionBatch();
+
+  /**
+   * @brief creates a batch of vacuous opinions sharing the given prior
+   * @param size
+   * @param prior
+   */
+  explicit SharedPriorOpinionBatch(std::size_t size, const BeliefType& prior = OpinionT::NeutralBeliefDistr());
+
+  /**
+   * @brief creates a batch of the given belief masses sharing the given prior
+   * @param masses
+   * @param prior
+   */
+  explicit SharedPriorOpinionBatch(OpinionBatchT masses, const BeliefType& prior = OpinionT::NeutralBeliefDistr());
+
+  /**
+   * @brief creates a batch from opinions stored as array of structs, equal priors are only stored once
+   * @param opinions
+   */
+  explicit SharedPriorOpinionBatch(const std::vector<OpinionT>& opinions);
+
+  /**
+   * @brief number of opinions stored in the batch
+   */
+  [[nodiscard]] std::size_t size() const;
+
+  /**
+   * @brief checks if the batch contains any opinion
+   */
+  [[nodiscard]] bool empty() const;
+
+  /**
+   * @brief belief masses of all entries, operators of OpinionBatch (e.g. trust discounting) can be applied directly
+   */
+  OpinionBatchT& masses();
+  [[nodiscard]] const OpinionBatchT& masses() const;
+
+  /**
+   * @brief number of priors in the table
+   */
+  [[nodiscard]] std::size_t num_priors() const;
+
+  /**
+   * @brief prior of the table at the given index
+   */
+  [[nodiscard]] const BeliefType& prior(std::size_t prior_idx) const;
+
+  /**
+   * @brief overwrites a prior of the table, which changes the prior of all entries referring to it
+   */
+  void set_prior(std::size_t prior_idx, const BeliefType& prior);
+
+  /**
+   * @brief index of the given prior within the table, the prior is appended if it is not present yet
+   */
+  PriorIndex find_or_add_prior(const BeliefType& prior);
+
+  /**
+   * @brief index of the prior used by the given entry
+   */
+  [[nodiscard]] PriorIndex prior_index(std::size_t idx) const;
+
+  /**
+   * @brief lets the given entry refer to another prior of the table
+   */
+  void set_prior_index(std::size_t idx, PriorIndex prior_idx);
+
+  /**
+   * @brief gathers the opinion (belief masses and prior) at the given index
+   */
+  [[nodiscard]] OpinionT get(std::size_t idx) const;
+  [[nodiscard]] OpinionT operator[](std::size_t idx) const;
+
+  /**
+   * @brief scatters the given opinion to the given index, its prior is added to the table if necessary
+   */
+  void set(std::size_t idx, const OpinionT& opinion);
+
+  /**
+   * @brief overwrites the belief masses of the given entry, the prior of the entry is kept
+   */
+  void set(std::size_t idx, const OpinionNoBaseT& opinion);
+
+  /**
+   * @brief projected probabilities of one hypothesis for all entries (see Opinion::getProjection)
+   * @param mass_idx - hypothesis, must be smaller than N
+   */
+  [[nodiscard]] AlignedVector<FloatT> getProjection(std::size_t mass_idx) const;
+  /**
+   * @brief writes the projected probabilities of one hypothesis for the entries [first, last) to out[first, last)
+   */
+  void getProjection(FloatT* out, std::size_t mass_idx, std::size_t first, std::size_t last) const;
+
+  /**
+   * @brief projected probabilities of all entries of binomial opinions (see Opinion::getBinomialProjection)
+   */
+  [[nodiscard]] AlignedVector<FloatT> getBinomialProjection() const
+    requires is_binomial<N>;
+
+  /**
+   * @brief degree of conflict [1] between the respective entries of this and other,
+   *        the projections of each side use their own priors
+   * @param other - batch of the same size
+   */
+  [[nodiscard]] AlignedVector<FloatT> degree_of_conflict(const SharedPriorOpinionBatch& other) const;
+  /**
+   * @brief writes the degree of conflict of the entries [first, last) to out[first, last)
+   */
+  void degree_of_conflict(FloatT* out, const SharedPriorOpinionBatch& other, std::size_t first, std::size_t last) const;
+
+  /**
+   * @brief multi-source fusion [2] of the respective entries of all sources, see multisource::Fusion::fuse_opinions.
+   *        the belief masses are fused directly on the lanes, the prior of each entry is the average of the priors of
+   *        the sources, weighted by their confidence for the weighted fusion
+   *        (i.e., if all sources share a prior, the result shares the same prior). the averaged priors are added to
+   *        the table once per combination of source priors, the weighted priors of entries whose sources differ in
+   *        their priors are added per entry
+   * @param fusion_type
+   * @param sources - batches of the same size
+   */
+  static SharedPriorOpinionBatch fuse_opinions(FusionType fusion_type,
+                                               const std::vector<SharedPriorOpinionBatch>& sources);
+
+protected:
+  static bool same_prior(const BeliefType& prior, const BeliefType& other);
+
+  /**
+   * @brief appends a prior to the table without searching for an equal one
+   */
+  PriorIndex add_prior(const BeliefType& prior);
+
+  /**
+   * @brief fuses the belief masses of all sources for the entries [first, last) according to the multi-source
+   *        fusion operators of [2], see OpinionBatch::fuse_opinions_
+   */
+  static void fuse_masses(OpinionBatchT& out,
+                          const std::vector<SharedPriorOpinionBatch>& sources,
+                          FusionType fusion_type,
+                          std::size_t first,
+                          std::size_t last);
+
+  OpinionBatchT masses_;
+  std::vector<BeliefType> priors_;
+  // empty as long as the table contains a single prior
+  AlignedVector<PriorIndex> prior_indices_;
+};
+
+template <std::size_t N, typename FloatT>
+SharedPriorOpinionBatch<N, FloatT>::SharedPriorOpinionBatch()
+  : SharedPriorOpinionBatch(std::size_t{ 0 })
+{
+}
+
+template <std::size_t N, typename FloatT>
+SharedPriorOpinionBatch<N, FloatT>::SharedPriorOpinionBatch(std::size_t size, const BeliefType& prior)
+  : masses_{ size }, priors_{ prior }
+{
+}
+
+template <std::size_t N, typename FloatT>
+SharedPriorOpinionBatch<N, FloatT>::SharedPriorOpinionBatch(OpinionBatchT masses, const BeliefType& prior)
+  : masses_{ std::move(masses) }, priors_{ prior }
+{
+}
+
+template <std::size_t N, typename FloatT>
+SharedPriorOpinionBatch<N, FloatT>::SharedPriorOpinionBatch(const std::vector<OpinionT>& opinions)
+  : masses_{ opinions.size() }
+{
+  priors_.push_back(opinions.empty() ? OpinionT::NeutralBeliefDistr() : opinions.front().prior_belief_masses());
+  for (std::size_t idx{ 0 }; idx < opinions.size(); ++idx)
+  {
+    set(idx, opinions[idx]);
+  }
+}
+
+template <std::size_t N, typename FloatT>
+std::size_t SharedPriorOpinionBatch<N, FloatT>::size() const
+{
+  return masses_.size();
+}
+
+template <std::size_t N, typename FloatT>
+bool SharedPriorOpinionBatch<N, FloatT>::empty() const
+{
+  return masses_.empty();
+}
+
+template <std::size_t N, typename FloatT>
+typename SharedPriorOpinionBatch<N, FloatT>::OpinionBatchT& SharedPriorOpinionBatch<N, FloatT>::masses()
+{
+  return masses_;
+}
+
+template <std::size_t N, typename FloatT>
+const typename SharedPriorOpinionBatch<N, FloatT>::OpinionBatchT& SharedPriorOpinionBatch<N, FloatT>::masses() const
+{
+  return masses_;
+}
+
+template <std::size_t N, typename FloatT>
+std::size_t SharedPriorOpinionBatch<N, FloatT>::num_priors() const
+{
+  return priors_.size();
+}
+
+template <std::size_t N, typename FloatT>
+const typename SharedPriorOpinionBatch<N, FloatT>::BeliefType&
+SharedPriorOpinionBatch<N, FloatT>::prior(std::size_t prior_idx) const
+{
+  assert(prior_idx < priors_.size());
+  return priors_[prior_idx];
+}
+
+template <std::size_t N, typename FloatT>
+void SharedPriorOpinionBatch<N, FloatT>::set_prior(std::size_t prior_idx, const BeliefType& prior)
+{
+  assert(prior_idx < priors_.size());
+  priors_[prior_idx] = prior;
+}
+
+template <std::size_t N, typename FloatT>
+bool SharedPriorOpinionBatch<N, FloatT>::same_prior(const BeliefType& prior, const BeliefType& other)
+{
+  // same tolerance as Opinion::operator==
+  FloatT diff{ 0. };
+  constexpr_for<0, N, 1>([&](std::size_t idx) { diff += std::abs(prior[idx] - other[idx]); });
+  return diff < EPS_v<FloatT>;
+}
+
+template <std::size_t N, typename FloatT>
+typename SharedPriorOpinionBatch<N, FloatT>::PriorIndex
+SharedPriorOpinionBatch<N, FloatT>::find_or_add_prior(const BeliefType& prior)
+{
+  for (std::size_t prior_idx{ 0 }; prior_idx < priors_.size(); ++prior_idx)
+  {
+    if (same_prior(priors_[prior_idx], prior))
+    {
+      return static_cast<PriorIndex>(prior_idx);
+    }
+  }
+  return add_prior(prior);
+}
+
+template <std::size_t N, typename FloatT>
+typename SharedPriorOpinionBatch<N, FloatT>::PriorIndex
+SharedPriorOpinionBatch<N, FloatT>::add_prior(const BeliefType& prior)
+{
+  if (priors_.size() == MAX_PRIORS)
+  {
+    throw std::length_error{ "a SharedPriorOpinionBatch supports at most " + std::to_string(MAX_PRIORS) + " priors" };
+  }
+  priors_.push_back(prior);
+  return static_cast<PriorIndex>(priors_.size() - 1);
+}
+
+template <std::size_t N, typename FloatT>
+typename SharedPriorOpinionBatch<N, FloatT>::PriorIndex
+SharedPriorOpinionBatch<N, FloatT>::prior_index(std::size_t idx) const
+{
+  assert(idx < size());
+  return prior_indices_.empty() ? PriorIndex{ 0 } : prior_indices_[idx];
+}
+
+template <std::size_t N, typename FloatT>
+void SharedPriorOpinionBatch<N, FloatT>::set_prior_index(std::size_t idx, PriorIndex prior_idx)
+{
+  assert(idx < size() and prior_idx < priors_.size());
+  if (prior_indices_.empty())
+  {
+    if (prior_idx == 0)
+    {
+      return;
+    }
+    // the first entry referring to another prior requires an index per entry
+    prior_indices_.assign(size(), PriorIndex{ 0 });
+  }
+  prior_indices_[idx] = prior_idx;
+}
+
+template <std::size_t N, typename FloatT>
+typename SharedPriorOpinionBatch<N, FloatT>::OpinionT SharedPriorOpinionBatch<N, FloatT>::get(std::size_t idx) const
+{
+  return OpinionT{ masses_.get(idx), priors_[prior_index(idx)] };
+}
+
+template <std::size_t N, typename FloatT>
+typename SharedPriorOpinionBatch<N, FloatT>::OpinionT
+SharedPriorOpinionBatch<N, FloatT>::operator[](std::size_t idx) const
+{
+  return get(idx);
+}
+
+template <std::size_t N, typename FloatT>
+void SharedPriorOpinionBatch<N, FloatT>::set(std::size_t idx, const OpinionT& opinion)
+{
+  masses_.set(idx, OpinionNoBaseT{ opinion.belief_masses() });
+  set_prior_index(idx, find_or_add_prior(opinion.prior_belief_masses()));
+}
+
+template <std::size_t N, typename FloatT>
+void SharedPriorOpinionBatch<N, FloatT>::set(std::size_t idx, const OpinionNoBaseT& opinion)
+{
+  masses_.set(idx, opinion);
+}
+
+template <std::size_t N, typename FloatT>
+AlignedVector<FloatT> SharedPriorOpinionBatch<N, FloatT>::getProjection(std::size_t mass_idx) const
+{
+  AlignedVector<FloatT> out(size());
+  getProjection(out.data(), mass_idx, 0, size());
+  return out;
+}
+
+template <std::size_t N, typename FloatT>
+void SharedPriorOpinionBatch<N, FloatT>::getProjection(FloatT* out,
+                                                       std::size_t mass_idx,
+                                                       std::size_t first,
+                                                       std::size_t last) const
+{
+  assert(mass_idx < N and last <= size());
+  const FloatT* belief = masses_.lane(mass_idx);
+  if (prior_indices_.empty())
+  {
+    // a single base rate for all entries keeps the loop free of any gather
+    FloatT base_rate = priors_.front()[mass_idx];
+    for (std::size_t idx{ first }; idx < last; ++idx)
+    {
+      out[idx] = belief[idx] + masses_.uncertainty(idx) * base_rate;
+    }
+    return;
+  }
+  for (std::size_t idx{ first }; idx < last; ++idx)
+  {
+    out[idx] = belief[idx] + masses_.uncertainty(idx) * priors_[prior_indices_[idx]][mass_idx];
+  }
+}
+
+template <std::size_t N, typename FloatT>
+AlignedVector<FloatT> SharedPriorOpinionBatch<N, FloatT>::getBinomialProjection() const
+  requires is_binomial<N>
+{
+  return getProjection(0);
+}
+
+template <std::size_t N, typename FloatT>
+AlignedVector<FloatT> SharedPriorOpinionBatch<N, FloatT>::degree_of_conflict(const SharedPriorOpinionBatch& other) const
+{
+  AlignedVector<FloatT> out(size());
+  degree_of_conflict(out.data(), other, 0, size());
+  return out;
+}
+
+template <std::size_t N, typename FloatT>
+void SharedPriorOpinionBatch<N, FloatT>::degree_of_conflict(FloatT* out,
+                                                            const SharedPriorOpinionBatch& other,
+                                                            std::size_t first,
+                                                            std::size_t last) const
+{
+  assert(last <= size() and last <= other.size());
+  for (std::size_t idx{ first }; idx < last; ++idx)
+  {
+    FloatT uncert_this = masses_.uncertainty(idx);
+    FloatT uncert_other = other.masses_.uncertainty(idx);
+    const BeliefType& prior_this = priors_[prior_index(idx)];
+    const BeliefType& prior_other = other.priors_[other.prior_index(idx)];
+
+    // see OpinionNoBase::degree_of_conflict, for binomial opinions the distance of the projections of both
+    // hypotheses is equal, thus, the halved sum over both equals the distance of the first one
+    FloatT proj_prob_distance{ 0. };
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+      FloatT prob_this = masses_.lane(mass_idx)[idx] + uncert_this * prior_this[mass_idx];
+      FloatT prob_other = other.masses_.lane(mass_idx)[idx] + uncert_other * prior_other[mass_idx];
+      proj_prob_distance += std::abs(prob_this - prob_other);
+    });
+    proj_prob_distance /= 2;
+
+    out[idx] = proj_prob_distance * (1 - uncert_this) * (1 - uncert_other);
+  }
+}
+
+template <std::size_t N, typename FloatT>
+void SharedPriorOpinionBatch<N, FloatT>::fuse_masses(OpinionBatchT& out,
+                                                     const std::vector<SharedPriorOpinionBatch>& sources,
+                                                     FusionType fusion_type,
+                                                     std::size_t first,
+                                                     std::size_t last)
+{
+  std::vector<typename OpinionBatchT::ConstLaneType> source_lanes;
+  source_lanes.reserve(sources.size());
+  for (const auto& source : sources)
+  {
+    source_lanes.push_back(source.masses_.lanes());
+  }
+  out.fuse_opinions_(fusion_type, source_lanes, first, last);
+}
+
+template <std::size_t N, typename FloatT>
+SharedPriorOpinionBatch<N, FloatT>
+SharedPriorOpinionBatch<N, FloatT>::fuse_opinions(FusionType fusion_type,
+                                                  const std::vector<SharedPriorOpinionBatch>& sources)
+{
+  if (sources.empty())
+  {
+    throw std::invalid_argument{ "multi-source fusion requires at least one source" };
+  }
+  const std::size_t size = sources.front().size();
+  for (const auto& source : sources)
+  {
+    if (source.size() != size)
+    {
+      throw std::invalid_argument{ "all sources of a multi-source fusion must have the same size" };
+    }
+  }
+
+  SharedPriorOpinionBatch result{ size, sources.front().priors_.front() };
+  switch (fusion_type)
+  {
+    case FusionType::CUMULATIVE:
+    case FusionType::BELIEF_CONSTRAINT:
+    case FusionType::AVERAGE:
+    case FusionType::WEIGHTED:
+    case FusionType::CONSENSUS_COMPROMISE:
+    {
+      fuse_masses(result.masses_, sources, fusion_type, 0, size);
+      break;
+    }
+    default:
+    {
+      throw std::logic_error{ "MultiSource fusion is not yet implemented for: " +
+                              std::to_string(static_cast<int>(fusion_type)) };
+    }
+  }
+
+  // the priors are averaged over all sources (see multisource::Fusion::average_prior), the weighted fusion weights
+  // them by the confidence of each source (see multisource::Fusion::weighted_prior).
+  // entries where all sources share a prior keep it without any rounding
+  bool shared_layout = std::all_of(sources.begin(), sources.end(), [&](const SharedPriorOpinionBatch& source) {
+    return source.prior_indices_.empty() and same_prior(source.priors_.front(), sources.front().priors_.front());
+  });
+  if (shared_layout)
+  {
+    return result;
+  }
+  // the averaged prior only depends on the priors of the sources, thus, it is looked up once per combination of
+  // their indices instead of searching the table for each entry
+  std::map<std::vector<PriorIndex>, PriorIndex> combination_priors;
+  std::vector<PriorIndex> combination(sources.size());
+  for (std::size_t idx{ 0 }; idx < size; ++idx)
+  {
+    const BeliefType& first_prior = sources.front().prior(sources.front().prior_index(idx));
+    BeliefType prior{ 0. };
+    BeliefType weighted_prior{ 0. };
+    FloatT confidence_sum{ 0. };
+    bool equal_priors{ true };
+    for (std::size_t source_idx{ 0 }; source_idx < sources.size(); ++source_idx)
+    {
+      const auto& source = sources[source_idx];
+      combination[source_idx] = source.prior_index(idx);
+      const BeliefType& source_prior = source.prior(combination[source_idx]);
+      const FloatT confidence = static_cast<FloatT>(1.) - source.masses_.uncertainty(idx);
+      equal_priors = equal_priors and same_prior(source_prior, first_prior);
+      prior += source_prior;
+      weighted_prior += source_prior * confidence;
+      confidence_sum += confidence;
+    }
+    if (not equal_priors and fusion_type == FusionType::WEIGHTED and confidence_sum >= EPS_v<FloatT>)
+    {
+      // the weighted prior depends on the confidences of the entry, i.e., it is (almost) never shared
+      result.set_prior_index(idx, result.add_prior(weighted_prior / confidence_sum));
+      continue;
+    }
+
+    auto combination_it = combination_priors.find(combination);
+    if (combination_it == combination_priors.end())
+    {
+      prior = equal_priors ? first_prior : prior / static_cast<FloatT>(sources.size());
+      combination_it = combination_priors.emplace(combination, result.find_or_add_prior(prior)).first;
+    }
+    result.set_prior_index(idx, combination_it->second);
+  }
+  return result;
+}
+
+}  // namespace subjective_logic
@@ -0,0 +1,559 @@
+#pragma once
+
+// the reader is invited to refer to the following book as reference for the implementations within this file:
+// [1] Subjective Logic - A Formalism for Reasoning Under Uncertainty,
+// Audun Jøsang, 2016, https://doi.org/10.1007/978-3-319-42337-1
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+
+#include "subjective_logic_lib/util.hpp"
+
+// explicit vectorization relies on the parallelism TS (std::experimental::simd).
+// it can be disabled by defining SUBJECTIVE_LOGIC_DISABLE_SIMD, in this case the scalar kernels are used.
+#if not defined(SUBJECTIVE_LOGIC_DISABLE_SIMD) and not defined(__CUDACC__) and __has_include(<experimental/simd>)
+#include <experimental/simd>
+#define SUBJECTIVE_LOGIC_SIMD_AVAIL 1
+#else
+#define SUBJECTIVE_LOGIC_SIMD_AVAIL 0
+#endif
+
+namespace subjective_logic::batch_kernels
+{
+
+/**
+ * @brief element access and blending for one cell at a time, used for the remainder of a lane
+ *        and whenever no vector instructions are available
+ */
+template <typename FloatT>
+struct ScalarTraits
+{
+  using ValueType = FloatT;
+  using MaskType = bool;
+  static constexpr std::size_t WIDTH{ 1 };
+
+  static inline ValueType load(const FloatT* ptr)
+  {
+    return *ptr;
+  }
+  static inline void store(FloatT* ptr, ValueType value)
+  {
+    *ptr = value;
+  }
+  static inline ValueType select(MaskType mask, ValueType if_true, ValueType if_false)
+  {
+    return mask ? if_true : if_false;
+  }
+  static inline MaskType is_zero(ValueType value)
+  {
+    return std::abs(value) < EPS_v<FloatT>;
+  }
+  static inline ValueType min(ValueType value, ValueType other)
+  {
+    return std::min(value, other);
+  }
+};
+
+#if SUBJECTIVE_LOGIC_SIMD_AVAIL
+/**
+ * @brief element access and masked blending for WIDTH cells at once,
+ *        the native ABI is the widest vector register the compilation target supports (e.g. AVX2 or AVX-512)
+ */
+template <typename FloatT>
+struct SimdTraits
+{
+  using ValueType = std::experimental::native_simd<FloatT>;
+  using MaskType = typename ValueType::mask_type;
+  static constexpr std::size_t WIDTH{ ValueType::size() };
+
+  static inline ValueType load(const FloatT* ptr)
+  {
+    return ValueType{ ptr, std::experimental::element_aligned };
+  }
+  static inline void store(FloatT* ptr, const ValueType& value)
+  {
+    value.copy_to(ptr, std::experimental::element_aligned);
+  }
+  static inline ValueType select(const MaskType& mask, const ValueType& if_true, ValueType if_false)
+  {
+    std::experimental::where(mask, if_false) = if_true;
+    return if_false;
+  }
+  static inline MaskType is_zero(const ValueType& value)
+  {
+    return std::experimental::abs(value) < ValueType{ EPS_v<FloatT> };
+  }
+  static inline ValueType min(const ValueType& value, const ValueType& other)
+  {
+    return std::experimental::min(value, other);
+  }
+};
+#endif
+
+/**
+ * @brief number of cells processed at once by the kernels below
+ */
+template <typename FloatT>
+constexpr std::size_t simd_width()
+{
+#if SUBJECTIVE_LOGIC_SIMD_AVAIL
+  return SimdTraits<FloatT>::WIDTH;
+#else
+  return ScalarTraits<FloatT>::WIDTH;
+#endif
+}
+
+/**
+ * @brief cumulative belief fusion of [1], see OpinionNoBase::cum_fuse_
+ *        dogmatic pairs are averaged using a masked blend instead of a branch
+ */
+struct CumulativeFusion
+{
+  template <typename Traits, std::size_t N, typename FloatT>
+  static inline void apply(const std::array<FloatT*, N>& dst,
+                           const std::array<const FloatT*, N>& src_this,
+                           const std::array<const FloatT*, N>& src_other,
+                           std::size_t idx)
+  {
+    using V = typename Traits::ValueType;
+    std::array<V, N> x_this;
+    std::array<V, N> x_other;
+    V uncert_this{ 1 };
+    V uncert_other{ 1 };
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+      x_this[mass_idx] = Traits::load(src_this[mass_idx] + idx);
+      x_other[mass_idx] = Traits::load(src_other[mass_idx] + idx);
+      uncert_this -= x_this[mass_idx];
+      uncert_other -= x_other[mass_idx];
+    });
+
+    V denom = uncert_this + uncert_other - uncert_this * uncert_other;
+    auto dogmatic = Traits::is_zero(denom);
+    // the denominator of masked out cells is replaced, which avoids divisions by zero
+    denom = Traits::select(dogmatic, V{ 1 }, denom);
+
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+      V mean = (x_this[mass_idx] + x_other[mass_idx]) * V{ static_cast<FloatT>(0.5) };
+      V fused = (x_this[mass_idx] * uncert_other + x_other[mass_idx] * uncert_this) / denom;
+      Traits::store(dst[mass_idx] + idx, Traits::select(dogmatic, mean, fused));
+    });
+  }
+};
+
+/**
+ * @brief averaging belief fusion of [1], see OpinionNoBase::average_fuse_
+ *        dogmatic pairs are averaged using a masked blend instead of a branch
+ */
+struct AverageFusion
+{
+  template <typename Traits, std::size_t N, typename FloatT>
+  static inline void apply(const std::array<FloatT*, N>& dst,
+                           const std::array<const FloatT*, N>& src_this,
+                           const std::array<const FloatT*, N>& src_other,
+                           std::size_t idx)
+  {
+    using V = typename Traits::ValueType;
+    std::array<V, N> x_this;
+    std::array<V, N> x_other;
+    V uncert_this{ 1 };
+    V uncert_other{ 1 };
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+      x_this[mass_idx] = Traits::load(src_this[mass_idx] + idx);
+      x_other[mass_idx] = Traits::load(src_other[mass_idx] + idx);
+      uncert_this -= x_this[mass_idx];
+      uncert_other -= x_other[mass_idx];
+    });
+
+    V denom = uncert_this + uncert_other;
+    auto dogmatic = Traits::is_zero(denom);
+    denom = Traits::select(dogmatic, V{ 1 }, denom);
+
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+      V mean = (x_this[mass_idx] + x_other[mass_idx]) * V{ static_cast<FloatT>(0.5) };
+      V fused = (x_this[mass_idx] * uncert_other + x_other[mass_idx] * uncert_this) / denom;
+      Traits::store(dst[mass_idx] + idx, Traits::select(dogmatic, mean, fused));
+    });
+  }
+};
+
+/**
+ * @brief weighted belief fusion of [1], see OpinionNoBase::wb_fuse_
+ *        a vanishing denominator results either from two dogmatic opinions (mean) or two vacuous opinions (vacuous),
+ *        both cases are handled by masked blends
+ */
+struct WeightedFusion
+{
+  template <typename Traits, std::size_t N, typename FloatT>
+  static inline void apply(const std::array<FloatT*, N>& dst,
+                           const std::array<const FloatT*, N>& src_this,
+                           const std::array<const FloatT*, N>& src_other,
+                           std::size_t idx)
+  {
+    using V = typename Traits::ValueType;
+    std::array<V, N> x_this;
+    std::array<V, N> x_other;
+    V uncert_this{ 1 };
+    V uncert_other{ 1 };
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+      x_this[mass_idx] = Traits::load(src_this[mass_idx] + idx);
+      x_other[mass_idx] = Traits::load(src_other[mass_idx] + idx);
+      uncert_this -= x_this[mass_idx];
+      uncert_other -= x_other[mass_idx];
+    });
+
+    V uncert_prod = uncert_this * uncert_other;
+    V denom = uncert_this + uncert_other - V{ 2 } * uncert_prod;
+    auto degenerated = Traits::is_zero(denom);
+    auto dogmatic = Traits::is_zero(uncert_prod);
+    denom = Traits::select(degenerated, V{ 1 }, denom);
+
+    V weight_this = (V{ 1 } - uncert_this) * uncert_other;
+    V weight_other = (V{ 1 } - uncert_other) * uncert_this;
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+      V mean = (x_this[mass_idx] + x_other[mass_idx]) * V{ static_cast<FloatT>(0.5) };
+      V fused = (x_this[mass_idx] * weight_this + x_other[mass_idx] * weight_other) / denom;
+      V fallback = Traits::select(dogmatic, mean, V{ 0 });
+      Traits::store(dst[mass_idx] + idx, Traits::select(degenerated, fallback, fused));
+    });
+  }
+};
+
+/**
+ * @brief belief constraint fusion of [1], see OpinionNoBase::bc_fuse_
+ *        totally conflicting pairs result in a neutral belief distribution using a masked blend
+ */
+struct BeliefConstraintFusion
+{
+  template <typename Traits, std::size_t N, typename FloatT>
+  static inline void apply(const std::array<FloatT*, N>& dst,
+                           const std::array<const FloatT*, N>& src_this,
+                           const std::array<const FloatT*, N>& src_other,
+                           std::size_t idx)
+  {
+    using V = typename Traits::ValueType;
+    std::array<V, N> x_this;
+    std::array<V, N> x_other;
+    V uncert_this{ 1 };
+    V uncert_other{ 1 };
+    V agreement{ 0 };
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+      x_this[mass_idx] = Traits::load(src_this[mass_idx] + idx);
+      x_other[mass_idx] = Traits::load(src_other[mass_idx] + idx);
+      uncert_this -= x_this[mass_idx];
+      uncert_other -= x_other[mass_idx];
+      agreement += x_this[mass_idx] * x_other[mass_idx];
+    });
+
+    // the conflict sums all products of different hypotheses,
+    // i.e., the product of both belief sums without the products of the same hypotheses
+    V conflict = (V{ 1 } - uncert_this) * (V{ 1 } - uncert_other) - agreement;
+    V normalizer = V{ 1 } - conflict;
+    auto total_conflict = Traits::is_zero(normalizer);
+    normalizer = Traits::select(total_conflict, V{ 1 }, normalizer);
+
+    V neutral{ static_cast<FloatT>(1.) / N };
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+      V harmony =
+          x_this[mass_idx] * uncert_other + x_other[mass_idx] * uncert_this + x_this[mass_idx] * x_other[mass_idx];
+      Traits::store(dst[mass_idx] + idx, Traits::select(total_conflict, neutral, harmony / normalizer));
+    });
+  }
+};
+
+/**
+ * @brief applies a binary kernel to the cells [first, last) of the given lanes
+ *        full vector registers are processed first, the remaining cells are handled by the scalar version
+ * @tparam Kernel - one of the kernels above
+ * @param dst - output lanes, may alias src_this
+ * @param src_this
+ * @param src_other
+ * @param first
+ * @param last
+ */
+template <typename Kernel, std::size_t N, typename FloatT>
+inline void apply_binary(const std::array<FloatT*, N>& dst,
+                         const std::array<const FloatT*, N>& src_this,
+                         const std::array<const FloatT*, N>& src_other,
+                         std::size_t first,
+                         std::size_t last)
+{
+  std::size_t idx{ first };
+#if SUBJECTIVE_LOGIC_SIMD_AVAIL
+  constexpr std::size_t WIDTH{ SimdTraits<FloatT>::WIDTH };
+  for (; idx + WIDTH <= last; idx += WIDTH)
+  {
+    Kernel::template apply<SimdTraits<FloatT>, N, FloatT>(dst, src_this, src_other, idx);
+  }
+#endif
+  for (; idx < last; ++idx)
+  {
+    Kernel::template apply<ScalarTraits<FloatT>, N, FloatT>(dst, src_this, src_other, idx);
+  }
+}
+
+/**
+ * @brief applies a binary kernel to the cells [0, COUNT) of the given lanes, e.g., the cells of a block
+ *        if COUNT is a multiple of the vector width, only full vector registers are processed, i.e., there is no
+ *        scalar remainder. otherwise, this is the same as the runtime version above
+ * @tparam Kernel - one of the kernels above
+ * @tparam COUNT - number of cells
+ * @param dst - output lanes, may alias src_this
+ * @param src_this
+ * @param src_other
+ */
+template <typename Kernel, std::size_t COUNT, std::size_t N, typename FloatT>
+inline void apply_binary(const std::array<FloatT*, N>& dst,
+                         const std::array<const FloatT*, N>& src_this,
+                         const std::array<const FloatT*, N>& src_other)
+{
+#if SUBJECTIVE_LOGIC_SIMD_AVAIL
+  constexpr std::size_t WIDTH{ SimdTraits<FloatT>::WIDTH };
+  if constexpr (COUNT % WIDTH == 0)
+  {
+    for (std::size_t idx{ 0 }; idx < COUNT; idx += WIDTH)
+    {
+      Kernel::template apply<SimdTraits<FloatT>, N, FloatT>(dst, src_this, src_other, idx);
+    }
+  }
+  else
+  {
+    apply_binary<Kernel, N, FloatT>(dst, src_this, src_other, 0, COUNT);
+  }
+#else
+  apply_binary<Kernel, N, FloatT>(dst, src_this, src_other, 0, COUNT);
+#endif
+}
+
+/**
+ * @brief loads the belief masses of one source
+ * @return the uncertainties of the loaded cells
+ */
+template <typename Traits, std::size_t N, typename FloatT>
+inline typename Traits::ValueType load_masses(const std::array<const FloatT*, N>& src,
+                                              std::size_t idx,
+                                              std::array<typename Traits::ValueType, N>& masses)
+{
+  using V = typename Traits::ValueType;
+  V uncertainty{ 1 };
+  constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+    masses[mass_idx] = Traits::load(src[mass_idx] + idx);
+    uncertainty -= masses[mass_idx];
+  });
+  return uncertainty;
+}
+
+/**
+ * @brief multi-source fusion operators of [2] which are formulated as sums of evidence,
+ *        see multisource::Fusion::weighted_belief_sum
+ */
+enum class EvidenceFusionType
+{
+  CUMULATIVE,
+  AVERAGE,
+  WEIGHTED,
+};
+
+/**
+ * @brief cumulative, averaging or weighted belief fusion of an arbitrary number of sources,
+ *        see multisource::Fusion::fuse_opinions. if any source is dogmatic, the mean of all dogmatic sources is the
+ *        result (see multisource::Fusion::preprocess_opinions), which is blended in using a mask
+ */
+template <EvidenceFusionType FusionT>
+struct MultiSourceEvidenceFusion
+{
+  template <typename Traits, std::size_t N, typename FloatT>
+  static inline void apply(const std::array<FloatT*, N>& dst,
+                           std::span<const std::array<const FloatT*, N>> sources,
+                           std::size_t idx)
+  {
+    using V = typename Traits::ValueType;
+    std::array<V, N> fused;
+    std::array<V, N> dogmatic_sum;
+    fused.fill(V{ 0 });
+    dogmatic_sum.fill(V{ 0 });
+    V evidence_sum{ 0 };
+    V num_dogmatic{ 0 };
+    for (const auto& src : sources)
+    {
+      std::array<V, N> x;
+      V uncert = load_masses<Traits>(src, idx, x);
+      auto dogmatic = Traits::is_zero(uncert);
+      num_dogmatic += Traits::select(dogmatic, V{ 1 }, V{ 0 });
+      V inv_uncert = V{ 1 } / Traits::select(dogmatic, V{ 1 }, uncert);
+      // the weighted fusion weights each source by its confidence ratio (1 - u) / u
+      V weight = inv_uncert;
+      if constexpr (FusionT == EvidenceFusionType::WEIGHTED)
+      {
+        weight = (V{ 1 } - uncert) * inv_uncert;
+      }
+      constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+        fused[mass_idx] += x[mass_idx] * weight;
+        evidence_sum += x[mass_idx] * inv_uncert;
+        dogmatic_sum[mass_idx] += Traits::select(dogmatic, x[mass_idx], V{ 0 });
+      });
+    }
+
+    V denom = evidence_sum;
+    if constexpr (FusionT == EvidenceFusionType::CUMULATIVE)
+    {
+      denom += V{ 1 };
+    }
+    else if constexpr (FusionT == EvidenceFusionType::AVERAGE)
+    {
+      denom += V{ static_cast<FloatT>(sources.size()) };
+    }
+    // vacuous sources only, which is a vacuous result for the weighted fusion
+    auto vacuous = Traits::is_zero(denom);
+    denom = Traits::select(vacuous, V{ 1 }, denom);
+
+    auto any_dogmatic = num_dogmatic > V{ 0 };
+    num_dogmatic = Traits::select(any_dogmatic, num_dogmatic, V{ 1 });
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+      V result = Traits::select(vacuous, V{ 0 }, fused[mass_idx] / denom);
+      Traits::store(dst[mass_idx] + idx, Traits::select(any_dogmatic, dogmatic_sum[mass_idx] / num_dogmatic, result));
+    });
+  }
+};
+
+/**
+ * @brief belief constraint fusion of an arbitrary number of sources, the sources are fused sequentially starting with a
+ *        vacuous opinion (see multisource::Fusion::belief_constraint_fusion_operator and BeliefConstraintFusion).
+ *        dogmatic sources are handled as in MultiSourceEvidenceFusion
+ */
+struct MultiSourceBeliefConstraintFusion
+{
+  template <typename Traits, std::size_t N, typename FloatT>
+  static inline void apply(const std::array<FloatT*, N>& dst,
+                           std::span<const std::array<const FloatT*, N>> sources,
+                           std::size_t idx)
+  {
+    using V = typename Traits::ValueType;
+    std::array<V, N> fused;
+    std::array<V, N> dogmatic_sum;
+    fused.fill(V{ 0 });
+    dogmatic_sum.fill(V{ 0 });
+    V uncert_fused{ 1 };
+    V num_dogmatic{ 0 };
+    V neutral{ static_cast<FloatT>(1.) / N };
+    for (const auto& src : sources)
+    {
+      std::array<V, N> x;
+      V uncert = load_masses<Traits>(src, idx, x);
+      auto dogmatic = Traits::is_zero(uncert);
+      num_dogmatic += Traits::select(dogmatic, V{ 1 }, V{ 0 });
+
+      V agreement{ 0 };
+      constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+        agreement += fused[mass_idx] * x[mass_idx];
+        dogmatic_sum[mass_idx] += Traits::select(dogmatic, x[mass_idx], V{ 0 });
+      });
+      V normalizer = V{ 1 } - ((V{ 1 } - uncert_fused) * (V{ 1 } - uncert) - agreement);
+      auto total_conflict = Traits::is_zero(normalizer);
+      normalizer = Traits::select(total_conflict, V{ 1 }, normalizer);
+
+      V next_uncert{ 1 };
+      constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+        V harmony = fused[mass_idx] * uncert + x[mass_idx] * uncert_fused + fused[mass_idx] * x[mass_idx];
+        fused[mass_idx] = Traits::select(total_conflict, neutral, harmony / normalizer);
+        next_uncert -= fused[mass_idx];
+      });
+      uncert_fused = next_uncert;
+    }
+
+    auto any_dogmatic = num_dogmatic > V{ 0 };
+    num_dogmatic = Traits::select(any_dogmatic, num_dogmatic, V{ 1 });
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+      Traits::store(dst[mass_idx] + idx,
+                    Traits::select(any_dogmatic, dogmatic_sum[mass_idx] / num_dogmatic, fused[mass_idx]));
+    });
+  }
+};
+
+/**
+ * @brief consensus & compromise fusion of an arbitrary number of sources in two passes over the sources,
+ *        see multisource::Fusion::consensus_compromise_fusion_operator
+ */
+struct MultiSourceConsensusCompromiseFusion
+{
+  template <typename Traits, std::size_t N, typename FloatT>
+  static inline void apply(const std::array<FloatT*, N>& dst,
+                           std::span<const std::array<const FloatT*, N>> sources,
+                           std::size_t idx)
+  {
+    using V = typename Traits::ValueType;
+    std::array<V, N> consensus;
+    std::array<V, N> x;
+    load_masses<Traits>(sources.front(), idx, consensus);
+    for (const auto& src : sources.subspan(1))
+    {
+      load_masses<Traits>(src, idx, x);
+      constexpr_for<0, N, 1>(
+          [&](std::size_t mass_idx) { consensus[mass_idx] = Traits::min(consensus[mass_idx], x[mass_idx]); });
+    }
+    V consensus_sum{ 0 };
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) { consensus_sum += consensus[mass_idx]; });
+
+    // see Fusion::consensus_compromise_fusion_operator, the factors are divided by u_i + r_i = 1 - consensus_sum
+    V non_consensus = V{ 1 } - consensus_sum;
+    auto no_compromise = Traits::is_zero(non_consensus);
+    non_consensus = Traits::select(no_compromise, V{ 1 }, non_consensus);
+    V uncertainty_product{ 1 };
+    std::array<V, N> unchosen_products;
+    unchosen_products.fill(V{ 1 });
+    for (const auto& src : sources)
+    {
+      uncertainty_product *= load_masses<Traits>(src, idx, x);
+      constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+        unchosen_products[mass_idx] *= V{ 1 } - (x[mass_idx] - consensus[mass_idx]) / non_consensus;
+      });
+    }
+
+    V compromise_sum{ 0 };
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+      unchosen_products[mass_idx] = V{ 1 } - unchosen_products[mass_idx];
+      compromise_sum += unchosen_products[mass_idx];
+    });
+    // without any residues, the consensus is the result
+    no_compromise = no_compromise || Traits::is_zero(compromise_sum);
+    compromise_sum = Traits::select(no_compromise, V{ 1 }, compromise_sum);
+    V normalization = (non_consensus - uncertainty_product) / compromise_sum;
+    normalization = Traits::select(no_compromise, V{ 0 }, normalization);
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+      Traits::store(dst[mass_idx] + idx, consensus[mass_idx] + normalization * unchosen_products[mass_idx]);
+    });
+  }
+};
+
+/**
+ * @brief applies a multi-source kernel to the cells [first, last), each cell is fused over all sources
+ *        full vector registers are processed first, the remaining cells are handled by the scalar version
+ * @tparam Kernel - one of the multi-source kernels above
+ * @param dst - output lanes, may alias one of the sources
+ * @param sources - lanes of each source, at least one
+ * @param first
+ * @param last
+ */
+template <typename Kernel, std::size_t N, typename FloatT>
+inline void apply_multi_source(const std::array<FloatT*, N>& dst,
+                               std::span<const std::array<const FloatT*, N>> sources,
+                               std::size_t first,
+                               std::size_t last)
+{
+  std::size_t idx{ first };
+#if SUBJECTIVE_LOGIC_SIMD_AVAIL
+  constexpr std::size_t WIDTH{ SimdTraits<FloatT>::WIDTH };
+  for (; idx + WIDTH <= last; idx += WIDTH)
+  {
+    Kernel::template apply<SimdTraits<FloatT>, N, FloatT>(dst, sources, idx);
+  }
+#endif
+  for (; idx < last; ++idx)
+  {
+    Kernel::template apply<ScalarTraits<FloatT>, N, FloatT>(dst, sources, idx);
+  }
+}
+
+}  // namespace subjective_logic::batch_kernels
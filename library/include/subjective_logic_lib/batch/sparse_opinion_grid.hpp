@@ -0,0 +1,538 @@
+#pragma once
+
+// the reader is invited to refer to the following book as reference for the implementations within this file:
+// [1] Subjective Logic - A Formalism for Reasoning Under Uncertainty,
+// Audun Jøsang, 2016, https://doi.org/10.1007/978-3-319-42337-1
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "subjective_logic_lib/util.hpp"
+#include "subjective_logic_lib/types/aligned_allocator.hpp"
+#include "subjective_logic_lib/opinions/opinion_no_base.hpp"
+#include "subjective_logic_lib/batch/simd_kernels.hpp"
+
+namespace subjective_logic
+{
+
+/**
+ * @brief sparse two dimensional grid of opinions, where the vacuous opinion is the implicit value of every cell.
+ * the grid is split into blocks of BLOCK_SIZE x BLOCK_SIZE cells, only blocks containing at least one non-vacuous
+ * opinion are stored. the blocks are found using a hash map of the block coordinates, hence, the grid is unbounded
+ * (negative coordinates are valid) and memory as well as runtime scale with the observed area instead of the size of
+ * the map.
+ *
+ * each block stores its belief masses in a structure of arrays layout (one lane per hypothesis) together with an
+ * occupancy mask, a set bit marks a non-vacuous cell. vacuous cells within a block are stored as exact zeros,
+ * thus, the fusion operators can process whole blocks using the kernels of simd_kernels.hpp.
+ *
+ * since the vacuous opinion is the neutral element of cumulative, weighted and belief constraint fusion [1],
+ * these operators only touch the blocks of the other grid. averaging fusion is not neutral w.r.t. vacuous opinions,
+ * therefore, it additionally processes the blocks which are only present in this grid.
+ *
+ * operators which may turn a cell vacuous (e.g. trust discounting with a probability of 0) keep the (then empty)
+ * block, use prune() to release them.
+ *
+ * this class is not available with CUDA.
+ *
+ * @tparam N dimension of the opinions
+ * @tparam FloatT float type of the stored belief masses
+ */
+template <std::size_t N = 2, typename FloatT = float>
+class SparseOpinionGrid
+{
+public:
+  using OpinionT = OpinionNoBase<N, FloatT>;
+
+  // helper to have accessible types/values when used from outside;
+  using FLOAT_t = FloatT;
+  static constexpr std::size_t SIZE = N;
+
+  // edge length of a block in cells
+  static constexpr std::int32_t BLOCK_SIZE{ 8 };
+  // number of cells per block, equals the number of bits of the occupancy mask
+  static constexpr std::size_t BLOCK_CELLS{ BLOCK_SIZE * BLOCK_SIZE };
+  // cells are mapped to blocks by shifts and masks
+  static_assert(std::has_single_bit(static_cast<std::uint32_t>(BLOCK_SIZE)), "the block size has to be a power of two");
+  // number of bits of the cell coordinates within a block
+  static constexpr int BLOCK_SHIFT{ std::countr_zero(static_cast<std::uint32_t>(BLOCK_SIZE)) };
+
+  /**
+   * @brief coordinates of a cell
+   */
+  struct CellIndex
+  {
+    std::int32_t x;
+    std::int32_t y;
+
+    bool operator==(const CellIndex& other) const = default;
+  };
+
+  /**
+   * @brief creates a grid where all cells are vacuous
+   */
+  SparseOpinionGrid() = default;
+
+  /**
+   * @brief number of stored blocks (including blocks which became empty and have not been pruned yet)
+   */
+  [[nodiscard]] std::size_t num_blocks() const;
+
+  /**
+   * @brief number of non-vacuous cells
+   */
+  [[nodiscard]] std::size_t num_occupied_cells() const;
+
+  /**
+   * @brief checks whether all cells are vacuous
+   */
+  [[nodiscard]] bool empty() const;
+
+  /**
+   * @brief removes all blocks, i.e., sets all cells to vacuous
+   */
+  void clear();
+
+  /**
+   * @brief releases the blocks which only contain vacuous cells
+   */
+  void prune();
+
+  /**
+   * @brief opinion of a cell, vacuous if the cell has not been observed
+   * @param x
+   * @param y
+   */
+  [[nodiscard]] OpinionT get(std::int32_t x, std::int32_t y) const;
+
+  /**
+   * @brief sets the opinion of a cell, setting an unobserved cell to vacuous does not allocate a block
+   * @param x
+   * @param y
+   * @param opinion
+   */
+  void set(std::int32_t x, std::int32_t y, const OpinionT& opinion);
+
+  /**
+   * @brief calls func(x, y, opinion) for each non-vacuous cell
+   * @param func
+   */
+  template <typename Func>
+  void for_each(Func&& func) const;
+
+  /**
+   * @brief applies cumulative belief fusion cellwise (inplace), only blocks of other are processed
+   */
+  SparseOpinionGrid& cum_fuse_(const SparseOpinionGrid& other);
+  [[nodiscard]] SparseOpinionGrid cum_fuse(const SparseOpinionGrid& other) const;
+
+  /**
+   * @brief applies averaging belief fusion cellwise (inplace), the blocks of both grids are processed
+   */
+  SparseOpinionGrid& average_fuse_(const SparseOpinionGrid& other);
+  [[nodiscard]] SparseOpinionGrid average_fuse(const SparseOpinionGrid& other) const;
+
+  /**
+   * @brief applies weighted belief fusion cellwise (inplace), only blocks of other are processed
+   */
+  SparseOpinionGrid& wb_fuse_(const SparseOpinionGrid& other);
+  [[nodiscard]] SparseOpinionGrid wb_fuse(const SparseOpinionGrid& other) const;
+
+  /**
+   * @brief applies belief constraint fusion cellwise (inplace), only blocks of other are processed
+   */
+  SparseOpinionGrid& bc_fuse_(const SparseOpinionGrid& other);
+  [[nodiscard]] SparseOpinionGrid bc_fuse(const SparseOpinionGrid& other) const;
+
+  /**
+   * @brief applies trust discounting with the same probability to each non-vacuous cell (inplace)
+   * @param prop - probability that the source of the opinions is trustworthy
+   */
+  SparseOpinionGrid& trust_discount_(FloatT prop);
+  [[nodiscard]] SparseOpinionGrid trust_discount(FloatT prop) const;
+
+  /**
+   * @brief projected probabilities of all non-vacuous cells, unobserved cells implicitly project to the base rate
+   * @param base_rate
+   */
+  [[nodiscard]] std::vector<std::pair<CellIndex, FloatT>> getBinomialProjection(FloatT base_rate = 0.5) const
+    requires is_binomial<N>;
+
+  /**
+   * @brief applies a classifier to each non-vacuous cell
+   *        unobserved cells implicitly belong to classifier(OpinionT{}), which is not evaluated here
+   * @param classifier - callable mapping an OpinionT to a label
+   */
+  template <typename Classifier>
+  [[nodiscard]] auto classify(Classifier&& classifier) const
+      -> std::vector<std::pair<CellIndex, std::invoke_result_t<Classifier, OpinionT>>>;
+
+protected:
+  using LaneType = std::array<FloatT*, N>;
+  using ConstLaneType = std::array<const FloatT*, N>;
+
+  /**
+   * @brief belief masses of BLOCK_SIZE x BLOCK_SIZE cells, the cell (x, y) of a block is stored at x + BLOCK_SIZE * y
+   */
+  struct alignas(BATCH_ALIGNMENT) Block
+  {
+    std::array<std::array<FloatT, BLOCK_CELLS>, N> masses{};
+    std::uint64_t occupancy{ 0 };
+    std::uint64_t key{ 0 };
+
+    LaneType lanes();
+    [[nodiscard]] ConstLaneType lanes() const;
+    /**
+     * @brief recomputes the occupancy from the stored belief masses
+     */
+    void update_occupancy();
+  };
+
+  static std::uint64_t block_key(std::int32_t x, std::int32_t y);
+  static std::size_t cell_offset(std::int32_t x, std::int32_t y);
+  static CellIndex cell_index(const Block& block, std::size_t offset);
+
+  [[nodiscard]] const Block* find_block(std::uint64_t key) const;
+  Block& find_or_create_block(std::uint64_t key);
+
+  /**
+   * @brief applies a kernel of simd_kernels.hpp cellwise to the blocks of both grids
+   * @param vacuous_is_neutral - whether blocks only present in this grid can be skipped
+   */
+  template <typename Kernel>
+  SparseOpinionGrid& fuse_(const SparseOpinionGrid& other, bool vacuous_is_neutral);
+
+  AlignedVector<Block> blocks_;
+  std::unordered_map<std::uint64_t, std::size_t> block_indices_;
+};
+
+template <std::size_t N, typename FloatT>
+typename SparseOpinionGrid<N, FloatT>::LaneType SparseOpinionGrid<N, FloatT>::Block::lanes()
+{
+  LaneType out;
+  constexpr_for<0, N, 1>([&](std::size_t mass_idx) { out[mass_idx] = masses[mass_idx].data(); });
+  return out;
+}
+
+template <std::size_t N, typename FloatT>
+typename SparseOpinionGrid<N, FloatT>::ConstLaneType SparseOpinionGrid<N, FloatT>::Block::lanes() const
+{
+  ConstLaneType out;
+  constexpr_for<0, N, 1>([&](std::size_t mass_idx) { out[mass_idx] = masses[mass_idx].data(); });
+  return out;
+}
+
+template <std::size_t N, typename FloatT>
+void SparseOpinionGrid<N, FloatT>::Block::update_occupancy()
+{
+  occupancy = 0;
+  for (std::size_t offset{ 0 }; offset < BLOCK_CELLS; ++offset)
+  {
+    bool occupied{ false };
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) { occupied |= masses[mass_idx][offset] != 0; });
+    occupancy |= static_cast<std::uint64_t>(occupied) << offset;
+  }
+}
+
+template <std::size_t N, typename FloatT>
+std::uint64_t SparseOpinionGrid<N, FloatT>::block_key(std::int32_t x, std::int32_t y)
+{
+  // arithmetic shifts round towards negative infinity, thus, negative coordinates map to their own blocks
+  auto block_x = static_cast<std::uint32_t>(x >> BLOCK_SHIFT);
+  auto block_y = static_cast<std::uint32_t>(y >> BLOCK_SHIFT);
+  return (static_cast<std::uint64_t>(block_x) << 32) | block_y;
+}
+
+template <std::size_t N, typename FloatT>
+std::size_t SparseOpinionGrid<N, FloatT>::cell_offset(std::int32_t x, std::int32_t y)
+{
+  return static_cast<std::size_t>((x & (BLOCK_SIZE - 1)) + BLOCK_SIZE * (y & (BLOCK_SIZE - 1)));
+}
+
+template <std::size_t N, typename FloatT>
+typename SparseOpinionGrid<N, FloatT>::CellIndex SparseOpinionGrid<N, FloatT>::cell_index(const Block& block,
+                                                                                          std::size_t offset)
+{
+  auto block_x = static_cast<std::int32_t>(static_cast<std::uint32_t>(block.key >> 32));
+  auto block_y = static_cast<std::int32_t>(static_cast<std::uint32_t>(block.key));
+  return CellIndex{ block_x * BLOCK_SIZE + static_cast<std::int32_t>(offset) % BLOCK_SIZE,
+                    block_y * BLOCK_SIZE + static_cast<std::int32_t>(offset) / BLOCK_SIZE };
+}
+
+template <std::size_t N, typename FloatT>
+const typename SparseOpinionGrid<N, FloatT>::Block* SparseOpinionGrid<N, FloatT>::find_block(std::uint64_t key) const
+{
+  auto iter = block_indices_.find(key);
+  return iter == block_indices_.end() ? nullptr : &blocks_[iter->second];
+}
+
+template <std::size_t N, typename FloatT>
+typename SparseOpinionGrid<N, FloatT>::Block& SparseOpinionGrid<N, FloatT>::find_or_create_block(std::uint64_t key)
+{
+  auto [iter, inserted] = block_indices_.try_emplace(key, blocks_.size());
+  if (inserted)
+  {
+    blocks_.emplace_back();
+    blocks_.back().key = key;
+  }
+  return blocks_[iter->second];
+}
+
+template <std::size_t N, typename FloatT>
+std::size_t SparseOpinionGrid<N, FloatT>::num_blocks() const
+{
+  return blocks_.size();
+}
+
+template <std::size_t N, typename FloatT>
+std::size_t SparseOpinionGrid<N, FloatT>::num_occupied_cells() const
+{
+  std::size_t count{ 0 };
+  for (const auto& block : blocks_)
+  {
+    count += std::popcount(block.occupancy);
+  }
+  return count;
+}
+
+template <std::size_t N, typename FloatT>
+bool SparseOpinionGrid<N, FloatT>::empty() const
+{
+  return num_occupied_cells() == 0;
+}
+
+template <std::size_t N, typename FloatT>
+void SparseOpinionGrid<N, FloatT>::clear()
+{
+  blocks_.clear();
+  block_indices_.clear();
+}
+
+template <std::size_t N, typename FloatT>
+void SparseOpinionGrid<N, FloatT>::prune()
+{
+  std::size_t block_idx{ 0 };
+  while (block_idx < blocks_.size())
+  {
+    if (blocks_[block_idx].occupancy != 0)
+    {
+      ++block_idx;
+      continue;
+    }
+    // the last block takes the place of the empty one
+    block_indices_.erase(blocks_[block_idx].key);
+    if (block_idx + 1 != blocks_.size())
+    {
+      blocks_[block_idx] = blocks_.back();
+      block_indices_[blocks_[block_idx].key] = block_idx;
+    }
+    blocks_.pop_back();
+  }
+}
+
+template <std::size_t N, typename FloatT>
+typename SparseOpinionGrid<N, FloatT>::OpinionT SparseOpinionGrid<N, FloatT>::get(std::int32_t x, std::int32_t y) const
+{
+  const Block* block = find_block(block_key(x, y));
+  OpinionT out{};
+  if (block == nullptr)
+  {
+    return out;
+  }
+  std::size_t offset = cell_offset(x, y);
+  constexpr_for<0, N, 1>(
+      [&](std::size_t mass_idx) { out.belief_masses()[mass_idx] = block->masses[mass_idx][offset]; });
+  return out;
+}
+
+template <std::size_t N, typename FloatT>
+void SparseOpinionGrid<N, FloatT>::set(std::int32_t x, std::int32_t y, const OpinionT& opinion)
+{
+  bool vacuous{ true };
+  constexpr_for<0, N, 1>([&](std::size_t mass_idx) { vacuous &= opinion.belief_masses()[mass_idx] == 0; });
+
+  std::uint64_t key = block_key(x, y);
+  if (vacuous and find_block(key) == nullptr)
+  {
+    return;
+  }
+
+  Block& block = find_or_create_block(key);
+  std::size_t offset = cell_offset(x, y);
+  constexpr_for<0, N, 1>(
+      [&](std::size_t mass_idx) { block.masses[mass_idx][offset] = opinion.belief_masses()[mass_idx]; });
+  std::uint64_t bit = std::uint64_t{ 1 } << offset;
+  block.occupancy = vacuous ? block.occupancy & ~bit : block.occupancy | bit;
+}
+
+template <std::size_t N, typename FloatT>
+template <typename Func>
+void SparseOpinionGrid<N, FloatT>::for_each(Func&& func) const
+{
+  for (const auto& block : blocks_)
+  {
+    for (std::uint64_t remaining = block.occupancy; remaining != 0; remaining &= remaining - 1)
+    {
+      std::size_t offset = std::countr_zero(remaining);
+      OpinionT opinion;
+      constexpr_for<0, N, 1>(
+          [&](std::size_t mass_idx) { opinion.belief_masses()[mass_idx] = block.masses[mass_idx][offset]; });
+      CellIndex cell = cell_index(block, offset);
+      func(cell.x, cell.y, opinion);
+    }
+  }
+}
+
+template <std::size_t N, typename FloatT>
+template <typename Kernel>
+SparseOpinionGrid<N, FloatT>& SparseOpinionGrid<N, FloatT>::fuse_(const SparseOpinionGrid& other,
+                                                                  bool vacuous_is_neutral)
+{
+  if (not vacuous_is_neutral)
+  {
+    // blocks only present in this grid are fused with vacuous opinions
+    const Block vacuous{};
+    for (auto& block : blocks_)
+    {
+      const Block* other_block = other.find_block(block.key);
+      const Block& src_other = other_block == nullptr ? vacuous : *other_block;
+      batch_kernels::apply_binary<Kernel, BLOCK_CELLS, N, FloatT>(
+          block.lanes(), std::as_const(block).lanes(), src_other.lanes());
+      block.update_occupancy();
+    }
+  }
+
+  for (const auto& other_block : other.blocks_)
+  {
+    if (other_block.occupancy == 0)
+    {
+      continue;
+    }
+    bool existing = find_block(other_block.key) != nullptr;
+    if (existing and not vacuous_is_neutral)
+    {
+      // already fused above
+      continue;
+    }
+    // a new block is vacuous, fusing it with the other block is still necessary for non neutral operators
+    Block& block = find_or_create_block(other_block.key);
+    batch_kernels::apply_binary<Kernel, BLOCK_CELLS, N, FloatT>(
+        block.lanes(), std::as_const(block).lanes(), other_block.lanes());
+    block.update_occupancy();
+  }
+  return *this;
+}
+
+template <std::size_t N, typename FloatT>
+SparseOpinionGrid<N, FloatT>& SparseOpinionGrid<N, FloatT>::cum_fuse_(const SparseOpinionGrid& other)
+{
+  return fuse_<batch_kernels::CumulativeFusion>(other, true);
+}
+
+template <std::size_t N, typename FloatT>
+SparseOpinionGrid<N, FloatT> SparseOpinionGrid<N, FloatT>::cum_fuse(const SparseOpinionGrid& other) const
+{
+  return SparseOpinionGrid(*this).cum_fuse_(other);
+}
+
+template <std::size_t N, typename FloatT>
+SparseOpinionGrid<N, FloatT>& SparseOpinionGrid<N, FloatT>::average_fuse_(const SparseOpinionGrid& other)
+{
+  return fuse_<batch_kernels::AverageFusion>(other, false);
+}
+
+template <std::size_t N, typename FloatT>
+SparseOpinionGrid<N, FloatT> SparseOpinionGrid<N, FloatT>::average_fuse(const SparseOpinionGrid& other) const
+{
+  return SparseOpinionGrid(*this).average_fuse_(other);
+}
+
+template <std::size_t N, typename FloatT>
+SparseOpinionGrid<N, FloatT>& SparseOpinionGrid<N, FloatT>::wb_fuse_(const SparseOpinionGrid& other)
+{
+  return fuse_<batch_kernels::WeightedFusion>(other, true);
+}
+
+template <std::size_t N, typename FloatT>
+SparseOpinionGrid<N, FloatT> SparseOpinionGrid<N, FloatT>::wb_fuse(const SparseOpinionGrid& other) const
+{
+  return SparseOpinionGrid(*this).wb_fuse_(other);
+}
+
+template <std::size_t N, typename FloatT>
+SparseOpinionGrid<N, FloatT>& SparseOpinionGrid<N, FloatT>::bc_fuse_(const SparseOpinionGrid& other)
+{
+  return fuse_<batch_kernels::BeliefConstraintFusion>(other, true);
+}
+
+template <std::size_t N, typename FloatT>
+SparseOpinionGrid<N, FloatT> SparseOpinionGrid<N, FloatT>::bc_fuse(const SparseOpinionGrid& other) const
+{
+  return SparseOpinionGrid(*this).bc_fuse_(other);
+}
+
+template <std::size_t N, typename FloatT>
+SparseOpinionGrid<N, FloatT>& SparseOpinionGrid<N, FloatT>::trust_discount_(FloatT prop)
+{
+  for (auto& block : blocks_)
+  {
+    for (auto& lane : block.masses)
+    {
+      for (auto& mass : lane)
+      {
+        mass *= prop;
+      }
+    }
+    block.update_occupancy();
+  }
+  return *this;
+}
+
+template <std::size_t N, typename FloatT>
+SparseOpinionGrid<N, FloatT> SparseOpinionGrid<N, FloatT>::trust_discount(FloatT prop) const
+{
+  return SparseOpinionGrid(*this).trust_discount_(prop);
+}
+
+template <std::size_t N, typename FloatT>
+std::vector<std::pair<typename SparseOpinionGrid<N, FloatT>::CellIndex, FloatT>>
+SparseOpinionGrid<N, FloatT>::getBinomialProjection(FloatT base_rate) const
+  requires is_binomial<N>
+{
+  std::vector<std::pair<CellIndex, FloatT>> out;
+  out.reserve(num_occupied_cells());
+  for (const auto& block : blocks_)
+  {
+    const FloatT* belief = block.masses[0].data();
+    const FloatT* disbelief = block.masses[1].data();
+    for (std::uint64_t remaining = block.occupancy; remaining != 0; remaining &= remaining - 1)
+    {
+      std::size_t offset = std::countr_zero(remaining);
+      out.emplace_back(cell_index(block, offset),
+                       belief[offset] + (1 - belief[offset] - disbelief[offset]) * base_rate);
+    }
+  }
+  return out;
+}
+
+template <std::size_t N, typename FloatT>
+template <typename Classifier>
+auto SparseOpinionGrid<N, FloatT>::classify(Classifier&& classifier) const
+    -> std::vector<std::pair<CellIndex, std::invoke_result_t<Classifier, OpinionT>>>
+{
+  std::vector<std::pair<CellIndex, std::invoke_result_t<Classifier, OpinionT>>> out;
+  out.reserve(num_occupied_cells());
+  for_each([&](std::int32_t x, std::int32_t y, const OpinionT& opinion) {
+    out.emplace_back(CellIndex{ x, y }, classifier(opinion));
+  });
+  return out;
+}
+
+}  // namespace subjective_logic
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace subjective_logic
+{
+
+/**
+ * @brief minimal work-stealing thread pool used to process batches of opinions in parallel.
+ *        a job consists of a number of independent tasks (identified by their index). the tasks are initially
+ *        distributed in contiguous blocks to one queue per thread, each thread processes its own queue from the front
+ *        and steals from the back of the other queues once its own queue is empty.
+ *        the calling thread participates in the processing, thus, a pool with num_threads = 1 runs everything
+ *        sequentially without spawning any thread.
+ *
+ *        this class is not available with CUDA.
+ */
+class ThreadPool
+{
+public:
+  using TaskType = std::function<void(std::size_t)>;
+
+  /**
+   * @brief creates a pool using the given number of threads (including the calling thread)
+   * @param num_threads - 0 selects the number of hardware threads
+   */
+  explicit ThreadPool(std::size_t num_threads = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /**
+   * @brief number of threads processing a job (including the calling thread)
+   */
+  [[nodiscard]] std::size_t num_threads() const;
+
+  /**
+   * @brief executes task(idx) for each idx in [0, num_tasks) and blocks until all tasks are done.
+   *        the first exception thrown by a task is rethrown after all other tasks finished.
+   *        only one job is processed at a time, concurrent calls are serialized.
+   * @param num_tasks
+   * @param task
+   */
+  void parallel_for(std::size_t num_tasks, const TaskType& task);
+
+protected:
+  struct WorkQueue
+  {
+    std::mutex mutex;
+    std::deque<std::size_t> tasks;
+  };
+
+  /**
+   * @brief takes the next task of the own queue or steals one from another queue
+   * @param queue_idx - index of the queue owned by the calling thread
+   */
+  std::optional<std::size_t> next_task(std::size_t queue_idx);
+
+  /**
+   * @brief processes tasks of the current job until no task is left in any queue
+   */
+  void work(std::size_t queue_idx, const TaskType& task);
+
+  void worker_loop(std::size_t queue_idx);
+
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
+  std::vector<std::thread> workers_;
+
+  // serializes calls to parallel_for
+  std::mutex job_mutex_;
+
+  // protects the job state below, waiting and waking is done using the atomics
+  std::mutex state_mutex_;
+  const TaskType* task_{ nullptr };
+  std::atomic<std::size_t> generation_{ 0 };
+  std::atomic<std::size_t> active_workers_{ 0 };
+  std::atomic<std::size_t> remaining_tasks_{ 0 };
+  std::exception_ptr exception_;
+  bool stop_{ false };
+};
+
+inline ThreadPool::ThreadPool(std::size_t num_threads)
+{
+  if (num_threads == 0)
+  {
+    num_threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  }
+
+  for (std::size_t idx{ 0 }; idx < num_threads; ++idx)
+  {
+    queues_.push_back(std::make_unique<WorkQueue>());
+  }
+  // queue 0 belongs to the calling thread
+  for (std::size_t idx{ 1 }; idx < num_threads; ++idx)
+  {
+    workers_.emplace_back([this, idx]() { worker_loop(idx); });
+  }
+}
+
+inline ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard lock{ state_mutex_ };
+    stop_ = true;
+    ++generation_;
+  }
+  generation_.notify_all();
+  for (auto& worker : workers_)
+  {
+    worker.join();
+  }
+}
+
+inline std::size_t ThreadPool::num_threads() const
+{
+  return queues_.size();
+}
+
+inline void ThreadPool::parallel_for(std::size_t num_tasks, const TaskType& task)
+{
+  if (num_tasks == 0)
+  {
+    return;
+  }
+  if (workers_.empty() or num_tasks == 1)
+  {
+    for (std::size_t idx{ 0 }; idx < num_tasks; ++idx)
+    {
+      task(idx);
+    }
+    return;
+  }
+
+  std::lock_guard job_lock{ job_mutex_ };
+
+  // contiguous blocks keep neighboring tiles on the same thread as long as no stealing is necessary
+  std::size_t num_queues = queues_.size();
+  for (std::size_t queue_idx{ 0 }; queue_idx < num_queues; ++queue_idx)
+  {
+    std::size_t first = num_tasks * queue_idx / num_queues;
+    std::size_t last = num_tasks * (queue_idx + 1) / num_queues;
+    std::lock_guard queue_lock{ queues_[queue_idx]->mutex };
+    for (std::size_t idx{ first }; idx < last; ++idx)
+    {
+      queues_[queue_idx]->tasks.push_back(idx);
+    }
+  }
+
+  {
+    std::lock_guard lock{ state_mutex_ };
+    task_ = &task;
+    exception_ = nullptr;
+    remaining_tasks_ = num_tasks;
+    ++generation_;
+  }
+  generation_.notify_all();
+
+  work(0, task);
+
+  for (std::size_t remaining = remaining_tasks_; remaining != 0; remaining = remaining_tasks_)
+  {
+    remaining_tasks_.wait(remaining);
+  }
+
+  {
+    std::lock_guard lock{ state_mutex_ };
+    // no worker can join the job from now on
+    task_ = nullptr;
+  }
+  // workers must have left the job before the task (owned by the caller) goes out of scope
+  for (std::size_t active = active_workers_; active != 0; active = active_workers_)
+  {
+    active_workers_.wait(active);
+  }
+
+  if (exception_)
+  {
+    std::rethrow_exception(exception_);
+  }
+}
+
+inline std::optional<std::size_t> ThreadPool::next_task(std::size_t queue_idx)
+{
+  {
+    WorkQueue& own = *queues_[queue_idx];
+    std::lock_guard lock{ own.mutex };
+    if (not own.tasks.empty())
+    {
+      std::size_t task_idx = own.tasks.front();
+      own.tasks.pop_front();
+      return task_idx;
+    }
+  }
+
+  for (std::size_t offset{ 1 }; offset < queues_.size(); ++offset)
+  {
+    WorkQueue& victim = *queues_[(queue_idx + offset) % queues_.size()];
+    std::lock_guard lock{ victim.mutex };
+    if (not victim.tasks.empty())
+    {
+      std::size_t task_idx = victim.tasks.back();
+      victim.tasks.pop_back();
+      return task_idx;
+    }
+  }
+  return std::nullopt;
+}
+
+inline void ThreadPool::work(std::size_t queue_idx, const TaskType& task)
+{
+  while (auto task_idx = next_task(queue_idx))
+  {
+    try
+    {
+      task(*task_idx);
+    }
+    catch (...)
+    {
+      std::lock_guard lock{ state_mutex_ };
+      if (not exception_)
+      {
+        exception_ = std::current_exception();
+      }
+    }
+
+    if (remaining_tasks_.fetch_sub(1) == 1)
+    {
+      remaining_tasks_.notify_all();
+    }
+  }
+}
+
+inline void ThreadPool::worker_loop(std::size_t queue_idx)
+{
+  std::size_t seen_generation{ 0 };
+  while (true)
+  {
+    generation_.wait(seen_generation);
+
+    const TaskType* task{ nullptr };
+    {
+      std::lock_guard lock{ state_mutex_ };
+      if (stop_)
+      {
+        return;
+      }
+      seen_generation = generation_;
+      if (task_ == nullptr)
+      {
+        // the job has already been finished by the other threads
+        continue;
+      }
+      task = task_;
+      ++active_workers_;
+    }
+
+    work(queue_idx, *task);
+
+    if (active_workers_.fetch_sub(1) == 1)
+    {
+      active_workers_.notify_all();
+    }
+  }
+}
+
+}  // namespace subjective_logic
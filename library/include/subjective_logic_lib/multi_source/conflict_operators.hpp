@@ -4,15 +4,22 @@
 // [1] Subjective Logic - A Formalism for Reasoning Under Uncertainty,
 // Audun Jøsang, 2016, https://doi.org/10.1007/978-3-319-42337-1
 
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <cmath>
 #include <iostream>
 #include <numeric>
+#include <span>
+#include <type_traits>
 #include <vector>
 
 #include "subjective_logic_lib/util.hpp"
 #include "subjective_logic_lib/opinions/opinion.hpp"
 #include "subjective_logic_lib/opinions/trusted_opinion.hpp"
+#include "subjective_logic_lib/types/accumulator.hpp"
 #include "subjective_logic_lib/multi_source/fusion_operators.hpp"
+#include "subjective_logic_lib/multi_source/workspace.hpp"
 
 namespace subjective_logic::multisource
 {
@@ -51,6 +58,45 @@ struct Conflict
                                                     std::optional<std::vector<bool>> use_opinion = std::nullopt)
     requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
 
+  /**
+   * conflict of the opinions of a contiguous range without copying them, no heap allocation is performed
+   * @tparam OpinionT
+   * @param conflict_type
+   * @param opinions
+   * @return
+   */
+  template <typename OpinionT>
+  static inline typename OpinionT::FLOAT_t conflict(ConflictType conflict_type, std::span<const OpinionT> opinions)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * same as above, the belief conflict types use the given reference fusion instead of fusing the opinions again,
+   * e.g., the reference fusion of an EvaluationContext shared with other operators
+   * @tparam OpinionT
+   * @param conflict_type
+   * @param opinions
+   * @param reference_fusion - fusion of the opinions with get_belief_fusion_type(conflict_type), only used by the
+   *                           belief conflict types
+   * @return
+   */
+  template <typename OpinionT>
+  static inline typename OpinionT::FLOAT_t conflict(ConflictType conflict_type,
+                                                    std::span<const OpinionT> opinions,
+                                                    const OpinionT& reference_fusion)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * conflict of a fixed number of opinions without any heap allocation
+   * @tparam K - number of opinions
+   * @tparam OpinionT
+   * @param conflict_type
+   * @param opinions
+   * @return
+   */
+  template <std::size_t K, typename OpinionT>
+  static inline typename OpinionT::FLOAT_t conflict(ConflictType conflict_type, const Array<K, OpinionT>& opinions)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
   template <typename OpinionT>
   static inline typename OpinionT::FLOAT_t harmony(ConflictType conflict_type, std::initializer_list<OpinionT> inputs)
     requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
@@ -65,6 +111,93 @@ struct Conflict
                                                    std::optional<std::vector<bool>> use_opinion = std::nullopt)
     requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
 
+  /**
+   * harmony of the opinions of a contiguous range without copying them, no heap allocation is performed
+   * @tparam OpinionT
+   * @param conflict_type
+   * @param opinions
+   * @return
+   */
+  template <typename OpinionT>
+  static inline typename OpinionT::FLOAT_t harmony(ConflictType conflict_type, std::span<const OpinionT> opinions)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * harmony counterpart of the conflict with a given reference fusion
+   * @tparam OpinionT
+   * @param conflict_type
+   * @param opinions
+   * @param reference_fusion - fusion of the opinions with get_belief_fusion_type(conflict_type), only used by the
+   *                           belief conflict types
+   * @return
+   */
+  template <typename OpinionT>
+  static inline typename OpinionT::FLOAT_t harmony(ConflictType conflict_type,
+                                                   std::span<const OpinionT> opinions,
+                                                   const OpinionT& reference_fusion)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * harmony of a fixed number of opinions without any heap allocation
+   * @tparam K - number of opinions
+   * @tparam OpinionT
+   * @param conflict_type
+   * @param opinions
+   * @return
+   */
+  template <std::size_t K, typename OpinionT>
+  static inline typename OpinionT::FLOAT_t harmony(ConflictType conflict_type, const Array<K, OpinionT>& opinions)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * conflict of the opinions of a contiguous range with the conflict operator chosen at compile time,
+   * there is no runtime dispatch, so that the operator can be inlined,
+   * and the conflict can be evaluated at compile time
+   * @tparam ConflictT
+   * @tparam OpinionT
+   * @param opinions
+   * @return
+   */
+  template <ConflictType ConflictT, typename OpinionT>
+  CUDA_AVAIL static constexpr typename OpinionT::FLOAT_t conflict(std::span<const OpinionT> opinions)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * harmony of the opinions of a contiguous range with the conflict operator chosen at compile time
+   * @tparam ConflictT
+   * @tparam OpinionT
+   * @param opinions
+   * @return
+   */
+  template <ConflictType ConflictT, typename OpinionT>
+  CUDA_AVAIL static constexpr typename OpinionT::FLOAT_t harmony(std::span<const OpinionT> opinions)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * conflict of a fixed number of opinions, all loops over the opinions are unrolled at compile time
+   * and no heap allocation is performed
+   * @tparam ConflictT
+   * @tparam K - number of opinions
+   * @tparam OpinionT
+   * @param opinions
+   * @return
+   */
+  template <ConflictType ConflictT, std::size_t K, typename OpinionT>
+  CUDA_AVAIL static constexpr typename OpinionT::FLOAT_t conflict(const Array<K, OpinionT>& opinions)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * harmony of a fixed number of opinions, see conflict
+   * @tparam ConflictT
+   * @tparam K - number of opinions
+   * @tparam OpinionT
+   * @param opinions
+   * @return
+   */
+  template <ConflictType ConflictT, std::size_t K, typename OpinionT>
+  CUDA_AVAIL static constexpr typename OpinionT::FLOAT_t harmony(const Array<K, OpinionT>& opinions)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
   /**
    * calculates the share to the average conflict of each opiniont
    * @tparam N
@@ -78,6 +211,116 @@ struct Conflict
   conflict_shares(ConflictType conflict_type, std::vector<OpinionT> opinions)
     requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
 
+  /**
+   * calculates the share to the average conflict of each opinion using the buffers of the given workspace
+   * @tparam RelationT
+   * @tparam OpinionT
+   * @param conflict_type
+   * @param opinions
+   * @param workspace - the returned shares refer to workspace.conflict_shares
+   * @return the average conflict and the share of each opinion to that conflict
+   */
+  template <RelationType RelationT, typename OpinionT>
+  static inline std::pair<typename OpinionT::FLOAT_t, std::span<const typename OpinionT::FLOAT_t>>
+  conflict_shares(ConflictType conflict_type, std::span<const OpinionT> opinions, Workspace<OpinionT>& workspace)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * projected probabilities used to calculate the degree of conflict and harmony, i.e., each opinion is projected
+   * using its own prior (neutral for OpinionNoBase)
+   * @tparam OpinionT
+   * @param opinion
+   * @return
+   */
+  template <typename OpinionT>
+  CUDA_AVAIL static constexpr typename OpinionT::BeliefType relation_projection(const OpinionT& opinion)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * degree of conflict (or harmony) of two opinions given by their projections and certainties (1 - u),
+   * see OpinionNoBase::degree_of_conflict. allows to reuse the projections for many pairs of opinions
+   * @tparam RelationT
+   * @tparam BeliefType
+   * @tparam FloatT
+   * @return
+   */
+  template <RelationType RelationT, typename BeliefType, typename FloatT>
+  CUDA_AVAIL static constexpr FloatT projected_relation(const BeliefType& projection,
+                                                        FloatT certainty,
+                                                        const BeliefType& projection_other,
+                                                        FloatT certainty_other);
+
+  /**
+   * number of opinions per block of pairwise_matrix, the projections of a row and a column block fit into the L1 cache
+   */
+  static constexpr std::size_t PAIRWISE_BLOCK_SIZE{ 64 };
+
+  /**
+   * pairwise conflict (or harmony) of all opinions, i.e., the symmetric matrix of degree_of_conflict
+   * (degree_of_harmony) of each pair of opinions. each pair is evaluated once and only the upper triangle
+   * (including the diagonal) is written, the lower triangle is not touched.
+   * the projections of all opinions are calculated once, the triangle is processed in blocks of
+   * PAIRWISE_BLOCK_SIZE x PAIRWISE_BLOCK_SIZE opinions to reuse them from the cache.
+   * see BatchExecutor::pairwise_matrix for a multithreaded version
+   * @tparam RelationT
+   * @tparam OpinionT
+   * @param opinions - n opinions
+   * @param matrix - row major n x n matrix
+   * @param workspace
+   */
+  template <RelationType RelationT, typename OpinionT>
+  static inline void pairwise_matrix(std::span<const OpinionT> opinions,
+                                     std::span<typename OpinionT::FLOAT_t> matrix,
+                                     Workspace<OpinionT>& workspace)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * pairwise_matrix without a reusable workspace
+   */
+  template <RelationType RelationT, typename OpinionT>
+  static inline void pairwise_matrix(std::span<const OpinionT> opinions, std::span<typename OpinionT::FLOAT_t> matrix)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * first step of pairwise_matrix, stores the projections and certainties of all opinions in the workspace
+   * @tparam OpinionT
+   * @param opinions
+   * @param workspace
+   */
+  template <typename OpinionT>
+  static inline void prepare_pairwise_matrix(std::span<const OpinionT> opinions, Workspace<OpinionT>& workspace)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * same as above for opinions which are not stored as OpinionT, e.g., rows of a foreign array
+   * @tparam OpinionT
+   * @tparam OpinionAt
+   * @param num_opinions
+   * @param opinion_at - callable returning the opinion (convertible to OpinionT) at the given index
+   * @param workspace
+   */
+  template <typename OpinionT, typename OpinionAt>
+  static inline void
+  prepare_pairwise_matrix(std::size_t num_opinions, OpinionAt&& opinion_at, Workspace<OpinionT>& workspace)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * second step of pairwise_matrix, evaluates the rows [first_row, last_row) of the upper triangle.
+   * disjoint row ranges write to disjoint parts of the matrix and may be processed in parallel
+   * @tparam RelationT
+   * @tparam OpinionT
+   * @param workspace - prepared by prepare_pairwise_matrix, only read
+   * @param matrix - row major n x n matrix
+   * @param first_row
+   * @param last_row
+   */
+  template <RelationType RelationT, typename OpinionT>
+  static inline void pairwise_matrix_rows(const Workspace<OpinionT>& workspace,
+                                          std::span<typename OpinionT::FLOAT_t> matrix,
+                                          std::size_t first_row,
+                                          std::size_t last_row)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
   /**
    * calculated all components for the belief conflict from josang.
    * the optional reference fusion is only required to implement the specific proposal of the paper....
@@ -98,6 +341,25 @@ struct Conflict
                        std::optional<OpinionT> reference_fusion = std::nullopt)
     requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
 
+  /**
+   * same as above without any allocation, the conflict of each opinion is written to conflicts
+   * @tparam RelationT
+   * @tparam OpinionT
+   * @param reference_fusion_type
+   * @param opinions
+   * @param conflicts - conflict of each opinion with the reference, may be empty if only the maximum and the average
+   *                    are required
+   * @param reference_fusion
+   * @return maximum and average conflict
+   */
+  template <RelationType RelationT, typename OpinionT>
+  static std::pair<typename OpinionT::FLOAT_t, typename OpinionT::FLOAT_t>
+  belief_conflicts(Fusion::FusionType reference_fusion_type,
+                   std::span<const OpinionT> opinions,
+                   std::span<typename OpinionT::FLOAT_t> conflicts,
+                   std::optional<OpinionT> reference_fusion = std::nullopt)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
   /**
    * calculates the uncertainty differentials for each opinion individually
    * @tparam N
@@ -110,6 +372,17 @@ struct Conflict
   static inline std::vector<typename OpinionT::FLOAT_t> uncertainty_differentials(std::vector<OpinionT> opinions)
     requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
 
+  /**
+   * same as above without any allocation
+   * @tparam OpinionT
+   * @param opinions
+   * @param differentials - output, one entry per opinion
+   */
+  template <typename OpinionT>
+  static inline void uncertainty_differentials(std::span<const OpinionT> opinions,
+                                               std::span<typename OpinionT::FLOAT_t> differentials)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
   /**
    * calculates the uncertainty differentials for each opinion individually.
    * Here, the trust of each trusted opinion is used.
@@ -123,17 +396,119 @@ struct Conflict
   uncertainty_differentials(std::vector<TrustedOpinionT> opinions)
     requires is_trusted_opinion<TrustedOpinionT>;
 
+  /**
+   * same as above without any allocation
+   * @tparam TrustedOpinionT
+   * @param opinions
+   * @param differentials - output, one entry per opinion
+   */
+  template <typename TrustedOpinionT>
+  static inline void uncertainty_differentials(std::span<const TrustedOpinionT> opinions,
+                                               std::span<typename TrustedOpinionT::OpinionT::FLOAT_t> differentials)
+    requires is_trusted_opinion<TrustedOpinionT>;
+
+  /**
+   * uncertainty differentials of given uncertainties, e.g., the trust uncertainties of an EvaluationContext
+   * @tparam FloatT
+   * @param uncertainties
+   * @param differentials - output, one entry per uncertainty
+   */
+  template <typename FloatT>
+  static inline void uncertainty_differentials(std::span<const FloatT> uncertainties, std::span<FloatT> differentials)
+    requires std::is_floating_point_v<FloatT>;
+
 protected:
-  // ConflictOperator is used internally, to type the functions for the specific operator implementation
+  /**
+   * selects the opinions flagged by use_opinion, all opinions are used if no flags are given
+   */
   template <typename OpinionT>
-  using ConflictOperator = std::function<typename OpinionT::FLOAT_t(const std::vector<OpinionT>&)>;
+  static inline std::vector<OpinionT> select_opinions(std::vector<OpinionT> opinions,
+                                                      const std::optional<std::vector<bool>>& use_opinion);
 
+  /**
+   * runtime dispatch of the conflict operators for std::span and Array
+   * @tparam RelationT
+   * @tparam OpinionRange - std::span or Array of opinions
+   * @param conflict_type
+   * @param opinions
+   * @return
+   */
+  template <RelationType RelationT, typename OpinionRange, typename OpinionT = typename OpinionRange::value_type>
+  static inline typename OpinionT::FLOAT_t function_switch(ConflictType conflict_type, const OpinionRange& opinions)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * same as function_switch, the belief conflict types use the given reference fusion
+   * @tparam RelationT
+   * @tparam OpinionT
+   * @param conflict_type
+   * @param opinions
+   * @param reference_fusion
+   * @return
+   */
   template <RelationType RelationT, typename OpinionT>
   static inline typename OpinionT::FLOAT_t function_switch(ConflictType conflict_type,
-                                                           std::vector<OpinionT> opinions,
-                                                           std::optional<std::vector<bool>> use_opinion = std::nullopt)
+                                                           std::span<const OpinionT> opinions,
+                                                           const OpinionT& reference_fusion)
     requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
 
+  /**
+   * compile time counterpart of function_switch
+   * @tparam RelationT
+   * @tparam ConflictT
+   * @tparam OpinionRange - std::span or Array of opinions
+   * @param opinions
+   * @return
+   */
+  template <RelationType RelationT,
+            ConflictType ConflictT,
+            typename OpinionRange,
+            typename OpinionT = typename OpinionRange::value_type>
+  static constexpr typename OpinionT::FLOAT_t relation(const OpinionRange& opinions)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * conflict (or harmony) of each opinion with the given reference opinion
+   * @tparam RelationT
+   * @tparam OpinionT
+   * @param reference
+   * @param opinions
+   * @param relations - output, may be empty if only the maximum and the average are required
+   * @return maximum and average relation
+   */
+  template <RelationType RelationT, typename OpinionRange, typename OpinionT = typename OpinionRange::value_type>
+  static constexpr std::pair<typename OpinionT::FLOAT_t, typename OpinionT::FLOAT_t>
+  reference_relations(const OpinionT& reference,
+                      const OpinionRange& opinions,
+                      std::span<typename OpinionT::FLOAT_t> relations)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * conflict shares of the pairwise conflict types (ACCUMULATE and AVERAGE) in O(n^2) instead of O(n^3).
+   * the relation of each pair of opinions is evaluated once and summed up for both opinions, the accumulated
+   * relation without an opinion is the accumulated relation of all opinions minus the sum of the opinion
+   * @tparam RelationT
+   * @tparam OpinionT
+   * @param conflict_type - ACCUMULATE or AVERAGE
+   * @param opinions
+   * @param workspace - the returned shares refer to workspace.conflict_shares
+   * @return the average conflict and the share of each opinion to that conflict
+   */
+  template <RelationType RelationT, typename OpinionT>
+  static inline std::pair<typename OpinionT::FLOAT_t, std::span<const typename OpinionT::FLOAT_t>>
+  pairwise_conflict_shares(ConflictType conflict_type,
+                           std::span<const OpinionT> opinions,
+                           Workspace<OpinionT>& workspace)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * uncertainty differentials of the uncertainties returned by uncertainty_function for each element of range
+   */
+  template <typename Range, typename UncertaintyFunction, typename FloatT>
+  static inline void uncertainty_differentials_(const Range& range,
+                                                UncertaintyFunction&& uncertainty_function,
+                                                std::span<FloatT> differentials);
+
   /**
    * accumulated conflict of all "connections" within the given set of opinions used
    * @tparam N - SL opinion dimension
@@ -143,8 +518,8 @@ protected:
    * @param use_opinion - flags which opinions to use
    * @return accumulated conflict
    */
-  template <RelationType RelationT, typename OpinionT>
-  static typename OpinionT::FLOAT_t accumulated_operator(std::vector<OpinionT> opinions)
+  template <RelationType RelationT, typename OpinionRange, typename OpinionT = typename OpinionRange::value_type>
+  static constexpr typename OpinionT::FLOAT_t accumulated_operator(const OpinionRange& opinions)
     requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
 
   /**
@@ -156,22 +531,23 @@ protected:
    * @param use_opinion - flags which opinions to use
    * @return averaged conflict
    */
-  template <RelationType RelationT, typename OpinionT>
-  static typename OpinionT::FLOAT_t average_operator(std::vector<OpinionT> opinions)
+  template <RelationType RelationT, typename OpinionRange, typename OpinionT = typename OpinionRange::value_type>
+  static constexpr typename OpinionT::FLOAT_t average_operator(const OpinionRange& opinions)
     requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
 
   /**
    * belief conflict using the given fusion operation to create the reference opinion
-   * @tparam N - SL opinion dimension
-   * @tparam typename OpinionT::FLOAT_t - SL opinion floating point type
-   * @tparam OpinionT - SL opinion type depending on the previous two parameters
+   * @tparam RelationT
+   * @tparam ReferenceFusionT - fusion operation of the reference opinion
+   * @tparam OpinionRange - std::span or Array of SL opinions
    * @param opinions - list of SL opinions
-   * @param use_opinion - flags which opinions to use
    * @return
    */
-  template <RelationType RelationT, typename OpinionT>
-  static typename OpinionT::FLOAT_t belief_conflict_operator(Fusion::FusionType reference_fusion_type,
-                                                             std::vector<OpinionT> opinions)
+  template <RelationType RelationT,
+            Fusion::FusionType ReferenceFusionT,
+            typename OpinionRange,
+            typename OpinionT = typename OpinionRange::value_type>
+  static constexpr typename OpinionT::FLOAT_t belief_conflict_operator(const OpinionRange& opinions)
     requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
 };
 
@@ -202,48 +578,61 @@ constexpr Fusion::FusionType Conflict::get_belief_fusion_type(ConflictType confl
     }
   }
 }
-template <Conflict::RelationType RelationT, typename OpinionT>
-inline typename OpinionT::FLOAT_t Conflict::function_switch(Conflict::ConflictType conflict_type,
-                                                            std::vector<OpinionT> opinions,
-                                                            std::optional<std::vector<bool>> use_opinion)
-  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+
+template <typename OpinionT>
+inline std::vector<OpinionT> Conflict::select_opinions(std::vector<OpinionT> opinions,
+                                                       const std::optional<std::vector<bool>>& use_opinion)
 {
-  std::vector<OpinionT> opinions_used;
-  if (use_opinion)
+  if (not use_opinion)
   {
-    // reserve the max possible number of opinions used
-    opinions_used.reserve(opinions.size());
+    return opinions;
+  }
+
+  std::vector<OpinionT> opinions_used;
+  // reserve the max possible number of opinions used
+  opinions_used.reserve(opinions.size());
 
-    assert(opinions.size() == (*use_opinion).size());
-    for (std::size_t idx{ 0 }; idx < opinions.size(); ++idx)
+  assert(opinions.size() == (*use_opinion).size());
+  for (std::size_t idx{ 0 }; idx < opinions.size(); ++idx)
+  {
+    if ((*use_opinion)[idx])
     {
-      if ((*use_opinion)[idx])
-      {
-        opinions_used.push_back(opinions[idx]);
-      }
+      opinions_used.push_back(opinions[idx]);
     }
   }
-  else
-  {
-    opinions_used = std::move(opinions);
-  }
+  return opinions_used;
+}
 
+template <Conflict::RelationType RelationT, typename OpinionRange, typename OpinionT>
+inline typename OpinionT::FLOAT_t Conflict::function_switch(Conflict::ConflictType conflict_type,
+                                                            const OpinionRange& opinions_used)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
   switch (conflict_type)
   {
     case ConflictType::ACCUMULATE:
     {
-      return accumulated_operator<RelationT>(opinions_used);
+      return relation<RelationT, ConflictType::ACCUMULATE>(opinions_used);
     }
     case ConflictType::AVERAGE:
     {
-      return average_operator<RelationT>(opinions_used);
+      return relation<RelationT, ConflictType::AVERAGE>(opinions_used);
     }
     case ConflictType::BELIEF_CUMULATIVE:
+    {
+      return relation<RelationT, ConflictType::BELIEF_CUMULATIVE>(opinions_used);
+    }
     case ConflictType::BELIEF_BELIEF_CONSTRAINT:
+    {
+      return relation<RelationT, ConflictType::BELIEF_BELIEF_CONSTRAINT>(opinions_used);
+    }
     case ConflictType::BELIEF_AVERAGE:
+    {
+      return relation<RelationT, ConflictType::BELIEF_AVERAGE>(opinions_used);
+    }
     case ConflictType::BELIEF_WEIGHTED:
     {
-      return belief_conflict_operator<RelationT>(get_belief_fusion_type(conflict_type), opinions_used);
+      return relation<RelationT, ConflictType::BELIEF_WEIGHTED>(opinions_used);
     }
     default:
     {
@@ -253,6 +642,38 @@ inline typename OpinionT::FLOAT_t Conflict::function_switch(Conflict::ConflictTy
   }
 }
 
+template <Conflict::RelationType RelationT, typename OpinionT>
+inline typename OpinionT::FLOAT_t Conflict::function_switch(Conflict::ConflictType conflict_type,
+                                                            std::span<const OpinionT> opinions,
+                                                            const OpinionT& reference_fusion)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  if (conflict_type == ConflictType::ACCUMULATE or conflict_type == ConflictType::AVERAGE)
+  {
+    return function_switch<RelationT>(conflict_type, opinions);
+  }
+  // see belief_conflict_operator
+  return reference_relations<RelationT>(reference_fusion, opinions, std::span<typename OpinionT::FLOAT_t>{}).second;
+}
+
+template <Conflict::RelationType RelationT, Conflict::ConflictType ConflictT, typename OpinionRange, typename OpinionT>
+constexpr typename OpinionT::FLOAT_t Conflict::relation(const OpinionRange& opinions)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  if constexpr (ConflictT == ConflictType::ACCUMULATE)
+  {
+    return accumulated_operator<RelationT>(opinions);
+  }
+  else if constexpr (ConflictT == ConflictType::AVERAGE)
+  {
+    return average_operator<RelationT>(opinions);
+  }
+  else
+  {
+    return belief_conflict_operator<RelationT, get_belief_fusion_type(ConflictT)>(opinions);
+  }
+}
+
 template <typename OpinionT>
 inline typename OpinionT::FLOAT_t Conflict::conflict(Conflict::ConflictType conflict_type,
                                                      std::initializer_list<OpinionT> inputs)
@@ -266,7 +687,8 @@ inline FirstType<Opinions...>::type::FLOAT_t Conflict::conflict(Conflict::Confli
                                                                 Opinions... opinions)
   requires is_opinion_no_base_list<Opinions...> or is_opinion_list<Opinions...>
 {
-  return conflict(conflict_type, { opinions... });
+  using OutType = FirstType<Opinions...>::type;
+  return conflict(conflict_type, Array<sizeof...(Opinions), OutType>{ OutType{ opinions }... });
 }
 
 template <typename OpinionT>
@@ -275,7 +697,33 @@ inline typename OpinionT::FLOAT_t Conflict::conflict(Conflict::ConflictType conf
                                                      std::optional<std::vector<bool>> use_opinion)
   requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
 {
-  return function_switch<RelationType::CONFLICT>(conflict_type, opinions, use_opinion);
+  const std::vector<OpinionT> opinions_used = select_opinions(std::move(opinions), use_opinion);
+  return function_switch<RelationType::CONFLICT>(conflict_type, std::span<const OpinionT>{ opinions_used });
+}
+
+template <typename OpinionT>
+inline typename OpinionT::FLOAT_t Conflict::conflict(Conflict::ConflictType conflict_type,
+                                                     std::span<const OpinionT> opinions)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  return function_switch<RelationType::CONFLICT>(conflict_type, opinions);
+}
+
+template <typename OpinionT>
+inline typename OpinionT::FLOAT_t Conflict::conflict(Conflict::ConflictType conflict_type,
+                                                     std::span<const OpinionT> opinions,
+                                                     const OpinionT& reference_fusion)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  return function_switch<RelationType::CONFLICT>(conflict_type, opinions, reference_fusion);
+}
+
+template <std::size_t K, typename OpinionT>
+inline typename OpinionT::FLOAT_t Conflict::conflict(Conflict::ConflictType conflict_type,
+                                                     const Array<K, OpinionT>& opinions)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  return function_switch<RelationType::CONFLICT>(conflict_type, opinions);
 }
 
 template <typename OpinionT>
@@ -291,7 +739,8 @@ inline FirstType<Opinions...>::type::FLOAT_t Conflict::harmony(Conflict::Conflic
                                                                Opinions... opinions)
   requires is_opinion_no_base_list<Opinions...> or is_opinion_list<Opinions...>
 {
-  return harmony(conflict_type, { opinions... });
+  using OutType = FirstType<Opinions...>::type;
+  return harmony(conflict_type, Array<sizeof...(Opinions), OutType>{ OutType{ opinions }... });
 }
 
 template <typename OpinionT>
@@ -300,11 +749,65 @@ inline typename OpinionT::FLOAT_t Conflict::harmony(Conflict::ConflictType confl
                                                     std::optional<std::vector<bool>> use_opinion)
   requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
 {
-  return function_switch<RelationType::HARMONY>(conflict_type, opinions, use_opinion);
+  const std::vector<OpinionT> opinions_used = select_opinions(std::move(opinions), use_opinion);
+  return function_switch<RelationType::HARMONY>(conflict_type, std::span<const OpinionT>{ opinions_used });
 }
 
-template <Conflict::RelationType RelationT, typename OpinionT>
-typename OpinionT::FLOAT_t Conflict::accumulated_operator(std::vector<OpinionT> opinions)
+template <typename OpinionT>
+inline typename OpinionT::FLOAT_t Conflict::harmony(Conflict::ConflictType conflict_type,
+                                                    std::span<const OpinionT> opinions)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  return function_switch<RelationType::HARMONY>(conflict_type, opinions);
+}
+
+template <typename OpinionT>
+inline typename OpinionT::FLOAT_t Conflict::harmony(Conflict::ConflictType conflict_type,
+                                                    std::span<const OpinionT> opinions,
+                                                    const OpinionT& reference_fusion)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  return function_switch<RelationType::HARMONY>(conflict_type, opinions, reference_fusion);
+}
+
+template <std::size_t K, typename OpinionT>
+inline typename OpinionT::FLOAT_t Conflict::harmony(Conflict::ConflictType conflict_type,
+                                                    const Array<K, OpinionT>& opinions)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  return function_switch<RelationType::HARMONY>(conflict_type, opinions);
+}
+
+template <Conflict::ConflictType ConflictT, typename OpinionT>
+constexpr typename OpinionT::FLOAT_t Conflict::conflict(std::span<const OpinionT> opinions)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  return relation<RelationType::CONFLICT, ConflictT>(opinions);
+}
+
+template <Conflict::ConflictType ConflictT, std::size_t K, typename OpinionT>
+constexpr typename OpinionT::FLOAT_t Conflict::conflict(const Array<K, OpinionT>& opinions)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  return relation<RelationType::CONFLICT, ConflictT>(opinions);
+}
+
+template <Conflict::ConflictType ConflictT, typename OpinionT>
+constexpr typename OpinionT::FLOAT_t Conflict::harmony(std::span<const OpinionT> opinions)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  return relation<RelationType::HARMONY, ConflictT>(opinions);
+}
+
+template <Conflict::ConflictType ConflictT, std::size_t K, typename OpinionT>
+constexpr typename OpinionT::FLOAT_t Conflict::harmony(const Array<K, OpinionT>& opinions)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  return relation<RelationType::HARMONY, ConflictT>(opinions);
+}
+
+template <Conflict::RelationType RelationT, typename OpinionRange, typename OpinionT>
+constexpr typename OpinionT::FLOAT_t Conflict::accumulated_operator(const OpinionRange& opinions)
   requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
 {
   if (opinions.size() < 2)
@@ -312,27 +815,48 @@ typename OpinionT::FLOAT_t Conflict::accumulated_operator(std::vector<OpinionT>
     return 0;
   }
 
-  typename OpinionT::FLOAT_t accumulated_conflict{ 0 };
-  for (std::size_t idx_outer{ 0 }; idx_outer < opinions.size(); ++idx_outer)
+  // the number of connections grows quadratically, see ACCUMULATION
+  Accumulator<typename OpinionT::FLOAT_t> accumulated_conflict;
+  auto accumulate = [&](std::size_t idx_outer, std::size_t idx_inner) {
+    if constexpr (RelationT == RelationType::CONFLICT)
+    {
+      accumulated_conflict += opinions[idx_outer].degree_of_conflict(opinions[idx_inner]);
+    }
+    else
+    {
+      accumulated_conflict += opinions[idx_outer].degree_of_harmony(opinions[idx_inner]);
+    }
+  };
+
+  if constexpr (is_fixed_size_array<OpinionRange>)
+  {
+    // same order of the connections as below, the condition is resolved at compile time after unrolling
+    constexpr std::size_t K = OpinionRange::size();
+    constexpr_for<0, K, 1>([&](std::size_t idx_outer) {
+      constexpr_for<0, K, 1>([&](std::size_t idx_inner) {
+        if (idx_inner > idx_outer)
+        {
+          accumulate(idx_outer, idx_inner);
+        }
+      });
+    });
+  }
+  else
   {
-    for (std::size_t idx_inner{ idx_outer + 1 }; idx_inner < opinions.size(); ++idx_inner)
+    for (std::size_t idx_outer{ 0 }; idx_outer < opinions.size(); ++idx_outer)
     {
-      if constexpr (RelationT == RelationType::CONFLICT)
-      {
-        accumulated_conflict += opinions[idx_outer].degree_of_conflict(opinions[idx_inner]);
-      }
-      else
+      for (std::size_t idx_inner{ idx_outer + 1 }; idx_inner < opinions.size(); ++idx_inner)
       {
-        accumulated_conflict += opinions[idx_outer].degree_of_harmony(opinions[idx_inner]);
+        accumulate(idx_outer, idx_inner);
       }
     }
   }
 
-  return accumulated_conflict;
+  return accumulated_conflict.value();
 }
 
-template <Conflict::RelationType RelationT, typename OpinionT>
-typename OpinionT::FLOAT_t Conflict::average_operator(std::vector<OpinionT> opinions)
+template <Conflict::RelationType RelationT, typename OpinionRange, typename OpinionT>
+constexpr typename OpinionT::FLOAT_t Conflict::average_operator(const OpinionRange& opinions)
   requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
 {
   std::size_t num_used = opinions.size();
@@ -348,13 +872,17 @@ typename OpinionT::FLOAT_t Conflict::average_operator(std::vector<OpinionT> opin
   return accumulated_conflict / num_connections;
 }
 
-template <Conflict::RelationType RelationT, typename OpinionT>
-typename OpinionT::FLOAT_t Conflict::belief_conflict_operator(Fusion::FusionType reference_fusion_type,
-                                                              std::vector<OpinionT> opinions)
+template <Conflict::RelationType RelationT,
+          Fusion::FusionType ReferenceFusionT,
+          typename OpinionRange,
+          typename OpinionT>
+constexpr typename OpinionT::FLOAT_t Conflict::belief_conflict_operator(const OpinionRange& opinions)
   requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
 {
   typename OpinionT::FLOAT_t avg_conflict =
-      std::get<2>(Conflict::belief_conflicts<RelationT>(reference_fusion_type, opinions));
+      Conflict::reference_relations<RelationT>(
+          Fusion::fuse<ReferenceFusionT>(opinions), opinions, std::span<typename OpinionT::FLOAT_t>{})
+          .second;
   return avg_conflict;
 }
 
@@ -363,43 +891,229 @@ std::pair<typename OpinionT::FLOAT_t, std::vector<typename OpinionT::FLOAT_t>>
 Conflict::conflict_shares(ConflictType conflict_type, std::vector<OpinionT> opinions)
   requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
 {
-  const std::size_t number_ops = opinions.size();
-  double avg_conflict;
-  if constexpr (RelationT == RelationType::CONFLICT)
+  Workspace<OpinionT> workspace;
+  auto [avg_conflict, conflict_shares] =
+      Conflict::conflict_shares<RelationT>(conflict_type, std::span<const OpinionT>{ opinions }, workspace);
+  return { avg_conflict, std::vector<typename OpinionT::FLOAT_t>(conflict_shares.begin(), conflict_shares.end()) };
+}
+
+template <Conflict::RelationType RelationT, typename OpinionT>
+std::pair<typename OpinionT::FLOAT_t, std::span<const typename OpinionT::FLOAT_t>>
+Conflict::conflict_shares(ConflictType conflict_type,
+                          std::span<const OpinionT> opinions,
+                          Workspace<OpinionT>& workspace)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  if (conflict_type == ConflictType::ACCUMULATE or conflict_type == ConflictType::AVERAGE)
   {
-    avg_conflict = Conflict::conflict(conflict_type, opinions);
+    return pairwise_conflict_shares<RelationT>(conflict_type, opinions, workspace);
   }
-  else
+
+  // the belief conflicts require a reference fusion without the respective opinion
+  const std::size_t number_ops = opinions.size();
+  auto& conflict_shares = workspace.conflict_shares;
+  double avg_conflict = function_switch<RelationT>(conflict_type, opinions);
+
+  if (avg_conflict < EPS_v<typename OpinionT::FLOAT_t>)
   {
-    avg_conflict = Conflict::harmony(conflict_type, opinions);
+    conflict_shares.assign(number_ops, 0.);
+    return { 0., conflict_shares };
   }
 
-  if (avg_conflict < EPS_v<typename OpinionT::FLOAT_t>)
+  conflict_shares.resize(number_ops);
+  for (std::size_t idx{ 0 }; idx < number_ops; ++idx)
   {
-    return { 0., std::vector<typename OpinionT::FLOAT_t>(number_ops, 0.) };
+    // all opinions except the current one
+    workspace.subset.assign(opinions.begin(), opinions.end());
+    workspace.subset.erase(workspace.subset.begin() + static_cast<std::ptrdiff_t>(idx));
+    double conflict_wo_self =
+        function_switch<RelationT>(conflict_type, std::span<const OpinionT>{ workspace.subset });
+
+    conflict_shares[idx] = 1.0 - conflict_wo_self / avg_conflict;
   }
 
-  std::vector<bool> use_opinions(number_ops, true);
-  std::vector<typename OpinionT::FLOAT_t> conflict_shares(number_ops, 0.);
+  return { avg_conflict, conflict_shares };
+}
 
-  for (std::size_t idx{ 0 }; idx < number_ops; ++idx)
+template <Conflict::RelationType RelationT, typename OpinionT>
+std::pair<typename OpinionT::FLOAT_t, std::span<const typename OpinionT::FLOAT_t>>
+Conflict::pairwise_conflict_shares(ConflictType conflict_type,
+                                   std::span<const OpinionT> opinions,
+                                   Workspace<OpinionT>& workspace)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  using FloatT = typename OpinionT::FLOAT_t;
+  using AccumulatorT = Accumulator<FloatT>;
+  using SumType = typename AccumulatorT::SumType;
+  const std::size_t number_ops = opinions.size();
+  auto& conflict_shares = workspace.conflict_shares;
+  auto& relation_sums = workspace.relation_sums;
+  relation_sums.assign(number_ops, AccumulatorT{});
+
+  // same order of the connections as accumulated_operator
+  AccumulatorT accumulated_relation;
+  for (std::size_t idx_outer{ 0 }; idx_outer < number_ops; ++idx_outer)
   {
-    use_opinions[idx] = false;
-    double conflict_wo_self;
-    if constexpr (RelationT == RelationType::CONFLICT)
+    for (std::size_t idx_inner{ idx_outer + 1 }; idx_inner < number_ops; ++idx_inner)
+    {
+      FloatT relation{ 0. };
+      if constexpr (RelationT == RelationType::CONFLICT)
+      {
+        relation = opinions[idx_outer].degree_of_conflict(opinions[idx_inner]);
+      }
+      else
+      {
+        relation = opinions[idx_outer].degree_of_harmony(opinions[idx_inner]);
+      }
+      relation_sums[idx_outer] += relation;
+      relation_sums[idx_inner] += relation;
+      accumulated_relation += relation;
+    }
+  }
+
+  // see average_operator, the number of connections of the remaining opinions is used for the average
+  auto normalize = [conflict_type](SumType accumulated, std::size_t num_used) -> SumType {
+    if (conflict_type == ConflictType::ACCUMULATE)
     {
-      conflict_wo_self = Conflict::conflict(conflict_type, opinions, use_opinions);
+      return accumulated;
     }
-    else
+    if (num_used < 2)
     {
-      conflict_wo_self = Conflict::harmony(conflict_type, opinions, use_opinions);
+      return 0;
     }
-    use_opinions[idx] = true;
+    return accumulated / static_cast<SumType>((num_used * (num_used - 1)) / 2);
+  };
 
-    conflict_shares[idx] = 1.0 - conflict_wo_self / avg_conflict;
+  const SumType avg_conflict = normalize(accumulated_relation.sum(), number_ops);
+  if (avg_conflict < EPS_v<FloatT>)
+  {
+    conflict_shares.assign(number_ops, 0.);
+    return { 0., conflict_shares };
   }
 
-  return { avg_conflict, conflict_shares };
+  conflict_shares.resize(number_ops);
+  for (std::size_t idx{ 0 }; idx < number_ops; ++idx)
+  {
+    // removing an opinion removes all of its connections
+    const SumType conflict_wo_self = normalize(accumulated_relation.sum() - relation_sums[idx].sum(), number_ops - 1);
+    conflict_shares[idx] = static_cast<FloatT>(1. - conflict_wo_self / avg_conflict);
+  }
+
+  return { static_cast<FloatT>(avg_conflict), conflict_shares };
+}
+
+template <typename OpinionT>
+constexpr typename OpinionT::BeliefType Conflict::relation_projection(const OpinionT& opinion)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  if constexpr (is_opinion<OpinionT>)
+  {
+    return opinion.getProjection();
+  }
+  else
+  {
+    return opinion.getProjection(OpinionT::NeutralBeliefDistr());
+  }
+}
+
+template <Conflict::RelationType RelationT, typename BeliefType, typename FloatT>
+constexpr FloatT Conflict::projected_relation(const BeliefType& projection,
+                                              FloatT certainty,
+                                              const BeliefType& projection_other,
+                                              FloatT certainty_other)
+{
+  // the distance of the projections times the conjunctive certainty
+  FloatT proj_prob_distance{ 0. };
+  constexpr_for<0, BeliefType::size(), 1>([&](std::size_t mass_idx) {
+    proj_prob_distance += std::abs(projection[mass_idx] - projection_other[mass_idx]);
+  });
+  proj_prob_distance /= 2.;
+  const FloatT conjunctive_certainty = certainty * certainty_other;
+  if constexpr (RelationT == RelationType::CONFLICT)
+  {
+    return proj_prob_distance * conjunctive_certainty;
+  }
+  else
+  {
+    return (1 - proj_prob_distance) * conjunctive_certainty;
+  }
+}
+
+template <Conflict::RelationType RelationT, typename OpinionT>
+void Conflict::pairwise_matrix(std::span<const OpinionT> opinions,
+                               std::span<typename OpinionT::FLOAT_t> matrix,
+                               Workspace<OpinionT>& workspace)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  prepare_pairwise_matrix(opinions, workspace);
+  pairwise_matrix_rows<RelationT>(workspace, matrix, 0, opinions.size());
+}
+
+template <Conflict::RelationType RelationT, typename OpinionT>
+void Conflict::pairwise_matrix(std::span<const OpinionT> opinions, std::span<typename OpinionT::FLOAT_t> matrix)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  Workspace<OpinionT> workspace;
+  pairwise_matrix<RelationT>(opinions, matrix, workspace);
+}
+
+template <typename OpinionT>
+void Conflict::prepare_pairwise_matrix(std::span<const OpinionT> opinions, Workspace<OpinionT>& workspace)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  prepare_pairwise_matrix(
+      opinions.size(), [&opinions](std::size_t idx) -> const OpinionT& { return opinions[idx]; }, workspace);
+}
+
+template <typename OpinionT, typename OpinionAt>
+void Conflict::prepare_pairwise_matrix(std::size_t num_opinions, OpinionAt&& opinion_at, Workspace<OpinionT>& workspace)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  workspace.projections.resize(num_opinions);
+  workspace.certainties.resize(num_opinions);
+  for (std::size_t idx{ 0 }; idx < num_opinions; ++idx)
+  {
+    const OpinionT& opinion = opinion_at(idx);
+    workspace.projections[idx] = relation_projection(opinion);
+    workspace.certainties[idx] = static_cast<typename OpinionT::FLOAT_t>(1.) - opinion.uncertainty();
+  }
+}
+
+template <Conflict::RelationType RelationT, typename OpinionT>
+void Conflict::pairwise_matrix_rows(const Workspace<OpinionT>& workspace,
+                                    std::span<typename OpinionT::FLOAT_t> matrix,
+                                    std::size_t first_row,
+                                    std::size_t last_row)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  using FloatT = typename OpinionT::FLOAT_t;
+  const std::size_t number_ops = workspace.projections.size();
+  assert(matrix.size() == number_ops * number_ops and last_row <= number_ops);
+
+  auto relation = [&workspace](std::size_t idx_row, std::size_t idx_col) {
+    return projected_relation<RelationT>(workspace.projections[idx_row],
+                                         workspace.certainties[idx_row],
+                                         workspace.projections[idx_col],
+                                         workspace.certainties[idx_col]);
+  };
+
+  for (std::size_t block_row{ first_row }; block_row < last_row; block_row += PAIRWISE_BLOCK_SIZE)
+  {
+    const std::size_t block_row_end = std::min(block_row + PAIRWISE_BLOCK_SIZE, last_row);
+    // column blocks on and right of the diagonal
+    for (std::size_t block_col{ block_row }; block_col < number_ops; block_col += PAIRWISE_BLOCK_SIZE)
+    {
+      const std::size_t block_col_end = std::min(block_col + PAIRWISE_BLOCK_SIZE, number_ops);
+      for (std::size_t idx_row{ block_row }; idx_row < block_row_end; ++idx_row)
+      {
+        FloatT* row = matrix.data() + idx_row * number_ops;
+        for (std::size_t idx_col{ std::max(block_col, idx_row) }; idx_col < block_col_end; ++idx_col)
+        {
+          row[idx_col] = relation(idx_row, idx_col);
+        }
+      }
+    }
+  }
 }
 
 template <Conflict::RelationType RelationT, typename OpinionT>
@@ -408,6 +1122,21 @@ Conflict::belief_conflicts(Fusion::FusionType reference_fusion_type,
                            std::vector<OpinionT> opinions,
                            std::optional<OpinionT> reference_fusion)
   requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  std::vector<typename OpinionT::FLOAT_t> conflicts(opinions.size());
+  auto [max_conflict, avg_conflict] = Conflict::belief_conflicts<RelationT>(
+      reference_fusion_type, std::span<const OpinionT>{ opinions }, std::span{ conflicts }, reference_fusion);
+
+  return { conflicts, max_conflict, avg_conflict };
+}
+
+template <Conflict::RelationType RelationT, typename OpinionT>
+std::pair<typename OpinionT::FLOAT_t, typename OpinionT::FLOAT_t>
+Conflict::belief_conflicts(Fusion::FusionType reference_fusion_type,
+                           std::span<const OpinionT> opinions,
+                           std::span<typename OpinionT::FLOAT_t> conflicts,
+                           std::optional<OpinionT> reference_fusion)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
 {
   OpinionT reference;
   if (reference_fusion)
@@ -419,11 +1148,22 @@ Conflict::belief_conflicts(Fusion::FusionType reference_fusion_type,
     reference = Fusion::fuse_opinions(reference_fusion_type, opinions);
   }
 
-  std::vector<typename OpinionT::FLOAT_t> conflicts;
-  conflicts.reserve(opinions.size());
-  for (auto const& opinion : opinions)
-  {
-    typename OpinionT::FLOAT_t reference_conflict;
+  return reference_relations<RelationT>(reference, opinions, conflicts);
+}
+
+template <Conflict::RelationType RelationT, typename OpinionRange, typename OpinionT>
+constexpr std::pair<typename OpinionT::FLOAT_t, typename OpinionT::FLOAT_t>
+Conflict::reference_relations(const OpinionT& reference,
+                              const OpinionRange& opinions,
+                              std::span<typename OpinionT::FLOAT_t> relations)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  assert(relations.empty() or relations.size() == opinions.size());
+  typename OpinionT::FLOAT_t max_conflict{ 0. };
+  Accumulator<typename OpinionT::FLOAT_t> acc_conflict;
+  std::size_t idx{ 0 };
+  for_each_entry(opinions, [&](const OpinionT& opinion) {
+    typename OpinionT::FLOAT_t reference_conflict{ 0. };
     if constexpr (RelationT == RelationType::CONFLICT)
     {
       reference_conflict = reference.degree_of_conflict(opinion);
@@ -432,55 +1172,93 @@ Conflict::belief_conflicts(Fusion::FusionType reference_fusion_type,
     {
       reference_conflict = reference.degree_of_harmony(opinion);
     }
-    conflicts.push_back(reference_conflict);
-  }
+    if (not relations.empty())
+    {
+      relations[idx] = reference_conflict;
+    }
+    ++idx;
 
-  typename OpinionT::FLOAT_t max_conflict{ 0. };
-  typename OpinionT::FLOAT_t acc_conflict{ 0. };
-  for (typename OpinionT::FLOAT_t conflict : conflicts)
-  {
-    if (conflict > max_conflict)
+    if (reference_conflict > max_conflict)
     {
-      max_conflict = conflict;
+      max_conflict = reference_conflict;
     }
-    acc_conflict += conflict;
-  }
-  typename OpinionT::FLOAT_t avg_conflict = acc_conflict / opinions.size();
+    acc_conflict += reference_conflict;
+  });
+  auto avg_conflict = static_cast<typename OpinionT::FLOAT_t>(acc_conflict.sum() / opinions.size());
 
-  return { conflicts, max_conflict, avg_conflict };
+  return { max_conflict, avg_conflict };
 }
 
 template <typename OpinionT>
 std::vector<typename OpinionT::FLOAT_t> Conflict::uncertainty_differentials(std::vector<OpinionT> opinions)
   requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
 {
-  double sum_of_uncertainty =
-      std::accumulate(opinions.begin(), opinions.end(), 0., [](typename OpinionT::FLOAT_t sum, OpinionT ops) {
-        return sum + ops.uncertainty();
-      });
-
-  if (sum_of_uncertainty < EPS_v<typename OpinionT::FLOAT_t>)
-  {
-    return std::vector<typename OpinionT::FLOAT_t>(opinions.size(), 0.);
-  }
-
-  std::vector<typename OpinionT::FLOAT_t> differentials;
-  differentials.reserve(opinions.size());
-
-  std::transform(opinions.begin(),
-                 opinions.end(),
-                 std::back_inserter(differentials),
-                 [sum_of_uncertainty](OpinionT ops) { return ops.uncertainty() / sum_of_uncertainty; });
-
+  std::vector<typename OpinionT::FLOAT_t> differentials(opinions.size());
+  uncertainty_differentials(std::span<const OpinionT>{ opinions }, std::span{ differentials });
   return differentials;
 }
 
+template <typename OpinionT>
+void Conflict::uncertainty_differentials(std::span<const OpinionT> opinions,
+                                         std::span<typename OpinionT::FLOAT_t> differentials)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  uncertainty_differentials_(
+      opinions, [](const OpinionT& opinion) { return opinion.uncertainty(); }, differentials);
+}
+
 template <typename TrustedOpinionT>
 std::vector<typename TrustedOpinionT::OpinionT::FLOAT_t>
 Conflict::uncertainty_differentials(std::vector<TrustedOpinionT> opinions)
   requires is_trusted_opinion<TrustedOpinionT>
 {
-  return uncertainty_differentials(TrustedOpinionT::extractTrusts(opinions));
+  std::vector<typename TrustedOpinionT::OpinionT::FLOAT_t> differentials(opinions.size());
+  uncertainty_differentials(std::span<const TrustedOpinionT>{ opinions }, std::span{ differentials });
+  return differentials;
+}
+
+template <typename TrustedOpinionT>
+void Conflict::uncertainty_differentials(std::span<const TrustedOpinionT> opinions,
+                                         std::span<typename TrustedOpinionT::OpinionT::FLOAT_t> differentials)
+  requires is_trusted_opinion<TrustedOpinionT>
+{
+  // the differentials of the trusts of all trusted opinions
+  uncertainty_differentials_(
+      opinions, [](const TrustedOpinionT& opinion) { return opinion.trust().uncertainty(); }, differentials);
+}
+
+template <typename FloatT>
+void Conflict::uncertainty_differentials(std::span<const FloatT> uncertainties, std::span<FloatT> differentials)
+  requires std::is_floating_point_v<FloatT>
+{
+  uncertainty_differentials_(
+      uncertainties, [](FloatT uncertainty) { return uncertainty; }, differentials);
+}
+
+template <typename Range, typename UncertaintyFunction, typename FloatT>
+void Conflict::uncertainty_differentials_(const Range& range,
+                                          UncertaintyFunction&& uncertainty_function,
+                                          std::span<FloatT> differentials)
+{
+  assert(differentials.size() == range.size());
+  Accumulator<FloatT> uncertainty_sum;
+  for (const auto& element : range)
+  {
+    uncertainty_sum += uncertainty_function(element);
+  }
+  const FloatT sum_of_uncertainty = uncertainty_sum.value();
+
+  if (sum_of_uncertainty < EPS_v<FloatT>)
+  {
+    std::fill(differentials.begin(), differentials.end(), 0.);
+    return;
+  }
+
+  std::size_t idx{ 0 };
+  for (const auto& element : range)
+  {
+    differentials[idx++] = uncertainty_function(element) / static_cast<double>(sum_of_uncertainty);
+  }
 }
 
 }  // namespace subjective_logic::multisource
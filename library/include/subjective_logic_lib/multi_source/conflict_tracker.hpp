@@ -0,0 +1,263 @@
+#pragma once
+
+// the reader is invited to refer to the following book as reference for the implementations within this file:
+// [1] Subjective Logic - A Formalism for Reasoning Under Uncertainty,
+// Audun Jøsang, 2016, https://doi.org/10.1007/978-3-319-42337-1
+
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "subjective_logic_lib/util.hpp"
+#include "subjective_logic_lib/types/accumulator.hpp"
+#include "subjective_logic_lib/opinions/opinion.hpp"
+#include "subjective_logic_lib/multi_source/conflict_operators.hpp"
+
+namespace subjective_logic::multisource
+{
+
+/**
+ * @brief stateful counterpart of the pairwise conflict operators (ACCUMULATE and AVERAGE) of Conflict for a fixed set
+ * of sources, e.g., the agents of a persistent trust network of which only few update their opinions per time step.
+ * the tracker keeps the projection of each source, the relation of each pair of sources and the sum of the relations
+ * of each source. updating a single source only re-evaluates its relations, i.e., O(n * N) instead of the
+ * O(n^2 * N) of Conflict::conflict, the accumulated and average relation and the conflict shares are available in
+ * O(1).
+ *
+ * the sums are accumulated according to the accumulation policy of FloatT (see Accumulator), as within
+ * Conflict::conflict_shares, and are recalculated from the relations after every n updates, so that many updates do
+ * not drift.
+ *
+ * @tparam OpinionT - Opinion or OpinionNoBase
+ * @tparam RelationT - CONFLICT or HARMONY
+ */
+template <typename OpinionT, Conflict::RelationType RelationT = Conflict::RelationType::CONFLICT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+class ConflictTracker
+{
+public:
+  using FloatT = typename OpinionT::FLOAT_t;
+  using BeliefType = typename OpinionT::BeliefType;
+  using AccumulatorT = Accumulator<FloatT>;
+  using SumType = typename AccumulatorT::SumType;
+
+  ConflictTracker() = default;
+
+  /**
+   * @brief creates a tracker of the given sources, see reset
+   * @param opinions
+   */
+  explicit ConflictTracker(std::span<const OpinionT> opinions);
+
+  /**
+   * @brief replaces all sources, evaluates the relations of all pairs, O(n^2 * N)
+   * @param opinions - opinion of each source, the index of an opinion identifies its source afterwards
+   */
+  void reset(std::span<const OpinionT> opinions);
+
+  /**
+   * @brief updates the opinion of a single source, amortized O(n * N) as the sums are recalculated after n updates
+   * @param idx - index of the source
+   * @param opinion - the new opinion of the source
+   */
+  void update(std::size_t idx, const OpinionT& opinion);
+
+  /**
+   * @brief number of sources
+   */
+  [[nodiscard]] std::size_t size() const;
+
+  /**
+   * @brief degree of conflict (or harmony) of two sources, O(1)
+   */
+  [[nodiscard]] FloatT relation(std::size_t idx, std::size_t idx_other) const;
+
+  /**
+   * @brief accumulated relation of all pairs of sources, equals Conflict::conflict(ACCUMULATE, sources), O(1)
+   */
+  [[nodiscard]] FloatT accumulated() const;
+
+  /**
+   * @brief average relation of all pairs of sources, equals Conflict::conflict(AVERAGE, sources), O(1)
+   */
+  [[nodiscard]] FloatT average() const;
+
+  /**
+   * @brief share of a source to the average relation, equals the respective entry of
+   * Conflict::conflict_shares(AVERAGE, sources), e.g., as required by TrustRevision::CONFLICT_SHARES, O(1).
+   * the shares of the other conflict types are not tracked
+   * @param idx - index of the source
+   */
+  [[nodiscard]] FloatT share(std::size_t idx) const;
+
+protected:
+  /**
+   * @brief recalculates all sums from the relations, O(n^2)
+   */
+  void resync();
+
+  /**
+   * @brief average relation of num_used sources given their accumulated relation, see Conflict::average_operator
+   */
+  static SumType average_of(SumType accumulated_relation, std::size_t num_used);
+
+  std::size_t num_sources_{ 0 };
+  std::size_t updates_since_resync_{ 0 };
+  // projection and certainty (1 - u) of each source, see Conflict::relation_projection
+  std::vector<BeliefType> projections_;
+  std::vector<FloatT> certainties_;
+  // row major matrix of the relations of all pairs of sources, the diagonal is not used
+  std::vector<FloatT> relations_;
+  // sum of the relations of each source to all other sources and the sum over all pairs
+  std::vector<AccumulatorT> relation_sums_;
+  AccumulatorT accumulated_relation_;
+};
+
+template <typename OpinionT, Conflict::RelationType RelationT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+ConflictTracker<OpinionT, RelationT>::ConflictTracker(std::span<const OpinionT> opinions)
+{
+  reset(opinions);
+}
+
+template <typename OpinionT, Conflict::RelationType RelationT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+void ConflictTracker<OpinionT, RelationT>::reset(std::span<const OpinionT> opinions)
+{
+  num_sources_ = opinions.size();
+  projections_.resize(num_sources_);
+  certainties_.resize(num_sources_);
+  for (std::size_t idx{ 0 }; idx < num_sources_; ++idx)
+  {
+    projections_[idx] = Conflict::relation_projection(opinions[idx]);
+    certainties_[idx] = static_cast<FloatT>(1.) - opinions[idx].uncertainty();
+  }
+
+  relations_.assign(num_sources_ * num_sources_, 0.);
+  for (std::size_t idx_outer{ 0 }; idx_outer < num_sources_; ++idx_outer)
+  {
+    for (std::size_t idx_inner{ idx_outer + 1 }; idx_inner < num_sources_; ++idx_inner)
+    {
+      const FloatT relation = Conflict::projected_relation<RelationT>(
+          projections_[idx_outer], certainties_[idx_outer], projections_[idx_inner], certainties_[idx_inner]);
+      relations_[idx_outer * num_sources_ + idx_inner] = relation;
+      relations_[idx_inner * num_sources_ + idx_outer] = relation;
+    }
+  }
+  resync();
+}
+
+template <typename OpinionT, Conflict::RelationType RelationT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+void ConflictTracker<OpinionT, RelationT>::update(std::size_t idx, const OpinionT& opinion)
+{
+  assert(idx < num_sources_);
+  projections_[idx] = Conflict::relation_projection(opinion);
+  certainties_[idx] = static_cast<FloatT>(1.) - opinion.uncertainty();
+
+  // only the row (and column) of the updated source changes, the sum of its row is recalculated from scratch,
+  // the sums of all other rows are corrected by the difference of their relation to the updated source
+  AccumulatorT relation_sum;
+  for (std::size_t idx_other{ 0 }; idx_other < num_sources_; ++idx_other)
+  {
+    if (idx_other == idx)
+    {
+      continue;
+    }
+    const FloatT relation = Conflict::projected_relation<RelationT>(
+        projections_[idx], certainties_[idx], projections_[idx_other], certainties_[idx_other]);
+    FloatT& old_relation = relations_[idx_other * num_sources_ + idx];
+    relation_sums_[idx_other] += static_cast<SumType>(relation) - old_relation;
+    old_relation = relation;
+    relations_[idx * num_sources_ + idx_other] = relation;
+    relation_sum += relation;
+  }
+  accumulated_relation_ += relation_sum.sum() - relation_sums_[idx].sum();
+  relation_sums_[idx] = relation_sum;
+
+  // the corrections of the other sums accumulate rounding errors, the sums are recalculated once their cost is
+  // amortized over the updates, i.e., O(n) per update
+  if (++updates_since_resync_ > num_sources_)
+  {
+    resync();
+  }
+}
+
+template <typename OpinionT, Conflict::RelationType RelationT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+void ConflictTracker<OpinionT, RelationT>::resync()
+{
+  relation_sums_.assign(num_sources_, AccumulatorT{});
+  accumulated_relation_ = AccumulatorT{};
+  for (std::size_t idx_outer{ 0 }; idx_outer < num_sources_; ++idx_outer)
+  {
+    for (std::size_t idx_inner{ idx_outer + 1 }; idx_inner < num_sources_; ++idx_inner)
+    {
+      const FloatT relation = relations_[idx_outer * num_sources_ + idx_inner];
+      relation_sums_[idx_outer] += relation;
+      relation_sums_[idx_inner] += relation;
+      accumulated_relation_ += relation;
+    }
+  }
+  updates_since_resync_ = 0;
+}
+
+template <typename OpinionT, Conflict::RelationType RelationT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+std::size_t ConflictTracker<OpinionT, RelationT>::size() const
+{
+  return num_sources_;
+}
+
+template <typename OpinionT, Conflict::RelationType RelationT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+typename OpinionT::FLOAT_t ConflictTracker<OpinionT, RelationT>::relation(std::size_t idx, std::size_t idx_other) const
+{
+  assert(idx < num_sources_ and idx_other < num_sources_);
+  return relations_[idx * num_sources_ + idx_other];
+}
+
+template <typename OpinionT, Conflict::RelationType RelationT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+typename OpinionT::FLOAT_t ConflictTracker<OpinionT, RelationT>::accumulated() const
+{
+  return accumulated_relation_.value();
+}
+
+template <typename OpinionT, Conflict::RelationType RelationT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+typename OpinionT::FLOAT_t ConflictTracker<OpinionT, RelationT>::average() const
+{
+  return static_cast<FloatT>(average_of(accumulated_relation_.sum(), num_sources_));
+}
+
+template <typename OpinionT, Conflict::RelationType RelationT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+typename OpinionT::FLOAT_t ConflictTracker<OpinionT, RelationT>::share(std::size_t idx) const
+{
+  assert(idx < num_sources_);
+  const SumType avg_relation = average_of(accumulated_relation_.sum(), num_sources_);
+  if (avg_relation < EPS_v<FloatT>)
+  {
+    return 0.;
+  }
+  // see Conflict::conflict_shares, the average relation of all other sources lacks all relations of this source
+  const SumType avg_relation_wo_self =
+      average_of(accumulated_relation_.sum() - relation_sums_[idx].sum(), num_sources_ - 1);
+  return static_cast<FloatT>(1. - avg_relation_wo_self / avg_relation);
+}
+
+template <typename OpinionT, Conflict::RelationType RelationT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+typename ConflictTracker<OpinionT, RelationT>::SumType
+ConflictTracker<OpinionT, RelationT>::average_of(SumType accumulated_relation, std::size_t num_used)
+{
+  if (num_used < 2)
+  {
+    return 0.;
+  }
+  return accumulated_relation / static_cast<SumType>((num_used * (num_used - 1)) / 2);
+}
+
+}  // namespace subjective_logic::multisource
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "subjective_logic_lib/util.hpp"
+#include "subjective_logic_lib/opinions/opinion.hpp"
+#include "subjective_logic_lib/multi_source/fusion_operators.hpp"
+
+namespace subjective_logic::multisource
+{
+
+/**
+ * @brief everything Conflict, TrustRevision and TrustedFusion derive from the same set of trusted opinions, i.e., the
+ * opinions, the discounted opinions, the uncertainties of the trusts and the reference fusions of the discounted
+ * opinions. a single trusted fusion call evaluates the context once and all revision types share it, so that the
+ * opinions are discounted once and each reference fusion type is fused at most once, instead of once per belief
+ * conflict, reference fusion revision and the final fusion.
+ *
+ * the reference fusions are fused lazily on the first request. the context is part of the Workspace and valid until
+ * the next call of evaluate.
+ *
+ * @tparam OpinionT - Opinion or OpinionNoBase, the type of the opinions (not of the trusts)
+ */
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+class EvaluationContext
+{
+public:
+  using FloatT = typename OpinionT::FLOAT_t;
+
+  /**
+   * @brief reserves all buffers for the given number of sources, see Workspace::reserve
+   * @param num_sources
+   */
+  void reserve(std::size_t num_sources);
+
+  /**
+   * @brief extracts the opinions, discounted opinions and trust uncertainties of the trusted opinions and drops all
+   * reference fusions of the previous evaluation
+   * @tparam TrustedOpinionT
+   * @param trusted_opinions
+   */
+  template <typename TrustedOpinionT>
+  void evaluate(std::span<const TrustedOpinionT> trusted_opinions)
+    requires is_trusted_opinion<TrustedOpinionT> and std::is_same_v<typename TrustedOpinionT::OpinionT, OpinionT>;
+
+  /**
+   * @brief number of evaluated sources
+   */
+  [[nodiscard]] std::size_t size() const;
+
+  /**
+   * @brief the (not discounted) opinions of the trusted opinions
+   */
+  [[nodiscard]] std::span<const OpinionT> opinions() const;
+
+  /**
+   * @brief the opinions discounted with the trust of the respective trusted opinion
+   */
+  [[nodiscard]] std::span<const OpinionT> discounted_opinions() const;
+
+  /**
+   * @brief the uncertainties of the trusts of the trusted opinions
+   */
+  [[nodiscard]] std::span<const FloatT> trust_uncertainties() const;
+
+  /**
+   * @brief fusion of the discounted opinions, fused on the first request of each fusion type
+   * @param fusion_type
+   * @return refers to the context, valid until the next call of evaluate
+   */
+  const OpinionT& reference_fusion(Fusion::FusionType fusion_type);
+
+protected:
+  // CONSENSUS_COMPROMISE is the last fusion type
+  static constexpr auto NUM_FUSION_TYPES = static_cast<std::size_t>(Fusion::FusionType::CONSENSUS_COMPROMISE) + 1;
+
+  std::vector<OpinionT> opinions_;
+  std::vector<OpinionT> discounted_opinions_;
+  std::vector<FloatT> trust_uncertainties_;
+  std::array<OpinionT, NUM_FUSION_TYPES> reference_fusions_;
+  std::array<bool, NUM_FUSION_TYPES> is_fused_{};
+};
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+void EvaluationContext<OpinionT>::reserve(std::size_t num_sources)
+{
+  opinions_.reserve(num_sources);
+  discounted_opinions_.reserve(num_sources);
+  trust_uncertainties_.reserve(num_sources);
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+template <typename TrustedOpinionT>
+void EvaluationContext<OpinionT>::evaluate(std::span<const TrustedOpinionT> trusted_opinions)
+  requires is_trusted_opinion<TrustedOpinionT> and std::is_same_v<typename TrustedOpinionT::OpinionT, OpinionT>
+{
+  opinions_.clear();
+  discounted_opinions_.clear();
+  trust_uncertainties_.clear();
+  for (const auto& trusted_opinion : trusted_opinions)
+  {
+    opinions_.push_back(trusted_opinion.opinion());
+    discounted_opinions_.push_back(trusted_opinion.discounted_opinion());
+    trust_uncertainties_.push_back(trusted_opinion.trust().uncertainty());
+  }
+  is_fused_.fill(false);
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+std::size_t EvaluationContext<OpinionT>::size() const
+{
+  return opinions_.size();
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+std::span<const OpinionT> EvaluationContext<OpinionT>::opinions() const
+{
+  return opinions_;
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+std::span<const OpinionT> EvaluationContext<OpinionT>::discounted_opinions() const
+{
+  return discounted_opinions_;
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+std::span<const typename OpinionT::FLOAT_t> EvaluationContext<OpinionT>::trust_uncertainties() const
+{
+  return trust_uncertainties_;
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+const OpinionT& EvaluationContext<OpinionT>::reference_fusion(Fusion::FusionType fusion_type)
+{
+  const auto type_idx = static_cast<std::size_t>(fusion_type);
+  if (not is_fused_[type_idx])
+  {
+    reference_fusions_[type_idx] =
+        Fusion::fuse_opinions(fusion_type, std::span<const OpinionT>{ discounted_opinions_ });
+    is_fused_[type_idx] = true;
+  }
+  return reference_fusions_[type_idx];
+}
+
+}  // namespace subjective_logic::multisource
@@ -0,0 +1,283 @@
+#pragma once
+
+// the reader is invited to refer to the following book as reference for the implementations within this file:
+// [1] Subjective Logic - A Formalism for Reasoning Under Uncertainty,
+// Audun Jøsang, 2016, https://doi.org/10.1007/978-3-319-42337-1
+// [2] Multi-source fusion in subjective logic
+// A. J⊘sang, D. Wang and J. Zhang,
+// 2017 20th International Conference on Information Fusion (Fusion), Xi'an, China, 2017, pp. 1-8,
+// doi: 10.23919/ICIF.2017.8009820.
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "subjective_logic_lib/util.hpp"
+#include "subjective_logic_lib/opinions/opinion.hpp"
+#include "subjective_logic_lib/multi_source/fusion_operators.hpp"
+
+namespace subjective_logic::multisource
+{
+
+/**
+ * @brief stateful counterpart of Fusion::fuse_opinions, sources can be added, removed and replaced in O(N) and the
+ * fused opinion is available in O(N) at any time.
+ * instead of the sources, the accumulator keeps their sufficient statistics, which is possible since the cumulative,
+ * averaging and weighted belief fusion of [2] can be written as ratios of sums over all sources
+ * (see Fusion::weighted_belief_sum), i.e., removing a source is a subtraction (the multi source version of
+ * cum_unfuse_ and average_unfuse_).
+ * the handling of dogmatic sources and of the prior equals Fusion::fuse_opinions.
+ *
+ * the statistics are kept in double precision, so that adding and removing sources does not drift noticeably for
+ * float opinions. removing a source which has not been added before results in invalid statistics.
+ *
+ * belief constraint fusion cannot be represented by such statistics and is not available.
+ *
+ * @tparam OpinionT - Opinion or OpinionNoBase
+ * @tparam FUSION_TYPE - CUMULATIVE, AVERAGE or WEIGHTED
+ */
+template <typename OpinionT, Fusion::FusionType FUSION_TYPE>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+class FusionAccumulator
+{
+  static_assert(FUSION_TYPE == Fusion::FusionType::CUMULATIVE or FUSION_TYPE == Fusion::FusionType::AVERAGE or
+                    FUSION_TYPE == Fusion::FusionType::WEIGHTED,
+                "the fusion accumulator requires a fusion operator which can be expressed by sums over all sources");
+
+public:
+  static constexpr std::size_t N = OpinionT::SIZE;
+  using FloatT = typename OpinionT::FLOAT_t;
+  using SumType = Array<N, double>;
+
+  FusionAccumulator() = default;
+
+  /**
+   * @brief creates an accumulator containing the given sources
+   * @param opinions
+   */
+  explicit FusionAccumulator(const std::vector<OpinionT>& opinions);
+
+  /**
+   * @brief adds a source, O(N)
+   * @param opinion
+   */
+  void add(const OpinionT& opinion);
+
+  /**
+   * @brief removes a source which has been added before, O(N)
+   * @param opinion - the opinion exactly as it has been added
+   */
+  void remove(const OpinionT& opinion);
+
+  /**
+   * @brief replaces a source, e.g., if it updated its report, O(N)
+   * @param old_opinion - the opinion exactly as it has been added
+   * @param new_opinion
+   */
+  void replace(const OpinionT& old_opinion, const OpinionT& new_opinion);
+
+  /**
+   * @brief removes all sources
+   */
+  void clear();
+
+  /**
+   * @brief number of sources
+   */
+  [[nodiscard]] std::size_t size() const;
+
+  /**
+   * @brief checks if no source has been added
+   */
+  [[nodiscard]] bool empty() const;
+
+  /**
+   * @brief number of dogmatic sources, as soon as there is one, the result is the mean of all dogmatic sources
+   */
+  [[nodiscard]] std::size_t num_dogmatic() const;
+
+  /**
+   * @brief fused opinion of all sources, equals Fusion::fuse_opinions(FUSION_TYPE, sources), O(N)
+   *        a vacuous opinion is returned if there is no source
+   */
+  [[nodiscard]] OpinionT result() const;
+
+protected:
+  /**
+   * @brief adds (sign = 1) or subtracts (sign = -1) the statistics of the given opinion
+   */
+  void accumulate(const OpinionT& opinion, double sign);
+
+  std::size_t num_sources_{ 0 };
+  std::size_t num_dogmatic_{ 0 };
+  // sum of the belief masses of all dogmatic sources
+  SumType dogmatic_sum_{ 0. };
+  // sum_i b_i / u_i over all non dogmatic sources, i.e., the evidences divided by the prior weight
+  SumType evidence_sum_{ 0. };
+  // sum_i c_i * b_i with c_i = (1 - u_i) / u_i over all non dogmatic sources, only used by the weighted fusion
+  SumType confidence_weighted_sum_{ 0. };
+  // sum of the priors and the priors weighted by (1 - u_i) of all sources, only used for Opinion
+  SumType prior_sum_{ 0. };
+  SumType confidence_weighted_prior_sum_{ 0. };
+  double confidence_sum_{ 0. };
+};
+
+template <typename OpinionT, Fusion::FusionType FUSION_TYPE>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+FusionAccumulator<OpinionT, FUSION_TYPE>::FusionAccumulator(const std::vector<OpinionT>& opinions)
+{
+  for (const auto& opinion : opinions)
+  {
+    add(opinion);
+  }
+}
+
+template <typename OpinionT, Fusion::FusionType FUSION_TYPE>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+void FusionAccumulator<OpinionT, FUSION_TYPE>::add(const OpinionT& opinion)
+{
+  accumulate(opinion, 1.);
+}
+
+template <typename OpinionT, Fusion::FusionType FUSION_TYPE>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+void FusionAccumulator<OpinionT, FUSION_TYPE>::remove(const OpinionT& opinion)
+{
+  assert(num_sources_ > 0);
+  accumulate(opinion, -1.);
+}
+
+template <typename OpinionT, Fusion::FusionType FUSION_TYPE>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+void FusionAccumulator<OpinionT, FUSION_TYPE>::replace(const OpinionT& old_opinion, const OpinionT& new_opinion)
+{
+  remove(old_opinion);
+  add(new_opinion);
+}
+
+template <typename OpinionT, Fusion::FusionType FUSION_TYPE>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+void FusionAccumulator<OpinionT, FUSION_TYPE>::clear()
+{
+  *this = FusionAccumulator{};
+}
+
+template <typename OpinionT, Fusion::FusionType FUSION_TYPE>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+std::size_t FusionAccumulator<OpinionT, FUSION_TYPE>::size() const
+{
+  return num_sources_;
+}
+
+template <typename OpinionT, Fusion::FusionType FUSION_TYPE>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+bool FusionAccumulator<OpinionT, FUSION_TYPE>::empty() const
+{
+  return num_sources_ == 0;
+}
+
+template <typename OpinionT, Fusion::FusionType FUSION_TYPE>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+std::size_t FusionAccumulator<OpinionT, FUSION_TYPE>::num_dogmatic() const
+{
+  return num_dogmatic_;
+}
+
+template <typename OpinionT, Fusion::FusionType FUSION_TYPE>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+void FusionAccumulator<OpinionT, FUSION_TYPE>::accumulate(const OpinionT& opinion, double sign)
+{
+  const FloatT uncertainty = opinion.uncertainty();
+  num_sources_ = sign > 0 ? num_sources_ + 1 : num_sources_ - 1;
+
+  if constexpr (is_opinion<OpinionT>)
+  {
+    const double confidence = 1. - static_cast<double>(uncertainty);
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+      const double prior = opinion.prior_belief_masses()[mass_idx];
+      prior_sum_[mass_idx] += sign * prior;
+      confidence_weighted_prior_sum_[mass_idx] += sign * confidence * prior;
+    });
+    confidence_sum_ += sign * confidence;
+  }
+
+  // the same classification as Fusion::preprocess_opinions, thus, removing a source reverts its classification
+  if (std::abs(uncertainty) < EPS_v<FloatT>)
+  {
+    num_dogmatic_ = sign > 0 ? num_dogmatic_ + 1 : num_dogmatic_ - 1;
+    constexpr_for<0, N, 1>(
+        [&](std::size_t mass_idx) { dogmatic_sum_[mass_idx] += sign * opinion.belief_masses()[mass_idx]; });
+    return;
+  }
+
+  const double inv_uncertainty = 1. / static_cast<double>(uncertainty);
+  const double confidence_ratio = (1. - static_cast<double>(uncertainty)) * inv_uncertainty;
+  constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+    const double mass = opinion.belief_masses()[mass_idx];
+    evidence_sum_[mass_idx] += sign * mass * inv_uncertainty;
+    if constexpr (FUSION_TYPE == Fusion::FusionType::WEIGHTED)
+    {
+      confidence_weighted_sum_[mass_idx] += sign * mass * confidence_ratio;
+    }
+  });
+}
+
+template <typename OpinionT, Fusion::FusionType FUSION_TYPE>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+OpinionT FusionAccumulator<OpinionT, FUSION_TYPE>::result() const
+{
+  OpinionT result;
+  if (num_sources_ == 0)
+  {
+    return result;
+  }
+
+  SumType masses{ 0. };
+  if (num_dogmatic_ > 0)
+  {
+    // see Fusion::preprocess_opinions, all dogmatic opinions are considered as equally strong
+    masses = dogmatic_sum_ / static_cast<double>(num_dogmatic_);
+  }
+  else
+  {
+    const double total_evidence = evidence_sum_.sum();
+    if constexpr (FUSION_TYPE == Fusion::FusionType::CUMULATIVE)
+    {
+      masses = evidence_sum_ / (1. + total_evidence);
+    }
+    else if constexpr (FUSION_TYPE == Fusion::FusionType::AVERAGE)
+    {
+      masses = evidence_sum_ / (static_cast<double>(num_sources_) + total_evidence);
+    }
+    else if (total_evidence >= EPS_v<FloatT>)
+    {
+      // weighted fusion, vacuous sources only result in a vacuous opinion
+      masses = confidence_weighted_sum_ / total_evidence;
+    }
+  }
+  constexpr_for<0, N, 1>(
+      [&](std::size_t mass_idx) { result.belief_masses()[mass_idx] = static_cast<FloatT>(masses[mass_idx]); });
+
+  if constexpr (is_opinion<OpinionT>)
+  {
+    // see Fusion::fuse_opinions_, the mean of several dogmatic sources keeps the default prior, only the weighted
+    // fusion sets its prior for any result
+    if (FUSION_TYPE != Fusion::FusionType::WEIGHTED and num_dogmatic_ > 0 and num_sources_ > 1)
+    {
+      return result;
+    }
+    // see Fusion::average_prior and Fusion::weighted_prior
+    SumType prior = prior_sum_ / static_cast<double>(num_sources_);
+    if (FUSION_TYPE == Fusion::FusionType::WEIGHTED and confidence_sum_ >= EPS_v<FloatT>)
+    {
+      prior = confidence_weighted_prior_sum_ / confidence_sum_;
+    }
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+      result.prior_belief_masses()[mass_idx] = static_cast<FloatT>(prior[mass_idx]);
+    });
+  }
+  return result;
+}
+
+}  // namespace subjective_logic::multisource
@@ -11,14 +11,17 @@
 // Kopp and F. Kargl, 2018 21st International Conference on Information Fusion (FUSION), Cambridge, UK, 2018, pp.
 // 1990-1997, doi: 10.23919/ICIF.2018.8455615.
 
+#include <algorithm>
+#include <array>
 #include <iostream>
 #include <numeric>
-#include <vector>
 #include <optional>
-#include <tuple>
+#include <span>
+#include <vector>
 
 #include "subjective_logic_lib/util.hpp"
 #include "subjective_logic_lib/opinions/opinion.hpp"
+#include "subjective_logic_lib/types/accumulator.hpp"
 
 namespace subjective_logic::multisource
 {
@@ -31,12 +34,37 @@ struct Fusion
     BELIEF_CONSTRAINT,
     AVERAGE,
     WEIGHTED,
+    CONSENSUS_COMPROMISE,
   };
 
   template <typename OpinionT>
   static inline OpinionT fuse_opinions(FusionType fusion_type, std::vector<OpinionT> opinions)
     requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
 
+  /**
+   * fuses the opinions of a contiguous range without copying them, e.g., a std::array, a part of a std::vector or a
+   * plain array. in contrast to the std::vector overload, no heap allocation is performed
+   * @tparam OpinionT
+   * @param fusion_type
+   * @param opinions
+   * @return
+   */
+  template <typename OpinionT>
+  static inline OpinionT fuse_opinions(FusionType fusion_type, std::span<const OpinionT> opinions)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * fuses a fixed number of opinions without any heap allocation, see fuse
+   * @tparam K - number of opinions
+   * @tparam OpinionT
+   * @param fusion_type
+   * @param opinions
+   * @return
+   */
+  template <std::size_t K, typename OpinionT>
+  static inline OpinionT fuse_opinions(FusionType fusion_type, const Array<K, OpinionT>& opinions)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
   template <typename OpinionT>
   static inline OpinionT fuse_opinions(FusionType fusion_type, std::initializer_list<OpinionT>& inputs)
     requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
@@ -45,11 +73,57 @@ struct Fusion
   static inline FirstType<Opinions...>::type fuse_opinions(FusionType fusion_type, Opinions... opinions)
     requires is_opinion_no_base_list<Opinions...> or is_opinion_list<Opinions...>;
 
+  /**
+   * fuses the opinions of a contiguous range with the fusion operator chosen at compile time,
+   * there is no runtime dispatch, so that the operator can be inlined, and the fusion can be evaluated at compile time
+   * @tparam FusionT
+   * @tparam OpinionT
+   * @param opinions
+   * @return
+   */
+  template <FusionType FusionT, typename OpinionT>
+  CUDA_AVAIL static constexpr OpinionT fuse(std::span<const OpinionT> opinions)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * fuses a fixed number of opinions, all loops over the opinions are unrolled at compile time and no heap allocation
+   * is performed, e.g., for the fusion of a few sources within (device) kernels
+   * @tparam FusionT
+   * @tparam K - number of opinions
+   * @tparam OpinionT
+   * @param opinions
+   * @return
+   */
+  template <FusionType FusionT, std::size_t K, typename OpinionT>
+  CUDA_AVAIL static constexpr OpinionT fuse(const Array<K, OpinionT>& opinions)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  template <FusionType FusionT, typename... Opinions>
+  CUDA_AVAIL static constexpr FirstType<Opinions...>::type fuse(Opinions... opinions)
+    requires is_opinion_no_base_list<Opinions...> or is_opinion_list<Opinions...>;
+
 protected:
-  // FusionOperator is used internally, to type the functions for the specific operator implementation
-  template <typename OpinionT>
-  using FusionOperator = std::function<
-      OpinionT(const std::vector<OpinionT>&, std::vector<typename OpinionT::FLOAT_t>, typename OpinionT::FLOAT_t)>;
+  /**
+   * implementation of fuse_opinions for std::span and Array
+   * @tparam OpinionRange - std::span or Array of opinions
+   * @param fusion_type
+   * @param opinions
+   * @return
+   */
+  template <typename OpinionRange, typename OpinionT = typename OpinionRange::value_type>
+  static inline OpinionT fuse_range(FusionType fusion_type, const OpinionRange& opinions)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * implementation of fuse for std::span and Array
+   * @tparam FusionT
+   * @tparam OpinionRange - std::span or Array of opinions
+   * @param opinions
+   * @return
+   */
+  template <FusionType FusionT, typename OpinionRange, typename OpinionT = typename OpinionRange::value_type>
+  static constexpr OpinionT fuse_range(const OpinionRange& opinions)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
 
   /**
    * preprocessing steps of all multi source fusion operators are combined in this function
@@ -60,81 +134,120 @@ protected:
    * @param opinions
    * @return
    */
-  template <typename OpinionT>
-  static inline std::tuple<std::vector<typename OpinionT::FLOAT_t>, std::optional<OpinionT>>
-  preprocess_opinions(const std::vector<OpinionT>& opinions)
+  template <typename OpinionRange, typename OpinionT = typename OpinionRange::value_type>
+  static constexpr std::optional<OpinionT> preprocess_opinions(const OpinionRange& opinions)
     requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
 
   /**
    * the prior is not handled by any multi source fusion model, instead it gets averaged over all available opinions
+   * (except for the mean of dogmatic opinions, which keeps the default prior, see fuse_opinions_)
+   * the sum of the priors is calculated according to ACCUMULATION_v of the floating point type
    * @tparam OpinionT
    * @param opinions
    * @return
    */
-  template <typename OpinionT>
-  static inline typename OpinionT::BeliefType average_prior(const std::vector<OpinionT>& opinions)
+  template <typename OpinionRange, typename OpinionT = typename OpinionRange::value_type>
+  static constexpr typename OpinionT::BeliefType average_prior(const OpinionRange& opinions)
     requires is_opinion<OpinionT>;
 
   /**
    * fuse all opinions using a given fusion operator
    * this functions handles everything except the actual fusion operation
-   * the given fusion operator is provided with precalculated uncertainties and the uncertainty product
-   * further, using the preprocess_opinions function, dogmatic opinions are handled.
-   * @tparam N
-   * @tparam FloatT
+   * using the preprocess_opinions function, dogmatic opinions are handled,
+   * i.e., the given fusion operator is only called for opinions with a non-zero uncertainty.
+   * the operator is a template parameter (instead of a std::function), so that no allocation is required to call it
+   * @tparam OpinionT
+   * @tparam OpinionRange - std::span or Array of opinions
+   * @tparam FusionOperatorT - callable with the signature OpinionT(const OpinionRange&)
    * @param opinions
    * @return
    */
-  template <typename OpinionT>
-  static inline OpinionT fuse_opinions_(const std::vector<OpinionT>& opinions, FusionOperator<OpinionT> fusion_operator)
+  template <typename OpinionRange,
+            typename FusionOperatorT,
+            typename OpinionT = typename OpinionRange::value_type>
+  static constexpr OpinionT fuse_opinions_(const OpinionRange& opinions, FusionOperatorT&& fusion_operator)
     requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
 
   /**
-   * includes all operator specific calculations and is used together with fuse_opinions
-   * @tparam N
-   * @tparam FloatT
+   * sums up the belief masses of all opinions, each multiplied by the weight of the respective opinion
+   * the operators of [2] are reformulated to such sums, e.g., with the weights 1 / u_i, the sum equals the sum of the
+   * evidences of all opinions divided by the prior weight. in contrast to the product of all uncertainties used by [2],
+   * no term vanishes for a large number of opinions. the sums are calculated according to ACCUMULATION_v of the
+   * floating point type, e.g., in double for float opinions
+   * @tparam OpinionT
+   * @tparam WeightFunction - callable returning the weight of an opinion, FloatT(const OpinionT&)
+   * @param opinions
+   * @param weight_function - weight of each opinion
+   * @param sums - the weighted belief masses of all opinions are added to this, elementwise
+   * @return sum over all weighted belief masses
+   */
+  template <typename OpinionRange, typename WeightFunction, typename OpinionT = typename OpinionRange::value_type>
+  static constexpr typename OpinionT::FLOAT_t weighted_belief_sum(const OpinionRange& opinions,
+                                                                   WeightFunction&& weight_function,
+                                                                   typename OpinionT::BeliefType& sums)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * the prior of the weighted belief fusion of [2], the priors are weighted by the confidence (1 - u) of each opinion
    * @tparam OpinionT
    * @param opinions
-   * @param uncertainties
-   * @param uncertainty_product
    * @return
    */
-  template <typename OpinionT>
-  static inline OpinionT cumulative_fusion_operator(const std::vector<OpinionT>& opinions,
-                                                    std::vector<typename OpinionT::FLOAT_t> uncertainties,
-                                                    typename OpinionT::FLOAT_t uncertainty_product)
+  template <typename OpinionRange, typename OpinionT = typename OpinionRange::value_type>
+  static constexpr typename OpinionT::BeliefType weighted_prior(const OpinionRange& opinions)
+    requires is_opinion<OpinionT>;
+
+  /**
+   * includes all operator specific calculations and is used together with fuse_opinions
+   * @tparam OpinionT
+   * @param opinions - non dogmatic opinions
+   * @return
+   */
+  template <typename OpinionRange, typename OpinionT = typename OpinionRange::value_type>
+  static constexpr OpinionT cumulative_fusion_operator(const OpinionRange& opinions)
     requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
 
   /**
    * includes all operator specific calculations and is used together with fuse_opinions
-   * @tparam N
-   * @tparam FloatT
    * @tparam OpinionT
-   * @param opinions
-   * @param uncertainties
-   * @param uncertainty_product
+   * @param opinions - non dogmatic opinions
    * @return
    */
-  template <typename OpinionT>
-  static inline OpinionT belief_constraint_fusion_operator(const std::vector<OpinionT>& opinions,
-                                                           std::vector<typename OpinionT::FLOAT_t> uncertainties,
-                                                           typename OpinionT::FLOAT_t uncertainty_product)
+  template <typename OpinionRange, typename OpinionT = typename OpinionRange::value_type>
+  static constexpr OpinionT belief_constraint_fusion_operator(const OpinionRange& opinions)
     requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
 
   /**
    * includes all operator specific calculations and is used together with fuse_opinions
-   * @tparam N
-   * @tparam FloatT
    * @tparam OpinionT
-   * @param opinions
-   * @param uncertainties
-   * @param uncertainty_product
+   * @param opinions - non dogmatic opinions
    * @return
    */
-  template <typename OpinionT>
-  static inline OpinionT average_fusion_operator(const std::vector<OpinionT>& opinions,
-                                                 std::vector<typename OpinionT::FLOAT_t> uncertainties,
-                                                 typename OpinionT::FLOAT_t uncertainty_product)
+  template <typename OpinionRange, typename OpinionT = typename OpinionRange::value_type>
+  static constexpr OpinionT average_fusion_operator(const OpinionRange& opinions)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * includes all operator specific calculations and is used together with fuse_opinions
+   * @tparam OpinionT
+   * @param opinions - non dogmatic opinions
+   * @return
+   */
+  template <typename OpinionRange, typename OpinionT = typename OpinionRange::value_type>
+  static constexpr OpinionT weighted_fusion_operator(const OpinionRange& opinions)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * multi-source consensus & compromise fusion of [2] in a single pass over all opinions.
+   * the consensus is the minimum belief mass of all opinions, the residues are distributed in the compromise step.
+   * as for OpinionNoBase::cc_fuse_, the belief of a composite set is assigned to each of its singletons.
+   * this operator is used without preprocess_opinions, since it is well-defined for dogmatic opinions
+   * @tparam OpinionT
+   * @param opinions - at least two opinions
+   * @return
+   */
+  template <typename OpinionRange, typename OpinionT = typename OpinionRange::value_type>
+  static constexpr OpinionT consensus_compromise_fusion_operator(const OpinionRange& opinions)
     requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
 };
 
@@ -142,7 +255,7 @@ template <typename OpinionT>
 inline OpinionT Fusion::fuse_opinions(Fusion::FusionType fusion_type, std::initializer_list<OpinionT>& inputs)
   requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
 {
-  return fuse_opinions(fusion_type, std::vector<OpinionT>{ inputs });
+  return fuse_opinions(fusion_type, std::span<const OpinionT>{ inputs.begin(), inputs.size() });
 }
 
 template <typename... Opinions>
@@ -150,26 +263,55 @@ inline FirstType<Opinions...>::type Fusion::fuse_opinions(Fusion::FusionType fus
   requires is_opinion_no_base_list<Opinions...> or is_opinion_list<Opinions...>
 {
   using OutType = FirstType<Opinions...>::type;
-  return OutType{ fuse_opinions(fusion_type, std::vector<OutType>{ opinions... }) };
+  return fuse_opinions(fusion_type, Array<sizeof...(Opinions), OutType>{ OutType{ opinions }... });
 }
 
 template <typename OpinionT>
 inline OpinionT Fusion::fuse_opinions(Fusion::FusionType fusion_type, std::vector<OpinionT> opinions)
   requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  return fuse_opinions(fusion_type, std::span<const OpinionT>{ opinions });
+}
+
+template <typename OpinionT>
+inline OpinionT Fusion::fuse_opinions(Fusion::FusionType fusion_type, std::span<const OpinionT> opinions)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  return fuse_range(fusion_type, opinions);
+}
+
+template <std::size_t K, typename OpinionT>
+inline OpinionT Fusion::fuse_opinions(Fusion::FusionType fusion_type, const Array<K, OpinionT>& opinions)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  return fuse_range(fusion_type, opinions);
+}
+
+template <typename OpinionRange, typename OpinionT>
+inline OpinionT Fusion::fuse_range(Fusion::FusionType fusion_type, const OpinionRange& opinions)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
 {
   switch (fusion_type)
   {
     case FusionType::CUMULATIVE:
     {
-      return fuse_opinions_(opinions, Fusion::cumulative_fusion_operator<OpinionT>);
+      return fuse<FusionType::CUMULATIVE>(opinions);
     }
     case FusionType::BELIEF_CONSTRAINT:
     {
-      return fuse_opinions_(opinions, Fusion::belief_constraint_fusion_operator<OpinionT>);
+      return fuse<FusionType::BELIEF_CONSTRAINT>(opinions);
     }
     case FusionType::AVERAGE:
     {
-      return fuse_opinions_(opinions, Fusion::average_fusion_operator<OpinionT>);
+      return fuse<FusionType::AVERAGE>(opinions);
+    }
+    case FusionType::WEIGHTED:
+    {
+      return fuse<FusionType::WEIGHTED>(opinions);
+    }
+    case FusionType::CONSENSUS_COMPROMISE:
+    {
+      return fuse<FusionType::CONSENSUS_COMPROMISE>(opinions);
     }
     default:
     {
@@ -179,94 +321,136 @@ inline OpinionT Fusion::fuse_opinions(Fusion::FusionType fusion_type, std::vecto
   }
 }
 
-template <typename OpinionT>
-inline typename OpinionT::BeliefType Fusion::average_prior(const std::vector<OpinionT>& opinions)
-  requires is_opinion<OpinionT>
+template <Fusion::FusionType FusionT, typename OpinionT>
+constexpr OpinionT Fusion::fuse(std::span<const OpinionT> opinions)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
 {
-  typename OpinionT::BeliefType prior{ 0 };
+  return fuse_range<FusionT>(opinions);
+}
+
+template <Fusion::FusionType FusionT, std::size_t K, typename OpinionT>
+constexpr OpinionT Fusion::fuse(const Array<K, OpinionT>& opinions)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  return fuse_range<FusionT>(opinions);
+}
+
+template <Fusion::FusionType FusionT, typename... Opinions>
+constexpr FirstType<Opinions...>::type Fusion::fuse(Opinions... opinions)
+  requires is_opinion_no_base_list<Opinions...> or is_opinion_list<Opinions...>
+{
+  using OutType = FirstType<Opinions...>::type;
+  return fuse<FusionT>(Array<sizeof...(Opinions), OutType>{ OutType{ opinions }... });
+}
 
-  for (auto const& opinion : opinions)
+template <Fusion::FusionType FusionT, typename OpinionRange, typename OpinionT>
+constexpr OpinionT Fusion::fuse_range(const OpinionRange& opinions)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  if constexpr (FusionT == FusionType::CUMULATIVE)
   {
-    for (std::size_t idx{ 0 }; idx < OpinionT::SIZE; ++idx)
+    return fuse_opinions_(opinions, Fusion::cumulative_fusion_operator<OpinionRange>);
+  }
+  else if constexpr (FusionT == FusionType::BELIEF_CONSTRAINT)
+  {
+    return fuse_opinions_(opinions, Fusion::belief_constraint_fusion_operator<OpinionRange>);
+  }
+  else if constexpr (FusionT == FusionType::AVERAGE)
+  {
+    return fuse_opinions_(opinions, Fusion::average_fusion_operator<OpinionRange>);
+  }
+  else if constexpr (FusionT == FusionType::WEIGHTED)
+  {
+    OpinionT result = fuse_opinions_(opinions, Fusion::weighted_fusion_operator<OpinionRange>);
+    if constexpr (is_opinion<OpinionT>)
     {
-      prior[idx] += opinion.prior_belief_masses()[idx];
+      // in contrast to the other operators, [2] defines the prior of the weighted belief fusion
+      result.prior_belief_masses() = Fusion::weighted_prior(opinions);
     }
+    return result;
   }
+  else
+  {
+    static_assert(FusionT == FusionType::CONSENSUS_COMPROMISE, "unknown fusion type");
+    if (opinions.size() < 2)
+    {
+      return opinions.size() == 1 ? opinions[0] : OpinionT{};
+    }
+    OpinionT result = Fusion::consensus_compromise_fusion_operator(opinions);
+    if constexpr (is_opinion<OpinionT>)
+    {
+      result.prior_belief_masses() = Fusion::average_prior(opinions);
+    }
+    return result;
+  }
+}
+
+template <typename OpinionRange, typename OpinionT>
+constexpr typename OpinionT::BeliefType Fusion::average_prior(const OpinionRange& opinions)
+  requires is_opinion<OpinionT>
+{
+  using AccumulatorT = Accumulator<typename OpinionT::FLOAT_t>;
+  Array<OpinionT::SIZE, AccumulatorT> prior_sums;
+
+  for_each_entry(opinions, [&](const OpinionT& opinion) {
+    for (std::size_t idx{ 0 }; idx < OpinionT::SIZE; ++idx)
+    {
+      prior_sums[idx] += opinion.prior_belief_masses()[idx];
+    }
+  });
+
+  typename OpinionT::BeliefType prior{ 0 };
   for (std::size_t idx{ 0 }; idx < OpinionT::SIZE; ++idx)
   {
-    prior[idx] /= opinions.size();
+    prior[idx] = static_cast<typename OpinionT::FLOAT_t>(prior_sums[idx].sum() / opinions.size());
   }
 
   return prior;
 }
 
-template <typename OpinionT>
-inline std::tuple<std::vector<typename OpinionT::FLOAT_t>, std::optional<OpinionT>>
-Fusion::preprocess_opinions(const std::vector<OpinionT>& opinions)
+template <typename OpinionRange, typename OpinionT>
+constexpr std::optional<OpinionT> Fusion::preprocess_opinions(const OpinionRange& opinions)
   requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
 {
   using FloatT = typename OpinionT::FLOAT_t;
   if (opinions.size() == 1)
   {
-    return std::make_tuple(std::vector<typename OpinionT::FLOAT_t>{}, *opinions.begin());
+    return opinions.front();
   }
 
-  const std::size_t n_elements = opinions.size();
-  std::vector<FloatT> uncertainties(opinions.size());
-  std::transform(
-      opinions.begin(), opinions.end(), uncertainties.begin(), [](OpinionT opinion) { return opinion.uncertainty(); });
-
   // search for dogmatic opinions to use different fusion approach if necessary
-  bool near_zero_uncertainties{ false };
-  std::vector<OpinionT> dogmatic_opinions;
-  for (std::size_t idx{ 0 }; idx < n_elements; ++idx)
-  {
-    if (std::abs(uncertainties[idx]) < EPS_v<typename OpinionT::FLOAT_t>)
+  // consider all opinions with near zero uncertainties as equally strong dogmatic opinions
+  // (meaning that the mean is calculated instead of separately consider the limes as given in [2])
+  OpinionT result;
+  std::size_t n_dogmatic_elements{ 0 };
+  for_each_entry(opinions, [&](const OpinionT& opinion) {
+    if (std::abs(opinion.uncertainty()) < EPS_v<FloatT>)
     {
-      near_zero_uncertainties = true;
-      dogmatic_opinions.push_back(opinions[idx]);
+      result.belief_masses() += opinion.belief_masses();
+      ++n_dogmatic_elements;
     }
-  }
+  });
 
-  if (near_zero_uncertainties)
+  if (n_dogmatic_elements > 0)
   {
-    OpinionT result;
-    // consider all opinions with near zero uncertainties as equally strong dogmatic opinions
-    // (meaning that the mean is calculated instead of separately consider the limes as given in [2])
-    for (const auto& opinion : dogmatic_opinions)
-    {
-      std::transform(result.belief_masses().begin(),
-                     result.belief_masses().end(),
-                     opinion.belief_masses().begin(),
-                     result.belief_masses().begin(),
-                     [](FloatT val1, FloatT val2) { return val1 + val2; });
-    }
-    const std::size_t n_dogmatic_elements = dogmatic_opinions.size();
-    std::transform(result.belief_masses().begin(),
-                   result.belief_masses().end(),
-                   result.belief_masses().begin(),
-                   [n_dogmatic_elements](FloatT val1) { return val1 / static_cast<FloatT>(n_dogmatic_elements); });
-    return std::make_tuple(std::vector<FloatT>{}, result);
+    result.belief_masses() /= static_cast<FloatT>(n_dogmatic_elements);
+    return result;
   }
-  return std::make_tuple(std::move(uncertainties), std::nullopt);
+  return std::nullopt;
 }
 
-template <typename OpinionT>
-OpinionT Fusion::fuse_opinions_(const std::vector<OpinionT>& opinions, FusionOperator<OpinionT> fusion_operator)
+template <typename OpinionRange, typename FusionOperatorT, typename OpinionT>
+constexpr OpinionT Fusion::fuse_opinions_(const OpinionRange& opinions, FusionOperatorT&& fusion_operator)
   requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
 {
-  using FloatT = typename OpinionT::FLOAT_t;
-  auto [uncertainties, pre_result] = Fusion::preprocess_opinions(opinions);
+  std::optional<OpinionT> pre_result = Fusion::preprocess_opinions(opinions);
+  // a precalculated result, i.e., a single opinion or the mean of dogmatic opinions, keeps its prior
   if (pre_result)
   {
     return *pre_result;
   }
 
-  // the product of all uncertainties can later be used to calculate specific products
-  // by dividing the respective uncertainty which is omitted
-  const FloatT uncert_prod = std::accumulate(uncertainties.begin(), uncertainties.end(), 1., std::multiplies<FloatT>());
-
-  OpinionT result = fusion_operator(opinions, uncertainties, uncert_prod);
+  OpinionT result = fusion_operator(opinions);
   if constexpr (is_opinion<OpinionT>)
   {
     result.prior_belief_masses() = Fusion::average_prior(opinions);
@@ -275,92 +459,209 @@ OpinionT Fusion::fuse_opinions_(const std::vector<OpinionT>& opinions, FusionOpe
   return result;
 }
 
-template <typename OpinionT>
-OpinionT Fusion::cumulative_fusion_operator(const std::vector<OpinionT>& opinions,
-                                            std::vector<typename OpinionT::FLOAT_t> uncertainties,
-                                            typename OpinionT::FLOAT_t uncertainty_product)
+template <typename OpinionRange, typename WeightFunction, typename OpinionT>
+constexpr typename OpinionT::FLOAT_t Fusion::weighted_belief_sum(const OpinionRange& opinions,
+                                                                 WeightFunction&& weight_function,
+                                                                 typename OpinionT::BeliefType& sums)
   requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
 {
   constexpr std::size_t N = OpinionT::SIZE;
   using FloatT = typename OpinionT::FLOAT_t;
-  std::size_t n_elements = opinions.size();
-  OpinionT result;
 
-  // calculate the nominator, during calculation the belief_mass entries of the result are invalid
+  // thousands of terms are summed up and a plain sum would lose the precision of float within a few hundred terms,
+  // thus, the sums are calculated according to the accumulation policy of FloatT
+  using AccumulatorT = Accumulator<FloatT>;
+  using SumType = typename AccumulatorT::SumType;
+  Array<N, AccumulatorT> weighted_sums;
+  for_each_entry(opinions, [&](const OpinionT& opinion) {
+    const SumType weight = weight_function(opinion);
+    for (std::size_t mass_idx{ 0 }; mass_idx < N; ++mass_idx)
+    {
+      weighted_sums[mass_idx] += static_cast<SumType>(opinion.belief_masses()[mass_idx]) * weight;
+    }
+  });
+
+  SumType total_sum{ 0. };
   for (std::size_t mass_idx{ 0 }; mass_idx < N; ++mass_idx)
   {
-    for (std::size_t opinion_idx{ 0 }; opinion_idx < n_elements; ++opinion_idx)
+    sums[mass_idx] += weighted_sums[mass_idx].value();
+    total_sum += weighted_sums[mass_idx].sum();
+  }
+  return static_cast<FloatT>(total_sum);
+}
+
+template <typename OpinionRange, typename OpinionT>
+constexpr typename OpinionT::BeliefType Fusion::weighted_prior(const OpinionRange& opinions)
+  requires is_opinion<OpinionT>
+{
+  using FloatT = typename OpinionT::FLOAT_t;
+  using AccumulatorT = Accumulator<FloatT>;
+  using SumType = typename AccumulatorT::SumType;
+  Array<OpinionT::SIZE, AccumulatorT> prior_sums;
+
+  AccumulatorT confidence_sum;
+  for_each_entry(opinions, [&](const OpinionT& opinion) {
+    const SumType confidence = static_cast<SumType>(1.) - opinion.uncertainty();
+    for (std::size_t idx{ 0 }; idx < OpinionT::SIZE; ++idx)
     {
-      result.belief_masses()[mass_idx] +=
-          opinions[opinion_idx].belief_masses()[mass_idx] * uncertainty_product / uncertainties[opinion_idx];
+      prior_sums[idx] += opinion.prior_belief_masses()[idx] * confidence;
     }
+    confidence_sum += confidence;
+  });
+
+  // vacuous opinions only, there is no confidence to weight with
+  if (confidence_sum.value() < EPS_v<FloatT>)
+  {
+    return average_prior(opinions);
   }
+  typename OpinionT::BeliefType prior{ 0 };
+  for (std::size_t idx{ 0 }; idx < OpinionT::SIZE; ++idx)
+  {
+    prior[idx] = static_cast<FloatT>(prior_sums[idx].sum() / confidence_sum.sum());
+  }
+  return prior;
+}
 
-  // sum of uncertainty products, where each product is omitting one specific uncertainty
-  FloatT denom =
-      std::accumulate(uncertainties.begin(), uncertainties.end(), 0., [uncertainty_product](FloatT sum, FloatT val) {
-        return sum + uncertainty_product / val;
-      });
-  denom -= (n_elements - 1) * uncertainty_product;
+template <typename OpinionRange, typename OpinionT>
+constexpr OpinionT Fusion::cumulative_fusion_operator(const OpinionRange& opinions)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  using FloatT = typename OpinionT::FLOAT_t;
+  OpinionT result;
 
-  // normalize belief_masses using the precalculated denominator
-  std::transform(result.belief_masses().begin(),
-                 result.belief_masses().end(),
-                 result.belief_masses().begin(),
-                 [denom](FloatT val) { return val / denom; });
+  // dividing the nominator and denominator of [2] by the product of all uncertainties U gives
+  //   nominator: sum_i b_i / u_i
+  //   denominator: sum_i 1 / u_i - (n - 1) = 1 + sum_i (1 - u_i) / u_i = 1 + sum_i sum_k b_ik / u_i
+  // i.e., the evidences of all sources (up to the prior weight) are summed up
+  const FloatT evidence_sum = weighted_belief_sum(
+      opinions,
+      [](const OpinionT& opinion) { return static_cast<FloatT>(1.) / opinion.uncertainty(); },
+      result.belief_masses());
+  result.belief_masses() /= static_cast<FloatT>(1.) + evidence_sum;
 
   return result;
 }
 
-template <typename OpinionT>
-OpinionT Fusion::belief_constraint_fusion_operator(const std::vector<OpinionT>& opinions,
-                                                   std::vector<typename OpinionT::FLOAT_t> uncertainties,
-                                                   typename OpinionT::FLOAT_t uncertainty_product)
+template <typename OpinionRange, typename OpinionT>
+constexpr OpinionT Fusion::belief_constraint_fusion_operator(const OpinionRange& opinions)
   requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
 {
   OpinionT result;
 
   // since the belief constrained fusion is commutative, simply apply belief_constraint fusion sequentially
-  for (auto const& opinion : opinions)
+  for_each_entry(opinions, [&](const OpinionT& opinion) { result.bc_fuse_(opinion); });
+
+  return result;
+}
+
+template <typename OpinionRange, typename OpinionT>
+constexpr OpinionT Fusion::average_fusion_operator(const OpinionRange& opinions)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  using FloatT = typename OpinionT::FLOAT_t;
+  OpinionT result;
+
+  // as for the cumulative fusion, the nominator and denominator of [2] are divided by the product of all uncertainties
+  //   denominator: sum_i 1 / u_i = n + sum_i sum_k b_ik / u_i
+  const FloatT evidence_sum = weighted_belief_sum(
+      opinions,
+      [](const OpinionT& opinion) { return static_cast<FloatT>(1.) / opinion.uncertainty(); },
+      result.belief_masses());
+  result.belief_masses() /= static_cast<FloatT>(opinions.size()) + evidence_sum;
+
+  return result;
+}
+
+template <typename OpinionRange, typename OpinionT>
+constexpr OpinionT Fusion::weighted_fusion_operator(const OpinionRange& opinions)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  using FloatT = typename OpinionT::FLOAT_t;
+  OpinionT result;
+
+  // dividing the nominator and denominator of [2] by the product of all uncertainties gives
+  //   belief masses: sum_i c_i * b_i / sum_i c_i
+  //   uncertainty: sum_i (1 - u_i) / sum_i c_i
+  // with the confidence ratio c_i = (1 - u_i) / u_i of each opinion
+  // sum_i c_i is the evidence sum of the opinions (see the cumulative fusion), it is summed up within the same pass
+  Accumulator<FloatT> weight_sum;
+  weighted_belief_sum(
+      opinions,
+      [&weight_sum](const OpinionT& opinion) {
+        const FloatT uncertainty = opinion.uncertainty();
+        const FloatT confidence_ratio = (static_cast<FloatT>(1.) - uncertainty) / uncertainty;
+        weight_sum += confidence_ratio;
+        return confidence_ratio;
+      },
+      result.belief_masses());
+
+  // vacuous opinions only, there is nothing to weight
+  if (weight_sum.value() < EPS_v<FloatT>)
   {
-    result.bc_fuse_(opinion);
+    return OpinionT{};
   }
+  result.belief_masses() /= weight_sum.value();
 
   return result;
 }
 
-template <typename OpinionT>
-OpinionT Fusion::average_fusion_operator(const std::vector<OpinionT>& opinions,
-                                         std::vector<typename OpinionT::FLOAT_t> uncertainties,
-                                         typename OpinionT::FLOAT_t uncertainty_product)
+template <typename OpinionRange, typename OpinionT>
+constexpr OpinionT Fusion::consensus_compromise_fusion_operator(const OpinionRange& opinions)
   requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
 {
   constexpr std::size_t N = OpinionT::SIZE;
   using FloatT = typename OpinionT::FLOAT_t;
-  std::size_t n_elements = opinions.size();
-  OpinionT result;
+  using BeliefType = typename OpinionT::BeliefType;
+
+  // consensus step, the belief masses all opinions agree on
+  BeliefType consensus = opinions[0].belief_masses();
+  for_each_entry(opinions, [&](const OpinionT& opinion) {
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+      consensus[mass_idx] = std::min(consensus[mass_idx], opinion.belief_masses()[mass_idx]);
+    });
+  });
+  const FloatT consensus_sum = consensus.sum();
+
+  OpinionT result{ consensus };
+  // dogmatic opinions which agree on all belief masses, there is nothing to compromise
+  const FloatT non_consensus = static_cast<FloatT>(1.) - consensus_sum;
+  if (non_consensus < EPS_v<FloatT>)
+  {
+    return result;
+  }
 
-  // calculate the nominator, during calculation the belief_mass entries of the result are invalid
-  for (std::size_t mass_idx{ 0 }; mass_idx < N; ++mass_idx)
+  // compromise step, the compromise of [2] sums the products over all combinations that choose for each opinion
+  // either its uncertainty or the residue of one of its belief masses. a belief mass receives all products which
+  // choose it at least once, i.e., all products minus the products which do not choose it:
+  //   compromise_k = prod_i (u_i + r_i) - prod_i (u_i + r_i - r_ik)
+  // with the residues r_ik = b_ik - consensus_k and their sum r_i. by this, no combination has to be enumerated.
+  // u_i + r_i = 1 - consensus_sum holds for each opinion, the factors are divided by it, so that the products do not
+  // vanish with the number of opinions, i.e., all products are 1 and only the relation of the compromises matters.
+  // the product choosing the uncertainties of all opinions is the uncertainty prior to the normalization
+  FloatT uncertainty_product{ 1. };
+  BeliefType unchosen_products{ 1. };
+  for_each_entry(opinions, [&](const OpinionT& opinion) {
+    const BeliefType residues = opinion.belief_masses() - consensus;
+    uncertainty_product *= opinion.uncertainty();
+    constexpr_for<0, N, 1>(
+        [&](std::size_t mass_idx) { unchosen_products[mass_idx] *= 1 - residues[mass_idx] / non_consensus; });
+  });
+
+  BeliefType compromise{ 0. };
+  constexpr_for<0, N, 1>([&](std::size_t mass_idx) { compromise[mass_idx] = 1 - unchosen_products[mass_idx]; });
+  const FloatT compromise_sum = compromise.sum();
+
+  // without any residues, e.g., for equal opinions, the consensus is the result
+  // and the remaining mass is kept as uncertainty
+  if (compromise_sum < EPS_v<FloatT>)
   {
-    for (std::size_t opinion_idx{ 0 }; opinion_idx < n_elements; ++opinion_idx)
-    {
-      result.belief_masses()[mass_idx] +=
-          opinions[opinion_idx].belief_masses()[mass_idx] * uncertainty_product / uncertainties[opinion_idx];
-    }
+    return result;
   }
 
-  // sum of uncertainty products, where each product is omitting one specific uncertainty
-  FloatT denom =
-      std::accumulate(uncertainties.begin(), uncertainties.end(), 0., [uncertainty_product](FloatT sum, FloatT val) {
-        return sum + uncertainty_product / val;
-      });
-
-  // normalize belief_masses using the precalculated denominator
-  std::transform(result.belief_masses().begin(),
-                 result.belief_masses().end(),
-                 result.belief_masses().begin(),
-                 [denom](FloatT val) { return val / denom; });
+  // the compromise is scaled such that the fused opinion is normalized
+  const FloatT normalization = (non_consensus - uncertainty_product) / compromise_sum;
+  compromise *= normalization;
+  result.belief_masses() += compromise;
 
   return result;
 }
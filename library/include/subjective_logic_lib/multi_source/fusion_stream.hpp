@@ -0,0 +1,359 @@
+#pragma once
+
+// the reader is invited to refer to the following book as reference for the implementations within this file:
+// [1] Subjective Logic - A Formalism for Reasoning Under Uncertainty,
+// Audun Jøsang, 2016, https://doi.org/10.1007/978-3-319-42337-1
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <deque>
+
+#include "subjective_logic_lib/util.hpp"
+#include "subjective_logic_lib/opinions/opinion.hpp"
+
+namespace subjective_logic::multisource
+{
+
+/**
+ * @brief cumulative fusion of all observations of the last window_size time steps of a stream, e.g., the observations
+ * of a time-dependent subjective network.
+ * instead of fusing the whole history in each step, each observation is fused once when it is pushed and unfused
+ * using cum_unfuse_ once it leaves the window, i.e., each observation costs amortized O(N).
+ * since unfusion accumulates rounding errors (and is not defined for dogmatic opinions), the window is fused again
+ * from scratch after as many evictions as observations are stored, which keeps the amortized cost at O(N).
+ *
+ * the fused opinion equals the successive cumulative fusion of all observations within the window,
+ * for Opinion, the prior is the mean prior of these observations (see Fusion::average_prior).
+ *
+ * @tparam OpinionT - Opinion or OpinionNoBase
+ */
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+class WindowedFusionStream
+{
+public:
+  static constexpr std::size_t N = OpinionT::SIZE;
+  using FloatT = typename OpinionT::FLOAT_t;
+  using NoBaseType = OpinionNoBase<N, FloatT>;
+
+  /**
+   * @param window_size - number of time steps an observation is part of the fused opinion, at least 1
+   */
+  explicit WindowedFusionStream(std::size_t window_size);
+
+  /**
+   * @brief adds an observation to the current time step, O(N)
+   * @param opinion
+   */
+  void push(const OpinionT& opinion);
+
+  /**
+   * @brief moves on to the next time step(s), observations older than the window are removed,
+   *        skipping at least window_size steps clears the window in a single step
+   * @param num_steps - number of elapsed time steps
+   */
+  void advance(std::size_t num_steps = 1);
+
+  /**
+   * @brief removes all observations, the current time step is kept
+   */
+  void clear();
+
+  /**
+   * @brief fused opinion of all observations within the window, vacuous if there are none
+   */
+  [[nodiscard]] OpinionT result() const;
+
+  /**
+   * @brief number of observations within the window
+   */
+  [[nodiscard]] std::size_t size() const;
+
+  [[nodiscard]] std::size_t window_size() const;
+
+  /**
+   * @brief number of time steps which elapsed since the creation of the stream
+   */
+  [[nodiscard]] std::size_t time_step() const;
+
+protected:
+  struct Observation
+  {
+    std::size_t time_step;
+    OpinionT opinion;
+  };
+
+  /**
+   * @brief fuses all observations within the window from scratch
+   */
+  void refuse();
+
+  std::size_t window_size_;
+  std::size_t time_step_{ 0 };
+  std::size_t evictions_since_refuse_{ 0 };
+  std::deque<Observation> observations_;
+  NoBaseType fused_{};
+  // sum of the priors within the window, only used for Opinion
+  Array<N, double> prior_sum_{ 0. };
+};
+
+/**
+ * @brief cumulative fusion of a stream of observations with exponential forgetting, in each time step the evidence of
+ * the fused opinion is scaled by the decay factor (see OpinionNoBase::scale_evidence_) before new observations are
+ * fused, i.e., an observation made k time steps ago contributes decay^k of its evidence.
+ * each observation and each time step costs O(N), skipping multiple time steps is done in closed form using decay^k.
+ *
+ * dogmatic observations carry infinite evidence and do not decay (unless decay is 0).
+ * for Opinion, the prior is the average of all priors weighted with the same decay.
+ *
+ * @tparam OpinionT - Opinion or OpinionNoBase
+ */
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+class DecayedFusionStream
+{
+public:
+  static constexpr std::size_t N = OpinionT::SIZE;
+  using FloatT = typename OpinionT::FLOAT_t;
+  using NoBaseType = OpinionNoBase<N, FloatT>;
+
+  /**
+   * @param decay - share of evidence kept per time step, in [0, 1]
+   */
+  explicit DecayedFusionStream(FloatT decay);
+
+  /**
+   * @brief fuses an observation into the current time step, O(N)
+   * @param opinion
+   */
+  void push(const OpinionT& opinion);
+
+  /**
+   * @brief moves on to the next time step(s), the evidence is scaled by decay^num_steps, O(N)
+   * @param num_steps - number of elapsed time steps
+   */
+  void advance(std::size_t num_steps = 1);
+
+  /**
+   * @brief forgets all observations, the current time step is kept
+   */
+  void clear();
+
+  /**
+   * @brief fused opinion of all observations, vacuous if there are none
+   */
+  [[nodiscard]] OpinionT result() const;
+
+  [[nodiscard]] FloatT decay() const;
+
+  /**
+   * @brief number of time steps which elapsed since the creation of the stream
+   */
+  [[nodiscard]] std::size_t time_step() const;
+
+protected:
+  FloatT decay_;
+  std::size_t time_step_{ 0 };
+  NoBaseType fused_{};
+  // decayed mean of the priors and the decayed number of observations it is based on, only used for Opinion
+  Array<N, double> prior_mean_{ 0. };
+  double prior_weight_{ 0. };
+};
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+WindowedFusionStream<OpinionT>::WindowedFusionStream(std::size_t window_size)
+  : window_size_{ window_size }
+{
+  assert(window_size_ > 0);
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+void WindowedFusionStream<OpinionT>::push(const OpinionT& opinion)
+{
+  observations_.push_back({ time_step_, opinion });
+  fused_.cum_fuse_(NoBaseType{ opinion.belief_masses() });
+  if constexpr (is_opinion<OpinionT>)
+  {
+    constexpr_for<0, N, 1>(
+        [&](std::size_t mass_idx) { prior_sum_[mass_idx] += opinion.prior_belief_masses()[mass_idx]; });
+  }
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+void WindowedFusionStream<OpinionT>::advance(std::size_t num_steps)
+{
+  time_step_ += num_steps;
+  if (num_steps >= window_size_)
+  {
+    // closed form, no observation is left
+    clear();
+    return;
+  }
+
+  bool requires_refuse{ false };
+  while (not observations_.empty() and observations_.front().time_step + window_size_ <= time_step_)
+  {
+    const auto& evicted = observations_.front();
+    if constexpr (is_opinion<OpinionT>)
+    {
+      constexpr_for<0, N, 1>(
+          [&](std::size_t mass_idx) { prior_sum_[mass_idx] -= evicted.opinion.prior_belief_masses()[mass_idx]; });
+    }
+    // unfusion is not defined for dogmatic opinions, the remaining window is fused again instead
+    requires_refuse = requires_refuse or std::abs(evicted.opinion.uncertainty()) < EPS_v<FloatT>;
+    if (not requires_refuse)
+    {
+      fused_.cum_unfuse_(NoBaseType{ evicted.opinion.belief_masses() });
+    }
+    ++evictions_since_refuse_;
+    observations_.pop_front();
+  }
+
+  if (requires_refuse or evictions_since_refuse_ > observations_.size())
+  {
+    refuse();
+  }
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+void WindowedFusionStream<OpinionT>::clear()
+{
+  observations_.clear();
+  fused_ = NoBaseType{};
+  prior_sum_ = Array<N, double>{ 0. };
+  evictions_since_refuse_ = 0;
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+void WindowedFusionStream<OpinionT>::refuse()
+{
+  fused_ = NoBaseType{};
+  for (const auto& observation : observations_)
+  {
+    fused_.cum_fuse_(NoBaseType{ observation.opinion.belief_masses() });
+  }
+  evictions_since_refuse_ = 0;
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+OpinionT WindowedFusionStream<OpinionT>::result() const
+{
+  OpinionT result{ fused_.belief_masses() };
+  if constexpr (is_opinion<OpinionT>)
+  {
+    if (not observations_.empty())
+    {
+      const double num_observations = static_cast<double>(observations_.size());
+      constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+        result.prior_belief_masses()[mass_idx] = static_cast<FloatT>(prior_sum_[mass_idx] / num_observations);
+      });
+    }
+  }
+  return result;
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+std::size_t WindowedFusionStream<OpinionT>::size() const
+{
+  return observations_.size();
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+std::size_t WindowedFusionStream<OpinionT>::window_size() const
+{
+  return window_size_;
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+std::size_t WindowedFusionStream<OpinionT>::time_step() const
+{
+  return time_step_;
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+DecayedFusionStream<OpinionT>::DecayedFusionStream(FloatT decay)
+  : decay_{ decay }
+{
+  assert(decay_ >= 0. and decay_ <= 1.);
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+void DecayedFusionStream<OpinionT>::push(const OpinionT& opinion)
+{
+  fused_.cum_fuse_(NoBaseType{ opinion.belief_masses() });
+  if constexpr (is_opinion<OpinionT>)
+  {
+    // running mean, which does not underflow even if the weight of the previous observations does
+    prior_weight_ += 1.;
+    constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+      prior_mean_[mass_idx] += (opinion.prior_belief_masses()[mass_idx] - prior_mean_[mass_idx]) / prior_weight_;
+    });
+  }
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+void DecayedFusionStream<OpinionT>::advance(std::size_t num_steps)
+{
+  time_step_ += num_steps;
+  const double factor = std::pow(static_cast<double>(decay_), static_cast<double>(num_steps));
+  fused_.scale_evidence_(static_cast<FloatT>(factor));
+  if constexpr (is_opinion<OpinionT>)
+  {
+    prior_weight_ *= factor;
+  }
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+void DecayedFusionStream<OpinionT>::clear()
+{
+  fused_ = NoBaseType{};
+  prior_mean_ = Array<N, double>{ 0. };
+  prior_weight_ = 0.;
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+OpinionT DecayedFusionStream<OpinionT>::result() const
+{
+  OpinionT result{ fused_.belief_masses() };
+  if constexpr (is_opinion<OpinionT>)
+  {
+    if (prior_weight_ > 0.)
+    {
+      constexpr_for<0, N, 1>([&](std::size_t mass_idx) {
+        result.prior_belief_masses()[mass_idx] = static_cast<FloatT>(prior_mean_[mass_idx]);
+      });
+    }
+  }
+  return result;
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+typename DecayedFusionStream<OpinionT>::FloatT DecayedFusionStream<OpinionT>::decay() const
+{
+  return decay_;
+}
+
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+std::size_t DecayedFusionStream<OpinionT>::time_step() const
+{
+  return time_step_;
+}
+
+}  // namespace subjective_logic::multisource
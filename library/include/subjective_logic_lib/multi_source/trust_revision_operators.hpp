@@ -4,8 +4,13 @@
 // [1] Subjective Logic - A Formalism for Reasoning Under Uncertainty,
 // Audun Jøsang, 2016, https://doi.org/10.1007/978-3-319-42337-1
 
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <iostream>
 #include <numeric>
+#include <span>
+#include <tuple>
 #include <vector>
 
 #include "subjective_logic_lib/util.hpp"
@@ -13,6 +18,9 @@
 #include "subjective_logic_lib/opinions/trusted_opinion.hpp"
 #include "subjective_logic_lib/multi_source/fusion_operators.hpp"
 #include "subjective_logic_lib/multi_source/conflict_operators.hpp"
+#include "subjective_logic_lib/multi_source/conflict_tracker.hpp"
+#include "subjective_logic_lib/multi_source/evaluation_context.hpp"
+#include "subjective_logic_lib/multi_source/workspace.hpp"
 
 #define BELIEF_REVISION_FOLLOWING_JOSAN 1
 
@@ -33,6 +41,9 @@ struct TrustRevision
     HARMONY_REFERENCE_FUSION
   };
 
+  // trust revision type, conflict type and weight of a revision within a weighted mix of revisions
+  using WeightedTypes = std::tuple<TrustRevisionType, Conflict::ConflictType, double>;
+
   template <typename TrustedOpinionT>
   static inline std::vector<typename TrustedOpinionT::FLOAT_t>
   revision_factors(TrustRevisionType trust_revision_type,
@@ -53,38 +64,175 @@ struct TrustRevision
                    std::optional<std::vector<bool>> use_opinion = std::nullopt)
     requires is_trusted_opinion<TrustedOpinionT>;
 
-protected:
-  // RevisionOperator is used internally, to type the functions for the specific operator implementation
+  /**
+   * revision factors of the trusted opinions of a contiguous range using the buffers of the given workspace,
+   * once the workspace has grown to the number of opinions, no heap allocation is performed
+   * @tparam TrustedOpinionT
+   * @param trust_revision_type
+   * @param conflict_type
+   * @param opinions
+   * @param workspace
+   * @return the revision factor of each opinion, refers to workspace.revision_factors
+   */
   template <typename TrustedOpinionT>
-  using RevisionOperator =
-      std::function<std::vector<typename TrustedOpinionT::FLOAT_t>(Conflict::ConflictType conflict_type,
-                                                                   const std::vector<TrustedOpinionT>&)>;
+  static inline std::span<const typename TrustedOpinionT::FLOAT_t>
+  revision_factors(TrustRevisionType trust_revision_type,
+                   Conflict::ConflictType conflict_type,
+                   std::span<const TrustedOpinionT> opinions,
+                   Workspace<typename TrustedOpinionT::OpinionT>& workspace)
+    requires is_trusted_opinion<TrustedOpinionT>;
 
   /**
-   * Todo add source of own paper
-   * calculates revision factors as given in [1] extended for the multi-source case as proposed in [OWN PAPER] using the
-   * accumulated conflict
+   * same as above with the trust revision chosen at compile time, i.e., without any runtime dispatch
+   * @tparam TrustRevisionT
    * @tparam TrustedOpinionT
+   * @param conflict_type
    * @param opinions
-   * @return
+   * @param workspace
+   * @return the revision factor of each opinion, refers to workspace.revision_factors
    */
-  template <Conflict::RelationType RelationT, typename TrustedOpinionT>
-  static inline std::vector<typename TrustedOpinionT::FLOAT_t>
-  normal_trust_revision(Conflict::ConflictType conflict_type, const std::vector<TrustedOpinionT>& opinions)
+  template <TrustRevisionType TrustRevisionT, typename TrustedOpinionT>
+  static inline std::span<const typename TrustedOpinionT::FLOAT_t>
+  revision_factors(Conflict::ConflictType conflict_type,
+                   std::span<const TrustedOpinionT> opinions,
+                   Workspace<typename TrustedOpinionT::OpinionT>& workspace)
     requires is_trusted_opinion<TrustedOpinionT>;
 
-  template <Conflict::RelationType RelationT, typename TrustedOpinionT>
-  static inline std::vector<typename TrustedOpinionT::FLOAT_t>
-  conflict_shares_trust_revision(Conflict::ConflictType conflict_type,
-                                 const std::vector<TrustedOpinionT>& opinions,
-                                 bool positive_scores_only = false)
-    requires is_trusted_opinion<TrustedOpinionT>;
+  /**
+   * revision factors of the CONFLICT_SHARES (HARMONY_SHARES) trust revision with the AVERAGE conflict type for sources
+   * tracked by a ConflictTracker, i.e., in O(n) instead of O(n^2 * N) if only few sources changed since the last call.
+   * the shares of the tracker are only defined for the AVERAGE conflict type, all other conflict types (ACCUMULATE and
+   * the belief conflict types) have to use the overload with the conflict type and the trusted opinions
+   * @tparam OpinionT
+   * @tparam RelationT - CONFLICT for CONFLICT_SHARES, HARMONY for HARMONY_SHARES
+   * @param tracker - tracks the (not discounted) opinions of the trusted opinions
+   * @param revision_factors - output, the revision factor of each tracked source
+   * @param positive_scores_only - true for CONFLICT_SHARES (HARMONY_SHARES), false for the ALLOW_NEGATIVE variants
+   */
+  template <typename OpinionT, Conflict::RelationType RelationT>
+  static inline void revision_factors(const ConflictTracker<OpinionT, RelationT>& tracker,
+                                      std::span<typename OpinionT::FLOAT_t> revision_factors,
+                                      bool positive_scores_only = true);
 
-  template <Conflict::RelationType RelationT, typename TrustedOpinionT>
-  static inline std::vector<typename TrustedOpinionT::FLOAT_t>
-  reference_fusion_trust_revision(Conflict::ConflictType conflict_type,
-                                  const std::vector<TrustedOpinionT>& trusted_opinions)
-    requires is_trusted_opinion<TrustedOpinionT>;
+  /**
+   * revision factors of the trusted opinions already evaluated by workspace.context, i.e., the context is not
+   * evaluated again and its reference fusions are shared with all other calls on the same context,
+   * e.g., the revision types of a weighted trusted fusion
+   * @tparam OpinionT
+   * @param trust_revision_type
+   * @param conflict_type
+   * @param workspace
+   * @return the revision factor of each opinion, refers to workspace.revision_factors
+   */
+  template <typename OpinionT>
+  static inline std::span<const typename OpinionT::FLOAT_t> revision_factors(TrustRevisionType trust_revision_type,
+                                                                             Conflict::ConflictType conflict_type,
+                                                                             Workspace<OpinionT>& workspace)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * same as above with the trust revision chosen at compile time
+   * @tparam TrustRevisionT
+   * @tparam OpinionT
+   * @param conflict_type
+   * @param workspace
+   * @return the revision factor of each opinion, refers to workspace.revision_factors
+   */
+  template <TrustRevisionType TrustRevisionT, typename OpinionT>
+  static inline std::span<const typename OpinionT::FLOAT_t> revision_factors(Conflict::ConflictType conflict_type,
+                                                                             Workspace<OpinionT>& workspace)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+  /**
+   * weighted sum of the revision factors of several revision types of the trusted opinions already evaluated by
+   * workspace.context, equals the weighted sum of revision_factors of each type.
+   * instead of evaluating each type on its own, the intermediates shared by several types are evaluated once, i.e.,
+   * the uncertainty differentials of all NORMAL types, the conflict shares of all SHARES types of the same relation
+   * and the conflict and harmony with the reference fusion of all REFERENCE_FUSION types of the same conflict type
+   * @tparam OpinionT
+   * @param weighted_types
+   * @param workspace
+   * @return the weighted revision factor of each opinion, refers to workspace.weighted_revision_factors
+   */
+  template <typename OpinionT>
+  static inline std::span<const typename OpinionT::FLOAT_t>
+  weighted_revision_factors(std::span<const WeightedTypes> weighted_types, Workspace<OpinionT>& workspace)
+    requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>;
+
+protected:
+  /**
+   * conflict (or harmony) of the discounted opinions of the context, the belief conflict types use the reference
+   * fusion of the context
+   * @tparam RelationT
+   * @tparam OpinionT
+   * @param conflict_type
+   * @param context
+   * @return
+   */
+  template <Conflict::RelationType RelationT, typename OpinionT>
+  static inline typename OpinionT::FLOAT_t discounted_relation(Conflict::ConflictType conflict_type,
+                                                               EvaluationContext<OpinionT>& context);
+
+  /**
+   * Todo add source of own paper
+   * calculates revision factors as given in [1] extended for the multi-source case as proposed in [OWN PAPER] using the
+   * accumulated conflict
+   * @tparam OpinionT
+   * @param workspace - evaluated context, the revision factors are written to workspace.revision_factors
+   */
+  template <Conflict::RelationType RelationT, typename OpinionT>
+  static inline void normal_trust_revision(Conflict::ConflictType conflict_type, Workspace<OpinionT>& workspace);
+
+  template <Conflict::RelationType RelationT, typename OpinionT>
+  static inline void conflict_shares_trust_revision(Conflict::ConflictType conflict_type,
+                                                    Workspace<OpinionT>& workspace,
+                                                    bool positive_scores_only = false);
+
+  /**
+   * revision factor of a single source given the overall relation and the share of the source
+   */
+  template <Conflict::RelationType RelationT, typename FloatT>
+  static inline FloatT share_revision_factor(FloatT relation, FloatT share, bool positive_scores_only);
+
+  template <Conflict::RelationType RelationT, typename OpinionT>
+  static inline void reference_fusion_trust_revision(Conflict::ConflictType conflict_type,
+                                                     Workspace<OpinionT>& workspace);
+
+  /**
+   * revision factor of a single source given its relation with the reference fusion and the maximum and average
+   * relation of all sources with the reference fusion
+   */
+  template <Conflict::RelationType RelationT, typename FloatT>
+  static inline FloatT reference_revision_factor(FloatT relation, FloatT max_relation, FloatT avg_relation);
+
+  /**
+   * adds the weighted revision factors of all (HARMONY_)SHARES types of weighted_types to
+   * workspace.weighted_revision_factors, the conflict shares are evaluated once
+   * @tparam RelationT - CONFLICT for the CONFLICT_SHARES types, HARMONY for the HARMONY_SHARES types
+   * @tparam OpinionT
+   * @tparam RelationFunction - overall relation of the discounted opinions for a relation and conflict type
+   * @param weighted_types
+   * @param workspace
+   * @param relation
+   */
+  template <Conflict::RelationType RelationT, typename OpinionT, typename RelationFunction>
+  static inline void add_weighted_shares(std::span<const WeightedTypes> weighted_types,
+                                         Workspace<OpinionT>& workspace,
+                                         RelationFunction&& relation);
+
+  /**
+   * adds the weighted revision factors of all (HARMONY_)REFERENCE_FUSION types with the given conflict type to
+   * workspace.weighted_revision_factors, the conflict and harmony of each opinion with the reference fusion are
+   * evaluated in a single pass
+   * @tparam OpinionT
+   * @param conflict_type - belief conflict type, defines the reference fusion
+   * @param weighted_types
+   * @param workspace
+   */
+  template <typename OpinionT>
+  static inline void add_weighted_reference_fusion(Conflict::ConflictType conflict_type,
+                                                   std::span<const WeightedTypes> weighted_types,
+                                                   Workspace<OpinionT>& workspace);
 };
 
 template <typename TrustedOpinionT>
@@ -135,45 +283,62 @@ TrustRevision::revision_factors(TrustRevisionType trust_revision_type,
     opinions_used = std::move(opinions);
   }
 
+  Workspace<typename TrustedOpinionT::OpinionT> workspace;
+  auto revision_factors = TrustRevision::revision_factors(
+      trust_revision_type, conflict_type, std::span<const TrustedOpinionT>{ opinions_used }, workspace);
+  return { revision_factors.begin(), revision_factors.end() };
+}
+
+template <typename TrustedOpinionT>
+inline std::span<const typename TrustedOpinionT::FLOAT_t>
+TrustRevision::revision_factors(TrustRevisionType trust_revision_type,
+                                Conflict::ConflictType conflict_type,
+                                std::span<const TrustedOpinionT> opinions,
+                                Workspace<typename TrustedOpinionT::OpinionT>& workspace)
+  requires is_trusted_opinion<TrustedOpinionT>
+{
+  workspace.context.evaluate(opinions);
+  return revision_factors(trust_revision_type, conflict_type, workspace);
+}
+
+template <typename OpinionT>
+inline std::span<const typename OpinionT::FLOAT_t> TrustRevision::revision_factors(
+    TrustRevisionType trust_revision_type, Conflict::ConflictType conflict_type, Workspace<OpinionT>& workspace)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
   switch (trust_revision_type)
   {
     case TrustRevisionType::NORMAL:
     {
-      return normal_trust_revision<Conflict::RelationType::CONFLICT, TrustedOpinionT>(conflict_type, opinions_used);
+      return revision_factors<TrustRevisionType::NORMAL>(conflict_type, workspace);
     }
     case TrustRevisionType::HARMONY_NORMAL:
     {
-      return normal_trust_revision<Conflict::RelationType::HARMONY, TrustedOpinionT>(conflict_type, opinions_used);
+      return revision_factors<TrustRevisionType::HARMONY_NORMAL>(conflict_type, workspace);
     }
     case TrustRevisionType::CONFLICT_SHARES:
     {
-      return conflict_shares_trust_revision<Conflict::RelationType::CONFLICT, TrustedOpinionT>(
-          conflict_type, opinions_used, true);
+      return revision_factors<TrustRevisionType::CONFLICT_SHARES>(conflict_type, workspace);
     }
     case TrustRevisionType::CONFLICT_SHARES_ALLOW_NEGATIVE:
     {
-      return conflict_shares_trust_revision<Conflict::RelationType::CONFLICT, TrustedOpinionT>(
-          conflict_type, opinions_used, false);
+      return revision_factors<TrustRevisionType::CONFLICT_SHARES_ALLOW_NEGATIVE>(conflict_type, workspace);
     }
     case TrustRevisionType::HARMONY_SHARES:
     {
-      return conflict_shares_trust_revision<Conflict::RelationType::HARMONY, TrustedOpinionT>(
-          conflict_type, opinions_used, true);
+      return revision_factors<TrustRevisionType::HARMONY_SHARES>(conflict_type, workspace);
     }
     case TrustRevisionType::HARMONY_SHARES_ALLOW_NEGATIVE:
     {
-      return conflict_shares_trust_revision<Conflict::RelationType::HARMONY, TrustedOpinionT>(
-          conflict_type, opinions_used, false);
+      return revision_factors<TrustRevisionType::HARMONY_SHARES_ALLOW_NEGATIVE>(conflict_type, workspace);
     }
     case TrustRevisionType::REFERENCE_FUSION:
     {
-      return reference_fusion_trust_revision<Conflict::RelationType::CONFLICT, TrustedOpinionT>(conflict_type,
-                                                                                                opinions_used);
+      return revision_factors<TrustRevisionType::REFERENCE_FUSION>(conflict_type, workspace);
     }
     case TrustRevisionType::HARMONY_REFERENCE_FUSION:
     {
-      return reference_fusion_trust_revision<Conflict::RelationType::HARMONY, TrustedOpinionT>(conflict_type,
-                                                                                               opinions_used);
+      return revision_factors<TrustRevisionType::HARMONY_REFERENCE_FUSION>(conflict_type, workspace);
     }
     default:
     {
@@ -183,30 +348,101 @@ TrustRevision::revision_factors(TrustRevisionType trust_revision_type,
   }
 }
 
-template <Conflict::RelationType RelationT, typename TrustedOpinionT>
-inline std::vector<typename TrustedOpinionT::FLOAT_t>
-TrustRevision::normal_trust_revision(Conflict::ConflictType conflict_type, const std::vector<TrustedOpinionT>& opinions)
+template <TrustRevision::TrustRevisionType TrustRevisionT, typename TrustedOpinionT>
+inline std::span<const typename TrustedOpinionT::FLOAT_t>
+TrustRevision::revision_factors(Conflict::ConflictType conflict_type,
+                                std::span<const TrustedOpinionT> opinions,
+                                Workspace<typename TrustedOpinionT::OpinionT>& workspace)
   requires is_trusted_opinion<TrustedOpinionT>
 {
-  using FloatT = typename TrustedOpinionT::FLOAT_t;
-  std::size_t num_ops{ opinions.size() };
+  workspace.context.evaluate(opinions);
+  return revision_factors<TrustRevisionT>(conflict_type, workspace);
+}
 
-  std::vector<typename TrustedOpinionT::OpinionT> discounted_opinions =
-      TrustedOpinionT::extractDiscountedOpinions(opinions);
+template <TrustRevision::TrustRevisionType TrustRevisionT, typename OpinionT>
+inline std::span<const typename OpinionT::FLOAT_t> TrustRevision::revision_factors(Conflict::ConflictType conflict_type,
+                                                                                   Workspace<OpinionT>& workspace)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  using RelationType = Conflict::RelationType;
+  if constexpr (TrustRevisionT == TrustRevisionType::NORMAL)
+  {
+    normal_trust_revision<RelationType::CONFLICT>(conflict_type, workspace);
+  }
+  else if constexpr (TrustRevisionT == TrustRevisionType::HARMONY_NORMAL)
+  {
+    normal_trust_revision<RelationType::HARMONY>(conflict_type, workspace);
+  }
+  else if constexpr (TrustRevisionT == TrustRevisionType::CONFLICT_SHARES)
+  {
+    conflict_shares_trust_revision<RelationType::CONFLICT>(conflict_type, workspace, true);
+  }
+  else if constexpr (TrustRevisionT == TrustRevisionType::CONFLICT_SHARES_ALLOW_NEGATIVE)
+  {
+    conflict_shares_trust_revision<RelationType::CONFLICT>(conflict_type, workspace, false);
+  }
+  else if constexpr (TrustRevisionT == TrustRevisionType::HARMONY_SHARES)
+  {
+    conflict_shares_trust_revision<RelationType::HARMONY>(conflict_type, workspace, true);
+  }
+  else if constexpr (TrustRevisionT == TrustRevisionType::HARMONY_SHARES_ALLOW_NEGATIVE)
+  {
+    conflict_shares_trust_revision<RelationType::HARMONY>(conflict_type, workspace, false);
+  }
+  else if constexpr (TrustRevisionT == TrustRevisionType::REFERENCE_FUSION)
+  {
+    reference_fusion_trust_revision<RelationType::CONFLICT>(conflict_type, workspace);
+  }
+  else
+  {
+    static_assert(TrustRevisionT == TrustRevisionType::HARMONY_REFERENCE_FUSION, "unknown trust revision type");
+    reference_fusion_trust_revision<RelationType::HARMONY>(conflict_type, workspace);
+  }
+  return workspace.revision_factors;
+}
 
-  std::vector<FloatT> uncertainty_differentials = Conflict::uncertainty_differentials(opinions);
-  FloatT conflict;
+template <Conflict::RelationType RelationT, typename OpinionT>
+inline typename OpinionT::FLOAT_t TrustRevision::discounted_relation(Conflict::ConflictType conflict_type,
+                                                                     EvaluationContext<OpinionT>& context)
+{
+  std::span<const OpinionT> discounted_opinions{ context.discounted_opinions() };
+  if (conflict_type == Conflict::ConflictType::ACCUMULATE or conflict_type == Conflict::ConflictType::AVERAGE)
+  {
+    if constexpr (RelationT == Conflict::RelationType::CONFLICT)
+    {
+      return Conflict::conflict(conflict_type, discounted_opinions);
+    }
+    else
+    {
+      return Conflict::harmony(conflict_type, discounted_opinions);
+    }
+  }
+
+  const OpinionT& reference_fusion = context.reference_fusion(Conflict::get_belief_fusion_type(conflict_type));
   if constexpr (RelationT == Conflict::RelationType::CONFLICT)
   {
-    conflict = Conflict::conflict(conflict_type, discounted_opinions);
+    return Conflict::conflict(conflict_type, discounted_opinions, reference_fusion);
   }
   else
   {
-    conflict = Conflict::harmony(conflict_type, discounted_opinions);
+    return Conflict::harmony(conflict_type, discounted_opinions, reference_fusion);
   }
+}
 
-  std::vector<FloatT> revision_factors;
-  revision_factors.reserve(num_ops);
+template <Conflict::RelationType RelationT, typename OpinionT>
+inline void TrustRevision::normal_trust_revision(Conflict::ConflictType conflict_type, Workspace<OpinionT>& workspace)
+{
+  using FloatT = typename OpinionT::FLOAT_t;
+  auto& context = workspace.context;
+  std::size_t num_ops{ context.size() };
+
+  auto& uncertainty_differentials = workspace.relations;
+  uncertainty_differentials.resize(num_ops);
+  Conflict::uncertainty_differentials(context.trust_uncertainties(), std::span{ uncertainty_differentials });
+  FloatT conflict = discounted_relation<RelationT>(conflict_type, context);
+
+  auto& revision_factors = workspace.revision_factors;
+  revision_factors.clear();
   for (std::size_t idx{ 0 }; idx < num_ops; ++idx)
   {
     FloatT score = uncertainty_differentials[idx] * conflict;
@@ -216,111 +452,320 @@ TrustRevision::normal_trust_revision(Conflict::ConflictType conflict_type, const
     }
     revision_factors.push_back(score);
   }
-
-  return revision_factors;
 }
 
-template <Conflict::RelationType RelationT, typename TrustedOpinionT>
-inline std::vector<typename TrustedOpinionT::FLOAT_t>
-TrustRevision::conflict_shares_trust_revision(Conflict::ConflictType conflict_type,
-                                              const std::vector<TrustedOpinionT>& opinions,
-                                              bool positive_scores_only)
-  requires is_trusted_opinion<TrustedOpinionT>
+template <Conflict::RelationType RelationT, typename OpinionT>
+inline void TrustRevision::conflict_shares_trust_revision(Conflict::ConflictType conflict_type,
+                                                          Workspace<OpinionT>& workspace,
+                                                          bool positive_scores_only)
 {
-  using FloatT = typename TrustedOpinionT::FLOAT_t;
-  std::size_t num_ops{ opinions.size() };
-
-  auto raw_opinions = TrustedOpinionT::extractOpinions(opinions);
-  std::vector<typename TrustedOpinionT::OpinionT> discounted_opinions =
-      TrustedOpinionT::extractDiscountedOpinions(opinions);
+  using FloatT = typename OpinionT::FLOAT_t;
+  auto& context = workspace.context;
+  std::size_t num_ops{ context.size() };
 
   // it only makes sense to distribute conflict based on average fusion, thus conflict_shares are calculated using
   // AVERAGE if, however, the demanded conflict type differs, the absolute overall conflict is calculated with the
   // respective conflict type
 
   //  auto [conflict, conflict_shares] = Conflict::conflict_shares<RelationT>(Conflict::ConflictType::AVERAGE,
-  //  discounted_opinions);
+  //  context.discounted_opinions());
   auto [conflict, conflict_shares] =
-      Conflict::conflict_shares<RelationT>(Conflict::ConflictType::AVERAGE, raw_opinions);
+      Conflict::conflict_shares<RelationT>(Conflict::ConflictType::AVERAGE, context.opinions(), workspace);
   if (conflict_type != Conflict::ConflictType::AVERAGE)
   {
-    if constexpr (RelationT == Conflict::RelationType::CONFLICT)
+    conflict = discounted_relation<RelationT>(conflict_type, context);
+  }
+
+  auto& revision_factors = workspace.revision_factors;
+  revision_factors.clear();
+  for (std::size_t idx{ 0 }; idx < num_ops; ++idx)
+  {
+    revision_factors.push_back(
+        share_revision_factor<RelationT>(static_cast<FloatT>(conflict), conflict_shares[idx], positive_scores_only));
+  }
+}
+
+template <Conflict::RelationType RelationT, typename FloatT>
+inline FloatT TrustRevision::share_revision_factor(FloatT relation, FloatT share, bool positive_scores_only)
+{
+  if (positive_scores_only and share < 0)
+  {
+    return 0;
+  }
+  FloatT scaled_share = relation * share;
+  if constexpr (RelationT == Conflict::RelationType::HARMONY)
+  {
+    scaled_share *= -1;
+  }
+  return scaled_share;
+}
+
+template <typename OpinionT, Conflict::RelationType RelationT>
+inline void TrustRevision::revision_factors(const ConflictTracker<OpinionT, RelationT>& tracker,
+                                            std::span<typename OpinionT::FLOAT_t> revision_factors,
+                                            bool positive_scores_only)
+{
+  assert(revision_factors.size() == tracker.size());
+  const auto relation = tracker.average();
+  for (std::size_t idx{ 0 }; idx < tracker.size(); ++idx)
+  {
+    revision_factors[idx] = share_revision_factor<RelationT>(relation, tracker.share(idx), positive_scores_only);
+  }
+}
+
+template <Conflict::RelationType RelationT, typename OpinionT>
+inline void TrustRevision::reference_fusion_trust_revision(Conflict::ConflictType conflict_type,
+                                                           Workspace<OpinionT>& workspace)
+{
+  auto& context = workspace.context;
+  std::size_t num_ops{ context.size() };
+
+  auto& belief_conflicts = workspace.relations;
+  belief_conflicts.resize(num_ops);
+  // the reference is the fusion of the discounted opinions in both cases, shared with all other users of the context
+  const Fusion::FusionType reference_fusion_type = Conflict::get_belief_fusion_type(conflict_type);
+  const OpinionT& reference_fusion = context.reference_fusion(reference_fusion_type);
+#ifdef BELIEF_REVISION_FOLLOWING_JOSAN
+  std::span<const OpinionT> opinions{ context.opinions() };
+#else
+  std::span<const OpinionT> opinions{ context.discounted_opinions() };
+#endif
+  auto [max_conflict, avg_conflict] = Conflict::belief_conflicts<RelationT>(
+      reference_fusion_type, opinions, std::span{ belief_conflicts }, { reference_fusion });
+
+  auto& revision_factors = workspace.revision_factors;
+  revision_factors.clear();
+  for (std::size_t idx{ 0 }; idx < num_ops; ++idx)
+  {
+    revision_factors.push_back(reference_revision_factor<RelationT>(belief_conflicts[idx], max_conflict, avg_conflict));
+  }
+}
+
+template <Conflict::RelationType RelationT, typename FloatT>
+inline FloatT TrustRevision::reference_revision_factor(FloatT relation, FloatT max_relation, FloatT avg_relation)
+{
+  FloatT relative_relation = relation - avg_relation;
+  if (relative_relation <= 0)
+  {
+    return 0;
+  }
+  FloatT revision_factor = max_relation * relative_relation / (max_relation - avg_relation);
+  if constexpr (RelationT == Conflict::RelationType::HARMONY)
+  {
+    revision_factor *= -1;
+  }
+  return revision_factor;
+}
+
+template <typename OpinionT>
+inline std::span<const typename OpinionT::FLOAT_t>
+TrustRevision::weighted_revision_factors(std::span<const WeightedTypes> weighted_types, Workspace<OpinionT>& workspace)
+  requires is_opinion<OpinionT> or is_opinion_no_base<OpinionT>
+{
+  using FloatT = typename OpinionT::FLOAT_t;
+  using RelationType = Conflict::RelationType;
+  using ConflictType = Conflict::ConflictType;
+  constexpr std::size_t NUM_CONFLICT_TYPES{ static_cast<std::size_t>(ConflictType::BELIEF_WEIGHTED) + 1 };
+  auto& context = workspace.context;
+  const std::size_t num_ops{ context.size() };
+
+  auto& weighted_revision_factors = workspace.weighted_revision_factors;
+  weighted_revision_factors.assign(num_ops, 0.);
+
+  // overall conflict and harmony of the discounted opinions, evaluated at most once per conflict type
+  std::array<std::array<FloatT, NUM_CONFLICT_TYPES>, 2> relations{};
+  std::array<std::array<bool, NUM_CONFLICT_TYPES>, 2> is_evaluated{};
+  auto relation = [&](RelationType relation_type, ConflictType conflict_type) {
+    const auto relation_idx = static_cast<std::size_t>(relation_type);
+    const auto type_idx = static_cast<std::size_t>(conflict_type);
+    if (not is_evaluated[relation_idx][type_idx])
     {
-      conflict = Conflict::conflict(conflict_type, discounted_opinions);
+      relations[relation_idx][type_idx] = relation_type == RelationType::CONFLICT
+                                               ? discounted_relation<RelationType::CONFLICT>(conflict_type, context)
+                                               : discounted_relation<RelationType::HARMONY>(conflict_type, context);
+      is_evaluated[relation_idx][type_idx] = true;
     }
-    else
+    return relations[relation_idx][type_idx];
+  };
+
+  // the NORMAL factors are the uncertainty differentials scaled by the overall relation, i.e., all NORMAL types sum
+  // up to the differentials scaled by the weighted sum of their relations
+  bool has_normal{ false };
+  FloatT normal_scale{ 0. };
+  std::array<bool, 2> has_shares{};
+  std::array<bool, NUM_CONFLICT_TYPES> has_reference_fusion{};
+  for (auto [trust_revision_type, conflict_type, weight] : weighted_types)
+  {
+    switch (trust_revision_type)
     {
-      conflict = Conflict::harmony(conflict_type, discounted_opinions);
+      case TrustRevisionType::NORMAL:
+      {
+        has_normal = true;
+        normal_scale += weight * relation(RelationType::CONFLICT, conflict_type);
+        break;
+      }
+      case TrustRevisionType::HARMONY_NORMAL:
+      {
+        has_normal = true;
+        normal_scale -= weight * relation(RelationType::HARMONY, conflict_type);
+        break;
+      }
+      case TrustRevisionType::CONFLICT_SHARES:
+      case TrustRevisionType::CONFLICT_SHARES_ALLOW_NEGATIVE:
+      {
+        has_shares[static_cast<std::size_t>(RelationType::CONFLICT)] = true;
+        break;
+      }
+      case TrustRevisionType::HARMONY_SHARES:
+      case TrustRevisionType::HARMONY_SHARES_ALLOW_NEGATIVE:
+      {
+        has_shares[static_cast<std::size_t>(RelationType::HARMONY)] = true;
+        break;
+      }
+      case TrustRevisionType::REFERENCE_FUSION:
+      case TrustRevisionType::HARMONY_REFERENCE_FUSION:
+      {
+        has_reference_fusion[static_cast<std::size_t>(conflict_type)] = true;
+        break;
+      }
+      default:
+      {
+        throw std::logic_error{ "TrustRevision is not yet implemented for: " +
+                                std::to_string(static_cast<int>(trust_revision_type)) };
+      }
     }
   }
 
-  std::vector<FloatT> revision_factors;
-  revision_factors.reserve(num_ops);
-  for (std::size_t idx{ 0 }; idx < num_ops; ++idx)
+  if (has_normal)
   {
-    FloatT share = conflict_shares[idx];
-    if (positive_scores_only and share < 0)
+    auto& uncertainty_differentials = workspace.relations;
+    uncertainty_differentials.resize(num_ops);
+    Conflict::uncertainty_differentials(context.trust_uncertainties(), std::span{ uncertainty_differentials });
+    for (std::size_t idx{ 0 }; idx < num_ops; ++idx)
     {
-      revision_factors.push_back(0);
-      continue;
+      weighted_revision_factors[idx] += uncertainty_differentials[idx] * normal_scale;
     }
-    FloatT scaled_share = conflict * share;
-    if constexpr (RelationT == Conflict::RelationType::HARMONY)
+  }
+  if (has_shares[static_cast<std::size_t>(RelationType::CONFLICT)])
+  {
+    add_weighted_shares<RelationType::CONFLICT>(weighted_types, workspace, relation);
+  }
+  if (has_shares[static_cast<std::size_t>(RelationType::HARMONY)])
+  {
+    add_weighted_shares<RelationType::HARMONY>(weighted_types, workspace, relation);
+  }
+  for (std::size_t type_idx{ 0 }; type_idx < NUM_CONFLICT_TYPES; ++type_idx)
+  {
+    if (has_reference_fusion[type_idx])
     {
-      scaled_share *= -1;
+      add_weighted_reference_fusion(static_cast<ConflictType>(type_idx), weighted_types, workspace);
     }
-    revision_factors.push_back(scaled_share);
   }
-
-  return revision_factors;
+  return weighted_revision_factors;
 }
 
-template <Conflict::RelationType RelationT, typename TrustedOpinionT>
-inline std::vector<typename TrustedOpinionT::FLOAT_t>
-TrustRevision::reference_fusion_trust_revision(Conflict::ConflictType conflict_type,
-                                               const std::vector<TrustedOpinionT>& trusted_opinions)
-  requires is_trusted_opinion<TrustedOpinionT>
+template <Conflict::RelationType RelationT, typename OpinionT, typename RelationFunction>
+inline void TrustRevision::add_weighted_shares(std::span<const WeightedTypes> weighted_types,
+                                               Workspace<OpinionT>& workspace,
+                                               RelationFunction&& relation)
 {
-  using FloatT = typename TrustedOpinionT::FLOAT_t;
-  std::size_t num_ops{ trusted_opinions.size() };
-
-  auto discounted_opinions = TrustedOpinionT::extractDiscountedOpinions(trusted_opinions);
+  using FloatT = typename OpinionT::FLOAT_t;
+  constexpr bool IS_CONFLICT = RelationT == Conflict::RelationType::CONFLICT;
+  constexpr TrustRevisionType POSITIVE_TYPE{ IS_CONFLICT ? TrustRevisionType::CONFLICT_SHARES
+                                                         : TrustRevisionType::HARMONY_SHARES };
+  constexpr TrustRevisionType NEGATIVE_TYPE{ IS_CONFLICT ? TrustRevisionType::CONFLICT_SHARES_ALLOW_NEGATIVE
+                                                         : TrustRevisionType::HARMONY_SHARES_ALLOW_NEGATIVE };
+  auto& weighted_revision_factors = workspace.weighted_revision_factors;
+
+  // see conflict_shares_trust_revision, the shares of all types are the AVERAGE shares of the opinions
+  auto [average_relation, conflict_shares] =
+      Conflict::conflict_shares<RelationT>(Conflict::ConflictType::AVERAGE, workspace.context.opinions(), workspace);
+  for (auto [trust_revision_type, conflict_type, weight] : weighted_types)
+  {
+    if (trust_revision_type != POSITIVE_TYPE and trust_revision_type != NEGATIVE_TYPE)
+    {
+      continue;
+    }
+    const FloatT type_relation =
+        conflict_type == Conflict::ConflictType::AVERAGE ? average_relation : relation(RelationT, conflict_type);
+    for (std::size_t idx{ 0 }; idx < conflict_shares.size(); ++idx)
+    {
+      weighted_revision_factors[idx] +=
+          weight * share_revision_factor<RelationT>(
+                       type_relation, conflict_shares[idx], trust_revision_type == POSITIVE_TYPE);
+    }
+  }
+}
 
+template <typename OpinionT>
+inline void TrustRevision::add_weighted_reference_fusion(Conflict::ConflictType conflict_type,
+                                                         std::span<const WeightedTypes> weighted_types,
+                                                         Workspace<OpinionT>& workspace)
+{
+  using FloatT = typename OpinionT::FLOAT_t;
+  using RelationType = Conflict::RelationType;
+  auto& context = workspace.context;
+  const std::size_t num_ops{ context.size() };
+
+  // see reference_fusion_trust_revision, the projection of the reference fusion and of each opinion is shared by the
+  // conflict and the harmony
+  const OpinionT& reference_fusion = context.reference_fusion(Conflict::get_belief_fusion_type(conflict_type));
+  const auto reference_projection = Conflict::relation_projection(reference_fusion);
+  const FloatT reference_certainty = static_cast<FloatT>(1.) - reference_fusion.uncertainty();
 #ifdef BELIEF_REVISION_FOLLOWING_JOSAN
-  auto opinions = TrustedOpinionT::extractOpinions(trusted_opinions);
-  // use the discounted opinions for fusion here
-  typename TrustedOpinionT::OpinionT reference_fusion =
-      Fusion::fuse_opinions(Conflict::get_belief_fusion_type(conflict_type), discounted_opinions);
-  auto [belief_conflicts, max_conflict, avg_conflict] = Conflict::belief_conflicts<RelationT>(
-      Conflict::get_belief_fusion_type(conflict_type), opinions, { reference_fusion });
+  std::span<const OpinionT> opinions{ context.opinions() };
 #else
-  auto [belief_conflicts, max_conflict, avg_conflict] =
-      Conflict::belief_conflicts<RelationT>(Conflict::get_belief_fusion_type(conflict_type), discounted_opinions);
+  std::span<const OpinionT> opinions{ context.discounted_opinions() };
 #endif
 
-  FloatT denom = max_conflict - avg_conflict;
-
-  std::vector<FloatT> revision_factors;
-  revision_factors.reserve(num_ops);
+  auto& conflicts = workspace.relations;
+  auto& harmonies = workspace.harmonies;
+  conflicts.resize(num_ops);
+  harmonies.resize(num_ops);
+  FloatT max_conflict{ 0. };
+  FloatT max_harmony{ 0. };
+  Accumulator<FloatT> acc_conflict;
+  Accumulator<FloatT> acc_harmony;
   for (std::size_t idx{ 0 }; idx < num_ops; ++idx)
   {
-    FloatT relative_conflict = belief_conflicts[idx] - avg_conflict;
+    const auto projection = Conflict::relation_projection(opinions[idx]);
+    const FloatT certainty = static_cast<FloatT>(1.) - opinions[idx].uncertainty();
+    conflicts[idx] = Conflict::projected_relation<RelationType::CONFLICT>(
+        reference_projection, reference_certainty, projection, certainty);
+    harmonies[idx] = Conflict::projected_relation<RelationType::HARMONY>(
+        reference_projection, reference_certainty, projection, certainty);
+    max_conflict = std::max(max_conflict, conflicts[idx]);
+    max_harmony = std::max(max_harmony, harmonies[idx]);
+    acc_conflict += conflicts[idx];
+    acc_harmony += harmonies[idx];
+  }
+  const auto avg_conflict = static_cast<FloatT>(acc_conflict.sum() / num_ops);
+  const auto avg_harmony = static_cast<FloatT>(acc_harmony.sum() / num_ops);
 
-    if (relative_conflict <= 0)
+  auto& weighted_revision_factors = workspace.weighted_revision_factors;
+  for (auto [trust_revision_type, type_conflict_type, weight] : weighted_types)
+  {
+    if (type_conflict_type != conflict_type)
     {
-      revision_factors.push_back(0);
       continue;
     }
-    FloatT revision_factor = max_conflict * relative_conflict / denom;
-
-    if constexpr (RelationT == Conflict::RelationType::HARMONY)
+    if (trust_revision_type == TrustRevisionType::REFERENCE_FUSION)
     {
-      revision_factor *= -1;
+      for (std::size_t idx{ 0 }; idx < num_ops; ++idx)
+      {
+        weighted_revision_factors[idx] +=
+            weight * reference_revision_factor<RelationType::CONFLICT>(conflicts[idx], max_conflict, avg_conflict);
+      }
+    }
+    else if (trust_revision_type == TrustRevisionType::HARMONY_REFERENCE_FUSION)
+    {
+      for (std::size_t idx{ 0 }; idx < num_ops; ++idx)
+      {
+        weighted_revision_factors[idx] +=
+            weight * reference_revision_factor<RelationType::HARMONY>(harmonies[idx], max_harmony, avg_harmony);
+      }
     }
-    revision_factors.push_back(revision_factor);
   }
-
-  return revision_factors;
 }
 
-}  // namespace subjective_logic::multisource
\ No newline at end of file
+}  // namespace subjective_logic::multisource
@@ -13,6 +13,7 @@
 
 #include <iostream>
 #include <numeric>
+#include <span>
 #include <vector>
 #include <tuple>
 
@@ -21,13 +22,14 @@
 #include "subjective_logic_lib/multi_source/conflict_operators.hpp"
 #include "subjective_logic_lib/multi_source/fusion_operators.hpp"
 #include "subjective_logic_lib/multi_source/trust_revision_operators.hpp"
+#include "subjective_logic_lib/multi_source/workspace.hpp"
 
 namespace subjective_logic::multisource
 {
 
 struct TrustedFusion
 {
-  using WeightedTypes = std::tuple<TrustRevision::TrustRevisionType, Conflict::ConflictType, double>;
+  using WeightedTypes = TrustRevision::WeightedTypes;
 
   template <typename TrustedOpinionT>
   static inline TrustedOpinionT::OpinionT fuse_opinions(Fusion::FusionType fusion_type,
@@ -60,23 +62,66 @@ struct TrustedFusion
                                                          std::vector<TrustedOpinionT>& trusted_opinions)
     requires is_trusted_opinion<TrustedOpinionT>;
 
+  /**
+   * fusion of the trusted opinions of a contiguous range using the buffers of the given workspace,
+   * once the workspace has grown to the number of opinions, no heap allocation is performed
+   * @tparam TrustedOpinionT
+   * @param fusion_type
+   * @param trust_revision_type
+   * @param conflict_type
+   * @param trusted_opinions
+   * @param workspace
+   * @return
+   */
+  template <typename TrustedOpinionT>
+  static inline TrustedOpinionT::OpinionT fuse_opinions(Fusion::FusionType fusion_type,
+                                                        TrustRevision::TrustRevisionType trust_revision_type,
+                                                        Conflict::ConflictType conflict_type,
+                                                        std::span<const TrustedOpinionT> trusted_opinions,
+                                                        Workspace<typename TrustedOpinionT::OpinionT>& workspace)
+    requires is_trusted_opinion<TrustedOpinionT>;
+
+  template <typename TrustedOpinionT>
+  static inline TrustedOpinionT::OpinionT fuse_opinions(Fusion::FusionType fusion_type,
+                                                        std::span<const WeightedTypes> weighted_conflict_types,
+                                                        std::span<const TrustedOpinionT> trusted_opinions,
+                                                        Workspace<typename TrustedOpinionT::OpinionT>& workspace)
+    requires is_trusted_opinion<TrustedOpinionT>;
+
+  template <typename TrustedOpinionT>
+  static inline TrustedOpinionT::OpinionT fuse_opinions_(Fusion::FusionType fusion_type,
+                                                         TrustRevision::TrustRevisionType trust_revision_type,
+                                                         Conflict::ConflictType conflict_type,
+                                                         std::span<TrustedOpinionT> trusted_opinions,
+                                                         Workspace<typename TrustedOpinionT::OpinionT>& workspace)
+    requires is_trusted_opinion<TrustedOpinionT>;
+
+  template <typename TrustedOpinionT>
+  static inline TrustedOpinionT::OpinionT fuse_opinions_(Fusion::FusionType fusion_type,
+                                                         std::span<const WeightedTypes> weighted_conflict_types,
+                                                         std::span<TrustedOpinionT> trusted_opinions,
+                                                         Workspace<typename TrustedOpinionT::OpinionT>& workspace)
+    requires is_trusted_opinion<TrustedOpinionT>;
+
 protected:
   /**
    * applies the fusion operation and can be used for inplace or copy based operation
    * in order to allow const and non const types, additional template parameter have been added
    * @tparam TrustedOpinionT - trusted opinion type
-   * @tparam Vector - either const or non const vector of TrustedOpinion
+   * @tparam Span - either const or non const span of TrustedOpinion
    * @tparam RevisionFunction - revision function either uses const or non const types
    * @param fusion_type
    * @param weighted_types
    * @param trusted_opinions
+   * @param workspace
    * @param revision_function
    * @return
    */
-  template <typename TrustedOpinionT, typename Vector, typename RevisionFunction>
+  template <typename TrustedOpinionT, typename Span, typename RevisionFunction>
   static inline TrustedOpinionT::OpinionT fusion_calculation(Fusion::FusionType fusion_type,
-                                                             std::vector<WeightedTypes> weighted_types,
-                                                             Vector trusted_opinions,
+                                                             std::span<const WeightedTypes> weighted_types,
+                                                             Span trusted_opinions,
+                                                             Workspace<typename TrustedOpinionT::OpinionT>& workspace,
                                                              RevisionFunction&& revision_function)
     requires is_trusted_opinion<TrustedOpinionT>;
 };
@@ -109,33 +154,81 @@ TrustedOpinionT::OpinionT TrustedFusion::fuse_opinions(Fusion::FusionType fusion
                                                        const std::vector<TrustedOpinionT>& trusted_opinions)
   requires is_trusted_opinion<TrustedOpinionT>
 {
-  auto revision_function = [](const TrustedOpinionT& top, typename TrustedOpinionT::FLOAT_t revision_factor) {
-    TrustedOpinionT copy{ top.revise_trust(revision_factor) };
-    return copy.discounted_opinion();
-  };
-
-  return fusion_calculation<TrustedOpinionT, const std::vector<TrustedOpinionT>&>(
-      fusion_type, weighted_conflict_types, trusted_opinions, revision_function);
+  Workspace<typename TrustedOpinionT::OpinionT> workspace;
+  return fuse_opinions(fusion_type,
+                       std::span<const WeightedTypes>{ weighted_conflict_types },
+                       std::span<const TrustedOpinionT>{ trusted_opinions },
+                       workspace);
 }
 
 template <typename TrustedOpinionT>
 TrustedOpinionT::OpinionT TrustedFusion::fuse_opinions(Fusion::FusionType fusion_type,
                                                        const std::vector<TrustedOpinionT>& trusted_opinions)
   requires is_trusted_opinion<TrustedOpinionT>
+{
+  Workspace<typename TrustedOpinionT::OpinionT> workspace;
+  return fuse_opinions(
+      fusion_type, std::span<const WeightedTypes>{}, std::span<const TrustedOpinionT>{ trusted_opinions }, workspace);
+}
+
+template <typename TrustedOpinionT>
+TrustedOpinionT::OpinionT TrustedFusion::fuse_opinions_(Fusion::FusionType fusion_type,
+                                                        std::vector<WeightedTypes> weighted_conflict_types,
+                                                        std::vector<TrustedOpinionT>& trusted_opinions)
+  requires is_trusted_opinion<TrustedOpinionT>
+{
+  Workspace<typename TrustedOpinionT::OpinionT> workspace;
+  return fuse_opinions_(fusion_type,
+                        std::span<const WeightedTypes>{ weighted_conflict_types },
+                        std::span<TrustedOpinionT>{ trusted_opinions },
+                        workspace);
+}
+
+template <typename TrustedOpinionT>
+inline TrustedOpinionT::OpinionT TrustedFusion::fuse_opinions(Fusion::FusionType fusion_type,
+                                                              TrustRevision::TrustRevisionType trust_revision_type,
+                                                              Conflict::ConflictType conflict_type,
+                                                              std::span<const TrustedOpinionT> trusted_opinions,
+                                                              Workspace<typename TrustedOpinionT::OpinionT>& workspace)
+  requires is_trusted_opinion<TrustedOpinionT>
+{
+  const WeightedTypes types = { trust_revision_type, conflict_type, 1.0 };
+  return fuse_opinions(fusion_type, std::span<const WeightedTypes>{ &types, 1 }, trusted_opinions, workspace);
+}
+
+template <typename TrustedOpinionT>
+TrustedOpinionT::OpinionT TrustedFusion::fuse_opinions(Fusion::FusionType fusion_type,
+                                                       std::span<const WeightedTypes> weighted_conflict_types,
+                                                       std::span<const TrustedOpinionT> trusted_opinions,
+                                                       Workspace<typename TrustedOpinionT::OpinionT>& workspace)
+  requires is_trusted_opinion<TrustedOpinionT>
 {
   auto revision_function = [](const TrustedOpinionT& top, typename TrustedOpinionT::FLOAT_t revision_factor) {
     TrustedOpinionT copy{ top.revise_trust(revision_factor) };
     return copy.discounted_opinion();
   };
 
-  return fusion_calculation<TrustedOpinionT, const std::vector<TrustedOpinionT>&>(
-      fusion_type, {}, trusted_opinions, revision_function);
+  return fusion_calculation<TrustedOpinionT>(
+      fusion_type, weighted_conflict_types, trusted_opinions, workspace, revision_function);
+}
+
+template <typename TrustedOpinionT>
+inline TrustedOpinionT::OpinionT TrustedFusion::fuse_opinions_(Fusion::FusionType fusion_type,
+                                                               TrustRevision::TrustRevisionType trust_revision_type,
+                                                               Conflict::ConflictType conflict_type,
+                                                               std::span<TrustedOpinionT> trusted_opinions,
+                                                               Workspace<typename TrustedOpinionT::OpinionT>& workspace)
+  requires is_trusted_opinion<TrustedOpinionT>
+{
+  const WeightedTypes types = { trust_revision_type, conflict_type, 1.0 };
+  return fuse_opinions_(fusion_type, std::span<const WeightedTypes>{ &types, 1 }, trusted_opinions, workspace);
 }
 
 template <typename TrustedOpinionT>
 TrustedOpinionT::OpinionT TrustedFusion::fuse_opinions_(Fusion::FusionType fusion_type,
-                                                        std::vector<WeightedTypes> weighted_conflict_types,
-                                                        std::vector<TrustedOpinionT>& trusted_opinions)
+                                                        std::span<const WeightedTypes> weighted_conflict_types,
+                                                        std::span<TrustedOpinionT> trusted_opinions,
+                                                        Workspace<typename TrustedOpinionT::OpinionT>& workspace)
   requires is_trusted_opinion<TrustedOpinionT>
 {
   auto revision_function = [](TrustedOpinionT& top, typename TrustedOpinionT::FLOAT_t revision_factor) {
@@ -143,14 +236,15 @@ TrustedOpinionT::OpinionT TrustedFusion::fuse_opinions_(Fusion::FusionType fusio
     return top.discounted_opinion();
   };
 
-  return fusion_calculation<TrustedOpinionT, std::vector<TrustedOpinionT>&>(
-      fusion_type, weighted_conflict_types, trusted_opinions, revision_function);
+  return fusion_calculation<TrustedOpinionT>(
+      fusion_type, weighted_conflict_types, trusted_opinions, workspace, revision_function);
 }
 
-template <typename TrustedOpinionT, typename Vector, typename RevisionFunction>
+template <typename TrustedOpinionT, typename Span, typename RevisionFunction>
 TrustedOpinionT::OpinionT TrustedFusion::fusion_calculation(Fusion::FusionType fusion_type,
-                                                            std::vector<WeightedTypes> weighted_types,
-                                                            Vector trusted_opinions,
+                                                            std::span<const WeightedTypes> weighted_types,
+                                                            Span trusted_opinions,
+                                                            Workspace<typename TrustedOpinionT::OpinionT>& workspace,
                                                             RevisionFunction&& revision_function)
   requires is_trusted_opinion<TrustedOpinionT>
 {
@@ -158,28 +252,34 @@ TrustedOpinionT::OpinionT TrustedFusion::fusion_calculation(Fusion::FusionType f
   using OpinionT = typename TrustedOpinionT::OpinionT;
   const std::size_t number_ops = trusted_opinions.size();
 
+  // the opinions are discounted once and the reference fusions are shared by all revision types
+  auto& context = workspace.context;
+  context.evaluate(std::span<const TrustedOpinionT>{ trusted_opinions });
+
   // in case that the list of types is empty, there is simply no trust revision
-  std::vector<FloatT> weighted_revision_factors(number_ops, 0.);
-  for (auto [trust_revision_type, conflict_type, weight] : weighted_types)
-  {
-    std::vector<FloatT> revision_factors =
-        TrustRevision::revision_factors(trust_revision_type, conflict_type, trusted_opinions);
+  std::span<const FloatT> weighted_revision_factors =
+      TrustRevision::weighted_revision_factors(weighted_types, workspace);
 
-    for (std::size_t op_idx{ 0 }; op_idx < number_ops; ++op_idx)
+  // a revision factor of zero does not change the trust, i.e., the discounted opinion of the context is reused
+  bool is_revised{ false };
+  auto& revised_opinions = workspace.revised_opinions;
+  revised_opinions.clear();
+  for (std::size_t op_idx{ 0 }; op_idx < number_ops; ++op_idx)
+  {
+    if (weighted_revision_factors[op_idx] == 0.)
     {
-      weighted_revision_factors[op_idx] += weight * revision_factors[op_idx];
+      revised_opinions.push_back(context.discounted_opinions()[op_idx]);
+      continue;
     }
+    revised_opinions.push_back(revision_function(trusted_opinions[op_idx], weighted_revision_factors[op_idx]));
+    is_revised = true;
   }
 
-  std::vector<OpinionT> discounted_opinions;
-  discounted_opinions.reserve(number_ops);
-  std::transform(trusted_opinions.begin(),
-                 trusted_opinions.end(),
-                 weighted_revision_factors.begin(),
-                 std::back_inserter(discounted_opinions),
-                 revision_function);
-
-  return Fusion::fuse_opinions(fusion_type, discounted_opinions);
+  if (not is_revised)
+  {
+    return context.reference_fusion(fusion_type);
+  }
+  return Fusion::fuse_opinions(fusion_type, std::span<const OpinionT>{ revised_opinions });
 }
 
 }  // namespace subjective_logic::multisource
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "subjective_logic_lib/util.hpp"
+#include "subjective_logic_lib/types/accumulator.hpp"
+#include "subjective_logic_lib/multi_source/evaluation_context.hpp"
+
+namespace subjective_logic::multisource
+{
+
+/**
+ * @brief reusable buffers of the span based overloads of Conflict, TrustRevision and TrustedFusion.
+ * the buffers only grow, i.e., once a workspace has been used for the largest number of sources,
+ * later calls do not perform any heap allocation.
+ * a workspace must not be shared between threads, results returned as spans refer to the workspace and are valid
+ * until the workspace is used for the next call.
+ *
+ * each buffer is used by a single level of the call hierarchy only, so that nested calls
+ * (e.g., TrustedFusion -> TrustRevision -> Conflict) can share one workspace. the only exception is the evaluation
+ * context, which is evaluated by the outermost call and shared by all nested calls.
+ *
+ * @tparam OpinionT - Opinion or OpinionNoBase, for trusted opinions the type of the opinions (not of the trusts)
+ */
+template <typename OpinionT>
+  requires(is_opinion<OpinionT> or is_opinion_no_base<OpinionT>)
+struct Workspace
+{
+  using FloatT = typename OpinionT::FLOAT_t;
+
+  /**
+   * @brief reserves all buffers for the given number of sources, not required but avoids the allocations of the
+   * first calls
+   * @param num_sources
+   */
+  void reserve(std::size_t num_sources)
+  {
+    subset.reserve(num_sources);
+    conflict_shares.reserve(num_sources);
+    relation_sums.reserve(num_sources);
+    projections.reserve(num_sources);
+    certainties.reserve(num_sources);
+    context.reserve(num_sources);
+    relations.reserve(num_sources);
+    harmonies.reserve(num_sources);
+    revision_factors.reserve(num_sources);
+    weighted_revision_factors.reserve(num_sources);
+    revised_opinions.reserve(num_sources);
+  }
+
+  // Conflict::conflict_shares, opinions without the one whose share is calculated, the summed up pairwise relations
+  // of each opinion and the resulting shares
+  std::vector<OpinionT> subset;
+  std::vector<Accumulator<FloatT>> relation_sums;
+  std::vector<FloatT> conflict_shares;
+
+  // Conflict::pairwise_matrix, projected probabilities and certainties (1 - u) of all opinions
+  std::vector<typename OpinionT::BeliefType> projections;
+  std::vector<FloatT> certainties;
+
+  // TrustRevision and TrustedFusion, (discounted) opinions of the trusted opinions and their reference fusions
+  EvaluationContext<OpinionT> context;
+
+  // TrustRevision::revision_factors, the uncertainty differentials or the conflicts with the reference fusion and the
+  // resulting revision factors
+  std::vector<FloatT> relations;
+  std::vector<FloatT> revision_factors;
+  // TrustRevision::weighted_revision_factors, the harmonies with the reference fusion (the conflicts are in relations)
+  std::vector<FloatT> harmonies;
+
+  // TrustedFusion::fuse_opinions, accumulated revision factors of all revision types
+  // (see TrustRevision::weighted_revision_factors) and the revised opinions
+  std::vector<FloatT> weighted_revision_factors;
+  std::vector<OpinionT> revised_opinions;
+};
+
+}  // namespace subjective_logic::multisource
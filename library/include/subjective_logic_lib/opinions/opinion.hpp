@@ -496,6 +496,19 @@ public:
   CUDA_AVAIL
   constexpr Opinion cum_unfuse(Opinion other) const;
 
+  /**
+   * @brief makes function available from protected inheritance, the prior is not affected
+   * @return the scaled opinion
+   */
+  CUDA_AVAIL
+  constexpr Opinion& scale_evidence_(FloatT factor);
+  /**
+   * @brief makes function available from protected inheritance, the prior is not affected
+   * @return the scaled opinion
+   */
+  CUDA_AVAIL
+  constexpr Opinion scale_evidence(FloatT factor) const;
+
   /**
    * @brief extends the function of the base class, since the prior is implicitly available
    * @return the projectedProbability
@@ -1099,6 +1112,18 @@ constexpr Opinion<N, FloatT> Opinion<N, FloatT>::cum_unfuse(Opinion other) const
 {
   return Opinion(*this).cum_unfuse_(other);
 }
+
+template <std::size_t N, typename FloatT>
+constexpr Opinion<N, FloatT>& Opinion<N, FloatT>::scale_evidence_(FloatT factor)
+{
+  opinion_no_base_.scale_evidence_(factor);
+  return *this;
+}
+template <std::size_t N, typename FloatT>
+constexpr Opinion<N, FloatT> Opinion<N, FloatT>::scale_evidence(FloatT factor) const
+{
+  return Opinion(*this).scale_evidence_(factor);
+}
 template <std::size_t N, typename FloatT>
 constexpr typename Opinion<N, FloatT>::BeliefType Opinion<N, FloatT>::harmony(Opinion other) const
 {
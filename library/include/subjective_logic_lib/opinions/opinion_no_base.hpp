@@ -434,6 +434,23 @@ public:
   CUDA_AVAIL
   constexpr OpinionNoBase cum_unfuse(OpinionNoBase other) const;
 
+  /**
+   * @brief scales the evidence of the opinion inplace, e.g., to let old evidence decay over time
+   *        factor = 1 keeps the opinion, factor = 0 results in a vacuous opinion,
+   *        dogmatic opinions (infinite evidence) are not affected by any positive factor
+   * @param factor - non negative scaling factor of the evidence
+   * @return the scaled opinion
+   */
+  CUDA_AVAIL
+  constexpr OpinionNoBase& scale_evidence_(FloatT factor);
+  /**
+   * @brief scales the evidence of the opinion using a copy
+   * @param factor - non negative scaling factor of the evidence
+   * @return the scaled opinion
+   */
+  CUDA_AVAIL
+  constexpr OpinionNoBase scale_evidence(FloatT factor) const;
+
   /**
    * @brief calculates the harmony of two opinion, which is later used for the belief constrained fusion
    * @param other
@@ -972,7 +989,7 @@ constexpr FloatT OpinionNoBase<N, FloatT>::degree_of_conflict(OpinionNoBase othe
   }
   FloatT proj_prob_distance{ 0. };
   BeliefType prob_this = getProjection(base_rate);
-  BeliefType prob_other = other.getProjection(base_rate);
+  BeliefType prob_other = other.getProjection(base_rate_other);
 
   constexpr_for<0, N, 1>([&](std::size_t idx) { proj_prob_distance += std::abs(prob_this[idx] - prob_other[idx]); });
   proj_prob_distance /= 2.;
@@ -1002,11 +1019,11 @@ constexpr FloatT OpinionNoBase<N, FloatT>::degree_of_harmony(OpinionNoBase other
 {
   if constexpr (is_binomial<N>)
   {
-    return degree_of_conflict(other, base_rate.front(), base_rate_other.front());
+    return degree_of_harmony(other, base_rate.front(), base_rate_other.front());
   }
   FloatT proj_prob_distance{ 0. };
   BeliefType prob_this = getProjection(base_rate);
-  BeliefType prob_other = other.getProjection(base_rate);
+  BeliefType prob_other = other.getProjection(base_rate_other);
 
   constexpr_for<0, N, 1>([&](std::size_t idx) { proj_prob_distance += std::abs(prob_this[idx] - prob_other[idx]); });
   proj_prob_distance /= 2.;
@@ -1171,6 +1188,30 @@ constexpr OpinionNoBase<N, FloatT> OpinionNoBase<N, FloatT>::cum_unfuse(OpinionN
   return OpinionNoBase(*this).cum_unfuse_(other);
 }
 
+template <std::size_t N, typename FloatT>
+constexpr OpinionNoBase<N, FloatT>& OpinionNoBase<N, FloatT>::scale_evidence_(FloatT factor)
+{
+  // the evidence r_i = W * b_i / u is scaled to factor * r_i,
+  // which results in b_i' = factor * b_i / (u + factor * (1 - u)) independent of the prior weight W
+  FloatT uncertainty = this->uncertainty();
+  FloatT denom = uncertainty + factor * (static_cast<FloatT>(1.) - uncertainty);
+  if (std::abs(denom) < EPS_v<FloatT>)
+  {
+    // all evidence is forgotten
+    belief_masses_ = VacuousBeliefDistr();
+    return *this;
+  }
+
+  FloatT scale = factor / denom;
+  constexpr_for<0, N, 1>([this, scale](std::size_t idx) { belief_masses_[idx] *= scale; });
+  return *this;
+}
+template <std::size_t N, typename FloatT>
+constexpr OpinionNoBase<N, FloatT> OpinionNoBase<N, FloatT>::scale_evidence(FloatT factor) const
+{
+  return OpinionNoBase(*this).scale_evidence_(factor);
+}
+
 template <std::size_t N, typename FloatT>
 constexpr typename OpinionNoBase<N, FloatT>::BeliefType OpinionNoBase<N, FloatT>::harmony(OpinionNoBase other) const
 {
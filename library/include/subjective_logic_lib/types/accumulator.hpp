@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "subjective_logic_lib/util.hpp"
+
+namespace subjective_logic
+{
+
+/**
+ * @brief precision of the sums over many opinions, e.g., within the multi-source fusion and conflict operators.
+ *        the opinions keep their (compact) floating point type, only the sums are affected
+ */
+enum class AccumulationPolicy : int
+{
+  // plain sum in the floating point type of the opinions
+  NATIVE = 0,
+  // plain sum in at least double precision, i.e., float opinions are summed up in double
+  WIDENED,
+  // compensated (Kahan) sum in the floating point type of the opinions
+  COMPENSATED,
+};
+
+/**
+ * @brief ACCUMULATION allows to specify the accumulation policy used within eSLIM++ for a floating point type.
+ *        float is summed up in double, which is cheap and more accurate than a compensated float sum,
+ *        double uses the compensated sum. the struct may be specialized to change the policy of a type
+ */
+template <typename FloatT>
+struct ACCUMULATION
+{
+  static constexpr AccumulationPolicy value{ std::is_same_v<FloatT, float> ? AccumulationPolicy::WIDENED
+                                                                            : AccumulationPolicy::COMPENSATED };
+};
+
+/**
+ * @brief shortcut definition to access the value of a specific ACCUMULATION struct
+ */
+template <typename FloatT>
+static constexpr AccumulationPolicy ACCUMULATION_v{ ACCUMULATION<FloatT>::value };
+
+/**
+ * @brief sums up values of the type FloatT according to the given accumulation policy
+ * @tparam FloatT - type of the summed up values and of the result
+ * @tparam Policy
+ */
+template <typename FloatT, AccumulationPolicy Policy = ACCUMULATION_v<FloatT>>
+class Accumulator
+{
+public:
+  /**
+   * @brief type of the internal sum, the terms should be calculated in this type if they are products
+   */
+  using SumType =
+      std::conditional_t<Policy == AccumulationPolicy::WIDENED and sizeof(FloatT) < sizeof(double), double, FloatT>;
+
+  CUDA_AVAIL constexpr Accumulator() = default;
+
+  /**
+   * @brief initializes the sum with the given value, e.g., 0 when used within an Array
+   */
+  CUDA_AVAIL constexpr explicit Accumulator(SumType value);
+
+  /**
+   * @brief adds a value to the sum
+   */
+  CUDA_AVAIL constexpr Accumulator& operator+=(SumType value);
+
+  /**
+   * @brief the sum in the precision of the accumulation, e.g., to divide two sums before rounding to FloatT
+   */
+  [[nodiscard]] CUDA_AVAIL constexpr SumType sum() const;
+
+  /**
+   * @brief the sum rounded to FloatT
+   */
+  [[nodiscard]] CUDA_AVAIL constexpr FloatT value() const;
+
+protected:
+  SumType sum_{ 0 };
+  // running compensation of the lost low-order bits, only used by the compensated sum
+  SumType compensation_{ 0 };
+};
+
+template <typename FloatT, AccumulationPolicy Policy>
+constexpr Accumulator<FloatT, Policy>::Accumulator(SumType value) : sum_{ value }
+{
+}
+
+template <typename FloatT, AccumulationPolicy Policy>
+constexpr Accumulator<FloatT, Policy>& Accumulator<FloatT, Policy>::operator+=(SumType value)
+{
+  if constexpr (Policy == AccumulationPolicy::COMPENSATED)
+  {
+    const SumType term = value - compensation_;
+    const SumType sum = sum_ + term;
+    compensation_ = (sum - sum_) - term;
+    sum_ = sum;
+  }
+  else
+  {
+    sum_ += value;
+  }
+  return *this;
+}
+
+template <typename FloatT, AccumulationPolicy Policy>
+constexpr typename Accumulator<FloatT, Policy>::SumType Accumulator<FloatT, Policy>::sum() const
+{
+  return sum_;
+}
+
+template <typename FloatT, AccumulationPolicy Policy>
+constexpr FloatT Accumulator<FloatT, Policy>::value() const
+{
+  return static_cast<FloatT>(sum_);
+}
+
+}  // namespace subjective_logic
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace subjective_logic
+{
+
+/**
+ * @brief default alignment used for batch storage, a full cache line which also satisfies the requirements of all
+ *        common vector instruction sets (up to AVX-512)
+ */
+static constexpr std::size_t BATCH_ALIGNMENT{ 64 };
+
+/**
+ * @brief minimal allocator handing out memory aligned to the given boundary.
+ *        it is meant to be used with std::vector to obtain contiguous lanes that the compiler can safely vectorize.
+ *        not available with CUDA, device memory must be managed by the user.
+ * @tparam T - value type
+ * @tparam Alignment - alignment in bytes, must be a power of two
+ */
+template <typename T, std::size_t Alignment = BATCH_ALIGNMENT>
+struct AlignedAllocator
+{
+  static_assert((Alignment & (Alignment - 1)) == 0, "alignment must be a power of two");
+  static_assert(Alignment >= alignof(T), "alignment must not be smaller than the natural alignment of T");
+
+  using value_type = T;
+
+  template <typename U>
+  struct rebind
+  {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  constexpr AlignedAllocator() noexcept = default;
+
+  template <typename U>
+  constexpr AlignedAllocator(const AlignedAllocator<U, Alignment>& /*other*/) noexcept
+  {
+  }
+
+  [[nodiscard]] T* allocate(std::size_t n)
+  {
+    return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ Alignment }));
+  }
+
+  void deallocate(T* ptr, std::size_t /*n*/) noexcept
+  {
+    ::operator delete(ptr, std::align_val_t{ Alignment });
+  }
+
+  template <typename U>
+  constexpr bool operator==(const AlignedAllocator<U, Alignment>& /*other*/) const noexcept
+  {
+    return true;
+  }
+};
+
+/**
+ * @brief shortcut definition of a std::vector using aligned storage
+ */
+template <typename T, std::size_t Alignment = BATCH_ALIGNMENT>
+using AlignedVector = std::vector<T, AlignedAllocator<T, Alignment>>;
+
+}  // namespace subjective_logic
@@ -534,4 +534,32 @@ std::array<T, N> Array<N, T>::as_array() const
   return out;
 }
 
+/**
+ * @brief checks whether a type is an Array of arbitrary size and entry type
+ */
+template <typename T>
+concept is_fixed_size_array = std::is_same_v<T, Array<T::size(), typename T::value_type>>;
+
+/**
+ * @brief calls func for each entry of a range, for an Array the loop is unrolled at compile time
+ * @param range - Array or any other range, e.g., std::span
+ * @param func - gets called with each entry
+ */
+template <typename Range, typename Func>
+CUDA_AVAIL constexpr void for_each_entry(Range&& range, Func&& func)
+{
+  using RangeT = std::remove_cvref_t<Range>;
+  if constexpr (is_fixed_size_array<RangeT>)
+  {
+    constexpr_for<0, RangeT::size(), 1>([&](std::size_t idx) { func(range[idx]); });
+  }
+  else
+  {
+    for (auto&& entry : range)
+    {
+      func(entry);
+    }
+  }
+}
+
 }  // namespace subjective_logic
@@ -7,6 +7,7 @@ from subjective_logic._subjective_logic_lib_python_api import Fusion
 from subjective_logic._subjective_logic_lib_python_api import TrustedFusion
 from subjective_logic._subjective_logic_lib_python_api import Conflict
 from subjective_logic._subjective_logic_lib_python_api import TrustRevision
+from subjective_logic._subjective_logic_lib_python_api import batch
 
 from subjective_logic._subjective_logic_lib_python_api import OpinionNoBase2f
 from subjective_logic._subjective_logic_lib_python_api import OpinionNoBase2d
@@ -121,3 +122,22 @@ from subjective_logic._subjective_logic_lib_python_api import DirichletDistribut
 from subjective_logic._subjective_logic_lib_python_api import DirichletDistribution9d
 from subjective_logic._subjective_logic_lib_python_api import DirichletDistribution10f
 from subjective_logic._subjective_logic_lib_python_api import DirichletDistribution10d
+
+from subjective_logic._subjective_logic_lib_python_api import OpinionBatch2f
+from subjective_logic._subjective_logic_lib_python_api import OpinionBatch2d
+from subjective_logic._subjective_logic_lib_python_api import OpinionBatch3f
+from subjective_logic._subjective_logic_lib_python_api import OpinionBatch3d
+from subjective_logic._subjective_logic_lib_python_api import OpinionBatch4f
+from subjective_logic._subjective_logic_lib_python_api import OpinionBatch4d
+from subjective_logic._subjective_logic_lib_python_api import OpinionBatch5f
+from subjective_logic._subjective_logic_lib_python_api import OpinionBatch5d
+from subjective_logic._subjective_logic_lib_python_api import OpinionBatch6f
+from subjective_logic._subjective_logic_lib_python_api import OpinionBatch6d
+from subjective_logic._subjective_logic_lib_python_api import OpinionBatch7f
+from subjective_logic._subjective_logic_lib_python_api import OpinionBatch7d
+from subjective_logic._subjective_logic_lib_python_api import OpinionBatch8f
+from subjective_logic._subjective_logic_lib_python_api import OpinionBatch8d
+from subjective_logic._subjective_logic_lib_python_api import OpinionBatch9f
+from subjective_logic._subjective_logic_lib_python_api import OpinionBatch9d
+from subjective_logic._subjective_logic_lib_python_api import OpinionBatch10f
+from subjective_logic._subjective_logic_lib_python_api import OpinionBatch10d
@@ -0,0 +1,449 @@
+#include "batch_bindings.hpp"
+#include "ndarray_helper.hpp"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "subjective_logic_lib/batch/batch_executor.hpp"
+#include "subjective_logic_lib/batch/opinion_batch.hpp"
+#include "subjective_logic_lib/opinions/opinion.hpp"
+#include "subjective_logic_lib/types/dirichlet_distribution.hpp"
+
+namespace nb = nanobind;
+namespace sl = subjective_logic;
+
+// ufunc like operators on numpy arrays of shape (n, N), each row contains the belief masses of one opinion.
+// the arrays are scattered into an OpinionBatch and processed by its kernels with the GIL released,
+// results are returned as arrays owning the C++ buffers.
+// operators without a batch kernel (cc_fuse, the unfusion, the projection and the degrees of conflict and harmony)
+// apply the respective opinion operator row by row, likewise with the GIL released.
+
+/**
+ * @brief executors shared by all calls of this module, one per number of threads, such that the worker threads are
+ *        only started once. concurrent calls using the same executor are serialized by its thread pool
+ * @param num_threads - 0 uses all hardware threads
+ */
+static sl::BatchExecutor& shared_executor(std::size_t num_threads)
+{
+  static std::mutex mutex;
+  static std::map<std::size_t, std::unique_ptr<sl::BatchExecutor>> executors;
+
+  std::lock_guard lock{ mutex };
+  auto& executor = executors[num_threads];
+  if (not executor)
+  {
+    executor = std::make_unique<sl::BatchExecutor>(num_threads);
+  }
+  return *executor;
+}
+
+template <typename FloatT>
+struct BatchOperatorLoader
+{
+  /**
+   * @brief applies op(batch_a, batch_b) to the batches created from a and b, the result is the modified batch_a
+   */
+  template <typename Op>
+  static MassArray<FloatT> binary_operator(const InputArray<FloatT>& a, const InputArray<FloatT>& b, Op op)
+  {
+    return dispatch_dimension(a.shape(1), [&a, &b, &op](auto dim) {
+      constexpr std::size_t N = decltype(dim)::value;
+      using Batch = sl::OpinionBatch<N, FloatT>;
+      check_shape<N>(b, a.shape(0));
+
+      std::unique_ptr<Batch> result;
+      {
+        nb::gil_scoped_release release;
+        result = std::make_unique<Batch>(batch_from_array<N>(a));
+        op(*result, batch_from_array<N>(b));
+      }
+      return batch_to_array(std::move(result));
+    });
+  }
+
+  /**
+   * @brief applies the opinion operator op(opinion_a, opinion_b) to each pair of rows of a and b,
+   *        used for the operators without a batch kernel
+   */
+  template <typename Op>
+  static MassArray<FloatT> rowwise_operator(const InputArray<FloatT>& a, const InputArray<FloatT>& b, Op op)
+  {
+    return dispatch_dimension(a.shape(1), [&a, &b, &op](auto dim) {
+      constexpr std::size_t N = decltype(dim)::value;
+      using Batch = sl::OpinionBatch<N, FloatT>;
+      using Opinion = sl::OpinionNoBase<N, FloatT>;
+      check_shape<N>(b, a.shape(0));
+
+      std::unique_ptr<Batch> result;
+      {
+        nb::gil_scoped_release release;
+        result = std::make_unique<Batch>(a.shape(0));
+        for (std::size_t idx{ 0 }; idx < result->size(); ++idx)
+        {
+          result->set(idx, op(Opinion{ array_row<N>(a, idx) }, Opinion{ array_row<N>(b, idx) }));
+        }
+      }
+      return batch_to_array(std::move(result));
+    });
+  }
+
+  static MassArray<FloatT> trust_discount(const InputArray<FloatT>& a, FloatT prop)
+  {
+    return dispatch_dimension(a.shape(1), [&a, prop](auto dim) {
+      constexpr std::size_t N = decltype(dim)::value;
+      using Batch = sl::OpinionBatch<N, FloatT>;
+
+      std::unique_ptr<Batch> result;
+      {
+        nb::gil_scoped_release release;
+        result = std::make_unique<Batch>(batch_from_array<N>(a));
+        result->trust_discount_(prop);
+      }
+      return batch_to_array(std::move(result));
+    });
+  }
+
+  static MassArray<FloatT>
+  trust_discount_batch(const InputArray<FloatT>& a, const InputArray<FloatT>& trusts, FloatT base_rate)
+  {
+    return dispatch_dimension(a.shape(1), [&a, &trusts, base_rate](auto dim) {
+      constexpr std::size_t N = decltype(dim)::value;
+      using Batch = sl::OpinionBatch<N, FloatT>;
+      check_shape<2>(trusts, a.shape(0));
+
+      std::unique_ptr<Batch> result;
+      {
+        nb::gil_scoped_release release;
+        result = std::make_unique<Batch>(batch_from_array<N>(a));
+        result->trust_discount_(batch_from_array<2>(trusts), base_rate);
+      }
+      return batch_to_array(std::move(result));
+    });
+  }
+
+  static ValueArray<FloatT> uncertainty(const InputArray<FloatT>& a)
+  {
+    return dispatch_dimension(a.shape(1), [&a](auto dim) {
+      constexpr std::size_t N = decltype(dim)::value;
+
+      typename sl::OpinionBatch<N, FloatT>::StorageType result;
+      {
+        nb::gil_scoped_release release;
+        result = batch_from_array<N>(a).uncertainties();
+      }
+      return values_to_array(std::move(result));
+    });
+  }
+
+  /**
+   * @brief degree of conflict (or harmony) of each pair of rows of a and b
+   * @param a - belief masses
+   * @param b - belief masses
+   * @param base_rates_a - base rates of the opinions in a, uniform if not given
+   * @param base_rates_b - base rates of the opinions in b, uniform if not given
+   * @return one value per row
+   */
+  template <sl::multisource::Conflict::RelationType RelationT>
+  static ValueArray<FloatT> rowwise_relation(const InputArray<FloatT>& a,
+                                             const InputArray<FloatT>& b,
+                                             const std::optional<InputArray<FloatT>>& base_rates_a,
+                                             const std::optional<InputArray<FloatT>>& base_rates_b)
+  {
+    return dispatch_dimension(a.shape(1), [&a, &b, &base_rates_a, &base_rates_b](auto dim) {
+      constexpr std::size_t N = decltype(dim)::value;
+      using Opinion = sl::OpinionNoBase<N, FloatT>;
+      using BeliefType = typename Opinion::BeliefType;
+      check_shape<N>(b, a.shape(0));
+      for (const auto* base_rates : { &base_rates_a, &base_rates_b })
+      {
+        if (base_rates->has_value())
+        {
+          check_shape<N>(base_rates->value(), a.shape(0));
+        }
+      }
+      auto base_rate = [](const std::optional<InputArray<FloatT>>& base_rates, std::size_t idx) -> BeliefType {
+        return base_rates.has_value() ? array_row<N>(base_rates.value(), idx) : Opinion::NeutralBeliefDistr();
+      };
+
+      typename sl::OpinionBatch<N, FloatT>::StorageType result(a.shape(0));
+      {
+        nb::gil_scoped_release release;
+        for (std::size_t idx{ 0 }; idx < result.size(); ++idx)
+        {
+          Opinion opinion{ array_row<N>(a, idx) };
+          Opinion other{ array_row<N>(b, idx) };
+          if constexpr (RelationT == sl::multisource::Conflict::RelationType::CONFLICT)
+          {
+            result[idx] = opinion.degree_of_conflict(other, base_rate(base_rates_a, idx), base_rate(base_rates_b, idx));
+          }
+          else
+          {
+            result[idx] = opinion.degree_of_harmony(other, base_rate(base_rates_a, idx), base_rate(base_rates_b, idx));
+          }
+        }
+      }
+      return values_to_array(std::move(result));
+    });
+  }
+
+  /**
+   * @brief projected probabilities of the opinions given by the rows of a
+   * @param a - belief masses
+   * @param base_rates - base rates of each opinion
+   * @return (n, N) projected probabilities
+   */
+  static MatrixArray<FloatT> projection(const InputArray<FloatT>& a, const InputArray<FloatT>& base_rates)
+  {
+    return dispatch_dimension(a.shape(1), [&a, &base_rates](auto dim) {
+      constexpr std::size_t N = decltype(dim)::value;
+      using Opinion = sl::OpinionNoBase<N, FloatT>;
+      const std::size_t num_opinions = a.shape(0);
+      check_shape<N>(base_rates, num_opinions);
+
+      std::vector<FloatT> result;
+      {
+        nb::gil_scoped_release release;
+        result.resize(num_opinions * N);
+        for (std::size_t idx{ 0 }; idx < num_opinions; ++idx)
+        {
+          auto projection = Opinion{ array_row<N>(a, idx) }.getProjection(array_row<N>(base_rates, idx));
+          std::copy(projection.begin(), projection.end(), result.begin() + idx * N);
+        }
+      }
+      return matrix_to_array(std::move(result), num_opinions, N);
+    });
+  }
+
+  static ValueArray<FloatT> binomial_projection(const InputArray<FloatT>& a, FloatT base_rate)
+  {
+    check_shape<2>(a, a.shape(0));
+
+    typename sl::OpinionBatch<2, FloatT>::StorageType result;
+    {
+      nb::gil_scoped_release release;
+      result = batch_from_array<2>(a).getBinomialProjection(base_rate);
+    }
+    return values_to_array(std::move(result));
+  }
+
+  /**
+   * @brief binomial deduction with the same conditionals for each row of a, see OpinionBatch::deduction_
+   */
+  static MassArray<FloatT> deduction(const InputArray<FloatT>& a,
+                                     FloatT base_x,
+                                     sl::OpinionNoBase<2, FloatT> cond_1,
+                                     sl::OpinionNoBase<2, FloatT> cond_2)
+  {
+    using Batch = sl::OpinionBatch<2, FloatT>;
+    check_shape<2>(a, a.shape(0));
+
+    std::unique_ptr<Batch> result;
+    {
+      nb::gil_scoped_release release;
+      result = std::make_unique<Batch>(batch_from_array<2>(a));
+      result->deduction_(base_x, cond_1, cond_2);
+    }
+    return batch_to_array(std::move(result));
+  }
+
+  /**
+   * @brief multi-source fusion of the respective rows of all sources, see OpinionBatch::fuse_opinions
+   * @param fusion_type
+   * @param sources - belief masses of shape (s, n, N), i.e., one (n, N) array per source
+   * @return (n, N) fused belief masses
+   */
+  static MassArray<FloatT> fuse_opinions(sl::multisource::Fusion::FusionType fusion_type,
+                                         const InputStack<FloatT>& sources)
+  {
+    return dispatch_dimension(sources.shape(2), [fusion_type, &sources](auto dim) {
+      constexpr std::size_t N = decltype(dim)::value;
+      using Batch = sl::OpinionBatch<N, FloatT>;
+
+      std::unique_ptr<Batch> result;
+      {
+        nb::gil_scoped_release release;
+        std::vector<Batch> batches;
+        batches.reserve(sources.shape(0));
+        for (std::size_t source_idx{ 0 }; source_idx < sources.shape(0); ++source_idx)
+        {
+          batches.push_back(batch_from_stack<N>(sources, source_idx));
+        }
+        result = std::make_unique<Batch>(Batch::fuse_opinions(fusion_type, batches));
+      }
+      return batch_to_array(std::move(result));
+    });
+  }
+
+  /**
+   * @brief applies Opinion::moment_matching_update_ to each row, the priors are not changed by the update
+   * @param a - belief masses
+   * @param priors - prior belief masses of each opinion
+   * @param probabilities - observed class probabilities of each opinion
+   * @return updated belief masses
+   */
+  static MassArray<FloatT> moment_matching_update(const InputArray<FloatT>& a,
+                                                  const InputArray<FloatT>& priors,
+                                                  const InputArray<FloatT>& probabilities)
+  {
+    return dispatch_dimension(a.shape(1), [&a, &priors, &probabilities](auto dim) {
+      constexpr std::size_t N = decltype(dim)::value;
+      using Batch = sl::OpinionBatch<N, FloatT>;
+      using Opinion = sl::Opinion<N, FloatT>;
+      check_shape<N>(priors, a.shape(0));
+      check_shape<N>(probabilities, a.shape(0));
+
+      std::unique_ptr<Batch> result;
+      {
+        nb::gil_scoped_release release;
+        result = std::make_unique<Batch>(a.shape(0));
+        for (std::size_t idx{ 0 }; idx < result->size(); ++idx)
+        {
+          Opinion opinion{ array_row<N>(a, idx), array_row<N>(priors, idx) };
+          opinion.moment_matching_update_(array_row<N>(probabilities, idx));
+          result->set(idx, opinion.as_no_base());
+        }
+      }
+      return batch_to_array(std::move(result));
+    });
+  }
+
+  /**
+   * @brief pairwise conflict or harmony of the opinions given by the rows of a, see BatchExecutor::pairwise_matrix
+   *        the upper triangle is mirrored, such that the full symmetric matrix is returned
+   * @param a - belief masses
+   * @param num_threads - 0 uses all hardware threads, the executor is shared with other calls of the same number
+   * @return (n, n) matrix
+   */
+  template <sl::multisource::Conflict::RelationType RelationT>
+  static MatrixArray<FloatT> pairwise_matrix(const InputArray<FloatT>& a, std::size_t num_threads)
+  {
+    return dispatch_dimension(a.shape(1), [&a, num_threads](auto dim) {
+      constexpr std::size_t N = decltype(dim)::value;
+      using Opinion = sl::OpinionNoBase<N, FloatT>;
+      const std::size_t num_opinions = a.shape(0);
+
+      std::vector<FloatT> result;
+      {
+        nb::gil_scoped_release release;
+        // the projections are calculated from the rows directly, the opinions are not stored in between
+        sl::multisource::Workspace<Opinion> workspace;
+        sl::multisource::Conflict::prepare_pairwise_matrix(
+            num_opinions, [&a](std::size_t idx) { return Opinion{ array_row<N>(a, idx) }; }, workspace);
+
+        result.resize(num_opinions * num_opinions);
+        shared_executor(num_threads).pairwise_matrix<RelationT>(std::as_const(workspace), std::span{ result });
+        for (std::size_t idx_row{ 1 }; idx_row < num_opinions; ++idx_row)
+        {
+          for (std::size_t idx_col{ 0 }; idx_col < idx_row; ++idx_col)
+          {
+            result[idx_row * num_opinions + idx_col] = result[idx_col * num_opinions + idx_row];
+          }
+        }
+      }
+      return matrix_to_array(std::move(result), num_opinions, num_opinions);
+    });
+  }
+
+  static void load(::nanobind::module_& bound_module)
+  {
+    bound_module
+        .def(
+            "cum_fuse",
+            [](const InputArray<FloatT>& a, const InputArray<FloatT>& b) {
+              return binary_operator(a, b, [](auto& dst, const auto& src) { dst.cum_fuse_(src); });
+            },
+            nb::arg("a"),
+            nb::arg("b"))
+        .def(
+            "average_fuse",
+            [](const InputArray<FloatT>& a, const InputArray<FloatT>& b) {
+              return binary_operator(a, b, [](auto& dst, const auto& src) { dst.average_fuse_(src); });
+            },
+            nb::arg("a"),
+            nb::arg("b"))
+        .def(
+            "wb_fuse",
+            [](const InputArray<FloatT>& a, const InputArray<FloatT>& b) {
+              return binary_operator(a, b, [](auto& dst, const auto& src) { dst.wb_fuse_(src); });
+            },
+            nb::arg("a"),
+            nb::arg("b"))
+        .def(
+            "bc_fuse",
+            [](const InputArray<FloatT>& a, const InputArray<FloatT>& b) {
+              return binary_operator(a, b, [](auto& dst, const auto& src) { dst.bc_fuse_(src); });
+            },
+            nb::arg("a"),
+            nb::arg("b"))
+        .def(
+            "cc_fuse",
+            [](const InputArray<FloatT>& a, const InputArray<FloatT>& b) {
+              return rowwise_operator(
+                  a, b, [](const auto& opinion, const auto& other) { return opinion.cc_fuse(other); });
+            },
+            nb::arg("a"),
+            nb::arg("b"))
+        .def(
+            "cum_unfuse",
+            [](const InputArray<FloatT>& a, const InputArray<FloatT>& b) {
+              return rowwise_operator(
+                  a, b, [](const auto& opinion, const auto& other) { return opinion.cum_unfuse(other); });
+            },
+            nb::arg("a"),
+            nb::arg("b"))
+        .def(
+            "average_unfuse",
+            [](const InputArray<FloatT>& a, const InputArray<FloatT>& b) {
+              return rowwise_operator(
+                  a, b, [](const auto& opinion, const auto& other) { return opinion.average_unfuse(other); });
+            },
+            nb::arg("a"),
+            nb::arg("b"))
+        .def("fuse_opinions", &fuse_opinions, nb::arg("fusion_type"), nb::arg("sources"))
+        .def("trust_discount", &trust_discount, nb::arg("a"), nb::arg("prop"))
+        .def("trust_discount", &trust_discount_batch, nb::arg("a"), nb::arg("trusts"), nb::arg("base_rate") = 0.5)
+        .def("uncertainty", &uncertainty, nb::arg("a"))
+        .def("getBinomialProjection", &binomial_projection, nb::arg("a"), nb::arg("base_rate") = 0.5)
+        .def("getProjection", &projection, nb::arg("a"), nb::arg("base_rates"))
+        .def("deduction", &deduction, nb::arg("a"), nb::arg("base_x"), nb::arg("cond_1"), nb::arg("cond_2"))
+        .def("degree_of_conflict",
+             &rowwise_relation<sl::multisource::Conflict::RelationType::CONFLICT>,
+             nb::arg("a"),
+             nb::arg("b"),
+             nb::arg("base_rates_a") = nb::none(),
+             nb::arg("base_rates_b") = nb::none())
+        .def("degree_of_harmony",
+             &rowwise_relation<sl::multisource::Conflict::RelationType::HARMONY>,
+             nb::arg("a"),
+             nb::arg("b"),
+             nb::arg("base_rates_a") = nb::none(),
+             nb::arg("base_rates_b") = nb::none())
+        .def("pairwise_conflict",
+             &pairwise_matrix<sl::multisource::Conflict::RelationType::CONFLICT>,
+             nb::arg("a"),
+             nb::arg("num_threads") = 0)
+        .def("pairwise_harmony",
+             &pairwise_matrix<sl::multisource::Conflict::RelationType::HARMONY>,
+             nb::arg("a"),
+             nb::arg("num_threads") = 0)
+        .def("moment_matching_update",
+             &moment_matching_update,
+             nb::arg("a"),
+             nb::arg("priors"),
+             nb::arg("probabilities"));
+  }
+};
+
+void loadBatchOperatorBindings(::nanobind::module_& bound_module)
+{
+  auto batch_module = bound_module.def_submodule("batch", "vectorized operators on arrays of shape (n, N)");
+  BatchOperatorLoader<float>::load(batch_module);
+  BatchOperatorLoader<double>::load(batch_module);
+}
@@ -0,0 +1,179 @@
+#pragma once
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "subjective_logic_lib/batch/opinion_batch.hpp"
+
+// conversions between numpy arrays of shape (n, N) and the SoA batch containers
+
+template <typename FloatT>
+using InputArray = ::nanobind::ndarray<const FloatT, ::nanobind::ndim<2>, ::nanobind::device::cpu>;
+template <typename FloatT>
+using InputVector = ::nanobind::ndarray<const FloatT, ::nanobind::ndim<1>, ::nanobind::device::cpu>;
+template <typename FloatT>
+using InputStack = ::nanobind::ndarray<const FloatT, ::nanobind::ndim<3>, ::nanobind::device::cpu>;
+template <typename FloatT>
+using MassArray = ::nanobind::ndarray<::nanobind::numpy, FloatT, ::nanobind::ndim<2>>;
+template <typename FloatT>
+using ValueArray = ::nanobind::ndarray<::nanobind::numpy, FloatT, ::nanobind::ndim<1>>;
+template <typename FloatT>
+using MatrixArray = ::nanobind::ndarray<::nanobind::numpy, FloatT, ::nanobind::ndim<2>>;
+
+/**
+ * @brief reads row idx of an (n, N) array with arbitrary strides
+ */
+template <std::size_t N, typename FloatT>
+subjective_logic::Array<N, FloatT> array_row(const InputArray<FloatT>& array, std::size_t idx)
+{
+  subjective_logic::Array<N, FloatT> row;
+  const FloatT* data = array.data() + static_cast<std::int64_t>(idx) * array.stride(0);
+  for (std::size_t mass_idx{ 0 }; mass_idx < N; ++mass_idx)
+  {
+    row[mass_idx] = data[static_cast<std::int64_t>(mass_idx) * array.stride(1)];
+  }
+  return row;
+}
+
+/**
+ * @brief throws if the given array does not have the shape (num_rows, N)
+ */
+template <std::size_t N, typename FloatT>
+void check_shape(const InputArray<FloatT>& array, std::size_t num_rows)
+{
+  if (array.shape(0) != num_rows or array.shape(1) != N)
+  {
+    throw std::invalid_argument("expected an array of shape (" + std::to_string(num_rows) + ", " + std::to_string(N) +
+                                "), got (" + std::to_string(array.shape(0)) + ", " + std::to_string(array.shape(1)) +
+                                ")");
+  }
+}
+
+/**
+ * @brief scatters an (n, N) array of belief masses into the lanes of an existing batch of size n
+ *        does not touch any python object, hence, it can be called without holding the GIL
+ */
+template <std::size_t N, typename FloatT>
+void copy_to_batch(const InputArray<FloatT>& masses, subjective_logic::OpinionBatch<N, FloatT>& batch)
+{
+  auto lanes = batch.lanes();
+  for (std::size_t idx{ 0 }; idx < batch.size(); ++idx)
+  {
+    auto row = array_row<N>(masses, idx);
+    for (std::size_t mass_idx{ 0 }; mass_idx < N; ++mass_idx)
+    {
+      lanes[mass_idx][idx] = row[mass_idx];
+    }
+  }
+}
+
+/**
+ * @brief scatters an (n, N) array of belief masses into the lanes of a new batch
+ *        the masses are always copied, as the batch stores them in SoA layout an (n, N) array cannot be wrapped
+ */
+template <std::size_t N, typename FloatT>
+subjective_logic::OpinionBatch<N, FloatT> batch_from_array(const InputArray<FloatT>& masses)
+{
+  subjective_logic::OpinionBatch<N, FloatT> batch{ masses.shape(0) };
+  copy_to_batch(masses, batch);
+  return batch;
+}
+
+/**
+ * @brief scatters the (n, N) slice source_idx of an (s, n, N) array into the lanes of a new batch
+ *        does not touch any python object, hence, it can be called without holding the GIL
+ */
+template <std::size_t N, typename FloatT>
+subjective_logic::OpinionBatch<N, FloatT> batch_from_stack(const InputStack<FloatT>& masses, std::size_t source_idx)
+{
+  subjective_logic::OpinionBatch<N, FloatT> batch{ masses.shape(1) };
+  auto lanes = batch.lanes();
+  const FloatT* source = masses.data() + static_cast<std::int64_t>(source_idx) * masses.stride(0);
+  for (std::size_t idx{ 0 }; idx < batch.size(); ++idx)
+  {
+    const FloatT* row = source + static_cast<std::int64_t>(idx) * masses.stride(1);
+    for (std::size_t mass_idx{ 0 }; mass_idx < N; ++mass_idx)
+    {
+      lanes[mass_idx][idx] = row[static_cast<std::int64_t>(mass_idx) * masses.stride(2)];
+    }
+  }
+  return batch;
+}
+
+/**
+ * @brief (n, N) view onto the lanes of a batch, the masses of one opinion are lane_stride apart
+ * @param owner - python object keeping the batch alive, none if the view is returned with reference_internal
+ */
+template <std::size_t N, typename FloatT>
+MassArray<FloatT> batch_view(subjective_logic::OpinionBatch<N, FloatT>& batch,
+                             ::nanobind::handle owner = ::nanobind::handle())
+{
+  std::size_t shape[2]{ batch.size(), N };
+  std::int64_t strides[2]{ 1, static_cast<std::int64_t>(batch.lane_stride()) };
+  return MassArray<FloatT>(batch.lane(0), 2, shape, owner, strides);
+}
+
+/**
+ * @brief hands a batch over to numpy without copying, the returned (n, N) array owns the batch afterwards
+ */
+template <std::size_t N, typename FloatT>
+MassArray<FloatT> batch_to_array(std::unique_ptr<subjective_logic::OpinionBatch<N, FloatT>> batch)
+{
+  using Batch = subjective_logic::OpinionBatch<N, FloatT>;
+  ::nanobind::capsule owner(batch.get(), [](void* ptr) noexcept { delete static_cast<Batch*>(ptr); });
+  return batch_view(*batch.release(), owner);
+}
+
+/**
+ * @brief hands a result buffer over to numpy without copying, the returned array owns the buffer afterwards
+ */
+template <typename StorageType>
+ValueArray<typename StorageType::value_type> values_to_array(StorageType&& values)
+{
+  using FloatT = typename StorageType::value_type;
+  auto* storage = new std::decay_t<StorageType>(std::forward<StorageType>(values));
+  ::nanobind::capsule owner(storage, [](void* ptr) noexcept { delete static_cast<std::decay_t<StorageType>*>(ptr); });
+  std::size_t shape[1]{ storage->size() };
+  return ValueArray<FloatT>(storage->data(), 1, shape, owner);
+}
+
+/**
+ * @brief hands a row major (num_rows, num_cols) result buffer over to numpy without copying
+ */
+template <typename StorageType>
+MatrixArray<typename StorageType::value_type> matrix_to_array(StorageType&& values,
+                                                              std::size_t num_rows,
+                                                              std::size_t num_cols)
+{
+  using FloatT = typename StorageType::value_type;
+  auto* storage = new std::decay_t<StorageType>(std::forward<StorageType>(values));
+  ::nanobind::capsule owner(storage, [](void* ptr) noexcept { delete static_cast<std::decay_t<StorageType>*>(ptr); });
+  std::size_t shape[2]{ num_rows, num_cols };
+  return MatrixArray<FloatT>(storage->data(), 2, shape, owner);
+}
+
+/**
+ * @brief calls func with std::integral_constant<std::size_t, N> for the runtime dimension dim, N = 2..10
+ */
+template <std::size_t N = 2, typename Func>
+decltype(auto) dispatch_dimension(std::size_t dim, Func&& func)
+{
+  if (dim == N)
+  {
+    return func(std::integral_constant<std::size_t, N>{});
+  }
+  if constexpr (N < 10)
+  {
+    return dispatch_dimension<N + 1>(dim, std::forward<Func>(func));
+  }
+  else
+  {
+    throw std::invalid_argument("opinions of dimension " + std::to_string(dim) + " are not supported");
+  }
+}
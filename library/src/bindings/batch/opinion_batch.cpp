@@ -0,0 +1,166 @@
+#include "batch_bindings.hpp"
+#include "ndarray_helper.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "subjective_logic_lib/batch/opinion_batch.hpp"
+
+namespace nb = nanobind;
+namespace sl = subjective_logic;
+
+template <std::size_t N, typename FloatT>
+struct OpinionBatchLoader
+{
+  using Batch = sl::OpinionBatch<N, FloatT>;
+  using OpinionNoBase = sl::OpinionNoBase<N, FloatT>;
+
+  /**
+   * @brief (n,) view onto a single lane of the batch without copying
+   */
+  static ValueArray<FloatT> lane_view(Batch& batch, std::size_t mass_idx)
+  {
+    if (mass_idx >= N)
+    {
+      throw std::out_of_range("lane index exceeds the dimension of the opinions");
+    }
+    std::size_t shape[1]{ batch.size() };
+    return ValueArray<FloatT>(batch.lane(mass_idx), 1, shape, nb::handle());
+  }
+
+  static Batch from_array(const InputArray<FloatT>& belief_masses)
+  {
+    check_shape<N>(belief_masses, belief_masses.shape(0));
+    return batch_from_array<N>(belief_masses);
+  }
+
+  /**
+   * @brief overwrites the masses in place, the lanes are not reallocated, i.e., existing views stay valid
+   */
+  static void assign_array(Batch& batch, const InputArray<FloatT>& belief_masses)
+  {
+    check_shape<N>(belief_masses, batch.size());
+    copy_to_batch(belief_masses, batch);
+  }
+
+  static void check_index(const Batch& batch, std::size_t idx)
+  {
+    if (idx >= batch.size())
+    {
+      throw nb::index_error(
+          ("index " + std::to_string(idx) + " is out of range for a batch of size " + std::to_string(batch.size()))
+              .c_str());
+    }
+  }
+
+  static OpinionNoBase get(const Batch& batch, std::size_t idx)
+  {
+    check_index(batch, idx);
+    return batch.get(idx);
+  }
+
+  static void set(Batch& batch, std::size_t idx, OpinionNoBase opinion)
+  {
+    check_index(batch, idx);
+    batch.set(idx, opinion);
+  }
+
+  static void defineBinomialDependentFields(::nanobind::class_<Batch>& bound_class)
+    requires sl::is_binomial<N>
+  {
+    bound_class
+        .def(
+            "getBinomialProjection",
+            [](const Batch& batch, FloatT base_rate) {
+              return values_to_array(batch.getBinomialProjection(base_rate));
+            },
+            nb::arg("base_rate") = 0.5)
+        .def("deduction_",
+             nb::overload_cast<FloatT, OpinionNoBase, OpinionNoBase>(&Batch::deduction_),
+             nb::rv_policy::reference)
+        .def("deduction", &Batch::deduction);
+  }
+
+  static void defineBinomialDependentFields(::nanobind::class_<Batch>& bound_class)
+    requires(not sl::is_binomial<N>)
+  {
+  }
+
+  static void load(::nanobind::module_& bound_module)
+  {
+    using TrustBatch = sl::OpinionBatch<2, FloatT>;
+
+    std::string module_name{ "OpinionBatch" };
+    module_name += std::to_string(N);
+    if constexpr (std::is_same_v<FloatT, double>)
+    {
+      module_name += "d";
+    }
+    else
+    {
+      module_name += "f";
+    }
+
+    auto bound_class =
+        nb::class_<Batch>(bound_module, module_name.c_str())
+            .def_ro_static("dimension", &Batch::SIZE)
+            .def(nb::init())
+            .def(nb::init<std::size_t, OpinionNoBase>(), nb::arg("size"), nb::arg("default_opinion") = OpinionNoBase{})
+            .def(nb::init<const std::vector<OpinionNoBase>&>(), nb::arg("opinions"))
+            // the masses are copied into the SoA lanes, an (n, N) array cannot be used as batch without a copy
+            .def(
+                "__init__",
+                [](Batch* batch, const InputArray<FloatT>& belief_masses) {
+                  new (batch) Batch{ from_array(belief_masses) };
+                },
+                nb::arg("belief_masses"))
+            .def(nb::init<const Batch&>())
+            .def("__deepcopy__", [](const Batch& a, nb::dict memo) -> Batch { return a; })
+            .def("copy", [](const Batch& batch) -> Batch { return batch; })
+            .def("__len__", &Batch::size)
+            .def("size", &Batch::size)
+            .def("empty", &Batch::empty)
+            .def("lane_stride", &Batch::lane_stride)
+            // views onto the C++ buffer which keep the batch alive, resize is not bound and the setter copies into
+            // the existing lanes, hence, the buffer is never reallocated while a view exists
+            .def_prop_rw(
+                "belief_masses", [](Batch& batch) { return batch_view(batch); }, &assign_array,
+                nb::rv_policy::reference_internal)
+            .def("lane", &lane_view, nb::arg("mass_idx"), nb::rv_policy::reference_internal)
+            .def("get", &get, nb::arg("idx"))
+            .def("__getitem__", &get)
+            .def("set", &set, nb::arg("idx"), nb::arg("opinion"))
+            .def("__setitem__", &set)
+            .def("__iter__", [](const Batch& batch) { return nb::iter(nb::cast(batch.as_vector())); })
+            .def("fill", &Batch::fill)
+            .def("as_vector", &Batch::as_vector)
+            .def("uncertainties", [](const Batch& batch) { return values_to_array(batch.uncertainties()); })
+            .def("cum_fuse_", nb::overload_cast<const Batch&>(&Batch::cum_fuse_), nb::rv_policy::reference)
+            .def("cum_fuse", &Batch::cum_fuse)
+            .def("average_fuse_", nb::overload_cast<const Batch&>(&Batch::average_fuse_), nb::rv_policy::reference)
+            .def("average_fuse", &Batch::average_fuse)
+            .def("wb_fuse_", nb::overload_cast<const Batch&>(&Batch::wb_fuse_), nb::rv_policy::reference)
+            .def("wb_fuse", &Batch::wb_fuse)
+            .def("bc_fuse_", nb::overload_cast<const Batch&>(&Batch::bc_fuse_), nb::rv_policy::reference)
+            .def("bc_fuse", &Batch::bc_fuse)
+            .def("trust_discount_", nb::overload_cast<FloatT>(&Batch::trust_discount_), nb::rv_policy::reference)
+            .def("trust_discount", nb::overload_cast<FloatT>(&Batch::trust_discount, nb::const_))
+            .def("trust_discount_",
+                 nb::overload_cast<const TrustBatch&, FloatT>(&Batch::trust_discount_),
+                 nb::arg("trusts"),
+                 nb::arg("base_rate") = 0.5,
+                 nb::rv_policy::reference)
+            .def("trust_discount",
+                 nb::overload_cast<const TrustBatch&, FloatT>(&Batch::trust_discount, nb::const_),
+                 nb::arg("trusts"),
+                 nb::arg("base_rate") = 0.5);
+
+    defineBinomialDependentFields(bound_class);
+  }
+};
+
+void loadOpinionBatchBindings(::nanobind::module_& bound_module)
+{
+  loadBindings<OpinionBatchLoader>(bound_module);
+}
@@ -17,4 +17,6 @@ NB_MODULE(_subjective_logic_lib_python_api, m)
   loadMultiSourceConflictOperatorBindings(m);
   loadMultiSourceTrustRevisionOperatorBindings(m);
   loadMultiSourceTrustedFusionOperatorBindings(m);
+  loadOpinionBatchBindings(m);
+  loadBatchOperatorBindings(m);
 }
\ No newline at end of file
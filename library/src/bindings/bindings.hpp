@@ -5,3 +5,4 @@
 #include "types/types_bindings.hpp"
 #include "opinions/opinions_bindings.hpp"
 #include "multi_source/multi_source_bindings.hpp"
+#include "batch/batch_bindings.hpp"
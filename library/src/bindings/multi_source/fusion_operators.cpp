@@ -48,7 +48,8 @@ void loadFusionTypes(::nanobind::class_<sl::multisource::Fusion>& nb_mod)
       .value("CUMULATIVE", slm::Fusion::FusionType::CUMULATIVE)
       .value("BELIEF_CONSTRAINT", slm::Fusion::FusionType::BELIEF_CONSTRAINT)
       .value("AVERAGE", slm::Fusion::FusionType::AVERAGE)
-      .value("WEIGHTED", slm::Fusion::FusionType::WEIGHTED);
+      .value("WEIGHTED", slm::Fusion::FusionType::WEIGHTED)
+      .value("CONSENSUS_COMPROMISE", slm::Fusion::FusionType::CONSENSUS_COMPROMISE);
 }
 
 void loadMultiSourceFusionOperatorBindings(::nanobind::module_& bound_module)
@@ -118,6 +118,8 @@ struct OpinionLoader
             .def("cum_fuse", &Opinion::cum_fuse)
             .def("cum_unfuse_", &Opinion::cum_unfuse_, nb::rv_policy::reference)
             .def("cum_unfuse", &Opinion::cum_unfuse)
+            .def("scale_evidence_", &Opinion::scale_evidence_, nb::rv_policy::reference)
+            .def("scale_evidence", &Opinion::scale_evidence)
             .def("harmony", &Opinion::harmony)
             .def("bc_fuse_", &Opinion::bc_fuse_, nb::rv_policy::reference)
             .def("bc_fuse", &Opinion::bc_fuse)
@@ -0,0 +1,270 @@
+#include <atomic>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "subjective_logic_lib/batch/batch_executor.hpp"
+
+namespace subjective_logic
+{
+
+TEST(ThreadPoolTest, ExecutesEachTaskOnce)
+{
+  for (std::size_t num_threads : { 1, 2, 4 })
+  {
+    ThreadPool pool{ num_threads };
+    EXPECT_EQ(pool.num_threads(), num_threads);
+
+    // run several jobs on the same pool to check that subsequent jobs do not interfere
+    for (std::size_t num_tasks : { 0, 1, 7, 1000 })
+    {
+      std::vector<std::atomic<int>> counters(num_tasks);
+      pool.parallel_for(num_tasks, [&counters](std::size_t idx) { ++counters[idx]; });
+      for (const auto& counter : counters)
+      {
+        EXPECT_EQ(counter, 1);
+      }
+    }
+  }
+}
+
+TEST(ThreadPoolTest, RethrowsTaskException)
+{
+  ThreadPool pool{ 3 };
+  std::atomic<std::size_t> executed{ 0 };
+  EXPECT_THROW(pool.parallel_for(100,
+                                 [&executed](std::size_t idx) {
+                                   ++executed;
+                                   if (idx == 42)
+                                   {
+                                     throw std::runtime_error("task failed");
+                                   }
+                                 }),
+               std::runtime_error);
+  // the remaining tasks are executed nevertheless
+  EXPECT_EQ(executed, 100);
+
+  // the pool is still usable afterwards
+  std::atomic<std::size_t> counter{ 0 };
+  pool.parallel_for(10, [&counter](std::size_t) { ++counter; });
+  EXPECT_EQ(counter, 10);
+}
+
+class BatchExecutorTest : public ::testing::Test
+{
+public:
+  using OpinionT = OpinionNoBase<2, float>;
+  using BatchT = OpinionBatch<2, float>;
+
+  // small tiles result in many tasks even for small batches
+  static constexpr std::size_t TILE_BYTES{ 1024 };
+  static constexpr std::size_t BATCH_SIZE{ 10007 };
+
+  static BatchT generate_batch(unsigned int seed)
+  {
+    std::mt19937 gen{ seed };
+    std::uniform_real_distribution<float> dist{ 0., 1. };
+    BatchT batch{ BATCH_SIZE };
+    for (std::size_t idx{ 0 }; idx < BATCH_SIZE; ++idx)
+    {
+      float belief = dist(gen);
+      float disbelief = dist(gen) * (1 - belief);
+      batch.set(idx, OpinionT{ belief, disbelief });
+    }
+    return batch;
+  }
+
+  static void expect_equal(const BatchT& batch, const BatchT& expected)
+  {
+    ASSERT_EQ(batch.size(), expected.size());
+    for (std::size_t idx{ 0 }; idx < batch.size(); ++idx)
+    {
+      EXPECT_EQ(batch.lane(0)[idx], expected.lane(0)[idx]);
+      EXPECT_EQ(batch.lane(1)[idx], expected.lane(1)[idx]);
+    }
+  }
+};
+
+TEST_F(BatchExecutorTest, TileSize)
+{
+  BatchExecutor executor{ 1, TILE_BYTES };
+  EXPECT_EQ(executor.tile_bytes(), TILE_BYTES);
+
+  std::size_t tile_size = executor.tile_size<BatchT>(4);
+  EXPECT_EQ(tile_size % BatchT::LANE_PADDING, 0);
+  EXPECT_LE(tile_size * 4 * sizeof(float), TILE_BYTES);
+
+  // at least a single aligned block is used
+  EXPECT_EQ(executor.tile_size<BatchT>(1000), BatchT::LANE_PADDING);
+}
+
+TEST_F(BatchExecutorTest, DeterministicFusion)
+{
+  const BatchT batch_a = generate_batch(0);
+  const BatchT batch_b = generate_batch(1);
+  const BatchT expected_cum = batch_a.cum_fuse(batch_b);
+  const BatchT expected_avg = batch_a.average_fuse(batch_b);
+  const BatchT expected_wb = batch_a.wb_fuse(batch_b);
+  const BatchT expected_bc = batch_a.bc_fuse(batch_b);
+
+  for (std::size_t num_threads : { 1, 2, 3, 4 })
+  {
+    BatchExecutor executor{ num_threads, TILE_BYTES };
+
+    BatchT result{ batch_a };
+    expect_equal(executor.cum_fuse_(result, batch_b), expected_cum);
+    result = batch_a;
+    expect_equal(executor.average_fuse_(result, batch_b), expected_avg);
+    result = batch_a;
+    expect_equal(executor.wb_fuse_(result, batch_b), expected_wb);
+    result = batch_a;
+    expect_equal(executor.bc_fuse_(result, batch_b), expected_bc);
+  }
+}
+
+TEST_F(BatchExecutorTest, DeterministicMultiSourceFusion)
+{
+  using FusionType = BatchT::FusionType;
+  const std::vector<BatchT> sources{ generate_batch(0), generate_batch(1), generate_batch(2) };
+
+  for (auto fusion_type : { FusionType::CUMULATIVE,
+                            FusionType::BELIEF_CONSTRAINT,
+                            FusionType::AVERAGE,
+                            FusionType::WEIGHTED,
+                            FusionType::CONSENSUS_COMPROMISE })
+  {
+    const BatchT expected = BatchT::fuse_opinions(fusion_type, sources);
+    for (std::size_t num_threads : { 1, 2, 3, 4 })
+    {
+      BatchExecutor executor{ num_threads, TILE_BYTES };
+      expect_equal(executor.fuse_opinions(fusion_type, sources), expected);
+    }
+  }
+
+  BatchExecutor executor{ 2, TILE_BYTES };
+  EXPECT_THROW(executor.fuse_opinions(FusionType::CUMULATIVE, std::vector<BatchT>{}), std::invalid_argument);
+}
+
+TEST_F(BatchExecutorTest, DeterministicPairwiseMatrix)
+{
+  using multisource::Conflict;
+  const BatchT batch = generate_batch(0);
+  const std::size_t num_opinions{ 3 * Conflict::PAIRWISE_BLOCK_SIZE + 5 };
+  std::vector<OpinionT> opinions;
+  for (std::size_t idx{ 0 }; idx < num_opinions; ++idx)
+  {
+    opinions.push_back(batch[idx]);
+  }
+
+  std::vector<float> expected(num_opinions * num_opinions);
+  Conflict::pairwise_matrix<Conflict::RelationType::CONFLICT>(std::span<const OpinionT>{ opinions },
+                                                              std::span{ expected });
+
+  multisource::Workspace<OpinionT> workspace;
+  for (std::size_t num_threads : { 1, 2, 3, 4 })
+  {
+    BatchExecutor executor{ num_threads, TILE_BYTES };
+    std::vector<float> result(num_opinions * num_opinions);
+    executor.pairwise_matrix<Conflict::RelationType::CONFLICT>(
+        std::span<const OpinionT>{ opinions }, std::span{ result }, workspace);
+    EXPECT_EQ(result, expected);
+  }
+
+  // the workspace can also be prepared from opinions which are not stored in a contiguous range
+  Conflict::prepare_pairwise_matrix(num_opinions, [&batch](std::size_t idx) { return batch[idx]; }, workspace);
+  BatchExecutor executor{ 3, TILE_BYTES };
+  std::vector<float> result(num_opinions * num_opinions);
+  executor.pairwise_matrix<Conflict::RelationType::CONFLICT>(std::as_const(workspace), std::span{ result });
+  EXPECT_EQ(result, expected);
+}
+
+TEST_F(BatchExecutorTest, DeterministicDiscountAndProjection)
+{
+  const BatchT batch = generate_batch(0);
+  const BatchT trusts = generate_batch(1);
+  const BatchT expected_prop = batch.trust_discount(0.3);
+  const BatchT expected_trusts = batch.trust_discount(trusts, 0.2);
+  const auto expected_projection = batch.getBinomialProjection(0.4);
+
+  for (std::size_t num_threads : { 1, 4 })
+  {
+    BatchExecutor executor{ num_threads, TILE_BYTES };
+
+    BatchT result{ batch };
+    expect_equal(executor.trust_discount_(result, 0.3F), expected_prop);
+    result = batch;
+    expect_equal(executor.trust_discount_(result, trusts, 0.2F), expected_trusts);
+
+    auto projection = executor.getBinomialProjection(batch, 0.4F);
+    ASSERT_EQ(projection.size(), expected_projection.size());
+    for (std::size_t idx{ 0 }; idx < projection.size(); ++idx)
+    {
+      EXPECT_EQ(projection[idx], expected_projection[idx]);
+    }
+  }
+}
+
+TEST_F(BatchExecutorTest, MismatchingSizes)
+{
+  BatchExecutor executor{ 2, TILE_BYTES };
+  BatchT batch = generate_batch(0);
+  const BatchT shorter{ BATCH_SIZE - 1 };
+  const EvidenceBatch<2, float> evidence{ BATCH_SIZE };
+
+  // the operands are checked before any tile is processed, i.e., the batch is not modified
+  EXPECT_THROW(executor.cum_fuse_(batch, shorter), std::invalid_argument);
+  EXPECT_THROW(executor.average_fuse_(batch, shorter), std::invalid_argument);
+  EXPECT_THROW(executor.wb_fuse_(batch, shorter), std::invalid_argument);
+  EXPECT_THROW(executor.bc_fuse_(batch, shorter), std::invalid_argument);
+  EXPECT_THROW(executor.trust_discount_(batch, shorter, 0.5F), std::invalid_argument);
+  expect_equal(batch, generate_batch(0));
+
+  EvidenceBatch<2, float> evidence_batch{ BATCH_SIZE + 1 };
+  EXPECT_THROW(executor.cum_fuse_(evidence_batch, evidence), std::invalid_argument);
+}
+
+TEST_F(BatchExecutorTest, Deduction)
+{
+  const BatchT batch = generate_batch(0);
+  OpinionT cond_1{ 0.7, 0.1 };
+  OpinionT cond_2{ 0.2, 0.5 };
+  float base_x{ 0.3 };
+
+  BatchExecutor executor{ 4, TILE_BYTES };
+  BatchT result{ batch };
+  executor.deduction_(result, base_x, cond_1, cond_2);
+
+  for (std::size_t idx{ 0 }; idx < batch.size(); ++idx)
+  {
+    auto expected = batch[idx].deduction(base_x, cond_1, cond_2);
+    EXPECT_NEAR(result[idx].belief(), expected.belief(), EPS_v<float>);
+    EXPECT_NEAR(result[idx].disbelief(), expected.disbelief(), EPS_v<float>);
+  }
+}
+
+TEST_F(BatchExecutorTest, Classify)
+{
+  const BatchT batch = generate_batch(0);
+  auto classifier = [](const OpinionT& opinion) {
+    if (opinion.uncertainty() > 0.5)
+    {
+      return 0;
+    }
+    float prob = opinion.getBinomialProjection();
+    return prob > 0.7 ? 1 : (prob < 0.3 ? 2 : 3);
+  };
+
+  BatchExecutor executor{ 3, TILE_BYTES };
+  auto labels = executor.classify(batch, classifier);
+  ASSERT_EQ(labels.size(), batch.size());
+  for (std::size_t idx{ 0 }; idx < batch.size(); ++idx)
+  {
+    EXPECT_EQ(labels[idx], classifier(batch[idx]));
+  }
+}
+
+}  // namespace subjective_logic
@@ -0,0 +1,97 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "subjective_logic_lib/batch/concurrent_evidence_accumulator.hpp"
+
+namespace subjective_logic
+{
+
+TEST(ConcurrentEvidenceAccumulatorTest, SequentialFusion)
+{
+  ConcurrentEvidenceAccumulator<3, double> accumulator{ 4, 2 };
+  EXPECT_EQ(accumulator.size(), 4);
+  EXPECT_EQ(accumulator.num_shards(), 2);
+
+  OpinionNoBase<3, double> op_a{ 0.2, 0.3, 0.1 };
+  OpinionNoBase<3, double> op_b{ 0.5, 0.1, 0.1 };
+  accumulator.cum_fuse_(0, 1, op_a);
+  accumulator.cum_fuse_(1, 1, op_b);
+
+  // the fused evidence equals the cumulative fusion of the opinions, independent of the shards
+  auto expected = op_a.cum_fuse(op_b);
+  auto result = accumulator.get(1);
+  for (std::size_t idx{ 0 }; idx < 3; ++idx)
+  {
+    EXPECT_NEAR(result.belief_masses()[idx], expected.belief_masses()[idx], EPS_v<double>);
+  }
+
+  // untouched cells are vacuous
+  EXPECT_DOUBLE_EQ(accumulator.get(0).uncertainty(), 1.);
+
+  Array<3, double> prior{ 0.5, 0.25, 0.25 };
+  Opinion<3, double> with_prior = accumulator.get(1, prior);
+  EXPECT_NEAR(with_prior.getProjection()[0], expected.getProjection(prior)[0], EPS_v<double>);
+
+  auto snapshot = accumulator.snapshot();
+  ASSERT_EQ(snapshot.size(), 4);
+  EXPECT_NEAR(snapshot[1].belief_masses()[0], expected.belief_masses()[0], EPS_v<double>);
+
+  accumulator.reset();
+  EXPECT_DOUBLE_EQ(accumulator.get(1).uncertainty(), 1.);
+}
+
+TEST(ConcurrentEvidenceAccumulatorTest, ConcurrentProducers)
+{
+  constexpr std::size_t num_producers{ 4 };
+  constexpr std::size_t num_cells{ 16 };
+  constexpr std::size_t num_updates{ 20000 };
+
+  ConcurrentEvidenceAccumulator<2, double> accumulator{ num_cells, num_producers };
+  std::atomic<bool> done{ false };
+  std::atomic<std::size_t> inconsistent_reads{ 0 };
+
+  // each update adds evidence with a fixed ratio, thus, every consistent snapshot keeps this ratio
+  std::thread reader([&]() {
+    while (not done)
+    {
+      for (std::size_t cell_idx{ 0 }; cell_idx < num_cells; ++cell_idx)
+      {
+        auto evidence = accumulator.evidence(cell_idx);
+        if (evidence[1] != 2 * evidence[0])
+        {
+          ++inconsistent_reads;
+        }
+      }
+    }
+  });
+
+  std::vector<std::thread> producers;
+  for (std::size_t shard_idx{ 0 }; shard_idx < num_producers; ++shard_idx)
+  {
+    producers.emplace_back([&accumulator, shard_idx]() {
+      for (std::size_t update{ 0 }; update < num_updates; ++update)
+      {
+        accumulator.add_evidence(shard_idx, update % num_cells, Array<2, double>{ 1., 2. });
+      }
+    });
+  }
+  for (auto& producer : producers)
+  {
+    producer.join();
+  }
+  done = true;
+  reader.join();
+
+  EXPECT_EQ(inconsistent_reads, 0);
+  for (std::size_t cell_idx{ 0 }; cell_idx < num_cells; ++cell_idx)
+  {
+    auto evidence = accumulator.evidence(cell_idx);
+    EXPECT_DOUBLE_EQ(evidence[0], static_cast<double>(num_producers * num_updates / num_cells));
+    EXPECT_DOUBLE_EQ(evidence[1], static_cast<double>(2 * num_producers * num_updates / num_cells));
+  }
+}
+
+}  // namespace subjective_logic
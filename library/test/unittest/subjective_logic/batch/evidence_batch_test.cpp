@@ -0,0 +1,156 @@
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "subjective_logic_lib/batch/batch_executor.hpp"
+#include "subjective_logic_lib/batch/evidence_batch.hpp"
+#include "subjective_logic_lib/types/convert.hpp"
+
+#include "test_helpers.hpp"
+
+namespace subjective_logic
+{
+
+using TestTypes = ::testing::Types<OpinionNoBase<2, float>,
+                                   OpinionNoBase<3, float>,
+                                   OpinionNoBase<6, float>,
+                                   OpinionNoBase<2, double>,
+                                   OpinionNoBase<3, double>,
+                                   OpinionNoBase<6, double> >;
+
+template <typename OpinionT>
+using EvidenceBatchOf = EvidenceBatch<OpinionT::SIZE, typename OpinionT::FLOAT_t>;
+
+template <typename OpinionT>
+class EvidenceBatchTest : public ::testing::Test
+{
+public:
+  static constexpr std::size_t BATCH_SIZE{ 101 };
+  static constexpr typename OpinionT::FLOAT_t TOLERANCE{ 10 * EPS_v<typename OpinionT::FLOAT_t> };
+
+  /**
+   * @brief generates non-dogmatic opinions, every fifth of them vacuous
+   */
+  static OpinionBatch<OpinionT::SIZE, typename OpinionT::FLOAT_t> generate_batch(unsigned int seed)
+  {
+    std::mt19937 gen{ seed };
+    OpinionBatch<OpinionT::SIZE, typename OpinionT::FLOAT_t> batch{ BATCH_SIZE };
+    for (std::size_t idx{ 0 }; idx < BATCH_SIZE; ++idx)
+    {
+      if (idx % 5 != 0)
+      {
+        batch.set(idx, test::random_opinion<OpinionT>(gen, 0.01));
+      }
+    }
+    return batch;
+  }
+};
+TYPED_TEST_SUITE(EvidenceBatchTest, TestTypes);
+
+TYPED_TEST(EvidenceBatchTest, Conversion)
+{
+  using EvidenceBatchT = EvidenceBatchOf<TypeParam>;
+  using FloatT = typename TypeParam::FLOAT_t;
+  auto opinions = TestFixture::generate_batch(0);
+
+  EvidenceBatchT evidence{ opinions };
+  ASSERT_EQ(evidence.size(), opinions.size());
+  EXPECT_EQ(evidence.lane_stride() % EvidenceBatchT::LANE_PADDING, 0);
+
+  auto round_trip = evidence.as_opinion_batch();
+  for (std::size_t idx{ 0 }; idx < opinions.size(); ++idx)
+  {
+    // the evidence is the same as the one of the Dirichlet distribution (see convert.hpp)
+    auto expected_distribution = static_cast<DirichletDistribution<TypeParam::SIZE, FloatT>>(opinions[idx]);
+    auto distribution = evidence.distribution(idx);
+    EXPECT_NEAR(evidence.uncertainty(idx), opinions[idx].uncertainty(), TestFixture::TOLERANCE);
+    for (std::size_t mass_idx{ 0 }; mass_idx < TypeParam::SIZE; ++mass_idx)
+    {
+      EXPECT_FLOAT_EQ(distribution.evidences()[mass_idx], expected_distribution.evidences()[mass_idx]);
+      EXPECT_NEAR(round_trip[idx].belief_masses()[mass_idx],
+                  opinions[idx].belief_masses()[mass_idx],
+                  TestFixture::TOLERANCE);
+      EXPECT_NEAR(
+          evidence[idx].belief_masses()[mass_idx], opinions[idx].belief_masses()[mass_idx], TestFixture::TOLERANCE);
+    }
+  }
+
+  evidence.reset();
+  for (std::size_t idx{ 0 }; idx < evidence.size(); ++idx)
+  {
+    EXPECT_FLOAT_EQ(evidence.uncertainty(idx), static_cast<FloatT>(1.));
+  }
+}
+
+TYPED_TEST(EvidenceBatchTest, CumFuse)
+{
+  using EvidenceBatchT = EvidenceBatchOf<TypeParam>;
+  auto opinions_a = TestFixture::generate_batch(0);
+  auto opinions_b = TestFixture::generate_batch(1);
+  auto expected = opinions_a.cum_fuse(opinions_b);
+
+  // fusing evidence batches or opinions into an evidence batch is equal to the cumulative fusion of the opinions
+  auto fused = EvidenceBatchT{ opinions_a }.cum_fuse(EvidenceBatchT{ opinions_b }).as_opinion_batch();
+  EvidenceBatchT fused_opinions{ opinions_a };
+  fused_opinions.cum_fuse_(opinions_b);
+
+  for (std::size_t idx{ 0 }; idx < expected.size(); ++idx)
+  {
+    for (std::size_t mass_idx{ 0 }; mass_idx < TypeParam::SIZE; ++mass_idx)
+    {
+      EXPECT_NEAR(
+          fused[idx].belief_masses()[mass_idx], expected[idx].belief_masses()[mass_idx], TestFixture::TOLERANCE);
+      EXPECT_NEAR(fused_opinions[idx].belief_masses()[mass_idx],
+                  expected[idx].belief_masses()[mass_idx],
+                  TestFixture::TOLERANCE);
+    }
+  }
+}
+
+TYPED_TEST(EvidenceBatchTest, CumUnfuse)
+{
+  using EvidenceBatchT = EvidenceBatchOf<TypeParam>;
+  auto opinions_a = TestFixture::generate_batch(0);
+  EvidenceBatchT evidence_a{ opinions_a };
+  EvidenceBatchT evidence_b{ TestFixture::generate_batch(1) };
+
+  auto restored = evidence_a.cum_fuse(evidence_b).cum_unfuse_(evidence_b);
+  for (std::size_t idx{ 0 }; idx < opinions_a.size(); ++idx)
+  {
+    for (std::size_t mass_idx{ 0 }; mass_idx < TypeParam::SIZE; ++mass_idx)
+    {
+      EXPECT_NEAR(restored[idx].belief_masses()[mass_idx],
+                  opinions_a[idx].belief_masses()[mass_idx],
+                  TestFixture::TOLERANCE);
+      EXPECT_GE(evidence_b.cum_unfuse(evidence_a).lane(mass_idx)[idx], 0.);
+    }
+  }
+}
+
+TEST(EvidenceBatchTest, BinomialProjection)
+{
+  OpinionBatch<2, float> opinions{ 3 };
+  opinions.set(1, OpinionNoBase<2, float>{ 0.5, 0.2 });
+  opinions.set(2, OpinionNoBase<2, float>{ 0.1, 0.8 });
+  EvidenceBatch<2, float> evidence{ opinions };
+
+  BatchExecutor executor{ 2, 64 };
+  auto projections = evidence.getBinomialProjection(0.3);
+  auto parallel_projections = executor.getBinomialProjection(evidence, 0.3F);
+  for (std::size_t idx{ 0 }; idx < opinions.size(); ++idx)
+  {
+    EXPECT_NEAR(projections[idx], opinions[idx].getBinomialProjection(0.3), EPS_v<float>);
+    EXPECT_EQ(parallel_projections[idx], projections[idx]);
+  }
+
+  EvidenceBatch<2, float> doubled{ evidence };
+  executor.cum_fuse_(doubled, evidence);
+  for (std::size_t idx{ 0 }; idx < opinions.size(); ++idx)
+  {
+    EXPECT_FLOAT_EQ(doubled.lane(0)[idx], 2 * evidence.lane(0)[idx]);
+    EXPECT_FLOAT_EQ(doubled.lane(1)[idx], 2 * evidence.lane(1)[idx]);
+  }
+}
+
+}  // namespace subjective_logic
@@ -0,0 +1,301 @@
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "subjective_logic_lib/batch/opinion_batch.hpp"
+
+#include "test_helpers.hpp"
+
+namespace subjective_logic
+{
+
+using TestTypes = ::testing::Types<OpinionNoBase<2, float>,
+                                   OpinionNoBase<3, float>,
+                                   OpinionNoBase<6, float>,
+                                   OpinionNoBase<2, double>,
+                                   OpinionNoBase<3, double>,
+                                   OpinionNoBase<6, double> >;
+
+template <typename OpinionT>
+using BatchOf = OpinionBatch<OpinionT::SIZE, typename OpinionT::FLOAT_t>;
+
+template <typename OpinionT>
+class OpinionBatchTest : public ::testing::Test
+{
+public:
+  // a size which is not a multiple of the lane padding to cover the remainder of each lane
+  static constexpr std::size_t BATCH_SIZE{ 203 };
+  static constexpr typename OpinionT::FLOAT_t TOLERANCE{ 10 * EPS_v<typename OpinionT::FLOAT_t> };
+
+  template <typename BatchT>
+  static void expect_near(const BatchT& batch, const std::vector<OpinionT>& expected)
+  {
+    ASSERT_EQ(batch.size(), expected.size());
+    for (std::size_t idx{ 0 }; idx < batch.size(); ++idx)
+    {
+      auto opinion = batch[idx];
+      for (std::size_t mass_idx{ 0 }; mass_idx < OpinionT::SIZE; ++mass_idx)
+      {
+        EXPECT_NEAR(opinion.belief_masses()[mass_idx], expected[idx].belief_masses()[mass_idx], TOLERANCE)
+            << "entry " << idx << ", mass " << mass_idx;
+      }
+    }
+  }
+};
+TYPED_TEST_SUITE(OpinionBatchTest, TestTypes);
+
+TYPED_TEST(OpinionBatchTest, Layout)
+{
+  using BatchT = BatchOf<TypeParam>;
+  using FloatT = typename TypeParam::FLOAT_t;
+
+  auto opinions = test::mixed_opinions<TypeParam>(TestFixture::BATCH_SIZE, 0);
+  BatchT batch{ opinions };
+
+  EXPECT_EQ(batch.size(), TestFixture::BATCH_SIZE);
+  EXPECT_EQ(batch.lane_stride() % BatchT::LANE_PADDING, 0);
+  EXPECT_GE(batch.lane_stride(), batch.size());
+  for (std::size_t mass_idx{ 0 }; mass_idx < TypeParam::SIZE; ++mass_idx)
+  {
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(batch.lane(mass_idx)) % BATCH_ALIGNMENT, 0);
+    for (std::size_t idx{ 0 }; idx < batch.size(); ++idx)
+    {
+      EXPECT_EQ(batch.lane(mass_idx)[idx], opinions[idx].belief_masses()[mass_idx]);
+    }
+  }
+
+  auto round_trip = batch.as_vector();
+  ASSERT_EQ(round_trip.size(), opinions.size());
+  for (std::size_t idx{ 0 }; idx < opinions.size(); ++idx)
+  {
+    EXPECT_EQ(round_trip[idx], opinions[idx]);
+    EXPECT_FLOAT_EQ(batch.uncertainty(idx), opinions[idx].uncertainty());
+  }
+
+  auto uncertainties = batch.uncertainties();
+  for (std::size_t idx{ 0 }; idx < opinions.size(); ++idx)
+  {
+    EXPECT_FLOAT_EQ(uncertainties[idx], opinions[idx].uncertainty());
+  }
+
+  // resizing keeps the existing entries and initializes new ones
+  TypeParam dogmatic{};
+  dogmatic.belief_masses().front() = 1.;
+  batch.resize(TestFixture::BATCH_SIZE + 10, dogmatic);
+  for (std::size_t idx{ 0 }; idx < batch.size(); ++idx)
+  {
+    EXPECT_EQ(batch[idx], idx < opinions.size() ? opinions[idx] : dogmatic);
+  }
+
+  batch.fill(TypeParam{});
+  for (std::size_t idx{ 0 }; idx < batch.size(); ++idx)
+  {
+    EXPECT_FLOAT_EQ(batch.uncertainty(idx), static_cast<FloatT>(1.));
+  }
+}
+
+TYPED_TEST(OpinionBatchTest, CumFuse)
+{
+  using BatchT = BatchOf<TypeParam>;
+  auto opinions_a = test::mixed_opinions<TypeParam>(TestFixture::BATCH_SIZE, 0);
+  auto opinions_b = test::mixed_opinions<TypeParam>(TestFixture::BATCH_SIZE, 1);
+
+  std::vector<TypeParam> expected;
+  for (std::size_t idx{ 0 }; idx < opinions_a.size(); ++idx)
+  {
+    expected.push_back(opinions_a[idx].cum_fuse(opinions_b[idx]));
+  }
+  TestFixture::expect_near(BatchT{ opinions_a }.cum_fuse(BatchT{ opinions_b }), expected);
+}
+
+TYPED_TEST(OpinionBatchTest, AverageFuse)
+{
+  using BatchT = BatchOf<TypeParam>;
+  auto opinions_a = test::mixed_opinions<TypeParam>(TestFixture::BATCH_SIZE, 0);
+  auto opinions_b = test::mixed_opinions<TypeParam>(TestFixture::BATCH_SIZE, 1);
+
+  std::vector<TypeParam> expected;
+  for (std::size_t idx{ 0 }; idx < opinions_a.size(); ++idx)
+  {
+    expected.push_back(opinions_a[idx].average_fuse(opinions_b[idx]));
+  }
+  TestFixture::expect_near(BatchT{ opinions_a }.average_fuse(BatchT{ opinions_b }), expected);
+}
+
+TYPED_TEST(OpinionBatchTest, WeightedFuse)
+{
+  using BatchT = BatchOf<TypeParam>;
+  auto opinions_a = test::mixed_opinions<TypeParam>(TestFixture::BATCH_SIZE, 0);
+  auto opinions_b = test::mixed_opinions<TypeParam>(TestFixture::BATCH_SIZE, 1);
+
+  std::vector<TypeParam> expected;
+  for (std::size_t idx{ 0 }; idx < opinions_a.size(); ++idx)
+  {
+    expected.push_back(opinions_a[idx].wb_fuse(opinions_b[idx]));
+  }
+  TestFixture::expect_near(BatchT{ opinions_a }.wb_fuse(BatchT{ opinions_b }), expected);
+}
+
+TYPED_TEST(OpinionBatchTest, BeliefConstraintFuse)
+{
+  using BatchT = BatchOf<TypeParam>;
+  auto opinions_a = test::mixed_opinions<TypeParam>(TestFixture::BATCH_SIZE, 0);
+  auto opinions_b = test::mixed_opinions<TypeParam>(TestFixture::BATCH_SIZE, 1);
+
+  std::vector<TypeParam> expected;
+  for (std::size_t idx{ 0 }; idx < opinions_a.size(); ++idx)
+  {
+    expected.push_back(opinions_a[idx].bc_fuse(opinions_b[idx]));
+  }
+  TestFixture::expect_near(BatchT{ opinions_a }.bc_fuse(BatchT{ opinions_b }), expected);
+}
+
+TYPED_TEST(OpinionBatchTest, TrustDiscount)
+{
+  using BatchT = BatchOf<TypeParam>;
+  using FloatT = typename TypeParam::FLOAT_t;
+  auto opinions = test::mixed_opinions<TypeParam>(TestFixture::BATCH_SIZE, 0);
+  auto trusts = test::mixed_opinions<OpinionNoBase<2, FloatT>>(TestFixture::BATCH_SIZE, 1);
+  FloatT base_rate{ 0.3 };
+
+  std::vector<TypeParam> expected_prop;
+  std::vector<TypeParam> expected_trusts;
+  for (std::size_t idx{ 0 }; idx < opinions.size(); ++idx)
+  {
+    expected_prop.push_back(opinions[idx].trust_discount(0.7));
+    expected_trusts.push_back(opinions[idx].trust_discount(trusts[idx], base_rate));
+  }
+
+  BatchT batch{ opinions };
+  TestFixture::expect_near(batch.trust_discount(0.7), expected_prop);
+  TestFixture::expect_near(batch.trust_discount(OpinionBatch<2, FloatT>{ trusts }, base_rate), expected_trusts);
+}
+
+TYPED_TEST(OpinionBatchTest, MismatchingSizes)
+{
+  using BatchT = BatchOf<TypeParam>;
+  using FloatT = typename TypeParam::FLOAT_t;
+  BatchT batch{ TestFixture::BATCH_SIZE };
+  const BatchT shorter{ TestFixture::BATCH_SIZE - 1 };
+  const BatchT longer{ TestFixture::BATCH_SIZE + 1 };
+
+  for (const BatchT* other : { &shorter, &longer })
+  {
+    EXPECT_THROW(batch.cum_fuse_(*other), std::invalid_argument);
+    EXPECT_THROW(batch.average_fuse_(*other), std::invalid_argument);
+    EXPECT_THROW(batch.wb_fuse_(*other), std::invalid_argument);
+    EXPECT_THROW(batch.bc_fuse_(*other), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(batch.cum_fuse(*other)), std::invalid_argument);
+  }
+  EXPECT_THROW(batch.trust_discount_(OpinionBatch<2, FloatT>{ TestFixture::BATCH_SIZE - 1 }), std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(batch.trust_discount(OpinionBatch<2, FloatT>{ 1 })), std::invalid_argument);
+}
+
+TYPED_TEST(OpinionBatchTest, TileRanges)
+{
+  using BatchT = BatchOf<TypeParam>;
+  auto opinions_a = test::mixed_opinions<TypeParam>(TestFixture::BATCH_SIZE, 0);
+  auto opinions_b = test::mixed_opinions<TypeParam>(TestFixture::BATCH_SIZE, 1);
+
+  // processing disjoint tiles must not touch the entries outside of the tile
+  std::size_t tile_size{ 17 };
+  BatchT batch_a{ opinions_a };
+  BatchT batch_b{ opinions_b };
+  for (std::size_t first{ 0 }; first < batch_a.size(); first += 2 * tile_size)
+  {
+    batch_a.cum_fuse_(batch_b, first, std::min(first + tile_size, batch_a.size()));
+  }
+
+  std::vector<TypeParam> expected;
+  for (std::size_t idx{ 0 }; idx < opinions_a.size(); ++idx)
+  {
+    bool in_tile = (idx / tile_size) % 2 == 0;
+    expected.push_back(in_tile ? opinions_a[idx].cum_fuse(opinions_b[idx]) : opinions_a[idx]);
+  }
+  TestFixture::expect_near(batch_a, expected);
+}
+
+TYPED_TEST(OpinionBatchTest, MultiSourceFusion)
+{
+  using BatchT = BatchOf<TypeParam>;
+  using FusionType = typename BatchT::FusionType;
+
+  std::vector<std::vector<TypeParam>> source_opinions;
+  std::vector<BatchT> sources;
+  for (unsigned int seed{ 0 }; seed < 4; ++seed)
+  {
+    source_opinions.push_back(test::mixed_opinions<TypeParam>(TestFixture::BATCH_SIZE, seed));
+    sources.emplace_back(source_opinions.back());
+  }
+
+  for (auto fusion_type : { FusionType::CUMULATIVE,
+                            FusionType::BELIEF_CONSTRAINT,
+                            FusionType::AVERAGE,
+                            FusionType::WEIGHTED,
+                            FusionType::CONSENSUS_COMPROMISE })
+  {
+    std::vector<TypeParam> expected;
+    for (std::size_t idx{ 0 }; idx < TestFixture::BATCH_SIZE; ++idx)
+    {
+      std::vector<TypeParam> cell_opinions;
+      for (const auto& opinions : source_opinions)
+      {
+        cell_opinions.push_back(opinions[idx]);
+      }
+      expected.push_back(multisource::Fusion::fuse_opinions(fusion_type, cell_opinions));
+    }
+    SCOPED_TRACE("fusion type " + std::to_string(static_cast<int>(fusion_type)));
+    TestFixture::expect_near(BatchT::fuse_opinions(fusion_type, sources), expected);
+
+    // a single source is the result of all operators
+    TestFixture::expect_near(BatchT::fuse_opinions(fusion_type, { sources.front() }), source_opinions.front());
+  }
+
+  EXPECT_THROW(BatchT::fuse_opinions(FusionType::CUMULATIVE, {}), std::invalid_argument);
+  EXPECT_THROW(BatchT::fuse_opinions(FusionType::CUMULATIVE, { sources.front(), BatchT{ 3 } }),
+               std::invalid_argument);
+}
+
+TYPED_TEST(OpinionBatchTest, CcFuseManySources)
+{
+  using BatchT = BatchOf<TypeParam>;
+  constexpr std::size_t num_sources{ 60 };
+
+  // the products over all sources vanish with the number of sources, yet there is a compromise to be made
+  TypeParam var1{};
+  var1.belief_masses().front() = .3;
+  var1.belief_masses().back() = .2;
+  TypeParam var2{};
+  var2.belief_masses().front() = .2;
+  var2.belief_masses().back() = .3;
+  std::vector<TypeParam> cell_opinions;
+  std::vector<BatchT> sources;
+  for (std::size_t idx{ 0 }; idx < num_sources; ++idx)
+  {
+    cell_opinions.push_back(idx % 2 == 0 ? var1 : var2);
+    sources.emplace_back(std::vector<TypeParam>(TestFixture::BATCH_SIZE, cell_opinions.back()));
+  }
+
+  auto expected = multisource::Fusion::fuse_opinions(BatchT::FusionType::CONSENSUS_COMPROMISE, cell_opinions);
+  EXPECT_NEAR(expected.belief_masses().front(), .5, 1e-5);
+  EXPECT_NEAR(expected.belief_masses().back(), .5, 1e-5);
+  TestFixture::expect_near(BatchT::fuse_opinions(BatchT::FusionType::CONSENSUS_COMPROMISE, sources),
+                           std::vector<TypeParam>(TestFixture::BATCH_SIZE, expected));
+}
+
+TEST(OpinionBatchTest, BinomialProjection)
+{
+  auto opinions = test::mixed_opinions<OpinionNoBase<2, float>>(101, 0);
+  OpinionBatch<2, float> batch{ opinions };
+
+  auto projections = batch.getBinomialProjection(0.2);
+  ASSERT_EQ(projections.size(), opinions.size());
+  for (std::size_t idx{ 0 }; idx < opinions.size(); ++idx)
+  {
+    EXPECT_FLOAT_EQ(projections[idx], opinions[idx].getBinomialProjection(0.2));
+  }
+}
+
+}  // namespace subjective_logic
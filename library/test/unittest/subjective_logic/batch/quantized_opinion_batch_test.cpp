@@ -0,0 +1,234 @@
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "subjective_logic_lib/batch/quantized_opinion_batch.hpp"
+
+#include "test_helpers.hpp"
+
+namespace subjective_logic
+{
+
+template <std::size_t N_, typename Codec_, typename FloatT_>
+struct QuantizedConfig
+{
+  static constexpr std::size_t N = N_;
+  using Codec = Codec_;
+  using FloatT = FloatT_;
+  using OpinionT = OpinionNoBase<N, FloatT>;
+  using BatchT = OpinionBatch<N, FloatT>;
+  using QuantizedT = QuantizedOpinionBatch<N, Codec, FloatT>;
+};
+
+using TestTypes = ::testing::Types<QuantizedConfig<2, UInt8Codec, float>,
+                                   QuantizedConfig<2, UInt16Codec, float>,
+                                   QuantizedConfig<2, Float16Codec, float>,
+                                   QuantizedConfig<2, BFloat16Codec, float>,
+                                   QuantizedConfig<3, UInt8Codec, double>,
+                                   QuantizedConfig<3, UInt16Codec, double>,
+                                   QuantizedConfig<6, Float16Codec, double>,
+                                   QuantizedConfig<6, BFloat16Codec, float> >;
+
+template <typename Config>
+class QuantizedOpinionBatchTest : public ::testing::Test
+{
+public:
+  // more than a single chunk and not a multiple of the chunk size
+  static constexpr std::size_t BATCH_SIZE{ 301 };
+
+  /**
+   * @brief generates vacuous, dogmatic and random opinions including tiny belief masses
+   */
+  static typename Config::BatchT generate_batch(unsigned int seed)
+  {
+    using OpinionT = typename Config::OpinionT;
+    std::mt19937 gen{ seed };
+    std::uniform_real_distribution<typename Config::FloatT> dist{ 0., 1. };
+
+    std::vector<OpinionT> opinions = test::mixed_opinions<OpinionT>(BATCH_SIZE, seed);
+    for (std::size_t idx{ 2 }; idx < BATCH_SIZE; idx += 5)
+    {
+      opinions[idx] = OpinionT{};
+      opinions[idx].belief_masses()[0] = static_cast<typename Config::FloatT>(1e-6) * dist(gen);
+    }
+    return typename Config::BatchT{ opinions };
+  }
+
+  static void expect_equal(const typename Config::QuantizedT& actual, const typename Config::QuantizedT& expected)
+  {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (std::size_t mass_idx{ 0 }; mass_idx < Config::N; ++mass_idx)
+    {
+      for (std::size_t idx{ 0 }; idx < actual.size(); ++idx)
+      {
+        EXPECT_EQ(actual.lane(mass_idx)[idx], expected.lane(mass_idx)[idx]) << "entry " << idx << ", mass " << mass_idx;
+      }
+    }
+  }
+
+  /**
+   * @brief the fused decode-operate-encode operator must match encoding the full precision operator on decoded inputs
+   */
+  template <typename QuantizedOp, typename BatchOp>
+  static void expect_fused_equivalence(QuantizedOp quantized_op, BatchOp batch_op)
+  {
+    using BatchT = typename Config::BatchT;
+    using QuantizedT = typename Config::QuantizedT;
+    const QuantizedT quantized_a{ generate_batch(0) };
+    const QuantizedT quantized_b{ generate_batch(1) };
+    BatchT decoded_a = quantized_a.decode();
+    const BatchT decoded_b = quantized_b.decode();
+
+    QuantizedT fused{ quantized_a };
+    quantized_op(fused, quantized_b);
+    batch_op(decoded_a, decoded_b);
+    expect_equal(fused, QuantizedT{ decoded_a });
+
+    // a full precision operand gives the same result
+    QuantizedT fused_mixed{ quantized_a };
+    quantized_op(fused_mixed, decoded_b);
+    expect_equal(fused_mixed, fused);
+  }
+};
+TYPED_TEST_SUITE(QuantizedOpinionBatchTest, TestTypes);
+
+TYPED_TEST(QuantizedOpinionBatchTest, ErrorBounds)
+{
+  using Codec = typename TypeParam::Codec;
+  using FloatT = typename TypeParam::FloatT;
+  using QuantizedT = typename TypeParam::QuantizedT;
+  constexpr std::size_t N = TypeParam::N;
+
+  auto batch = TestFixture::generate_batch(0);
+  QuantizedT quantized{ batch };
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(quantized.lane(0)) % BATCH_ALIGNMENT, 0);
+  EXPECT_EQ(QuantizedT::BYTES_PER_OPINION, N * sizeof(typename Codec::StorageType));
+
+  for (std::size_t idx{ 0 }; idx < batch.size(); ++idx)
+  {
+    auto original = batch[idx];
+    auto decoded = quantized[idx];
+    for (std::size_t mass_idx{ 0 }; mass_idx < N; ++mass_idx)
+    {
+      FloatT mass = original.belief_masses()[mass_idx];
+      EXPECT_NEAR(decoded.belief_masses()[mass_idx], mass, Codec::error_bound(mass))
+          << "entry " << idx << ", mass " << mass_idx;
+    }
+    // quantization never results in a negative uncertainty (up to the rounding of the decoded masses)
+    EXPECT_GE(decoded.uncertainty(), -EPS_v<FloatT>) << "entry " << idx;
+
+    // decoding and encoding again is stable
+    QuantizedT round_trip{ 1 };
+    round_trip.set(0, decoded);
+    EXPECT_EQ(round_trip[0], decoded) << "entry " << idx;
+  }
+}
+
+TYPED_TEST(QuantizedOpinionBatchTest, CumFuse)
+{
+  using QuantizedT = typename TypeParam::QuantizedT;
+  using BatchT = typename TypeParam::BatchT;
+  TestFixture::expect_fused_equivalence([](QuantizedT& a, const auto& b) { a.cum_fuse_(b); },
+                                        [](BatchT& a, const BatchT& b) { a.cum_fuse_(b); });
+}
+
+TYPED_TEST(QuantizedOpinionBatchTest, AverageFuse)
+{
+  using QuantizedT = typename TypeParam::QuantizedT;
+  using BatchT = typename TypeParam::BatchT;
+  TestFixture::expect_fused_equivalence([](QuantizedT& a, const auto& b) { a.average_fuse_(b); },
+                                        [](BatchT& a, const BatchT& b) { a.average_fuse_(b); });
+}
+
+TYPED_TEST(QuantizedOpinionBatchTest, WeightedFuse)
+{
+  using QuantizedT = typename TypeParam::QuantizedT;
+  using BatchT = typename TypeParam::BatchT;
+  TestFixture::expect_fused_equivalence([](QuantizedT& a, const auto& b) { a.wb_fuse_(b); },
+                                        [](BatchT& a, const BatchT& b) { a.wb_fuse_(b); });
+}
+
+TYPED_TEST(QuantizedOpinionBatchTest, BeliefConstraintFuse)
+{
+  using QuantizedT = typename TypeParam::QuantizedT;
+  using BatchT = typename TypeParam::BatchT;
+  TestFixture::expect_fused_equivalence([](QuantizedT& a, const auto& b) { a.bc_fuse_(b); },
+                                        [](BatchT& a, const BatchT& b) { a.bc_fuse_(b); });
+}
+
+TYPED_TEST(QuantizedOpinionBatchTest, TrustDiscount)
+{
+  using QuantizedT = typename TypeParam::QuantizedT;
+  using BatchT = typename TypeParam::BatchT;
+  using FloatT = typename TypeParam::FloatT;
+  TestFixture::expect_fused_equivalence([](QuantizedT& a, const auto& /*b*/) { a.trust_discount_(FloatT{ 0.3 }); },
+                                        [](BatchT& a, const BatchT& /*b*/) { a.trust_discount_(FloatT{ 0.3 }); });
+}
+
+TYPED_TEST(QuantizedOpinionBatchTest, Ranges)
+{
+  using QuantizedT = typename TypeParam::QuantizedT;
+  const QuantizedT quantized_a{ TestFixture::generate_batch(0) };
+  const QuantizedT quantized_b{ TestFixture::generate_batch(1) };
+
+  QuantizedT full = quantized_a.cum_fuse(quantized_b);
+  QuantizedT ranged{ quantized_a };
+  ranged.cum_fuse_(quantized_b, 0, 17);
+  ranged.cum_fuse_(quantized_b, 17, 200);
+  ranged.cum_fuse_(quantized_b, 200, quantized_a.size());
+  TestFixture::expect_equal(ranged, full);
+}
+
+TEST(QuantizedOpinionBatchTest, BinomialProjection)
+{
+  OpinionBatch<2, float> batch{ 3 };
+  batch.set(0, OpinionNoBase<2, float>{ 0.2, 0.3 });
+  batch.set(1, OpinionNoBase<2, float>{ 0.6, 0.4 });
+  QuantizedOpinionBatch<2, UInt16Codec, float> quantized{ batch };
+
+  auto projection = quantized.getBinomialProjection(0.4);
+  auto expected = batch.getBinomialProjection(0.4);
+  ASSERT_EQ(projection.size(), expected.size());
+  for (std::size_t idx{ 0 }; idx < projection.size(); ++idx)
+  {
+    EXPECT_NEAR(projection[idx], expected[idx], 2 * UInt16Codec::error_bound(1.f));
+  }
+}
+
+TEST(QuantizedOpinionBatchTest, Codecs)
+{
+  // exactly representable values are kept
+  EXPECT_EQ(Float16Codec::decode<float>(Float16Codec::encode(0.5f)), 0.5f);
+  EXPECT_EQ(Float16Codec::decode<float>(Float16Codec::encode(1.f)), 1.f);
+  EXPECT_EQ(Float16Codec::decode<float>(Float16Codec::encode(0.f)), 0.f);
+  EXPECT_EQ(BFloat16Codec::decode<float>(BFloat16Codec::encode(0.25f)), 0.25f);
+  EXPECT_EQ(UInt8Codec::encode(1.f), 255);
+  EXPECT_EQ(UInt8Codec::encode(0.f), 0);
+  EXPECT_EQ(UInt8Codec::decode<float>(255), 1.f);
+
+  // half precision subnormals, 2^-20
+  EXPECT_EQ(Float16Codec::decode<float>(Float16Codec::encode(9.5367431640625e-07f)), 9.5367431640625e-07f);
+
+  // every code is stable w.r.t. decoding and encoding again
+  for (std::uint32_t code{ 0 }; code <= 0x3c00; ++code)
+  {
+    auto code_16 = static_cast<std::uint16_t>(code);
+    EXPECT_EQ(Float16Codec::encode(Float16Codec::decode<float>(code_16)), code_16);
+    EXPECT_EQ(Float16Codec::encode(Float16Codec::decode<double>(code_16)), code_16);
+  }
+  for (std::uint32_t code{ 0 }; code <= 0xffff; ++code)
+  {
+    auto code_16 = static_cast<std::uint16_t>(code);
+    ASSERT_EQ(UInt16Codec::encode(UInt16Codec::decode<float>(code_16)), code_16);
+    ASSERT_EQ(UInt16Codec::encode(UInt16Codec::decode<double>(code_16)), code_16);
+  }
+  for (std::uint32_t code{ 0 }; code <= 0x3f80; ++code)
+  {
+    auto code_16 = static_cast<std::uint16_t>(code);
+    EXPECT_EQ(BFloat16Codec::encode(BFloat16Codec::decode<float>(code_16)), code_16);
+  }
+}
+
+}  // namespace subjective_logic
@@ -0,0 +1,251 @@
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "subjective_logic_lib/batch/shared_prior_opinion_batch.hpp"
+
+#include "test_helpers.hpp"
+
+namespace subjective_logic
+{
+
+using TestTypes = ::testing::Types<Opinion<2, float>,
+                                   Opinion<3, float>,
+                                   Opinion<6, float>,
+                                   Opinion<2, double>,
+                                   Opinion<3, double>,
+                                   Opinion<6, double> >;
+
+template <typename OpinionT>
+using SharedPriorBatchOf = SharedPriorOpinionBatch<OpinionT::SIZE, typename OpinionT::FLOAT_t>;
+
+template <typename OpinionT>
+class SharedPriorOpinionBatchTest : public ::testing::Test
+{
+public:
+  using FloatT = typename OpinionT::FLOAT_t;
+  static constexpr std::size_t N = OpinionT::SIZE;
+  using BeliefType = typename OpinionT::BeliefType;
+
+  static constexpr std::size_t BATCH_SIZE{ 77 };
+  static constexpr FloatT TOLERANCE{ 10 * EPS_v<FloatT> };
+
+  static BeliefType generate_prior(std::mt19937& gen)
+  {
+    std::uniform_real_distribution<FloatT> dist{ 0.1, 1. };
+    BeliefType prior;
+    for (std::size_t mass_idx{ 0 }; mass_idx < N; ++mass_idx)
+    {
+      prior[mass_idx] = dist(gen);
+    }
+    return prior / prior.sum();
+  }
+
+  /**
+   * @brief generates vacuous, dogmatic and random opinions using one of the given priors
+   */
+  static std::vector<OpinionT> generate_opinions(const std::vector<BeliefType>& priors, unsigned int seed)
+  {
+    std::mt19937 gen{ seed };
+    std::uniform_int_distribution<std::size_t> prior_dist{ 0, priors.size() - 1 };
+
+    std::vector<OpinionT> opinions;
+    for (std::size_t idx{ 0 }; idx < BATCH_SIZE; ++idx)
+    {
+      OpinionT opinion{};
+      if (idx % 7 == 1)
+      {
+        opinion.belief_masses()[(idx + seed) % N] = 1.;
+      }
+      else if (idx % 7 != 0)
+      {
+        opinion = test::random_opinion<OpinionT>(gen);
+      }
+      opinion.prior_belief_masses() = priors[prior_dist(gen)];
+      opinions.push_back(opinion);
+    }
+    return opinions;
+  }
+};
+TYPED_TEST_SUITE(SharedPriorOpinionBatchTest, TestTypes);
+
+TYPED_TEST(SharedPriorOpinionBatchTest, PriorTable)
+{
+  using BatchT = SharedPriorBatchOf<TypeParam>;
+  std::mt19937 gen{ 0 };
+  auto prior = TestFixture::generate_prior(gen);
+
+  // a single prior does not require any index per entry
+  auto opinions = TestFixture::generate_opinions({ prior }, 0);
+  BatchT batch{ opinions };
+  EXPECT_EQ(batch.num_priors(), 1);
+  for (std::size_t idx{ 0 }; idx < opinions.size(); ++idx)
+  {
+    EXPECT_EQ(batch[idx], opinions[idx]);
+    EXPECT_EQ(batch.prior_index(idx), 0);
+  }
+
+  // changing the prior of the table affects all entries referring to it
+  auto new_prior = TestFixture::generate_prior(gen);
+  batch.set_prior(0, new_prior);
+  for (std::size_t idx{ 0 }; idx < opinions.size(); ++idx)
+  {
+    EXPECT_EQ(batch[idx], (TypeParam{ opinions[idx].belief_masses(), new_prior }));
+  }
+
+  // multiple priors are stored once each
+  std::vector<typename TestFixture::BeliefType> priors{ prior, new_prior, TestFixture::generate_prior(gen) };
+  auto mixed_opinions = TestFixture::generate_opinions(priors, 1);
+  BatchT mixed{ mixed_opinions };
+  EXPECT_EQ(mixed.num_priors(), 3);
+  for (std::size_t idx{ 0 }; idx < mixed_opinions.size(); ++idx)
+  {
+    EXPECT_EQ(mixed[idx], mixed_opinions[idx]);
+  }
+}
+
+TYPED_TEST(SharedPriorOpinionBatchTest, Projection)
+{
+  using BatchT = SharedPriorBatchOf<TypeParam>;
+  std::mt19937 gen{ 0 };
+  std::vector<typename TestFixture::BeliefType> priors{ TestFixture::generate_prior(gen),
+                                                        TestFixture::generate_prior(gen) };
+
+  for (const auto& used_priors : { std::vector{ priors.front() }, priors })
+  {
+    auto opinions = TestFixture::generate_opinions(used_priors, 0);
+    BatchT batch{ opinions };
+    for (std::size_t mass_idx{ 0 }; mass_idx < TestFixture::N; ++mass_idx)
+    {
+      auto projection = batch.getProjection(mass_idx);
+      for (std::size_t idx{ 0 }; idx < opinions.size(); ++idx)
+      {
+        EXPECT_NEAR(projection[idx], opinions[idx].getProjection()[mass_idx], TestFixture::TOLERANCE);
+      }
+    }
+  }
+}
+
+TYPED_TEST(SharedPriorOpinionBatchTest, DegreeOfConflict)
+{
+  using BatchT = SharedPriorBatchOf<TypeParam>;
+  std::mt19937 gen{ 0 };
+  auto prior = TestFixture::generate_prior(gen);
+
+  auto opinions_a = TestFixture::generate_opinions({ prior }, 0);
+  auto opinions_b = TestFixture::generate_opinions({ prior }, 1);
+  auto conflict = BatchT{ opinions_a }.degree_of_conflict(BatchT{ opinions_b });
+  for (std::size_t idx{ 0 }; idx < opinions_a.size(); ++idx)
+  {
+    EXPECT_NEAR(conflict[idx], opinions_a[idx].degree_of_conflict(opinions_b[idx]), TestFixture::TOLERANCE);
+  }
+}
+
+TEST(SharedPriorOpinionBatchTest, BinomialDegreeOfConflictWithDifferentPriors)
+{
+  using BatchT = SharedPriorOpinionBatch<2, double>;
+  using OpinionT = Opinion<2, double>;
+  std::vector<OpinionT> opinions_a{ OpinionT{ 0.2, 0.3, 0.2 }, OpinionT{ 0.5, 0.1, 0.2 } };
+  std::vector<OpinionT> opinions_b{ OpinionT{ 0.1, 0.6, 0.7 }, OpinionT{ 0.4, 0.4, 0.7 } };
+
+  auto conflict = BatchT{ opinions_a }.degree_of_conflict(BatchT{ opinions_b });
+  for (std::size_t idx{ 0 }; idx < opinions_a.size(); ++idx)
+  {
+    EXPECT_NEAR(conflict[idx], opinions_a[idx].degree_of_conflict(opinions_b[idx]), 1e-12);
+  }
+  EXPECT_DOUBLE_EQ(BatchT{ opinions_a }.getBinomialProjection()[0], opinions_a[0].getBinomialProjection());
+}
+
+TYPED_TEST(SharedPriorOpinionBatchTest, MultiSourceFusion)
+{
+  using BatchT = SharedPriorBatchOf<TypeParam>;
+  using FusionType = typename BatchT::FusionType;
+  using NoBaseT = OpinionNoBase<TestFixture::N, typename TestFixture::FloatT>;
+  std::mt19937 gen{ 0 };
+  auto prior = TestFixture::generate_prior(gen);
+
+  std::vector<std::vector<TypeParam>> source_opinions;
+  std::vector<BatchT> sources;
+  for (unsigned int seed{ 0 }; seed < 4; ++seed)
+  {
+    source_opinions.push_back(TestFixture::generate_opinions({ prior }, seed));
+    sources.emplace_back(source_opinions.back());
+  }
+
+  for (auto fusion_type : { FusionType::CUMULATIVE,
+                            FusionType::BELIEF_CONSTRAINT,
+                            FusionType::AVERAGE,
+                            FusionType::WEIGHTED,
+                            FusionType::CONSENSUS_COMPROMISE })
+  {
+    auto fused = BatchT::fuse_opinions(fusion_type, sources);
+    ASSERT_EQ(fused.size(), TestFixture::BATCH_SIZE);
+    EXPECT_EQ(fused.num_priors(), 1);
+    for (std::size_t idx{ 0 }; idx < fused.size(); ++idx)
+    {
+      std::vector<NoBaseT> cell_opinions;
+      for (const auto& opinions : source_opinions)
+      {
+        cell_opinions.emplace_back(opinions[idx].belief_masses());
+      }
+      auto expected = multisource::Fusion::fuse_opinions(fusion_type, cell_opinions);
+      auto actual = fused[idx];
+      for (std::size_t mass_idx{ 0 }; mass_idx < TestFixture::N; ++mass_idx)
+      {
+        EXPECT_NEAR(actual.belief_masses()[mass_idx], expected.belief_masses()[mass_idx], 100 * TestFixture::TOLERANCE)
+            << "fusion type " << static_cast<int>(fusion_type) << ", entry " << idx;
+      }
+      EXPECT_EQ(actual.prior_belief_masses()[0], prior[0]);
+    }
+  }
+
+  EXPECT_THROW(BatchT::fuse_opinions(FusionType::CUMULATIVE, {}), std::invalid_argument);
+}
+
+TEST(SharedPriorOpinionBatchTest, MultiSourceFusionAveragesPriors)
+{
+  using BatchT = SharedPriorOpinionBatch<2, double>;
+  BatchT source_a{ 2, BatchT::BeliefType{ 0.2, 0.8 } };
+  BatchT source_b{ 2, BatchT::BeliefType{ 0.2, 0.8 } };
+  source_b.set(1, Opinion<2, double>{ 0.3, 0.2, 0.6 });
+
+  auto fused = BatchT::fuse_opinions(BatchT::FusionType::CUMULATIVE, { source_a, source_b });
+  EXPECT_EQ(fused.num_priors(), 2);
+  EXPECT_DOUBLE_EQ(fused[0].getBinomialPrior(), 0.2);
+  EXPECT_DOUBLE_EQ(fused[1].getBinomialPrior(), 0.4);
+  EXPECT_DOUBLE_EQ(fused[1].belief(), 0.3);
+}
+
+TEST(SharedPriorOpinionBatchTest, WeightedFusionOfManyEntriesWithDifferentPriors)
+{
+  // each entry gets its own confidence-weighted prior, i.e., more priors than a 16 bit index could refer to
+  using BatchT = SharedPriorOpinionBatch<2, double>;
+  constexpr std::size_t BATCH_SIZE{ 70000 };
+  BatchT source_a{ BATCH_SIZE, BatchT::BeliefType{ 0.2, 0.8 } };
+  BatchT source_b{ BATCH_SIZE, BatchT::BeliefType{ 0.6, 0.4 } };
+  for (std::size_t idx{ 0 }; idx < BATCH_SIZE; ++idx)
+  {
+    const double belief = 0.5 * static_cast<double>(idx) / BATCH_SIZE;
+    source_a.set(idx, OpinionNoBase<2, double>{ belief, 0.1 });
+    source_b.set(idx, OpinionNoBase<2, double>{ 0.3, 0.1 });
+  }
+
+  auto fused = BatchT::fuse_opinions(BatchT::FusionType::WEIGHTED, { source_a, source_b });
+  ASSERT_EQ(fused.size(), BATCH_SIZE);
+  EXPECT_GT(fused.num_priors(), BATCH_SIZE / 2);
+  for (std::size_t idx : { std::size_t{ 0 }, std::size_t{ 1 }, BATCH_SIZE / 2, BATCH_SIZE - 1 })
+  {
+    auto expected = multisource::Fusion::fuse_opinions(
+        BatchT::FusionType::WEIGHTED, std::vector<Opinion<2, double>>{ source_a[idx], source_b[idx] });
+    EXPECT_NEAR(fused[idx].getBinomialPrior(), expected.getBinomialPrior(), 1e-12);
+    EXPECT_NEAR(fused[idx].belief(), expected.belief(), 1e-12);
+  }
+
+  // the averaged prior is shared by all entries
+  fused = BatchT::fuse_opinions(BatchT::FusionType::AVERAGE, { source_a, source_b });
+  EXPECT_EQ(fused.num_priors(), 2);
+  EXPECT_DOUBLE_EQ(fused[BATCH_SIZE - 1].getBinomialPrior(), 0.4);
+}
+
+}  // namespace subjective_logic
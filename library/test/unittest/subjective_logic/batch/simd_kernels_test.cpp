@@ -0,0 +1,118 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "subjective_logic_lib/batch/opinion_batch.hpp"
+#include "subjective_logic_lib/batch/simd_kernels.hpp"
+
+#include "test_helpers.hpp"
+
+namespace subjective_logic::batch_kernels
+{
+
+using TestTypes = ::testing::Types<OpinionNoBase<2, float>,
+                                   OpinionNoBase<3, float>,
+                                   OpinionNoBase<6, float>,
+                                   OpinionNoBase<2, double>,
+                                   OpinionNoBase<3, double>,
+                                   OpinionNoBase<6, double> >;
+
+template <typename OpinionT>
+class SimdKernelsTest : public ::testing::Test
+{
+public:
+  using FloatT = typename OpinionT::FLOAT_t;
+  static constexpr std::size_t N = OpinionT::SIZE;
+  using BatchT = OpinionBatch<N, FloatT>;
+
+  /**
+   * @brief creates a batch where each vector register contains a mix of vacuous, dogmatic and regular cells
+   */
+  static BatchT generate_batch(std::size_t size, unsigned int seed)
+  {
+    return BatchT{ test::mixed_opinions<OpinionT>(size, seed) };
+  }
+
+  /**
+   * @brief compares the vectorized kernel to its scalar version on all cells
+   */
+  template <typename Kernel>
+  static void expect_scalar_equivalence()
+  {
+    std::size_t size{ 8 * simd_width<FloatT>() + 3 };
+    const BatchT batch_a = generate_batch(size, 0);
+    const BatchT batch_b = generate_batch(size, 1);
+
+    BatchT vectorized{ batch_a };
+    apply_binary<Kernel, N, FloatT>(vectorized.lanes(), batch_a.lanes(), batch_b.lanes(), 0, size);
+
+    BatchT scalar{ batch_a };
+    for (std::size_t idx{ 0 }; idx < size; ++idx)
+    {
+      Kernel::template apply<ScalarTraits<FloatT>, N, FloatT>(scalar.lanes(), batch_a.lanes(), batch_b.lanes(), idx);
+    }
+
+    for (std::size_t idx{ 0 }; idx < size; ++idx)
+    {
+      for (std::size_t mass_idx{ 0 }; mass_idx < N; ++mass_idx)
+      {
+        EXPECT_FLOAT_EQ(vectorized.lane(mass_idx)[idx], scalar.lane(mass_idx)[idx]);
+      }
+    }
+  }
+
+  /**
+   * @brief compares the kernel applied to a compile-time number of cells with the runtime version
+   */
+  template <typename Kernel, std::size_t COUNT>
+  static void expect_fixed_count_equivalence()
+  {
+    const BatchT batch_a = generate_batch(COUNT, 0);
+    const BatchT batch_b = generate_batch(COUNT, 1);
+
+    BatchT fixed{ batch_a };
+    apply_binary<Kernel, COUNT, N, FloatT>(fixed.lanes(), batch_a.lanes(), batch_b.lanes());
+
+    BatchT runtime{ batch_a };
+    apply_binary<Kernel, N, FloatT>(runtime.lanes(), batch_a.lanes(), batch_b.lanes(), 0, COUNT);
+
+    for (std::size_t idx{ 0 }; idx < COUNT; ++idx)
+    {
+      for (std::size_t mass_idx{ 0 }; mass_idx < N; ++mass_idx)
+      {
+        EXPECT_EQ(fixed.lane(mass_idx)[idx], runtime.lane(mass_idx)[idx]);
+      }
+    }
+  }
+};
+TYPED_TEST_SUITE(SimdKernelsTest, TestTypes);
+
+TYPED_TEST(SimdKernelsTest, CumulativeFusion)
+{
+  TestFixture::template expect_scalar_equivalence<CumulativeFusion>();
+}
+
+TYPED_TEST(SimdKernelsTest, AverageFusion)
+{
+  TestFixture::template expect_scalar_equivalence<AverageFusion>();
+}
+
+TYPED_TEST(SimdKernelsTest, WeightedFusion)
+{
+  TestFixture::template expect_scalar_equivalence<WeightedFusion>();
+}
+
+TYPED_TEST(SimdKernelsTest, BeliefConstraintFusion)
+{
+  TestFixture::template expect_scalar_equivalence<BeliefConstraintFusion>();
+}
+
+TYPED_TEST(SimdKernelsTest, FixedCount)
+{
+  // a multiple of the vector width without any scalar remainder and a count with remainder
+  constexpr std::size_t WIDTH = simd_width<typename TypeParam::FLOAT_t>();
+  TestFixture::template expect_fixed_count_equivalence<AverageFusion, 8 * WIDTH>();
+  TestFixture::template expect_fixed_count_equivalence<BeliefConstraintFusion, 8 * WIDTH + 3>();
+}
+
+}  // namespace subjective_logic::batch_kernels
@@ -0,0 +1,248 @@
+#include <algorithm>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "subjective_logic_lib/batch/sparse_opinion_grid.hpp"
+
+#include "test_helpers.hpp"
+
+namespace subjective_logic
+{
+
+using TestTypes = ::testing::Types<OpinionNoBase<2, float>,
+                                   OpinionNoBase<3, float>,
+                                   OpinionNoBase<6, float>,
+                                   OpinionNoBase<2, double>,
+                                   OpinionNoBase<3, double>,
+                                   OpinionNoBase<6, double> >;
+
+template <typename OpinionT>
+using GridOf = SparseOpinionGrid<OpinionT::SIZE, typename OpinionT::FLOAT_t>;
+
+template <typename OpinionT>
+class SparseOpinionGridTest : public ::testing::Test
+{
+public:
+  static constexpr std::size_t N = OpinionT::SIZE;
+  using ReferenceT = std::map<std::pair<std::int32_t, std::int32_t>, OpinionT>;
+
+  static constexpr typename OpinionT::FLOAT_t TOLERANCE{ 10 * EPS_v<typename OpinionT::FLOAT_t> };
+  // the generated cells are located within [-RANGE, RANGE)
+  static constexpr std::int32_t RANGE{ 20 };
+
+  /**
+   * @brief generates a grid of scattered (partly dogmatic) opinions and the same opinions as dense reference
+   */
+  static std::pair<GridOf<OpinionT>, ReferenceT> generate_grid(std::size_t num_cells, unsigned int seed)
+  {
+    std::mt19937 gen{ seed };
+    std::uniform_int_distribution<std::int32_t> coord{ -RANGE, RANGE - 1 };
+
+    GridOf<OpinionT> grid;
+    ReferenceT reference;
+    for (std::size_t idx{ 0 }; idx < num_cells; ++idx)
+    {
+      OpinionT opinion{};
+      if (idx % 4 == 1)
+      {
+        opinion.belief_masses()[idx % N] = 1.;
+      }
+      else
+      {
+        opinion = test::random_opinion<OpinionT>(gen);
+      }
+      std::int32_t x = coord(gen);
+      std::int32_t y = coord(gen);
+      grid.set(x, y, opinion);
+      reference[{ x, y }] = opinion;
+    }
+    return { grid, reference };
+  }
+
+  static OpinionT lookup(const ReferenceT& reference, std::int32_t x, std::int32_t y)
+  {
+    auto iter = reference.find({ x, y });
+    return iter == reference.end() ? OpinionT{} : iter->second;
+  }
+
+  /**
+   * @brief compares a grid operator with the scalar operator applied to every cell of the covered area
+   */
+  template <typename GridOp, typename ScalarOp>
+  static void expect_cellwise(GridOp grid_op, ScalarOp scalar_op)
+  {
+    auto [grid_a, reference_a] = generate_grid(150, 0);
+    auto [grid_b, reference_b] = generate_grid(150, 1);
+
+    GridOf<OpinionT> fused = grid_op(grid_a, grid_b);
+    for (std::int32_t x{ -RANGE - 8 }; x < RANGE + 8; ++x)
+    {
+      for (std::int32_t y{ -RANGE - 8 }; y < RANGE + 8; ++y)
+      {
+        OpinionT expected = scalar_op(lookup(reference_a, x, y), lookup(reference_b, x, y));
+        OpinionT actual = fused.get(x, y);
+        for (std::size_t mass_idx{ 0 }; mass_idx < N; ++mass_idx)
+        {
+          EXPECT_NEAR(actual.belief_masses()[mass_idx], expected.belief_masses()[mass_idx], TOLERANCE)
+              << "cell " << x << ", " << y << ", mass " << mass_idx;
+        }
+      }
+    }
+  }
+};
+TYPED_TEST_SUITE(SparseOpinionGridTest, TestTypes);
+
+TYPED_TEST(SparseOpinionGridTest, Access)
+{
+  using GridT = GridOf<TypeParam>;
+
+  GridT grid;
+  EXPECT_TRUE(grid.empty());
+  EXPECT_EQ(grid.get(3, -5), TypeParam{});
+
+  // setting vacuous opinions does not allocate
+  grid.set(100, 100, TypeParam{});
+  EXPECT_EQ(grid.num_blocks(), 0);
+
+  TypeParam opinion{};
+  opinion.belief_masses()[0] = 0.5;
+  // the cells are in distinct blocks, including the ones left of and below the origin
+  grid.set(0, 0, opinion);
+  grid.set(-1, 0, opinion);
+  grid.set(0, -1, opinion);
+  grid.set(-8, -9, opinion);
+  grid.set(7, 7, opinion);
+  EXPECT_EQ(grid.num_blocks(), 4);
+  EXPECT_EQ(grid.num_occupied_cells(), 5);
+
+  EXPECT_EQ(grid.get(-1, 0), opinion);
+  EXPECT_EQ(grid.get(-8, -9), opinion);
+  EXPECT_EQ(grid.get(1, 0), TypeParam{});
+
+  std::vector<std::pair<std::int32_t, std::int32_t>> visited;
+  grid.for_each([&](std::int32_t x, std::int32_t y, const TypeParam& cell) {
+    EXPECT_EQ(cell, opinion);
+    visited.emplace_back(x, y);
+  });
+  std::sort(visited.begin(), visited.end());
+  std::vector<std::pair<std::int32_t, std::int32_t>> expected{ { -8, -9 }, { -1, 0 }, { 0, -1 }, { 0, 0 }, { 7, 7 } };
+  EXPECT_EQ(visited, expected);
+
+  // resetting a cell to vacuous keeps the block until it is pruned
+  grid.set(-8, -9, TypeParam{});
+  EXPECT_EQ(grid.get(-8, -9), TypeParam{});
+  EXPECT_EQ(grid.num_occupied_cells(), 4);
+  EXPECT_EQ(grid.num_blocks(), 4);
+  grid.prune();
+  EXPECT_EQ(grid.num_blocks(), 3);
+  EXPECT_EQ(grid.get(-1, 0), opinion);
+  EXPECT_EQ(grid.get(7, 7), opinion);
+
+  grid.clear();
+  EXPECT_TRUE(grid.empty());
+  EXPECT_EQ(grid.get(0, 0), TypeParam{});
+}
+
+TYPED_TEST(SparseOpinionGridTest, CumFuse)
+{
+  using GridT = GridOf<TypeParam>;
+  TestFixture::expect_cellwise([](const GridT& a, const GridT& b) { return a.cum_fuse(b); },
+                               [](const TypeParam& a, const TypeParam& b) { return a.cum_fuse(b); });
+}
+
+TYPED_TEST(SparseOpinionGridTest, AverageFuse)
+{
+  using GridT = GridOf<TypeParam>;
+  TestFixture::expect_cellwise([](const GridT& a, const GridT& b) { return a.average_fuse(b); },
+                               [](const TypeParam& a, const TypeParam& b) { return a.average_fuse(b); });
+}
+
+TYPED_TEST(SparseOpinionGridTest, WeightedFuse)
+{
+  using GridT = GridOf<TypeParam>;
+  TestFixture::expect_cellwise([](const GridT& a, const GridT& b) { return a.wb_fuse(b); },
+                               [](const TypeParam& a, const TypeParam& b) { return a.wb_fuse(b); });
+}
+
+TYPED_TEST(SparseOpinionGridTest, BeliefConstraintFuse)
+{
+  using GridT = GridOf<TypeParam>;
+  TestFixture::expect_cellwise([](const GridT& a, const GridT& b) { return a.bc_fuse(b); },
+                               [](const TypeParam& a, const TypeParam& b) { return a.bc_fuse(b); });
+}
+
+TYPED_TEST(SparseOpinionGridTest, FusionTouchesObservedBlocksOnly)
+{
+  using GridT = GridOf<TypeParam>;
+
+  TypeParam opinion{};
+  opinion.belief_masses()[0] = 0.5;
+  GridT grid_a;
+  grid_a.set(0, 0, opinion);
+  GridT grid_b;
+  grid_b.set(1000, -1000, opinion);
+
+  GridT fused = grid_a.cum_fuse(grid_b);
+  EXPECT_EQ(fused.num_blocks(), 2);
+  EXPECT_EQ(fused.num_occupied_cells(), 2);
+  EXPECT_EQ(fused.get(0, 0), opinion);
+  EXPECT_EQ(fused.get(1000, -1000), opinion);
+
+  // fusing with an empty grid is a no-op
+  fused.cum_fuse_(GridT{});
+  EXPECT_EQ(fused.num_blocks(), 2);
+}
+
+TYPED_TEST(SparseOpinionGridTest, TrustDiscount)
+{
+  using FloatT = typename TypeParam::FLOAT_t;
+  auto [grid, reference] = TestFixture::generate_grid(100, 0);
+  FloatT prop{ 0.3 };
+
+  auto discounted = grid.trust_discount(prop);
+  EXPECT_EQ(discounted.num_occupied_cells(), reference.size());
+  for (const auto& [coords, opinion] : reference)
+  {
+    EXPECT_EQ(discounted.get(coords.first, coords.second), opinion.trust_discount(prop));
+  }
+
+  // a probability of zero turns every cell vacuous
+  discounted.trust_discount_(0.);
+  EXPECT_TRUE(discounted.empty());
+  discounted.prune();
+  EXPECT_EQ(discounted.num_blocks(), 0);
+}
+
+TYPED_TEST(SparseOpinionGridTest, Classify)
+{
+  auto [grid, reference] = TestFixture::generate_grid(100, 0);
+  auto classifier = [](const TypeParam& opinion) { return opinion.uncertainty() < 0.5 ? 1 : 0; };
+
+  auto labels = grid.classify(classifier);
+  ASSERT_EQ(labels.size(), reference.size());
+  for (const auto& [cell, label] : labels)
+  {
+    EXPECT_EQ(label, classifier(reference.at({ cell.x, cell.y })));
+  }
+}
+
+TEST(SparseOpinionGridTest, BinomialProjection)
+{
+  SparseOpinionGrid<2, double> grid;
+  grid.set(-3, 4, OpinionNoBase<2, double>{ 0.2, 0.3 });
+  grid.set(12, 4, OpinionNoBase<2, double>{ 0.6, 0.4 });
+
+  auto projection = grid.getBinomialProjection(0.4);
+  ASSERT_EQ(projection.size(), 2);
+  std::sort(projection.begin(), projection.end(), [](const auto& a, const auto& b) { return a.first.x < b.first.x; });
+  EXPECT_EQ(projection[0].first, (SparseOpinionGrid<2, double>::CellIndex{ -3, 4 }));
+  EXPECT_DOUBLE_EQ(projection[0].second, 0.2 + 0.5 * 0.4);
+  EXPECT_EQ(projection[1].first, (SparseOpinionGrid<2, double>::CellIndex{ 12, 4 }));
+  EXPECT_DOUBLE_EQ(projection[1].second, 0.6);
+}
+
+}  // namespace subjective_logic
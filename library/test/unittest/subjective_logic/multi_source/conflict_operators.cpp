@@ -1,5 +1,8 @@
 #include <iostream>
 #include <algorithm>
+#include <array>
+#include <random>
+#include <span>
 
 #include "gtest/gtest.h"
 
@@ -27,6 +30,52 @@ TEST(MultiSourceNoBaseConflictTest, JosangExampleCumFuse)
   EXPECT_FLOAT_EQ(expected_avg_conflict, avg_conflict);
 }
 
+TEST(MultiSourceNoBaseConflictTest, JosangExampleCompileTime)
+{
+  // the conflict operator is chosen at compile time, thus, the whole conflict can be evaluated at compile time
+  static constexpr std::array opinions{ OpinionNoBase(0.1, 0.3), OpinionNoBase(0.4, 0.2), OpinionNoBase(0.7, 0.1) };
+  constexpr std::span<const OpinionNoBase<2, float>> opinion_span{ opinions };
+
+  constexpr float acc_conflict = Conflict::conflict<Conflict::ConflictType::ACCUMULATE>(opinion_span);
+  constexpr float avg_conflict = Conflict::conflict<Conflict::ConflictType::AVERAGE>(opinion_span);
+  static_assert(acc_conflict > 0.);
+  static_assert(avg_conflict * 3 > acc_conflict - 1e-6 and avg_conflict * 3 < acc_conflict + 1e-6);
+  constexpr float belief_conflict = Conflict::conflict<Conflict::ConflictType::BELIEF_AVERAGE>(opinion_span);
+  constexpr float belief_harmony = Conflict::harmony<Conflict::ConflictType::BELIEF_WEIGHTED>(opinion_span);
+
+  // equal to the runtime dispatch
+  EXPECT_FLOAT_EQ(acc_conflict, Conflict::conflict(Conflict::ConflictType::ACCUMULATE, opinion_span));
+  EXPECT_FLOAT_EQ(avg_conflict, Conflict::conflict(Conflict::ConflictType::AVERAGE, opinion_span));
+  EXPECT_FLOAT_EQ(belief_conflict, Conflict::conflict(Conflict::ConflictType::BELIEF_AVERAGE, opinion_span));
+  EXPECT_FLOAT_EQ(belief_harmony, Conflict::harmony(Conflict::ConflictType::BELIEF_WEIGHTED, opinion_span));
+}
+
+TEST(MultiSourceNoBaseConflictTest, FixedArityEqualsSpan)
+{
+  static constexpr Array<4, OpinionNoBase<3, double>> opinions{ OpinionNoBase<3, double>{ 0.1, 0.3, 0.2 },
+                                                                OpinionNoBase<3, double>{ 0.4, 0.2, 0.1 },
+                                                                OpinionNoBase<3, double>{ 0.0, 0.0, 0.0 },
+                                                                OpinionNoBase<3, double>{ 0.3, 0.1, 0.5 } };
+  constexpr std::span<const OpinionNoBase<3, double>> opinion_span{ &opinions[0], opinions.size() };
+
+  // the unrolled pairs are summed up in the same order as the loops over a span, thus, the results are equal
+  for (auto conflict_type : { Conflict::ConflictType::ACCUMULATE,
+                              Conflict::ConflictType::AVERAGE,
+                              Conflict::ConflictType::BELIEF_CUMULATIVE,
+                              Conflict::ConflictType::BELIEF_BELIEF_CONSTRAINT,
+                              Conflict::ConflictType::BELIEF_AVERAGE,
+                              Conflict::ConflictType::BELIEF_WEIGHTED })
+  {
+    EXPECT_EQ(Conflict::conflict(conflict_type, opinions), Conflict::conflict(conflict_type, opinion_span));
+    EXPECT_EQ(Conflict::harmony(conflict_type, opinions), Conflict::harmony(conflict_type, opinion_span));
+  }
+
+  constexpr double acc_conflict = Conflict::conflict<Conflict::ConflictType::ACCUMULATE>(opinions);
+  static_assert(acc_conflict == Conflict::conflict<Conflict::ConflictType::ACCUMULATE>(opinion_span));
+  static_assert(Conflict::harmony<Conflict::ConflictType::AVERAGE>(Array<1, OpinionNoBase<3, double>>{ opinions[0] })
+                == 0.);
+}
+
 using TestTypes = ::testing::Types<OpinionNoBase<2, float>,
                                    OpinionNoBase<3, float>,
                                    OpinionNoBase<6, float>,
@@ -134,6 +183,112 @@ TYPED_TEST(MultiSourceNoBaseConflictTest, MultiSourceConflictSharesOutlier)
   EXPECT_FLOAT_EQ(conflict_shares[2], 1.0);
 }
 
+TYPED_TEST(MultiSourceNoBaseConflictTest, MultiSourceConflictSharesLeaveOneOut)
+{
+  using FloatT = typename TypeParam::FLOAT_t;
+  std::mt19937 gen{ 0 };
+  std::uniform_real_distribution<FloatT> dist{ 0.05, 1. };
+
+  std::vector<TypeParam> opinions(12);
+  for (auto& opinion : opinions)
+  {
+    for (std::size_t mass_idx{ 0 }; mass_idx < TypeParam::SIZE; ++mass_idx)
+    {
+      opinion.belief_masses()[mass_idx] = dist(gen);
+    }
+    opinion.belief_masses() *= dist(gen) / opinion.belief_masses().sum();
+  }
+
+  // the shares derived from the pairwise relations equal the relations recalculated without each opinion
+  for (auto conflict_type : { Conflict::ConflictType::ACCUMULATE, Conflict::ConflictType::AVERAGE })
+  {
+    auto [avg_conflict, conflict_shares] =
+        Conflict::conflict_shares<Conflict::RelationType::CONFLICT>(conflict_type, opinions);
+    auto [avg_harmony, harmony_shares] =
+        Conflict::conflict_shares<Conflict::RelationType::HARMONY>(conflict_type, opinions);
+    EXPECT_NEAR(avg_conflict, Conflict::conflict(conflict_type, opinions), 1e-5);
+    EXPECT_NEAR(avg_harmony, Conflict::harmony(conflict_type, opinions), 1e-5);
+
+    for (std::size_t idx{ 0 }; idx < opinions.size(); ++idx)
+    {
+      std::vector<bool> use_opinion(opinions.size(), true);
+      use_opinion[idx] = false;
+      EXPECT_NEAR(conflict_shares[idx],
+                  1. - Conflict::conflict(conflict_type, opinions, use_opinion) / avg_conflict,
+                  1e-4);
+      EXPECT_NEAR(harmony_shares[idx],
+                  1. - Conflict::harmony(conflict_type, opinions, use_opinion) / avg_harmony,
+                  1e-4);
+    }
+  }
+}
+
+TYPED_TEST(MultiSourceNoBaseConflictTest, PairwiseMatrix)
+{
+  using FloatT = typename TypeParam::FLOAT_t;
+  std::mt19937 gen{ 1 };
+  std::uniform_real_distribution<FloatT> dist{ 0.05, 1. };
+
+  // more opinions than a single block to cover the blocks off the diagonal
+  constexpr std::size_t NUM_OPINIONS{ Conflict::PAIRWISE_BLOCK_SIZE + 29 };
+  std::vector<TypeParam> opinions(NUM_OPINIONS);
+  for (auto& opinion : opinions)
+  {
+    for (std::size_t mass_idx{ 0 }; mass_idx < TypeParam::SIZE; ++mass_idx)
+    {
+      opinion.belief_masses()[mass_idx] = dist(gen);
+    }
+    opinion.belief_masses() *= dist(gen) / opinion.belief_masses().sum();
+  }
+
+  constexpr FloatT UNTOUCHED{ -1. };
+  std::vector<FloatT> conflicts(NUM_OPINIONS * NUM_OPINIONS, UNTOUCHED);
+  std::vector<FloatT> harmonies(NUM_OPINIONS * NUM_OPINIONS, UNTOUCHED);
+  Conflict::pairwise_matrix<Conflict::RelationType::CONFLICT>(std::span<const TypeParam>{ opinions },
+                                                              std::span{ conflicts });
+  Conflict::pairwise_matrix<Conflict::RelationType::HARMONY>(std::span<const TypeParam>{ opinions },
+                                                             std::span{ harmonies });
+
+  for (std::size_t idx_row{ 0 }; idx_row < NUM_OPINIONS; ++idx_row)
+  {
+    for (std::size_t idx_col{ 0 }; idx_col < NUM_OPINIONS; ++idx_col)
+    {
+      const std::size_t idx = idx_row * NUM_OPINIONS + idx_col;
+      if (idx_col < idx_row)
+      {
+        EXPECT_EQ(conflicts[idx], UNTOUCHED);
+        EXPECT_EQ(harmonies[idx], UNTOUCHED);
+        continue;
+      }
+      EXPECT_NEAR(conflicts[idx], opinions[idx_row].degree_of_conflict(opinions[idx_col]), 1e-6);
+      EXPECT_NEAR(harmonies[idx], opinions[idx_row].degree_of_harmony(opinions[idx_col]), 1e-6);
+    }
+  }
+}
+
+TEST(MultiSourceConflictTest, PairwiseMatrixWithPriors)
+{
+  using OpinionT = Opinion<3, double>;
+  using BeliefT = OpinionT::BeliefType;
+  // each opinion is projected using its own prior
+  std::vector<OpinionT> opinions{ OpinionT{ BeliefT{ 0.2, 0.3, 0.1 }, BeliefT{ 0.6, 0.2, 0.2 } },
+                                  OpinionT{ BeliefT{ 0.1, 0.1, 0.5 }, BeliefT{ 0.1, 0.1, 0.8 } },
+                                  OpinionT{ BeliefT{ 0.4, 0.0, 0.0 }, BeliefT{ 0.3, 0.3, 0.4 } } };
+
+  std::vector<double> conflicts(9);
+  Conflict::pairwise_matrix<Conflict::RelationType::CONFLICT>(std::span<const OpinionT>{ opinions },
+                                                              std::span{ conflicts });
+  for (std::size_t idx_row{ 0 }; idx_row < 3; ++idx_row)
+  {
+    EXPECT_NEAR(conflicts[idx_row * 4], 0., 1e-12);
+    for (std::size_t idx_col{ idx_row + 1 }; idx_col < 3; ++idx_col)
+    {
+      EXPECT_NEAR(conflicts[idx_row * 3 + idx_col], opinions[idx_row].degree_of_conflict(opinions[idx_col]), 1e-12);
+      EXPECT_NEAR(conflicts[idx_row * 3 + idx_col], opinions[idx_col].degree_of_conflict(opinions[idx_row]), 1e-12);
+    }
+  }
+}
+
 TYPED_TEST(MultiSourceNoBaseConflictTest, MultiSourceBeliefConflictZeroConflict)
 {
   static constexpr std::size_t N = TypeParam::SIZE;
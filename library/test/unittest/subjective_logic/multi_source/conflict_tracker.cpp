@@ -0,0 +1,157 @@
+#include <random>
+#include <span>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "subjective_logic_lib/multi_source/conflict_tracker.hpp"
+#include "subjective_logic_lib/multi_source/conflict_operators.hpp"
+#include "subjective_logic_lib/multi_source/trust_revision_operators.hpp"
+
+#include "test_helpers.hpp"
+
+namespace subjective_logic::multisource
+{
+
+template <typename OpinionT>
+class ConflictTrackerTest : public ::testing::Test
+{
+public:
+  static constexpr double TOLERANCE = std::is_same_v<typename OpinionT::FLOAT_t, float> ? 1e-4 : 1e-9;
+  static constexpr std::size_t NUM_SOURCES{ 7 };
+
+  OpinionT random_opinion()
+  {
+    return test::random_opinion<OpinionT>(gen, 0.05);
+  }
+
+  void SetUp() override
+  {
+    for (std::size_t idx{ 0 }; idx < NUM_SOURCES; ++idx)
+    {
+      opinions.push_back(random_opinion());
+    }
+  }
+
+  // compares the tracker with the stateless conflict operators of the current opinions
+  template <Conflict::RelationType RelationT>
+  void expect_consistent(const ConflictTracker<OpinionT, RelationT>& tracker)
+  {
+    constexpr bool CONFLICT = RelationT == Conflict::RelationType::CONFLICT;
+    ASSERT_EQ(tracker.size(), opinions.size());
+    for (std::size_t idx{ 0 }; idx < opinions.size(); ++idx)
+    {
+      for (std::size_t idx_other{ 0 }; idx_other < opinions.size(); ++idx_other)
+      {
+        if (idx == idx_other)
+        {
+          continue;
+        }
+        auto expected = CONFLICT ? opinions[idx].degree_of_conflict(opinions[idx_other])
+                                   : opinions[idx].degree_of_harmony(opinions[idx_other]);
+        EXPECT_NEAR(tracker.relation(idx, idx_other), expected, TOLERANCE);
+      }
+    }
+
+    auto accumulated = CONFLICT ? Conflict::conflict(Conflict::ConflictType::ACCUMULATE, opinions)
+                                  : Conflict::harmony(Conflict::ConflictType::ACCUMULATE, opinions);
+    EXPECT_NEAR(tracker.accumulated(), accumulated, TOLERANCE);
+
+    auto [average, shares] = Conflict::conflict_shares<RelationT>(Conflict::ConflictType::AVERAGE, opinions);
+    EXPECT_NEAR(tracker.average(), average, TOLERANCE);
+    for (std::size_t idx{ 0 }; idx < opinions.size(); ++idx)
+    {
+      EXPECT_NEAR(tracker.share(idx), shares[idx], TOLERANCE);
+    }
+  }
+
+  std::mt19937 gen{ 0 };
+  std::vector<OpinionT> opinions;
+};
+
+using TestTypes = ::testing::Types<OpinionNoBase<2, float>, OpinionNoBase<3, double>, Opinion<2, double>,
+                                   Opinion<4, float>>;
+TYPED_TEST_SUITE(ConflictTrackerTest, TestTypes);
+
+TYPED_TEST(ConflictTrackerTest, UpdatesEqualStatelessOperators)
+{
+  ConflictTracker<TypeParam> conflict_tracker{ std::span<const TypeParam>{ this->opinions } };
+  ConflictTracker<TypeParam, Conflict::RelationType::HARMONY> harmony_tracker{ std::span<const TypeParam>{
+      this->opinions } };
+  this->expect_consistent(conflict_tracker);
+  this->expect_consistent(harmony_tracker);
+
+  std::uniform_int_distribution<std::size_t> source_dist{ 0, TestFixture::NUM_SOURCES - 1 };
+  for (int step{ 0 }; step < 50; ++step)
+  {
+    const std::size_t idx = source_dist(this->gen);
+    this->opinions[idx] = this->random_opinion();
+    conflict_tracker.update(idx, this->opinions[idx]);
+    harmony_tracker.update(idx, this->opinions[idx]);
+  }
+  this->expect_consistent(conflict_tracker);
+  this->expect_consistent(harmony_tracker);
+
+  // a source that agrees with all others does not contribute to the conflict
+  this->opinions.assign(TestFixture::NUM_SOURCES, this->opinions[0]);
+  conflict_tracker.reset(std::span<const TypeParam>{ this->opinions });
+  EXPECT_NEAR(conflict_tracker.accumulated(), 0., TestFixture::TOLERANCE);
+  EXPECT_EQ(conflict_tracker.share(0), 0.);
+}
+
+TYPED_TEST(ConflictTrackerTest, ManyUpdatesDoNotDrift)
+{
+  ConflictTracker<TypeParam> conflict_tracker{ std::span<const TypeParam>{ this->opinions } };
+
+  // the sums are recalculated several times in between, the last updates are not followed by a recalculation
+  std::uniform_int_distribution<std::size_t> source_dist{ 0, TestFixture::NUM_SOURCES - 1 };
+  for (std::size_t step{ 0 }; step < 100 * TestFixture::NUM_SOURCES + 3; ++step)
+  {
+    const std::size_t idx = source_dist(this->gen);
+    this->opinions[idx] = this->random_opinion();
+    conflict_tracker.update(idx, this->opinions[idx]);
+  }
+  this->expect_consistent(conflict_tracker);
+}
+
+TYPED_TEST(ConflictTrackerTest, TrustRevisionFactors)
+{
+  using FloatT = typename TypeParam::FLOAT_t;
+  using TrustedOpinionT = TrustedOpinion<TypeParam>;
+  using RevisionType = TrustRevision::TrustRevisionType;
+
+  std::vector<TrustedOpinionT> trusted_opinions;
+  for (const auto& opinion : this->opinions)
+  {
+    trusted_opinions.emplace_back(typename TrustedOpinionT::TrustT{ 0.6, 0.1, 0.5 }, opinion);
+  }
+  ConflictTracker<TypeParam> conflict_tracker{ std::span<const TypeParam>{ this->opinions } };
+  ConflictTracker<TypeParam, Conflict::RelationType::HARMONY> harmony_tracker{ std::span<const TypeParam>{
+      this->opinions } };
+
+  Workspace<TypeParam> workspace;
+  std::span<const TrustedOpinionT> trusted{ trusted_opinions };
+  std::vector<FloatT> factors(this->opinions.size());
+  auto expect_factors = [&](std::span<const FloatT> expected) {
+    ASSERT_EQ(expected.size(), factors.size());
+    for (std::size_t idx{ 0 }; idx < factors.size(); ++idx)
+    {
+      EXPECT_NEAR(factors[idx], expected[idx], TestFixture::TOLERANCE);
+    }
+  };
+
+  TrustRevision::revision_factors(conflict_tracker, std::span{ factors });
+  expect_factors(TrustRevision::revision_factors<RevisionType::CONFLICT_SHARES>(
+      Conflict::ConflictType::AVERAGE, trusted, workspace));
+  TrustRevision::revision_factors(conflict_tracker, std::span{ factors }, false);
+  expect_factors(TrustRevision::revision_factors<RevisionType::CONFLICT_SHARES_ALLOW_NEGATIVE>(
+      Conflict::ConflictType::AVERAGE, trusted, workspace));
+  TrustRevision::revision_factors(harmony_tracker, std::span{ factors });
+  expect_factors(TrustRevision::revision_factors<RevisionType::HARMONY_SHARES>(
+      Conflict::ConflictType::AVERAGE, trusted, workspace));
+  TrustRevision::revision_factors(harmony_tracker, std::span{ factors }, false);
+  expect_factors(TrustRevision::revision_factors<RevisionType::HARMONY_SHARES_ALLOW_NEGATIVE>(
+      Conflict::ConflictType::AVERAGE, trusted, workspace));
+}
+
+}  // namespace subjective_logic::multisource
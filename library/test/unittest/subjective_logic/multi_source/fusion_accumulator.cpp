@@ -0,0 +1,161 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "subjective_logic_lib/multi_source/fusion_accumulator.hpp"
+
+#include "test_helpers.hpp"
+
+namespace subjective_logic::multisource
+{
+
+template <typename T>
+class FusionAccumulatorTest : public ::testing::Test
+{
+public:
+  static constexpr Fusion::FusionType FUSION_TYPE = T::second_type::value;
+  using AccumulatorT = FusionAccumulator<typename T::first_type, FUSION_TYPE>;
+  static constexpr double TOLERANCE = std::is_same_v<typename T::first_type::FLOAT_t, float> ? 1e-4 : 1e-9;
+
+  // compares the accumulated result with fusing all given opinions at once
+  static void expect_fusion_of(const AccumulatorT& accumulator, const std::vector<typename T::first_type>& opinions)
+  {
+    test::expect_near(accumulator.result(), Fusion::fuse_opinions(FUSION_TYPE, opinions), TOLERANCE);
+  }
+};
+
+template <typename OpinionT, Fusion::FusionType FUSION_TYPE>
+using TestType = std::pair<OpinionT, std::integral_constant<Fusion::FusionType, FUSION_TYPE>>;
+
+using TestTypes = ::testing::Types<TestType<OpinionNoBase<2, float>, Fusion::FusionType::CUMULATIVE>,
+                                   TestType<OpinionNoBase<5, double>, Fusion::FusionType::CUMULATIVE>,
+                                   TestType<Opinion<3, double>, Fusion::FusionType::CUMULATIVE>,
+                                   TestType<OpinionNoBase<2, float>, Fusion::FusionType::AVERAGE>,
+                                   TestType<Opinion<2, double>, Fusion::FusionType::AVERAGE>,
+                                   TestType<Opinion<5, float>, Fusion::FusionType::AVERAGE>,
+                                   TestType<OpinionNoBase<3, double>, Fusion::FusionType::WEIGHTED>,
+                                   TestType<Opinion<2, float>, Fusion::FusionType::WEIGHTED>,
+                                   TestType<Opinion<5, double>, Fusion::FusionType::WEIGHTED>>;
+TYPED_TEST_SUITE(FusionAccumulatorTest, TestTypes);
+
+TYPED_TEST(FusionAccumulatorTest, AddEqualsFusion)
+{
+  using OpinionT = typename TypeParam::first_type;
+  typename TestFixture::AccumulatorT accumulator;
+  EXPECT_TRUE(accumulator.empty());
+  EXPECT_EQ(accumulator.result(), OpinionT{});
+
+  std::vector<OpinionT> added;
+  for (const auto& opinion : test::random_opinions<OpinionT>(20, 0, 0.05))
+  {
+    accumulator.add(opinion);
+    added.push_back(opinion);
+    EXPECT_EQ(accumulator.size(), added.size());
+    TestFixture::expect_fusion_of(accumulator, added);
+  }
+
+  // a single source reproduces itself
+  typename TestFixture::AccumulatorT single{ { added.front() } };
+  test::expect_near(single.result(), added.front(), TestFixture::TOLERANCE);
+}
+
+TYPED_TEST(FusionAccumulatorTest, RemoveAndReplace)
+{
+  using OpinionT = typename TypeParam::first_type;
+  auto opinions = test::random_opinions<OpinionT>(20, 1, 0.05);
+  typename TestFixture::AccumulatorT accumulator{ opinions };
+
+  // replacing the reports of some sources
+  auto updates = test::random_opinions<OpinionT>(5, 2, 0.05);
+  for (std::size_t idx{ 0 }; idx < updates.size(); ++idx)
+  {
+    accumulator.replace(opinions[3 * idx], updates[idx]);
+    opinions[3 * idx] = updates[idx];
+  }
+  EXPECT_EQ(accumulator.size(), opinions.size());
+  TestFixture::expect_fusion_of(accumulator, opinions);
+
+  // removing sources in a different order than they have been added
+  while (opinions.size() > 1)
+  {
+    auto removed = opinions.begin() + static_cast<std::ptrdiff_t>(opinions.size() / 2);
+    accumulator.remove(*removed);
+    opinions.erase(removed);
+    TestFixture::expect_fusion_of(accumulator, opinions);
+  }
+
+  accumulator.remove(opinions.front());
+  EXPECT_TRUE(accumulator.empty());
+  EXPECT_EQ(accumulator.result(), OpinionT{});
+
+  accumulator.add(opinions.front());
+  accumulator.clear();
+  EXPECT_TRUE(accumulator.empty());
+}
+
+TYPED_TEST(FusionAccumulatorTest, DogmaticSources)
+{
+  using OpinionT = typename TypeParam::first_type;
+  auto opinions = test::random_opinions<OpinionT>(6, 3, 0.05);
+  typename TestFixture::AccumulatorT accumulator{ opinions };
+
+  OpinionT dogmatic_a = opinions[0];
+  dogmatic_a.belief_masses() = typename OpinionT::BeliefType{ 0. };
+  dogmatic_a.belief_masses()[0] = 1.;
+  OpinionT dogmatic_b = opinions[1];
+  dogmatic_b.belief_masses() = typename OpinionT::BeliefType{ 0. };
+  dogmatic_b.belief_masses()[1] = 1.;
+
+  // dogmatic sources dominate all other sources
+  accumulator.add(dogmatic_a);
+  opinions.push_back(dogmatic_a);
+  EXPECT_EQ(accumulator.num_dogmatic(), 1);
+  TestFixture::expect_fusion_of(accumulator, opinions);
+
+  accumulator.add(dogmatic_b);
+  opinions.push_back(dogmatic_b);
+  TestFixture::expect_fusion_of(accumulator, opinions);
+
+  // the result falls back to the non dogmatic sources once the dogmatic ones are removed
+  accumulator.remove(dogmatic_a);
+  accumulator.remove(dogmatic_b);
+  opinions.resize(opinions.size() - 2);
+  EXPECT_EQ(accumulator.num_dogmatic(), 0);
+  TestFixture::expect_fusion_of(accumulator, opinions);
+}
+
+TYPED_TEST(FusionAccumulatorTest, VacuousSources)
+{
+  using OpinionT = typename TypeParam::first_type;
+  std::vector<OpinionT> opinions(3);
+  typename TestFixture::AccumulatorT accumulator{ opinions };
+  TestFixture::expect_fusion_of(accumulator, opinions);
+  EXPECT_NEAR(accumulator.result().uncertainty(), 1., TestFixture::TOLERANCE);
+
+  auto informative = test::random_opinions<OpinionT>(1, 4, 0.05).front();
+  accumulator.add(informative);
+  opinions.push_back(informative);
+  TestFixture::expect_fusion_of(accumulator, opinions);
+}
+
+TEST(FusionAccumulatorTest, JosangExample)
+{
+  OpinionNoBase op_c1(0.1, 0.3);
+  OpinionNoBase op_c2(0.4, 0.2);
+  OpinionNoBase op_c3(0.7, 0.1);
+  using OpinionT = decltype(op_c1);
+
+  FusionAccumulator<OpinionT, Fusion::FusionType::CUMULATIVE> cumulative{ { op_c1, op_c2, op_c3 } };
+  EXPECT_FLOAT_EQ(cumulative.result().belief(), 0.6511628);
+  EXPECT_FLOAT_EQ(cumulative.result().disbelief(), 0.20930232);
+
+  FusionAccumulator<OpinionT, Fusion::FusionType::AVERAGE> average{ { op_c1, op_c2, op_c3 } };
+  EXPECT_FLOAT_EQ(average.result().belief(), 0.5090909);
+  EXPECT_FLOAT_EQ(average.result().disbelief(), 0.16363636);
+
+  // removing the third source equals fusing the first two only
+  average.remove(op_c3);
+  EXPECT_FLOAT_EQ(average.result().belief(), Fusion::fuse_opinions(Fusion::FusionType::AVERAGE, op_c1, op_c2).belief());
+}
+
+}  // namespace subjective_logic::multisource
@@ -1,5 +1,8 @@
 #include <iostream>
 #include <algorithm>
+#include <array>
+#include <random>
+#include <span>
 
 #include "gtest/gtest.h"
 
@@ -46,6 +49,133 @@ TEST(MultiSourceNoBaseFusionTest, JosangExampleAvgFuse)
   EXPECT_FLOAT_EQ(result.disbelief(), 0.16363636);
 }
 
+TEST(MultiSourceNoBaseFusionTest, JosangExampleWeightedFuse)
+{
+  OpinionNoBase op_c1(0.1, 0.3);
+  OpinionNoBase op_c2(0.4, 0.2);
+  OpinionNoBase op_c3(0.7, 0.1);
+
+  // values of [2] (rounded to three digits within the paper)
+  auto result = Fusion::fuse_opinions(Fusion::FusionType::WEIGHTED, op_c1, op_c2, op_c3);
+  EXPECT_NEAR(result.belief(), 0.562, 5e-4);
+  EXPECT_NEAR(result.disbelief(), 0.146, 5e-4);
+  EXPECT_NEAR(result.uncertainty(), 0.292, 5e-4);
+
+  result = Fusion::fuse_opinions(Fusion::FusionType::WEIGHTED, op_c3, op_c1, op_c2);
+  EXPECT_NEAR(result.belief(), 0.562, 5e-4);
+  EXPECT_NEAR(result.disbelief(), 0.146, 5e-4);
+}
+
+TEST(MultiSourceNoBaseFusionTest, JosangExampleCompileTime)
+{
+  // the fusion operator is chosen at compile time, thus, the whole fusion can be evaluated at compile time
+  constexpr OpinionNoBase op_c1(0.1, 0.3);
+  constexpr OpinionNoBase op_c2(0.4, 0.2);
+  constexpr OpinionNoBase op_c3(0.7, 0.1);
+
+  constexpr auto cumulative = Fusion::fuse<Fusion::FusionType::CUMULATIVE>(op_c1, op_c2, op_c3);
+  static_assert(cumulative.belief() > 0.65116 and cumulative.belief() < 0.65117);
+  constexpr auto average = Fusion::fuse<Fusion::FusionType::AVERAGE>(op_c1, op_c2, op_c3);
+  static_assert(average.belief() > 0.50909 and average.belief() < 0.50910);
+  constexpr auto weighted = Fusion::fuse<Fusion::FusionType::WEIGHTED>(op_c1, op_c2, op_c3);
+  static_assert(weighted.uncertainty() > 0.2915 and weighted.uncertainty() < 0.2925);
+
+  static constexpr std::array opinions{ op_c1, op_c2, op_c3 };
+  constexpr auto belief_constraint =
+      Fusion::fuse<Fusion::FusionType::BELIEF_CONSTRAINT>(std::span<const decltype(op_c1)>{ opinions });
+
+  // equal to the runtime dispatch
+  EXPECT_EQ(cumulative, Fusion::fuse_opinions(Fusion::FusionType::CUMULATIVE, op_c1, op_c2, op_c3));
+  EXPECT_EQ(average, Fusion::fuse_opinions(Fusion::FusionType::AVERAGE, op_c1, op_c2, op_c3));
+  EXPECT_EQ(weighted, Fusion::fuse_opinions(Fusion::FusionType::WEIGHTED, op_c1, op_c2, op_c3));
+  EXPECT_EQ(belief_constraint, Fusion::fuse_opinions(Fusion::FusionType::BELIEF_CONSTRAINT, op_c1, op_c2, op_c3));
+}
+
+TEST(MultiSourceFusionTest, FixedArityEqualsSpan)
+{
+  using OpinionT = Opinion<3, double>;
+  using BeliefT = OpinionT::BeliefType;
+
+  // the unrolled fusion of an Array equals the loops over a span, including dogmatic opinions
+  const Array<4, OpinionT> opinions{ OpinionT{ BeliefT{ 0.1, 0.3, 0.2 }, BeliefT{ 0.2, 0.5, 0.3 } },
+                                     OpinionT{ BeliefT{ 0.4, 0.2, 0.1 }, BeliefT{ 0.6, 0.2, 0.2 } },
+                                     OpinionT{ BeliefT{ 0.0, 0.0, 0.0 }, BeliefT{ 0.1, 0.1, 0.8 } },
+                                     OpinionT{ BeliefT{ 0.3, 0.1, 0.5 }, BeliefT{ 0.3, 0.3, 0.4 } } };
+  const std::span<const OpinionT> opinion_span{ &opinions[0], opinions.size() };
+  const Array<2, OpinionT> dogmatic{ opinions[0], OpinionT{ BeliefT{ 0.5, 0.2, 0.3 }, BeliefT{ 0.2, 0.2, 0.6 } } };
+
+  for (auto fusion_type : { Fusion::FusionType::CUMULATIVE,
+                            Fusion::FusionType::BELIEF_CONSTRAINT,
+                            Fusion::FusionType::AVERAGE,
+                            Fusion::FusionType::WEIGHTED })
+  {
+    EXPECT_EQ(Fusion::fuse_opinions(fusion_type, opinions), Fusion::fuse_opinions(fusion_type, opinion_span));
+    EXPECT_EQ(Fusion::fuse_opinions(fusion_type, dogmatic),
+              Fusion::fuse_opinions(fusion_type, std::span<const OpinionT>{ &dogmatic[0], 2 }));
+  }
+  EXPECT_EQ(Fusion::fuse<Fusion::FusionType::WEIGHTED>(opinions),
+            Fusion::fuse_opinions(Fusion::FusionType::WEIGHTED, opinion_span));
+
+  // a single opinion is returned as is
+  EXPECT_EQ(Fusion::fuse_opinions(Fusion::FusionType::CUMULATIVE, Array<1, OpinionT>{ opinions[1] }), opinions[1]);
+
+  static constexpr Array<3, OpinionNoBase<2, double>> no_base{ OpinionNoBase<2, double>{ 0.1, 0.3 },
+                                                               OpinionNoBase<2, double>{ 0.4, 0.2 },
+                                                               OpinionNoBase<2, double>{ 0.7, 0.1 } };
+  constexpr auto cumulative = Fusion::fuse<Fusion::FusionType::CUMULATIVE>(no_base);
+  static_assert(cumulative.belief() > 0.65116 and cumulative.belief() < 0.65117);
+}
+
+TEST(MultiSourceFusionTest, WeightedFusePrior)
+{
+  Opinion<2, double> op_c1{ 0.1, 0.3, 0.2 };
+  Opinion<2, double> op_c2{ 0.4, 0.2, 0.6 };
+
+  // two sources equal the pairwise weighted belief fusion, including the prior
+  auto result = Fusion::fuse_opinions(Fusion::FusionType::WEIGHTED, op_c1, op_c2);
+  auto expected_result = op_c1.wb_fuse(op_c2);
+  EXPECT_NEAR(result.belief(), expected_result.belief(), 1e-12);
+  EXPECT_NEAR(result.disbelief(), expected_result.disbelief(), 1e-12);
+  EXPECT_NEAR(result.getBinomialPrior(), expected_result.getBinomialPrior(), 1e-12);
+
+  // vacuous sources only, the priors are averaged
+  Opinion<2, double> vacuous_1{ 0., 0., 0.2 };
+  Opinion<2, double> vacuous_2{ 0., 0., 0.6 };
+  result = Fusion::fuse_opinions(Fusion::FusionType::WEIGHTED, vacuous_1, vacuous_2);
+  EXPECT_NEAR(result.uncertainty(), 1., 1e-12);
+  EXPECT_NEAR(result.getBinomialPrior(), 0.4, 1e-12);
+}
+
+TEST(MultiSourceFusionTest, DogmaticFusePrior)
+{
+  using OpinionT = Opinion<3, double>;
+  using BeliefT = OpinionT::BeliefType;
+
+  // the belief masses are the mean of the dogmatic opinions, which keeps the default prior, only the weighted fusion
+  // weights the priors of all opinions by their confidence
+  const std::array opinions{ OpinionT{ BeliefT{ 0.5, 0.2, 0.3 }, BeliefT{ 0.2, 0.3, 0.5 } },
+                             OpinionT{ BeliefT{ 0.1, 0.6, 0.3 }, BeliefT{ 0.6, 0.2, 0.2 } },
+                             OpinionT{ BeliefT{ 0.2, 0.2, 0.1 }, BeliefT{ 0.1, 0.1, 0.8 } } };
+  const BeliefT expected_belief{ 0.3, 0.4, 0.3 };
+  const BeliefT default_prior = OpinionT{}.prior_belief_masses();
+  // weighted by the certainties 1, 1 and 0.5
+  const BeliefT weighted_prior{ 0.34, 0.22, 0.44 };
+
+  for (auto fusion_type : { Fusion::FusionType::CUMULATIVE,
+                            Fusion::FusionType::BELIEF_CONSTRAINT,
+                            Fusion::FusionType::AVERAGE,
+                            Fusion::FusionType::WEIGHTED })
+  {
+    auto result = Fusion::fuse_opinions(fusion_type, std::span<const OpinionT>{ opinions });
+    const BeliefT& expected_prior = fusion_type == Fusion::FusionType::WEIGHTED ? weighted_prior : default_prior;
+    for (std::size_t idx{ 0 }; idx < OpinionT::SIZE; ++idx)
+    {
+      EXPECT_NEAR(result.belief_masses()[idx], expected_belief[idx], 1e-12);
+      EXPECT_NEAR(result.prior_belief_masses()[idx], expected_prior[idx], 1e-12);
+    }
+  }
+}
+
 using TestTypes = ::testing::Types<OpinionNoBase<2, float>,
                                    OpinionNoBase<3, float>,
                                    OpinionNoBase<6, float>,
@@ -300,4 +430,341 @@ TYPED_TEST(MultiSourceNoBaseFusionTest, AvgFuseVariables)
   }
 }
 
+TYPED_TEST(MultiSourceNoBaseFusionTest, CumFuseManySources)
+{
+  using FloatT = typename TypeParam::FLOAT_t;
+  constexpr std::size_t num_sources{ 10000 };
+
+  // the product of all uncertainties (0.9^5000 * 0.8^5000) underflows even for double precision
+  TypeParam var1{};
+  var1.belief_masses().front() = .1;
+  TypeParam var2{};
+  var2.belief_masses().back() = .2;
+  std::vector<TypeParam> opinions;
+  for (std::size_t idx{ 0 }; idx < num_sources / 2; ++idx)
+  {
+    opinions.push_back(var1);
+    opinions.push_back(var2);
+  }
+
+  // the fused opinion sums up the evidences of all sources
+  const double evidence_1 = num_sources / 2 * (.1 / .9);
+  const double evidence_2 = num_sources / 2 * (.2 / .8);
+  const double denom = 1. + evidence_1 + evidence_2;
+
+  auto result = Fusion::fuse_opinions(Fusion::FusionType::CUMULATIVE, opinions);
+  EXPECT_GT(result.uncertainty(), FloatT{ 0. });
+  EXPECT_NEAR(result.uncertainty(), 1. / denom, 1e-3 / denom);
+  EXPECT_NEAR(result.belief_masses().front(), evidence_1 / denom, 1e-4);
+  EXPECT_NEAR(result.belief_masses().back(), evidence_2 / denom, 1e-4);
+}
+
+TYPED_TEST(MultiSourceNoBaseFusionTest, AvgFuseManySources)
+{
+  constexpr std::size_t num_sources{ 10000 };
+
+  TypeParam var1{};
+  var1.belief_masses().front() = .1;
+  TypeParam var2{};
+  var2.belief_masses().back() = .2;
+  std::vector<TypeParam> opinions;
+  for (std::size_t idx{ 0 }; idx < num_sources / 2; ++idx)
+  {
+    opinions.push_back(var1);
+    opinions.push_back(var2);
+  }
+
+  // averaging the two groups equals averaging the two opinions
+  auto result = Fusion::fuse_opinions(Fusion::FusionType::AVERAGE, opinions);
+  auto expected_result = var1.average_fuse(var2);
+  EXPECT_NEAR(result.uncertainty(), expected_result.uncertainty(), 1e-4);
+  for (std::size_t idx{ 0 }; idx < TypeParam::SIZE; ++idx)
+  {
+    EXPECT_NEAR(result.belief_masses()[idx], expected_result.belief_masses()[idx], 1e-4);
+  }
+}
+
+TYPED_TEST(MultiSourceNoBaseFusionTest, WbFuseTwoVariables)
+{
+  TypeParam var1{};
+  TypeParam var2{};
+
+  var1.belief_masses().front() = 0.2;
+  var2.belief_masses().back() = 0.5;
+  auto result = Fusion::fuse_opinions(Fusion::FusionType::WEIGHTED, var1, var2);
+  auto expected_result = var1.wb_fuse(var2);
+
+  EXPECT_FLOAT_EQ(result.uncertainty(), expected_result.uncertainty());
+  for (std::size_t idx{ 0 }; idx < TypeParam::SIZE; ++idx)
+  {
+    EXPECT_FLOAT_EQ(expected_result.belief_masses()[idx], result.belief_masses()[idx]);
+  }
+}
+
+TYPED_TEST(MultiSourceNoBaseFusionTest, WbFuseVariablesVacuous)
+{
+  TypeParam var1{};
+  TypeParam var2{};
+  TypeParam var3{};
+  TypeParam var4{};
+  var4.belief_masses().front() = 0.3;
+
+  auto result = Fusion::fuse_opinions(Fusion::FusionType::WEIGHTED, var1, var2, var3);
+  EXPECT_FLOAT_EQ(result.uncertainty(), 1.);
+
+  // vacuous opinions have no weight at all
+  result = Fusion::fuse_opinions(Fusion::FusionType::WEIGHTED, var1, var2, var3, var4);
+  EXPECT_FLOAT_EQ(result.uncertainty(), var4.uncertainty());
+  for (std::size_t idx{ 0 }; idx < TypeParam::SIZE; ++idx)
+  {
+    EXPECT_FLOAT_EQ(var4.belief_masses()[idx], result.belief_masses()[idx]);
+  }
+}
+
+TYPED_TEST(MultiSourceNoBaseFusionTest, WbFuseVariablesDogmatic)
+{
+  TypeParam var1{};
+  var1.belief_masses().front() = 1.;
+  TypeParam var2{};
+  var2.belief_masses().front() = .3;
+  TypeParam var3{};
+  var3.belief_masses().back() = 1.;
+
+  auto result = Fusion::fuse_opinions(Fusion::FusionType::WEIGHTED, var1, var2, var3);
+  TypeParam expected_result{};
+  expected_result.belief_masses().front() = 0.5;
+  expected_result.belief_masses().back() = 0.5;
+
+  EXPECT_FLOAT_EQ(result.uncertainty(), expected_result.uncertainty());
+  for (std::size_t idx{ 0 }; idx < TypeParam::SIZE; ++idx)
+  {
+    EXPECT_FLOAT_EQ(expected_result.belief_masses()[idx], result.belief_masses()[idx]);
+  }
+}
+
+TYPED_TEST(MultiSourceNoBaseFusionTest, WbFuseVariables)
+{
+  TypeParam var1{};
+  var1.belief_masses().front() = .2;
+  TypeParam var2{};
+  var2.belief_masses().front() = .5;
+  TypeParam var3{};
+  var3.belief_masses().back() = .1;
+  TypeParam var4{};
+  var4.belief_masses().back() = .3;
+
+  std::vector<TypeParam> opinions = { var1, var2, var3, var4 };
+  std::vector<TypeParam> results;
+
+  auto comperator = [](TypeParam tp1, TypeParam tp2) { return tp1.belief_masses()[0] < tp2.belief_masses()[0]; };
+  do
+  {
+    results.push_back(Fusion::fuse_opinions(Fusion::FusionType::WEIGHTED, opinions));
+  } while (std::ranges::next_permutation(opinions, comperator).found);
+
+  for (std::size_t idx{ 1 }; idx < results.size(); ++idx)
+  {
+    EXPECT_FLOAT_EQ(results[0].uncertainty(), results[idx].uncertainty());
+    for (std::size_t mass_idx{ 0 }; mass_idx < TypeParam::SIZE; ++mass_idx)
+    {
+      EXPECT_FLOAT_EQ(results[0].belief_masses()[mass_idx], results[idx].belief_masses()[mass_idx]);
+    }
+  }
+}
+
+TYPED_TEST(MultiSourceNoBaseFusionTest, WbFuseManySources)
+{
+  constexpr std::size_t num_sources{ 10000 };
+
+  TypeParam var1{};
+  var1.belief_masses().front() = .1;
+  TypeParam var2{};
+  var2.belief_masses().back() = .2;
+  std::vector<TypeParam> opinions;
+  for (std::size_t idx{ 0 }; idx < num_sources / 2; ++idx)
+  {
+    opinions.push_back(var1);
+    opinions.push_back(var2);
+  }
+
+  // both groups are weighted by their confidence ratio, i.e., the result equals the pairwise fusion
+  auto result = Fusion::fuse_opinions(Fusion::FusionType::WEIGHTED, opinions);
+  auto expected_result = var1.wb_fuse(var2);
+  EXPECT_NEAR(result.uncertainty(), expected_result.uncertainty(), 1e-4);
+  for (std::size_t idx{ 0 }; idx < TypeParam::SIZE; ++idx)
+  {
+    EXPECT_NEAR(result.belief_masses()[idx], expected_result.belief_masses()[idx], 1e-4);
+  }
+}
+
+TYPED_TEST(MultiSourceNoBaseFusionTest, CcFuseTwoVariables)
+{
+  TypeParam var1{};
+  TypeParam var2{};
+
+  var1.belief_masses().front() = 0.2;
+  var1.belief_masses().back() = 0.1;
+  var2.belief_masses().back() = 0.5;
+  auto result = Fusion::fuse_opinions(Fusion::FusionType::CONSENSUS_COMPROMISE, var1, var2);
+  auto expected_result = var1.cc_fuse(var2);
+
+  EXPECT_FLOAT_EQ(result.uncertainty(), expected_result.uncertainty());
+  for (std::size_t idx{ 0 }; idx < TypeParam::SIZE; ++idx)
+  {
+    EXPECT_FLOAT_EQ(expected_result.belief_masses()[idx], result.belief_masses()[idx]);
+  }
+
+  // contradicting dogmatic opinions result in a compromise
+  var1 = TypeParam{};
+  var1.belief_masses().front() = 1.;
+  var2 = TypeParam{};
+  var2.belief_masses().back() = 1.;
+  result = Fusion::fuse_opinions(Fusion::FusionType::CONSENSUS_COMPROMISE, var1, var2);
+  expected_result = var1.cc_fuse(var2);
+  EXPECT_NEAR(result.uncertainty(), 0., 1e-6);
+  for (std::size_t idx{ 0 }; idx < TypeParam::SIZE; ++idx)
+  {
+    EXPECT_FLOAT_EQ(expected_result.belief_masses()[idx], result.belief_masses()[idx]);
+  }
+}
+
+TYPED_TEST(MultiSourceNoBaseFusionTest, CcFuseVariablesVacuous)
+{
+  TypeParam var1{};
+  TypeParam var2{};
+  TypeParam var3{};
+
+  auto result = Fusion::fuse_opinions(Fusion::FusionType::CONSENSUS_COMPROMISE, var1, var2, var3);
+  EXPECT_FLOAT_EQ(result.uncertainty(), 1.);
+
+  // equal opinions agree on everything, i.e., there is nothing to compromise
+  var1.belief_masses().front() = 0.4;
+  result = Fusion::fuse_opinions(Fusion::FusionType::CONSENSUS_COMPROMISE, var1, var1, var1);
+  EXPECT_FLOAT_EQ(result.uncertainty(), var1.uncertainty());
+  EXPECT_FLOAT_EQ(result.belief_masses().front(), 0.4);
+}
+
+TYPED_TEST(MultiSourceNoBaseFusionTest, CcFuseVariables)
+{
+  TypeParam var1{};
+  var1.belief_masses().front() = .2;
+  var1.belief_masses().back() = .1;
+  TypeParam var2{};
+  var2.belief_masses().front() = .5;
+  TypeParam var3{};
+  var3.belief_masses().front() = .05;
+  var3.belief_masses().back() = .3;
+  TypeParam var4{};
+  var4.belief_masses().front() = .1;
+  var4.belief_masses().back() = .6;
+
+  std::vector<TypeParam> opinions = { var1, var2, var3, var4 };
+  std::vector<TypeParam> results;
+
+  // in contrast to chaining the pairwise operator, the result does not depend on the order of the opinions
+  auto comperator = [](TypeParam tp1, TypeParam tp2) { return tp1.belief_masses()[0] < tp2.belief_masses()[0]; };
+  std::ranges::sort(opinions, comperator);
+  do
+  {
+    results.push_back(Fusion::fuse_opinions(Fusion::FusionType::CONSENSUS_COMPROMISE, opinions));
+  } while (std::ranges::next_permutation(opinions, comperator).found);
+  ASSERT_EQ(results.size(), 24);
+
+  for (std::size_t idx{ 0 }; idx < results.size(); ++idx)
+  {
+    // the uncertainty is the product of all uncertainties
+    EXPECT_NEAR(results[idx].uncertainty(),
+                var1.uncertainty() * var2.uncertainty() * var3.uncertainty() * var4.uncertainty(),
+                1e-6);
+    for (std::size_t mass_idx{ 0 }; mass_idx < TypeParam::SIZE; ++mass_idx)
+    {
+      EXPECT_NEAR(results[0].belief_masses()[mass_idx], results[idx].belief_masses()[mass_idx], 1e-6);
+    }
+  }
+}
+
+TYPED_TEST(MultiSourceNoBaseFusionTest, CcFuseManySources)
+{
+  constexpr std::size_t num_sources{ 60 };
+
+  // the products over all sources vanish with the number of sources, yet there is a compromise to be made
+  TypeParam var1{};
+  var1.belief_masses().front() = .3;
+  var1.belief_masses().back() = .2;
+  TypeParam var2{};
+  var2.belief_masses().front() = .2;
+  var2.belief_masses().back() = .3;
+  std::vector<TypeParam> opinions;
+  for (std::size_t idx{ 0 }; idx < num_sources / 2; ++idx)
+  {
+    opinions.push_back(var1);
+    opinions.push_back(var2);
+  }
+
+  // the consensus of 0.2 is kept and the remaining mass is compromised equally, as the sources are symmetric
+  auto result = Fusion::fuse_opinions(Fusion::FusionType::CONSENSUS_COMPROMISE, opinions);
+  EXPECT_NEAR(result.uncertainty(), 0., 1e-6);
+  EXPECT_NEAR(result.belief_masses().front(), .5, 1e-5);
+  EXPECT_NEAR(result.belief_masses().back(), .5, 1e-5);
+}
+
+TEST(MultiSourceFusionTest, FloatFusionWithWidenedAccumulation)
+{
+  constexpr std::size_t num_sources{ 100000 };
+  std::mt19937 gen{ 0 };
+  std::uniform_real_distribution<float> dist{ 0.05, 1. };
+
+  // float opinions are fused with double sums, i.e., they equal the fusion of the same opinions in double
+  std::vector<Opinion<3, float>> opinions;
+  std::vector<Opinion<3, double>> opinions_double;
+  for (std::size_t idx{ 0 }; idx < num_sources; ++idx)
+  {
+    Opinion<3, float> opinion;
+    float belief_sum{ 0. };
+    float prior_sum{ 0. };
+    for (std::size_t mass_idx{ 0 }; mass_idx < 3; ++mass_idx)
+    {
+      opinion.belief_masses()[mass_idx] = dist(gen);
+      opinion.prior_belief_masses()[mass_idx] = dist(gen);
+      belief_sum += opinion.belief_masses()[mass_idx];
+      prior_sum += opinion.prior_belief_masses()[mass_idx];
+    }
+    opinion.belief_masses() *= 0.9F / belief_sum;
+    opinion.prior_belief_masses() /= prior_sum;
+    opinions.push_back(opinion);
+
+    Opinion<3, double>& opinion_double = opinions_double.emplace_back();
+    for (std::size_t mass_idx{ 0 }; mass_idx < 3; ++mass_idx)
+    {
+      opinion_double.belief_masses()[mass_idx] = opinion.belief_masses()[mass_idx];
+      opinion_double.prior_belief_masses()[mass_idx] = opinion.prior_belief_masses()[mass_idx];
+    }
+  }
+
+  for (auto fusion_type : { Fusion::FusionType::CUMULATIVE, Fusion::FusionType::AVERAGE, Fusion::FusionType::WEIGHTED })
+  {
+    auto result = Fusion::fuse_opinions(fusion_type, opinions);
+    auto expected = Fusion::fuse_opinions(fusion_type, opinions_double);
+    for (std::size_t mass_idx{ 0 }; mass_idx < 3; ++mass_idx)
+    {
+      EXPECT_NEAR(result.belief_masses()[mass_idx], expected.belief_masses()[mass_idx], 1e-6);
+      EXPECT_NEAR(result.prior_belief_masses()[mass_idx], expected.prior_belief_masses()[mass_idx], 1e-6);
+    }
+  }
+}
+
+TEST(MultiSourceFusionTest, CcFusePrior)
+{
+  // the fusion operator can be evaluated at compile time, as well
+  constexpr auto result = Fusion::fuse<Fusion::FusionType::CONSENSUS_COMPROMISE>(
+      Opinion<2, double>{ 0.1, 0.3, 0.2 }, Opinion<2, double>{ 0.4, 0.2, 0.6 }, Opinion<2, double>{ 0.5, 0.1, 0.4 });
+  static_assert(result.uncertainty() > 0.6 * 0.4 * 0.4 - 1e-12 and result.uncertainty() < 0.6 * 0.4 * 0.4 + 1e-12);
+
+  EXPECT_NEAR(result.getBinomialPrior(), 0.4, 1e-12);
+  EXPECT_NEAR(result.belief() + result.disbelief() + result.uncertainty(), 1., 1e-12);
+  // the consensus is kept
+  EXPECT_GT(result.belief(), 0.1);
+  EXPECT_GT(result.disbelief(), 0.1);
+}
+
 }  // namespace subjective_logic::multisource
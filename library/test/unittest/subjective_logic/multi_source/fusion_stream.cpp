@@ -0,0 +1,211 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "subjective_logic_lib/multi_source/fusion_operators.hpp"
+#include "subjective_logic_lib/multi_source/fusion_stream.hpp"
+
+#include "test_helpers.hpp"
+
+namespace subjective_logic::multisource
+{
+
+template <typename OpinionT>
+class FusionStreamTest : public ::testing::Test
+{
+public:
+  static constexpr std::size_t N = OpinionT::SIZE;
+  static constexpr double TOLERANCE = std::is_same_v<typename OpinionT::FLOAT_t, float> ? 1e-4 : 1e-9;
+
+  /**
+   * @brief random opinions with an uncertainty of at least 0.3, such that the fused opinions stay far from dogmatic
+   */
+  static OpinionT random_opinion(std::mt19937& gen)
+  {
+    OpinionT opinion = test::random_opinion<OpinionT>(gen, 0.05);
+    opinion.belief_masses() *= static_cast<typename OpinionT::FLOAT_t>(0.7);
+    return opinion;
+  }
+
+  static void expect_near(const OpinionT& actual, const OpinionT& expected)
+  {
+    test::expect_near(actual, expected, TOLERANCE);
+  }
+};
+
+using TestTypes = ::testing::Types<OpinionNoBase<2, float>,
+                                   OpinionNoBase<4, double>,
+                                   Opinion<2, double>,
+                                   Opinion<3, float>,
+                                   Opinion<5, double> >;
+TYPED_TEST_SUITE(FusionStreamTest, TestTypes);
+
+TYPED_TEST(FusionStreamTest, WindowEqualsFusionOfWindow)
+{
+  constexpr std::size_t WINDOW_SIZE{ 4 };
+  std::mt19937 gen{ 0 };
+  std::uniform_int_distribution<std::size_t> num_dist{ 0, 3 };
+
+  WindowedFusionStream<TypeParam> stream{ WINDOW_SIZE };
+  EXPECT_EQ(stream.result(), TypeParam{});
+
+  // observations of each time step, the last WINDOW_SIZE entries form the window
+  std::vector<std::vector<TypeParam>> history;
+  for (std::size_t step{ 0 }; step < 100; ++step)
+  {
+    history.emplace_back();
+    for (std::size_t idx{ 0 }, num = num_dist(gen); idx < num; ++idx)
+    {
+      history.back().push_back(TestFixture::random_opinion(gen));
+      stream.push(history.back().back());
+    }
+
+    std::vector<TypeParam> window;
+    std::size_t first_step = history.size() > WINDOW_SIZE ? history.size() - WINDOW_SIZE : 0;
+    for (std::size_t idx{ first_step }; idx < history.size(); ++idx)
+    {
+      window.insert(window.end(), history[idx].begin(), history[idx].end());
+    }
+    ASSERT_EQ(stream.size(), window.size());
+    if (window.empty())
+    {
+      EXPECT_EQ(stream.result(), TypeParam{});
+    }
+    else
+    {
+      TestFixture::expect_near(stream.result(), Fusion::fuse_opinions(Fusion::FusionType::CUMULATIVE, window));
+    }
+    stream.advance();
+  }
+  EXPECT_EQ(stream.time_step(), 100);
+}
+
+TYPED_TEST(FusionStreamTest, WindowSkipsTimeSteps)
+{
+  std::mt19937 gen{ 1 };
+  WindowedFusionStream<TypeParam> stream{ 5 };
+
+  std::vector<TypeParam> opinions;
+  for (std::size_t idx{ 0 }; idx < 3; ++idx)
+  {
+    opinions.push_back(TestFixture::random_opinion(gen));
+    stream.push(opinions.back());
+    stream.advance(2);
+  }
+
+  // the first observation has been made 6 steps ago, the second one 4 steps ago
+  EXPECT_EQ(stream.size(), 2);
+  auto expected = Fusion::fuse_opinions(Fusion::FusionType::CUMULATIVE, opinions[1], opinions[2]);
+  TestFixture::expect_near(stream.result(), expected);
+
+  stream.advance(5);
+  EXPECT_EQ(stream.size(), 0);
+  EXPECT_EQ(stream.result(), TypeParam{});
+  EXPECT_EQ(stream.time_step(), 11);
+}
+
+TYPED_TEST(FusionStreamTest, WindowWithDogmaticObservation)
+{
+  std::mt19937 gen{ 2 };
+  WindowedFusionStream<TypeParam> stream{ 2 };
+
+  TypeParam dogmatic = TestFixture::random_opinion(gen);
+  dogmatic.belief_masses() /= dogmatic.belief_masses().sum();
+  stream.push(dogmatic);
+  stream.advance();
+
+  // the dogmatic observation dominates as long as it is part of the window
+  TypeParam opinion = TestFixture::random_opinion(gen);
+  stream.push(opinion);
+  EXPECT_NEAR(stream.result().uncertainty(), 0., TestFixture::TOLERANCE);
+
+  stream.advance();
+  TestFixture::expect_near(stream.result(), opinion);
+}
+
+TYPED_TEST(FusionStreamTest, DecayEqualsScaledEvidence)
+{
+  using FloatT = typename TypeParam::FLOAT_t;
+  constexpr FloatT DECAY{ 0.8 };
+  std::mt19937 gen{ 3 };
+
+  DecayedFusionStream<TypeParam> stream{ DECAY };
+  EXPECT_EQ(stream.result(), TypeParam{});
+
+  // the evidence of each observation is decayed according to its age and fused afterwards
+  std::vector<TypeParam> opinions;
+  std::vector<std::size_t> time_steps;
+  std::uniform_int_distribution<std::size_t> step_dist{ 0, 3 };
+  for (std::size_t idx{ 0 }; idx < 30; ++idx)
+  {
+    opinions.push_back(TestFixture::random_opinion(gen));
+    time_steps.push_back(stream.time_step());
+    stream.push(opinions.back());
+    stream.advance(step_dist(gen));
+
+    std::vector<TypeParam> decayed;
+    double prior_weight{ 0. };
+    Array<TestFixture::N, double> prior{ 0. };
+    for (std::size_t opinion_idx{ 0 }; opinion_idx <= idx; ++opinion_idx)
+    {
+      double factor = std::pow(static_cast<double>(DECAY), stream.time_step() - time_steps[opinion_idx]);
+      decayed.push_back(opinions[opinion_idx].scale_evidence(static_cast<FloatT>(factor)));
+      if constexpr (is_opinion<TypeParam>)
+      {
+        for (std::size_t mass_idx{ 0 }; mass_idx < TestFixture::N; ++mass_idx)
+        {
+          prior[mass_idx] += factor * opinions[opinion_idx].prior_belief_masses()[mass_idx];
+        }
+        prior_weight += factor;
+      }
+    }
+
+    auto expected = Fusion::fuse_opinions(Fusion::FusionType::CUMULATIVE, decayed);
+    if constexpr (is_opinion<TypeParam>)
+    {
+      for (std::size_t mass_idx{ 0 }; mass_idx < TestFixture::N; ++mass_idx)
+      {
+        expected.prior_belief_masses()[mass_idx] = static_cast<FloatT>(prior[mass_idx] / prior_weight);
+      }
+    }
+    TestFixture::expect_near(stream.result(), expected);
+  }
+}
+
+TYPED_TEST(FusionStreamTest, DecaySkipsTimeSteps)
+{
+  std::mt19937 gen{ 4 };
+  DecayedFusionStream<TypeParam> single_steps{ 0.9 };
+  DecayedFusionStream<TypeParam> skipped{ 0.9 };
+
+  for (std::size_t idx{ 0 }; idx < 5; ++idx)
+  {
+    auto opinion = TestFixture::random_opinion(gen);
+    single_steps.push(opinion);
+    skipped.push(opinion);
+    for (std::size_t step{ 0 }; step < 7; ++step)
+    {
+      single_steps.advance();
+    }
+    skipped.advance(7);
+    TestFixture::expect_near(skipped.result(), single_steps.result());
+  }
+
+  // without decay, the stream equals the cumulative fusion of all observations
+  DecayedFusionStream<TypeParam> no_decay{ 1. };
+  std::vector<TypeParam> opinions{ TestFixture::random_opinion(gen), TestFixture::random_opinion(gen) };
+  no_decay.push(opinions[0]);
+  no_decay.advance(1000);
+  no_decay.push(opinions[1]);
+  TestFixture::expect_near(no_decay.result(), Fusion::fuse_opinions(Fusion::FusionType::CUMULATIVE, opinions));
+
+  // a decay of 0 forgets everything with the next time step
+  DecayedFusionStream<TypeParam> forget{ 0. };
+  forget.push(opinions[0]);
+  forget.advance();
+  EXPECT_NEAR(forget.result().uncertainty(), 1., TestFixture::TOLERANCE);
+}
+
+}  // namespace subjective_logic::multisource
@@ -63,6 +63,36 @@ TEST(MultiSourceTrustedFusionTest, JosangExampleCumFuse)
 #endif
 }
 
+TEST(MultiSourceTrustedFusionTest, WeightedFuse)
+{
+  Trust<double> a_c1{ 0.3, 0.0, 0.9 };
+  Trust<double> a_c2{ 0.7, 0.0, 0.9 };
+  Trust<double> a_c3{ 0.4, 0.1, 0.9 };
+
+  TrustedOpinion<Opinion<2, double>> a_c1_x{ a_c1, Opinion{ 1.0, 0.0, 0.1 } };
+  TrustedOpinion<Opinion<2, double>> a_c2_x{ a_c2, Opinion{ 0.0, 1.0, 0.1 } };
+  TrustedOpinion<Opinion<2, double>> a_c3_x{ a_c3, Opinion{ 1.0, 0.0, 0.1 } };
+  std::vector<TrustedOpinion<Opinion<2, double>>> t_ops{ a_c1_x, a_c2_x, a_c3_x };
+
+  // without any trust revision, the discounted opinions are fused
+  auto wb_fused_no_revision = TrustedFusion::fuse_opinions(Fusion::FusionType::WEIGHTED, t_ops);
+  auto expected = Fusion::fuse_opinions(Fusion::FusionType::WEIGHTED,
+                                        std::vector{ a_c1_x.discounted_opinion(),
+                                                     a_c2_x.discounted_opinion(),
+                                                     a_c3_x.discounted_opinion() });
+  EXPECT_NEAR(wb_fused_no_revision.belief(), expected.belief(), 1e-12);
+  EXPECT_NEAR(wb_fused_no_revision.disbelief(), expected.disbelief(), 1e-12);
+  EXPECT_NEAR(wb_fused_no_revision.uncertainty(), expected.uncertainty(), 1e-12);
+
+  auto wb_fused_wb_revision = TrustedFusion::fuse_opinions(Fusion::FusionType::WEIGHTED,
+                                                           TrustRevision::TrustRevisionType::REFERENCE_FUSION,
+                                                           Conflict::ConflictType::BELIEF_AVERAGE,
+                                                           t_ops);
+  // same tendency as for the example above, the trust in c1 and c3 is revised
+  EXPECT_LT(wb_fused_wb_revision.belief(), wb_fused_no_revision.belief());
+  EXPECT_GE(wb_fused_wb_revision.uncertainty(), 0.);
+}
+
 using TestTypes = ::testing::Types<TrustedOpinion<OpinionNoBase<2, float>>>;
 
 template <typename OpinionT>
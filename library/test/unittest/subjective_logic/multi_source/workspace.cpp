@@ -0,0 +1,208 @@
+#include <span>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "workspace_fixture.hpp"
+
+namespace subjective_logic::multisource
+{
+
+TYPED_TEST_SUITE(WorkspaceTest, TestTypes);
+
+TYPED_TEST(WorkspaceTest, SpanOverloadsEqualVectorOverloads)
+{
+  using FloatT = typename TypeParam::FLOAT_t;
+  using TrustedOpinionT = TrustedOpinion<TypeParam>;
+  std::span<const TypeParam> sources{ this->opinions };
+  std::span<const TrustedOpinionT> trusted{ this->trusted_opinions };
+  Workspace<TypeParam> workspace;
+
+  for (auto fusion_type : FUSION_TYPES)
+  {
+    EXPECT_EQ(Fusion::fuse_opinions(fusion_type, sources), Fusion::fuse_opinions(fusion_type, this->opinions));
+  }
+
+  for (auto conflict_type : CONFLICT_TYPES)
+  {
+    EXPECT_NEAR(Conflict::conflict(conflict_type, sources),
+                Conflict::conflict(conflict_type, this->opinions),
+                TestFixture::TOLERANCE);
+    EXPECT_NEAR(Conflict::harmony(conflict_type, sources),
+                Conflict::harmony(conflict_type, this->opinions),
+                TestFixture::TOLERANCE);
+
+    auto [conflict, shares] =
+        Conflict::conflict_shares<Conflict::RelationType::CONFLICT>(conflict_type, sources, workspace);
+    auto [expected_conflict, expected_shares] =
+        Conflict::conflict_shares<Conflict::RelationType::CONFLICT>(conflict_type, this->opinions);
+    EXPECT_NEAR(conflict, expected_conflict, TestFixture::TOLERANCE);
+    ASSERT_EQ(shares.size(), expected_shares.size());
+    for (std::size_t idx{ 0 }; idx < shares.size(); ++idx)
+    {
+      EXPECT_NEAR(shares[idx], expected_shares[idx], TestFixture::TOLERANCE);
+    }
+
+    for (auto revision_type : REVISION_TYPES)
+    {
+      if (not is_defined(revision_type, conflict_type))
+      {
+        continue;
+      }
+      std::vector<FloatT> expected_factors =
+          TrustRevision::revision_factors(revision_type, conflict_type, this->trusted_opinions);
+      std::span<const FloatT> factors =
+          TrustRevision::revision_factors(revision_type, conflict_type, trusted, workspace);
+      ASSERT_EQ(factors.size(), expected_factors.size());
+      for (std::size_t idx{ 0 }; idx < factors.size(); ++idx)
+      {
+        EXPECT_NEAR(factors[idx], expected_factors[idx], TestFixture::TOLERANCE);
+      }
+
+      for (auto fusion_type : FUSION_TYPES)
+      {
+        EXPECT_EQ(
+            TrustedFusion::fuse_opinions(fusion_type, revision_type, conflict_type, trusted, workspace),
+            TrustedFusion::fuse_opinions(fusion_type, revision_type, conflict_type, this->trusted_opinions));
+      }
+    }
+  }
+
+  // inplace fusion revises the trusts of the given opinions
+  auto revised_opinions = this->trusted_opinions;
+  auto expected_revised_opinions = this->trusted_opinions;
+  EXPECT_EQ(TrustedFusion::fuse_opinions_(Fusion::FusionType::CUMULATIVE,
+                                          TrustRevision::TrustRevisionType::CONFLICT_SHARES,
+                                          Conflict::ConflictType::BELIEF_AVERAGE,
+                                          std::span<TrustedOpinionT>{ revised_opinions },
+                                          workspace),
+            TrustedFusion::fuse_opinions_(Fusion::FusionType::CUMULATIVE,
+                                          TrustRevision::TrustRevisionType::CONFLICT_SHARES,
+                                          Conflict::ConflictType::BELIEF_AVERAGE,
+                                          expected_revised_opinions));
+  for (std::size_t idx{ 0 }; idx < revised_opinions.size(); ++idx)
+  {
+    EXPECT_EQ(revised_opinions[idx].trust(), expected_revised_opinions[idx].trust());
+  }
+}
+
+TYPED_TEST(WorkspaceTest, SharedEvaluationContext)
+{
+  using FloatT = typename TypeParam::FLOAT_t;
+  using TrustedOpinionT = TrustedOpinion<TypeParam>;
+  std::span<const TrustedOpinionT> trusted{ this->trusted_opinions };
+  Workspace<TypeParam> workspace;
+  auto& context = workspace.context;
+  context.evaluate(trusted);
+
+  ASSERT_EQ(context.size(), TestFixture::NUM_SOURCES);
+  std::vector<TypeParam> discounted_opinions;
+  for (std::size_t idx{ 0 }; idx < TestFixture::NUM_SOURCES; ++idx)
+  {
+    EXPECT_EQ(context.opinions()[idx], this->trusted_opinions[idx].opinion());
+    EXPECT_EQ(context.discounted_opinions()[idx], this->trusted_opinions[idx].discounted_opinion());
+    EXPECT_EQ(context.trust_uncertainties()[idx], this->trusted_opinions[idx].trust().uncertainty());
+    discounted_opinions.push_back(this->trusted_opinions[idx].discounted_opinion());
+  }
+  for (auto fusion_type : FUSION_TYPES)
+  {
+    EXPECT_EQ(context.reference_fusion(fusion_type), Fusion::fuse_opinions(fusion_type, discounted_opinions));
+  }
+
+  // the conflict with a given reference fusion equals the conflict fusing the opinions again
+  std::span<const TypeParam> discounted{ context.discounted_opinions() };
+  for (auto conflict_type : CONFLICT_TYPES)
+  {
+    auto reference_type = Fusion::FusionType::AVERAGE;
+    if (conflict_type != Conflict::ConflictType::ACCUMULATE and conflict_type != Conflict::ConflictType::AVERAGE)
+    {
+      reference_type = Conflict::get_belief_fusion_type(conflict_type);
+    }
+    const TypeParam& reference_fusion = context.reference_fusion(reference_type);
+    EXPECT_NEAR(Conflict::conflict(conflict_type, discounted, reference_fusion),
+                Conflict::conflict(conflict_type, discounted),
+                TestFixture::TOLERANCE);
+    EXPECT_NEAR(Conflict::harmony(conflict_type, discounted, reference_fusion),
+                Conflict::harmony(conflict_type, discounted),
+                TestFixture::TOLERANCE);
+
+    // the revision factors on the evaluated context equal the ones evaluating the trusted opinions
+    for (auto revision_type : REVISION_TYPES)
+    {
+      if (not is_defined(revision_type, conflict_type))
+      {
+        continue;
+      }
+      std::vector<FloatT> expected_factors =
+          TrustRevision::revision_factors(revision_type, conflict_type, this->trusted_opinions);
+      std::span<const FloatT> factors = TrustRevision::revision_factors(revision_type, conflict_type, workspace);
+      ASSERT_EQ(factors.size(), expected_factors.size());
+      for (std::size_t idx{ 0 }; idx < factors.size(); ++idx)
+      {
+        EXPECT_NEAR(factors[idx], expected_factors[idx], TestFixture::TOLERANCE);
+      }
+    }
+  }
+
+  // without trust revision, the trusted fusion is the reference fusion of the context
+  for (auto fusion_type : FUSION_TYPES)
+  {
+    EXPECT_EQ(TrustedFusion::fuse_opinions(
+                  fusion_type, std::span<const TrustedFusion::WeightedTypes>{}, trusted, workspace),
+              Fusion::fuse_opinions(fusion_type, discounted_opinions));
+  }
+}
+
+TYPED_TEST(WorkspaceTest, WeightedRevisionFactorsInOnePass)
+{
+  using FloatT = typename TypeParam::FLOAT_t;
+  using TrustedOpinionT = TrustedOpinion<TypeParam>;
+  using RevisionType = TrustRevision::TrustRevisionType;
+  std::span<const TrustedOpinionT> trusted{ this->trusted_opinions };
+
+  // all defined combinations of revision and conflict types with distinct weights, and the mix of the reference
+  // fusion revisions as used by the experiments of the publication
+  std::vector<TrustRevision::WeightedTypes> all_types;
+  double weight{ 0.1 };
+  for (auto conflict_type : CONFLICT_TYPES)
+  {
+    for (auto revision_type : REVISION_TYPES)
+    {
+      if (is_defined(revision_type, conflict_type))
+      {
+        all_types.emplace_back(revision_type, conflict_type, weight);
+        weight = -weight * 1.1;
+      }
+    }
+  }
+  const std::vector<TrustRevision::WeightedTypes> reference_fusion_types{
+    { RevisionType::REFERENCE_FUSION, Conflict::ConflictType::BELIEF_AVERAGE, 0.2 },
+    { RevisionType::HARMONY_REFERENCE_FUSION, Conflict::ConflictType::BELIEF_AVERAGE, 0.2 }
+  };
+
+  Workspace<TypeParam> workspace;
+  for (const auto& weighted_types : { all_types, reference_fusion_types })
+  {
+    std::vector<double> expected_factors(TestFixture::NUM_SOURCES, 0.);
+    for (auto [revision_type, conflict_type, type_weight] : weighted_types)
+    {
+      std::span<const FloatT> factors =
+          TrustRevision::revision_factors(revision_type, conflict_type, trusted, workspace);
+      for (std::size_t idx{ 0 }; idx < factors.size(); ++idx)
+      {
+        expected_factors[idx] += type_weight * factors[idx];
+      }
+    }
+
+    workspace.context.evaluate(trusted);
+    std::span<const FloatT> factors = TrustRevision::weighted_revision_factors(
+        std::span<const TrustRevision::WeightedTypes>{ weighted_types }, workspace);
+    ASSERT_EQ(factors.size(), expected_factors.size());
+    for (std::size_t idx{ 0 }; idx < factors.size(); ++idx)
+    {
+      EXPECT_NEAR(factors[idx], expected_factors[idx], TestFixture::TOLERANCE);
+    }
+  }
+}
+
+}  // namespace subjective_logic::multisource
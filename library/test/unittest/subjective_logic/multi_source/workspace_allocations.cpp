@@ -0,0 +1,236 @@
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <span>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "workspace_fixture.hpp"
+
+namespace
+{
+// counts all calls of the (replaced) global allocation functions of this test executable
+std::atomic<std::size_t> num_allocations{ 0 };
+
+void* allocate(std::size_t size, std::size_t alignment)
+{
+  ++num_allocations;
+  size = size == 0 ? 1 : size;
+  if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+  {
+    return std::malloc(size);
+  }
+  // the size of aligned_alloc has to be a multiple of the alignment
+  return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+void* allocate_or_throw(std::size_t size, std::size_t alignment)
+{
+  if (void* ptr = allocate(size, alignment))
+  {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void deallocate(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+}  // namespace
+
+// all replaceable allocation functions are replaced, such that the memory of each form is released by the same
+// deallocation function
+void* operator new(std::size_t size)
+{
+  return allocate_or_throw(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](std::size_t size)
+{
+  return allocate_or_throw(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+  return allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+  return allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  return allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+  return allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+  deallocate(ptr);
+}
+
+namespace subjective_logic::multisource
+{
+
+TYPED_TEST_SUITE(WorkspaceTest, TestTypes);
+
+TYPED_TEST(WorkspaceTest, SteadyStateWithoutAllocations)
+{
+  using TrustedOpinionT = TrustedOpinion<TypeParam>;
+  std::span<const TypeParam> sources{ this->opinions };
+  std::span<const TrustedOpinionT> trusted{ this->trusted_opinions };
+  std::vector<TrustedOpinionT> revised_opinions = this->trusted_opinions;
+  const std::array weighted_types{
+    TrustedFusion::WeightedTypes{ TrustRevision::TrustRevisionType::NORMAL, Conflict::ConflictType::AVERAGE, 0.5 },
+    TrustedFusion::WeightedTypes{
+        TrustRevision::TrustRevisionType::REFERENCE_FUSION, Conflict::ConflictType::BELIEF_AVERAGE, 0.5 }
+  };
+
+  Workspace<TypeParam> workspace;
+  workspace.reserve(TestFixture::NUM_SOURCES);
+
+  // the results are accumulated, so that the calls cannot be optimized away
+  double checksum{ 0. };
+  const std::size_t allocations_before = num_allocations;
+  for (auto fusion_type : FUSION_TYPES)
+  {
+    checksum += Fusion::fuse_opinions(fusion_type, sources).uncertainty();
+    checksum += Fusion::fuse_opinions(fusion_type, sources.first(3)).uncertainty();
+  }
+  for (auto conflict_type : CONFLICT_TYPES)
+  {
+    checksum += Conflict::conflict(conflict_type, sources);
+    checksum += Conflict::harmony(conflict_type, sources);
+    checksum += Conflict::conflict_shares<Conflict::RelationType::CONFLICT>(conflict_type, sources, workspace).first;
+    for (auto revision_type : REVISION_TYPES)
+    {
+      if (not is_defined(revision_type, conflict_type))
+      {
+        continue;
+      }
+      checksum += TrustRevision::revision_factors(revision_type, conflict_type, trusted, workspace).front();
+      checksum += TrustedFusion::fuse_opinions(
+                      Fusion::FusionType::CUMULATIVE, revision_type, conflict_type, trusted, workspace)
+                      .uncertainty();
+    }
+  }
+  checksum += TrustedFusion::fuse_opinions(
+                  Fusion::FusionType::AVERAGE, std::span{ weighted_types }, trusted, workspace)
+                  .uncertainty();
+  checksum += TrustedFusion::fuse_opinions_(Fusion::FusionType::WEIGHTED,
+                                            std::span{ weighted_types },
+                                            std::span<TrustedOpinionT>{ revised_opinions },
+                                            workspace)
+                  .uncertainty();
+  const std::size_t allocations_after = num_allocations;
+
+  EXPECT_EQ(allocations_after, allocations_before);
+
+  // the counter does see the allocations of the vector overloads
+  checksum += Fusion::fuse_opinions(Fusion::FusionType::CUMULATIVE, this->opinions).uncertainty();
+  EXPECT_GT(num_allocations.load(), allocations_after);
+  EXPECT_FALSE(std::isnan(checksum));
+}
+
+TYPED_TEST(WorkspaceTest, WorkspaceGrowsOnce)
+{
+  using TrustedOpinionT = TrustedOpinion<TypeParam>;
+  std::span<const TrustedOpinionT> trusted{ this->trusted_opinions };
+  Workspace<TypeParam> workspace;
+
+  // the first call grows the buffers, all later calls of the same or a smaller size reuse them
+  auto fuse = [&](std::size_t num_sources) {
+    return TrustedFusion::fuse_opinions(Fusion::FusionType::AVERAGE,
+                                        TrustRevision::TrustRevisionType::CONFLICT_SHARES,
+                                        Conflict::ConflictType::BELIEF_CUMULATIVE,
+                                        trusted.first(num_sources),
+                                        workspace);
+  };
+  fuse(TestFixture::NUM_SOURCES);
+
+  const std::size_t allocations_before = num_allocations;
+  for (std::size_t num_sources{ 1 }; num_sources <= TestFixture::NUM_SOURCES; ++num_sources)
+  {
+    fuse(num_sources);
+  }
+  const std::size_t allocations_after = num_allocations;
+
+  EXPECT_EQ(allocations_after, allocations_before);
+}
+
+}  // namespace subjective_logic::multisource
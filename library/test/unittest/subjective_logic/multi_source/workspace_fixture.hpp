@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "subjective_logic_lib/multi_source/workspace.hpp"
+#include "subjective_logic_lib/multi_source/fusion_operators.hpp"
+#include "subjective_logic_lib/multi_source/conflict_operators.hpp"
+#include "subjective_logic_lib/multi_source/trust_revision_operators.hpp"
+#include "subjective_logic_lib/multi_source/trusted_fusion_operators.hpp"
+
+#include "test_helpers.hpp"
+
+/**
+ * trusted opinions and operator types shared by the workspace tests and the allocation tests of the workspace, which
+ * are built as separate executable
+ */
+namespace subjective_logic::multisource
+{
+
+constexpr std::array FUSION_TYPES{ Fusion::FusionType::CUMULATIVE,
+                                   Fusion::FusionType::BELIEF_CONSTRAINT,
+                                   Fusion::FusionType::AVERAGE,
+                                   Fusion::FusionType::WEIGHTED };
+
+constexpr std::array CONFLICT_TYPES{ Conflict::ConflictType::ACCUMULATE,
+                                     Conflict::ConflictType::AVERAGE,
+                                     Conflict::ConflictType::BELIEF_CUMULATIVE,
+                                     Conflict::ConflictType::BELIEF_BELIEF_CONSTRAINT,
+                                     Conflict::ConflictType::BELIEF_AVERAGE,
+                                     Conflict::ConflictType::BELIEF_WEIGHTED };
+
+constexpr std::array REVISION_TYPES{ TrustRevision::TrustRevisionType::NORMAL,
+                                     TrustRevision::TrustRevisionType::HARMONY_NORMAL,
+                                     TrustRevision::TrustRevisionType::CONFLICT_SHARES,
+                                     TrustRevision::TrustRevisionType::CONFLICT_SHARES_ALLOW_NEGATIVE,
+                                     TrustRevision::TrustRevisionType::HARMONY_SHARES,
+                                     TrustRevision::TrustRevisionType::HARMONY_SHARES_ALLOW_NEGATIVE,
+                                     TrustRevision::TrustRevisionType::REFERENCE_FUSION,
+                                     TrustRevision::TrustRevisionType::HARMONY_REFERENCE_FUSION };
+
+// the reference fusion revision is only defined for the belief conflict types
+constexpr bool is_defined(TrustRevision::TrustRevisionType revision_type, Conflict::ConflictType conflict_type)
+{
+  bool reference_fusion = revision_type == TrustRevision::TrustRevisionType::REFERENCE_FUSION or
+                          revision_type == TrustRevision::TrustRevisionType::HARMONY_REFERENCE_FUSION;
+  bool belief_conflict =
+      conflict_type != Conflict::ConflictType::ACCUMULATE and conflict_type != Conflict::ConflictType::AVERAGE;
+  return not reference_fusion or belief_conflict;
+}
+
+template <typename OpinionT>
+class WorkspaceTest : public ::testing::Test
+{
+public:
+  static constexpr double TOLERANCE = std::is_same_v<typename OpinionT::FLOAT_t, float> ? 1e-4 : 1e-9;
+  static constexpr std::size_t NUM_SOURCES{ 6 };
+
+  void SetUp() override
+  {
+    using FloatT = typename OpinionT::FLOAT_t;
+    std::mt19937 gen{ 0 };
+    std::uniform_real_distribution<FloatT> dist{ 0.05, 1. };
+    for (std::size_t idx{ 0 }; idx < NUM_SOURCES; ++idx)
+    {
+      opinions.push_back(test::random_opinion<OpinionT>(gen, 0.05));
+
+      typename TrustedOpinion<OpinionT>::TrustT trust{ dist(gen), 0., 0.5 };
+      trust.belief_masses() *= static_cast<FloatT>(0.8);
+      trust.belief_masses()[1] = static_cast<FloatT>(0.1);
+      trusted_opinions.emplace_back(trust, opinions.back());
+    }
+  }
+
+  std::vector<OpinionT> opinions;
+  std::vector<TrustedOpinion<OpinionT>> trusted_opinions;
+};
+
+using TestTypes = ::testing::Types<OpinionNoBase<2, float>, Opinion<2, double>, Opinion<3, float>, Opinion<4, double>>;
+
+}  // namespace subjective_logic::multisource
@@ -261,6 +261,31 @@ TYPED_TEST(BinomialOpinionNoBaseTest, DegreeOfConflict)
   EXPECT_FLOAT_EQ(first.degree_of_conflict(second), expected_doc);
 }
 
+TYPED_TEST(BinomialOpinionNoBaseTest, DegreeOfHarmony)
+{
+  // all priors are set to 0.5 by default
+
+  OpinionT<TypeParam> first{ 0, 0 };
+  OpinionT<TypeParam> second = first;
+  EXPECT_FLOAT_EQ(first.degree_of_harmony(second), 0.F);
+
+  first = OpinionT<TypeParam>{ 1., 0. };
+  second = first;
+  EXPECT_FLOAT_EQ(first.degree_of_harmony(second), 1.F);
+
+  second = OpinionT<TypeParam>{ 0., 1. };
+  EXPECT_FLOAT_EQ(first.degree_of_harmony(second), 0.F);
+
+  // the belief type base rates are the same as the scalar ones
+  first = OpinionT<TypeParam>{ 0.5, 0. };
+  second = OpinionT<TypeParam>{ 0., 0.5 };
+  TypeParam expected_doh = (1 - (0.5 + 0.5) / 2.) * ((1 - 0.5) * (1 - 0.5));
+  EXPECT_FLOAT_EQ(first.degree_of_harmony(second), expected_doh);
+  using BeliefType = typename OpinionT<TypeParam>::BeliefType;
+  EXPECT_FLOAT_EQ(first.degree_of_harmony(second, BeliefType{ 0.2, 0.8 }, BeliefType{ 0.6, 0.4 }),
+                  first.degree_of_harmony(second, 0.2, 0.6));
+}
+
 TYPED_TEST(BinomialOpinionNoBaseTest, UncertaintyDifferential)
 {
   constexpr TypeParam second_belief{ 0.3 };
@@ -211,6 +211,30 @@ TYPED_TEST(MultinomialOpinionNoBaseTest, DegreeOfConflict)
                   expected_doc);
 }
 
+TYPED_TEST(MultinomialOpinionNoBaseTest, DegreeOfConflictBaseRates)
+{
+  using Float = typename TypeParam::FLOAT_t;
+
+  // equal opinions differ only by their base rates, i.e., the other opinion has to be projected with its own base rate
+  TypeParam first{};
+  first.belief_masses()[0] = 0.5;
+  TypeParam second = first;
+  typename TypeParam::BeliefType base_rate{ 0. };
+  base_rate[0] = 1.;
+  typename TypeParam::BeliefType base_rate_other{ 0. };
+  base_rate_other[1] = 1.;
+
+  // projections (1, 0, ...) and (0.5, 0.5, 0, ...), both with a certainty of 0.5
+  Float expected_distance = 0.5;
+  Float expected_certainty = 0.5 * 0.5;
+  EXPECT_FLOAT_EQ(first.degree_of_conflict(second, base_rate, base_rate_other), expected_distance * expected_certainty);
+  EXPECT_FLOAT_EQ(second.degree_of_conflict(first, base_rate_other, base_rate), expected_distance * expected_certainty);
+  EXPECT_FLOAT_EQ(first.degree_of_harmony(second, base_rate, base_rate_other),
+                  (1 - expected_distance) * expected_certainty);
+  EXPECT_FLOAT_EQ(second.degree_of_harmony(first, base_rate_other, base_rate),
+                  (1 - expected_distance) * expected_certainty);
+}
+
 TYPED_TEST(MultinomialOpinionNoBaseTest, CumulativeFusion)
 {
   TypeParam neutral_element{};
@@ -340,6 +364,41 @@ TYPED_TEST(MultinomialOpinionNoBaseTest, TrustDiscount)
   EXPECT_FLOAT_EQ(var.uncertainty(), expected_uncert);
 }
 
+TYPED_TEST(MultinomialOpinionNoBaseTest, ScaleEvidence)
+{
+  // scaling the evidence equals scaling the evidence of the Dirichlet representation
+  auto scaled = this->variable_.scale_evidence(0.25);
+  auto expected_evidence = this->variable_.evidence() * static_cast<typename TypeParam::FLOAT_t>(0.25);
+  for (std::size_t idx{ 0 }; idx < TypeParam::SIZE; ++idx)
+  {
+    EXPECT_NEAR(scaled.evidence()[idx], expected_evidence[idx], 1e-5);
+  }
+  EXPECT_GT(scaled.uncertainty(), this->variable_.uncertainty());
+
+  // scaling twice equals a single scaling with the product of both factors
+  auto twice = this->variable_.scale_evidence(0.5).scale_evidence(0.5);
+  for (std::size_t idx{ 0 }; idx < TypeParam::SIZE; ++idx)
+  {
+    EXPECT_NEAR(twice.belief_masses()[idx], scaled.belief_masses()[idx], 1e-6);
+  }
+
+  // the cumulative fusion of an opinion with itself doubles its evidence
+  auto doubled = this->variable_.scale_evidence(2.);
+  auto fused = this->variable_.cum_fuse(this->variable_);
+  for (std::size_t idx{ 0 }; idx < TypeParam::SIZE; ++idx)
+  {
+    EXPECT_NEAR(doubled.belief_masses()[idx], fused.belief_masses()[idx], 1e-6);
+  }
+
+  EXPECT_EQ(this->variable_.scale_evidence(1.), this->variable_);
+  EXPECT_EQ(this->variable_.scale_evidence(0.), TypeParam{});
+
+  // dogmatic opinions keep their infinite evidence, unless it is completely forgotten
+  TypeParam dogmatic{ TypeParam::NeutralBeliefDistr() };
+  EXPECT_EQ(dogmatic.scale_evidence(0.1), dogmatic);
+  EXPECT_EQ(dogmatic.scale_evidence(0.), TypeParam{});
+}
+
 TYPED_TEST(MultinomialOpinionNoBaseTest, ReducedOpinions)
 {
   constexpr std::size_t newN{ 2 };
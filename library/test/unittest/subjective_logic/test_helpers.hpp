@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "subjective_logic_lib/opinions/opinion.hpp"
+#include "subjective_logic_lib/opinions/opinion_no_base.hpp"
+
+/**
+ * random opinions and comparisons shared by the tests of the batch and multi-source operators
+ */
+namespace subjective_logic::test
+{
+
+/**
+ * @brief draws the belief masses from [min_mass, 1) and normalizes them, such that the opinion is either dogmatic or
+ * has a random uncertainty. the prior of opinions with base rate is drawn from [min_mass, 1) and normalized as well
+ * @tparam OpinionT - Opinion or OpinionNoBase
+ * @param gen
+ * @param min_mass - lower bound of the drawn (unnormalized) masses
+ * @param dogmatic - whether the belief masses sum up to one
+ */
+template <typename OpinionT>
+OpinionT random_opinion(std::mt19937& gen, typename OpinionT::FLOAT_t min_mass = 0., bool dogmatic = false)
+{
+  using FloatT = typename OpinionT::FLOAT_t;
+  std::uniform_real_distribution<FloatT> dist{ min_mass, 1. };
+
+  OpinionT opinion;
+  FloatT sum{ 0. };
+  for (std::size_t mass_idx{ 0 }; mass_idx < OpinionT::SIZE; ++mass_idx)
+  {
+    opinion.belief_masses()[mass_idx] = dist(gen);
+    sum += opinion.belief_masses()[mass_idx];
+  }
+  opinion.belief_masses() /= sum + (dogmatic ? static_cast<FloatT>(0.) : dist(gen));
+  if constexpr (is_opinion<OpinionT>)
+  {
+    for (std::size_t mass_idx{ 0 }; mass_idx < OpinionT::SIZE; ++mass_idx)
+    {
+      opinion.prior_belief_masses()[mass_idx] = dist(gen);
+    }
+    opinion.prior_belief_masses() /= opinion.prior_belief_masses().sum();
+  }
+  return opinion;
+}
+
+/**
+ * @brief non-dogmatic random opinions, see random_opinion
+ */
+template <typename OpinionT>
+std::vector<OpinionT> random_opinions(std::size_t num_opinions,
+                                      unsigned int seed,
+                                      typename OpinionT::FLOAT_t min_mass = 0.)
+{
+  std::mt19937 gen{ seed };
+  std::vector<OpinionT> opinions;
+  for (std::size_t idx{ 0 }; idx < num_opinions; ++idx)
+  {
+    opinions.push_back(random_opinion<OpinionT>(gen, min_mass));
+  }
+  return opinions;
+}
+
+/**
+ * @brief opinions covering vacuous, dogmatic and random belief distributions, i.e., every fifth opinion is vacuous,
+ * every fifth one believes in a single state and every third of the remaining random ones is dogmatic
+ */
+template <typename OpinionT>
+std::vector<OpinionT> mixed_opinions(std::size_t num_opinions, unsigned int seed)
+{
+  std::mt19937 gen{ seed };
+  std::vector<OpinionT> opinions(num_opinions);
+  for (std::size_t idx{ 0 }; idx < num_opinions; ++idx)
+  {
+    switch (idx % 5)
+    {
+      case 0:
+        break;
+      case 1:
+        opinions[idx].belief_masses()[(idx + seed) % OpinionT::SIZE] = 1.;
+        break;
+      default:
+        opinions[idx] = random_opinion<OpinionT>(gen, 0., idx % 3 == 0);
+        break;
+    }
+  }
+  return opinions;
+}
+
+/**
+ * @brief compares the belief masses and, for opinions with base rate, the priors of two opinions
+ */
+template <typename OpinionT>
+void expect_near(const OpinionT& actual, const OpinionT& expected, double tolerance)
+{
+  for (std::size_t mass_idx{ 0 }; mass_idx < OpinionT::SIZE; ++mass_idx)
+  {
+    EXPECT_NEAR(actual.belief_masses()[mass_idx], expected.belief_masses()[mass_idx], tolerance);
+    if constexpr (is_opinion<OpinionT>)
+    {
+      EXPECT_NEAR(actual.prior_belief_masses()[mass_idx], expected.prior_belief_masses()[mass_idx], tolerance);
+    }
+  }
+}
+
+}  // namespace subjective_logic::test
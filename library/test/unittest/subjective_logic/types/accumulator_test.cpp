@@ -0,0 +1,67 @@
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+#include "subjective_logic_lib/types/accumulator.hpp"
+#include "subjective_logic_lib/types/cuda_compatible_array.hpp"
+
+namespace subjective_logic
+{
+
+template <typename FloatT, AccumulationPolicy Policy>
+FloatT sum_up(FloatT value, std::size_t num_terms)
+{
+  Accumulator<FloatT, Policy> accumulator;
+  for (std::size_t idx{ 0 }; idx < num_terms; ++idx)
+  {
+    accumulator += value;
+  }
+  return accumulator.value();
+}
+
+TEST(AccumulatorTest, DefaultPolicies)
+{
+  EXPECT_EQ(ACCUMULATION_v<float>, AccumulationPolicy::WIDENED);
+  EXPECT_EQ(ACCUMULATION_v<double>, AccumulationPolicy::COMPENSATED);
+  static_assert(std::is_same_v<Accumulator<float>::SumType, double>);
+  static_assert(std::is_same_v<Accumulator<double>::SumType, double>);
+  static_assert(std::is_same_v<Accumulator<float, AccumulationPolicy::COMPENSATED>::SumType, float>);
+}
+
+TEST(AccumulatorTest, Precision)
+{
+  constexpr std::size_t NUM_TERMS{ 1000000 };
+  constexpr double EXPECTED{ 0.1 * NUM_TERMS };
+
+  // the plain float sum drifts away after a few thousand terms
+  float native = sum_up<float, AccumulationPolicy::NATIVE>(0.1F, NUM_TERMS);
+  EXPECT_GT(std::abs(native - EXPECTED), 100.);
+
+  float widened = sum_up<float, AccumulationPolicy::WIDENED>(0.1F, NUM_TERMS);
+  float compensated = sum_up<float, AccumulationPolicy::COMPENSATED>(0.1F, NUM_TERMS);
+  double compensated_double = sum_up<double, AccumulationPolicy::COMPENSATED>(0.1, NUM_TERMS);
+  EXPECT_NEAR(widened, EXPECTED, 1e-2);
+  EXPECT_NEAR(compensated, EXPECTED, 1e-2);
+  EXPECT_NEAR(compensated_double, EXPECTED, 1e-9);
+}
+
+TEST(AccumulatorTest, ConstexprAndArray)
+{
+  constexpr auto sum = []() {
+    Array<2, Accumulator<float>> sums;
+    for (int idx{ 0 }; idx < 10; ++idx)
+    {
+      sums[0] += 0.5F;
+      sums[1] += static_cast<float>(idx);
+    }
+    return Array<2, double>{ sums[0].sum(), sums[1].sum() };
+  }();
+  static_assert(sum[0] == 5.);
+  static_assert(sum[1] == 45.);
+
+  Accumulator<double> initialized{ 2. };
+  initialized += 0.5;
+  EXPECT_EQ(initialized.value(), 2.5);
+}
+
+}  // namespace subjective_logic
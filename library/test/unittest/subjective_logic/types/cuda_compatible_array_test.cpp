@@ -1,3 +1,6 @@
+#include <span>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "subjective_logic_lib/types/cuda_compatible_array.hpp"
@@ -278,5 +281,22 @@ TYPED_TEST(ArrayTest, Sum)
   auto expected_result = this->test.size() * (this->test.size() - 1) * 0.5;
   EXPECT_FLOAT_EQ(sum, expected_result);
 }
+TYPED_TEST(ArrayTest, ForEachEntry)
+{
+  static_assert(is_fixed_size_array<TypeParam>);
+  static_assert(not is_fixed_size_array<std::span<const typename TestFixture::T>>);
+
+  // the unrolled loop visits the entries in the same order as the loop over a span
+  std::vector<typename TestFixture::T> visited;
+  for_each_entry(this->test, [&](const auto& entry) { visited.push_back(entry); });
+  for_each_entry(std::span{ &this->test[0], this->test.size() },
+                 [&](const auto& entry) { visited.push_back(entry); });
+  ASSERT_EQ(visited.size(), 2 * TypeParam::size());
+  for (std::size_t idx{ 0 }; idx < TypeParam::size(); ++idx)
+  {
+    EXPECT_EQ(visited[idx], this->test[idx]);
+    EXPECT_EQ(visited[TypeParam::size() + idx], this->test[idx]);
+  }
+}
 
 }  // namespace subjective_logic